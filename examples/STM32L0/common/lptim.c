@@ -21,6 +21,9 @@
 // LPTIM Minimuim Settable time (mS)
 #define LPTIM_TIME_MIN_MS 3
 
+// Set by the compare match IRQ, cleared each time the LPTIM is set.
+static volatile bool lptim_cmpm = false;
+
 // Function for Writing  the LPTIM Compare Register
 // Note LPTIM must be enabled before setting the register
 static void lptim_compare_set(uint16_t cmp_reg) {
@@ -133,9 +136,12 @@ void lptim_set(uint16_t period_ms) {
   lptim_init();
 
   // Calculate the compare value using the scaling of 1024 cnts per 1000 mS
-  // if above the min. period.  Limit the counter to the auto reload value
+  // if above the min. period.  Limit the period to the auto reload value
+  if (period_ms > LPTIM_MAX_MS) {
+    period_ms = LPTIM_MAX_MS;
+  }
   if (period_ms > LPTIM_TIME_MIN_MS) {
-    compare_value = ((period_ms * 1024) / 1000) & LPTIM_ARR_MAX;
+    compare_value = ((uint32_t)period_ms * LPTIM_COUNT_HZ) / 1000;
   }
 
   // Write the Compare Register Value / LPTIM must be enabled
@@ -144,13 +150,14 @@ void lptim_set(uint16_t period_ms) {
 
   // Clear all of the LPTIM interrupt flags (Write Any Access)
   LPTIM1->ICR = 0x00000000;
+  lptim_cmpm = false;
 
   // Start the LPTIM in one-shot / no reload Mode.  Sets the SNGSTRT bit
   // Counts up from zero, compare event happens when reaching the compare value.
   LL_LPTIM_StartCounter(LPTIM1, LL_LPTIM_OPERATING_MODE_ONESHOT);
 }
 
-uint32_t lptim_ms_get(void) {
+uint32_t lptim_count_get(void) {
   volatile uint32_t prev_count = LL_LPTIM_GetCounter(LPTIM1);
   volatile uint32_t cur_count = LL_LPTIM_GetCounter(LPTIM1);
 
@@ -160,8 +167,16 @@ uint32_t lptim_ms_get(void) {
     prev_count = cur_count;
     cur_count = LL_LPTIM_GetCounter(LPTIM1);
   }
+  return cur_count;
+}
+
+uint32_t lptim_ms_get(void) {
   // 1000 mS per 1024 cnts
-  return (cur_count * 1000) / 1024;
+  return (lptim_count_get() * 1000) / LPTIM_COUNT_HZ;
+}
+
+bool lptim_expired(void) {
+  return lptim_cmpm;
 }
 
 void lptim_disable(void) {
@@ -184,4 +199,5 @@ void LPTIM1_IRQHandler(void) {
 
   // Any Write will Clear the Compare Match IRQ
   LL_LPTIM_ClearFLAG_CMPM(LPTIM1);
+  lptim_cmpm = true;
 }
\ No newline at end of file
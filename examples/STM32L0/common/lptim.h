@@ -21,6 +21,7 @@
 #ifndef LPTIM_H__
 #define LPTIM_H__
 
+#include <stdbool.h>
 #include "stm32l0xx.h"
 
 #ifdef __cplusplus
@@ -34,12 +35,19 @@ extern "C" {
 // The minimuim LPTIM programmaable time (mS)
 #define LPTIM_MIN_MS 3
 
+// The LPTIM counter frequency after the pre-scaler (Hz)
+#define LPTIM_COUNT_HZ 1024
+
+// The maximum LPTIM programmable time, limited by the 16 bit counter (mS)
+#define LPTIM_MAX_MS ((0xFFFF * 1000) / LPTIM_COUNT_HZ)
+
 /**@brief Function for setting up LPTIM in one-shot mode with an interrupt
  * to expire at time period in the future.  This function initializes the LPTIM
  * if needed and enables the LPTIM and its interrupt.
  *
  * Note that the minimuim time interval is 3 mS.  Time intervals less than
- * this will be increased to 3 mS.
+ * this will be increased to 3 mS.  Time intervals greater than LPTIM_MAX_MS
+ * will be limited to LPTIM_MAX_MS.
  *
  * @param[in] period_ms The counter duration in mS.
  */
@@ -59,6 +67,27 @@ void lptim_set(uint16_t period_ms);
  */
 uint32_t lptim_ms_get(void);
 
+/**@brief Function for getting the current value of LPTIM Counter in
+ * counts of LPTIM_COUNT_HZ.
+ *
+ * The raw count can be accumulated over several consecutive timer periods
+ * and converted to mS once to avoid accumulating the rounding error of each
+ * lptim_ms_get() conversion.
+ *
+ * @return The current LPTIM counter value.
+ */
+uint32_t lptim_count_get(void);
+
+/**@brief Function for checking if the compare match interrupt has occurred
+ * since the LPTIM was last set with lptim_set().
+ *
+ * This can be checked on wakeup from stop to determine if the processor was
+ * woken by the LPTIM or by a different interrupt source.
+ *
+ * @return True if the programmed period expired, false otherwise.
+ */
+bool lptim_expired(void);
+
 /**
  *
  * Function disabling the LPTIM Module.
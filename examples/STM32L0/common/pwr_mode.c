@@ -161,32 +161,64 @@ void pwr_sleep(void) {
 // Estimated Overhead in mS of using the Stop LPTIM Method
 #define STOP_LPTIM_OVERHEAD_MS 4
 
-void pwr_stop_lptim(uint16_t period_ms) {
+void pwr_stop_lptim(uint32_t period_ms) {
 
   if (period_ms > STOP_LPTIM_OVERHEAD_MS) {
 
-    // Stop the SysTick IRQ
-    HAL_SuspendTick();
-
-    // Enable the LPTIM with the desired delay minus the estimated overhead.
-    lptim_set(period_ms - STOP_LPTIM_OVERHEAD_MS);
+    // The time remaining to stop for, minus the estimated overhead.
+    uint32_t remaining_ms = period_ms - STOP_LPTIM_OVERHEAD_MS;
 
-    // WFI Logic:
-    // Each of the ISR's starts a scheduler event so we need for the scheduler to run after
-    // each interrupt. Theres no advantage to using the WFE or using auto sleep on ISR exit.
+    // The total LPTIM counts & corrected mS for all of the stop periods.
+    uint64_t stopped_cnt = 0;
+    uint32_t corrected_ms = 0;
 
-    // Clear the Wakup Flag & Enter Stop Mode
-    __HAL_PWR_CLEAR_FLAG(PWR_FLAG_WU);
-    HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+    // Stop the SysTick IRQ
+    HAL_SuspendTick();
 
-    /* After waking up from stop, correct the SysTick counter with the time interval
-     * that the processor was stopped for.  This interval may be different than the
-     * programmed interval if the processor was woken from a different interrupt.
+    /* The 16 bit LPTIM counter limits a single stop to LPTIM_MAX_MS.  Longer
+     * periods are chained, re-entering the stop mode after each compare match
+     * until the full period has expired or the processor is woken by a
+     * different interrupt.
      */
-    uwTick = uwTick + lptim_ms_get() + STOP_LPTIM_OVERHEAD_MS;
+    while (remaining_ms >= LPTIM_MIN_MS) {
+
+      uint32_t stop_ms = (remaining_ms > LPTIM_MAX_MS) ? LPTIM_MAX_MS : remaining_ms;
+
+      // Enable the LPTIM with the next stop period.
+      lptim_set((uint16_t)stop_ms);
+
+      // WFI Logic:
+      // Each of the ISR's starts a scheduler event so we need for the scheduler to run after
+      // each interrupt. Theres no advantage to using the WFE or using auto sleep on ISR exit.
+
+      // Clear the Wakup Flag & Enter Stop Mode
+      __HAL_PWR_CLEAR_FLAG(PWR_FLAG_WU);
+      HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+
+      /* After waking up from stop, correct the SysTick counter with the time interval
+       * that the processor was stopped for.  This interval may be different than the
+       * programmed interval if the processor was woken from a different interrupt.
+       * The correction is calculated from the total LPTIM count so the count to mS
+       * rounding error doesn't accumulate over chained stop periods.
+       */
+      stopped_cnt += lptim_count_get();
+      uint32_t stopped_ms = (uint32_t)((stopped_cnt * 1000) / LPTIM_COUNT_HZ);
+      uwTick = uwTick + (stopped_ms - corrected_ms);
+      corrected_ms = stopped_ms;
+
+      bool expired = lptim_expired();
+
+      // Disable the LPTIM
+      lptim_disable();
+
+      // Return once woken by a different interrupt.
+      if (!expired) {
+        break;
+      }
+      remaining_ms -= stop_ms;
+    }
 
-    // Disable the LPTIM
-    lptim_disable();
+    uwTick = uwTick + STOP_LPTIM_OVERHEAD_MS;
 
     // Restart the SysTick Irq.
     HAL_ResumeTick();
@@ -18,6 +18,32 @@
 extern "C" {
 #endif
 
+/**
+ * The run modes, numbered from the lowest power mode as the scheduler's
+ * task run modes.
+ */
+typedef enum {
+  /// Run from the 4.194 MHz Medium Speed Internal Oscillator.
+  PWR_RUN_MSI = 0,
+  /// Run from the 16 MHz High Speed Internal Oscillator.
+  PWR_RUN_HSI = 1
+} pwr_run_t;
+
+/**
+ * The sleep modes, numbered from the shallowest mode as the scheduler's
+ * task sleep modes.
+ */
+typedef enum {
+  /// Busy wait, the processor isn't stopped.
+  PWR_SLEEP_NONE = 0,
+  /// The Sleep Power Mode, the peripheral clocks keep running and the
+  /// SysTick wakes the processor every mS.
+  PWR_SLEEP_WFI = 1,
+  /// The Stop Power Mode, only the LSE clocked peripherals keep running and
+  /// the LPTIM wakes the processor.
+  PWR_SLEEP_STOP = 2
+} pwr_sleep_t;
+
 /**
  * Function for enabling the Run Power Mode with the Medium Speed
  * Internal Oscillator.
@@ -47,7 +73,10 @@ void pwr_sleep(void);
  *
  * The systick timer and interupt are disabled in the stop mode. The systick
  * timer is corrected for the duration of the stop once the processor is woken.
- * The systick time is not corrected until this function returns.
+ *
+ * Periods longer than the LPTIM's 16 bit range (LPTIM_MAX_MS) are split into
+ * consecutive stops so a single call can span the full 32 bit mS range.  The
+ * systick timer is corrected after each of the stops.
  *
  * Note that this function is blocking.  It does not return until the time
  * interval expires or another hardware interrupt is received.
@@ -55,7 +84,7 @@ void pwr_sleep(void);
  * @param[in] period_ms The duration to sleep in mS.
  *
  */
-void pwr_stop_lptim(uint16_t period_ms);
+void pwr_stop_lptim(uint32_t period_ms);
 
 /**@brief Function for initializing the power module and starting the run mode.
  *
@@ -2,22 +2,41 @@
 #include "sched_port.h"
 #include "pwr_mode.h"
 #include "stm32l0xx_hal.h"
-#include <stdio.h>
 
-// Uncomment to Log the Sleep Method at Scheduler Init
-#define LOG_SLEEP_METHOD
-
-// Sleep Method Definition.
-
-// Don't sleep between tasks
-#define SLEEP_NONE 0
-// Stop the processor and use the systick timer to wake it.
-#define SLEEP_SYSTICK 1
-// Stop the processor and use the LPTIMER to wake it.
-#define SLEEP_LPTIMER 2
-
-// Select the sleep method to use between scheduler tasks.
-#define SLEEP_METHOD SLEEP_NONE
+/* Sleep Policy
+ *
+ * The sleep method is chosen at runtime before each sleep.  With the
+ * scheduler's SCHED_TASK_POWER_EN build define enabled, the scheduler
+ * switches to the pwr_run_t run mode each task handler requires and selects
+ * each sleep's pwr_sleep_t mode from the sleep state table below.  The
+ * deepest state allowed by the started tasks whose break-even time fits in
+ * the time until the next task expires is used, and the processor is woken
+ * early by the state's exit latency.  Without task power modes, the
+ * processor always stops between tasks.
+ */
+
+// The selected sleep mode.
+static pwr_sleep_t sleep_limit = PWR_SLEEP_STOP;
+
+/* Sleep State Table
+ *
+ * The latencies and break-even times, in mS, are estimates for the
+ * STM32L053 running from the MSI clock with the LSE clocked LPTIM.  They
+ * should be calibrated on the target hardware with the sleep_cal module, see
+ * the power project's README.  The Stop Mode's break-even time covers the
+ * LPTIM set up and the SysTick correction (STOP_LPTIM_OVERHEAD_MS) and its
+ * exit latency covers the wake up from the LPTIM interrupt.
+ */
+static const sched_port_sleep_state_t sleep_states[] = {
+    {.sleep_mode = PWR_SLEEP_NONE, .entry_ticks = 0, .exit_ticks = 0, .break_even_ticks = 0},
+    {.sleep_mode = PWR_SLEEP_WFI, .entry_ticks = 0, .exit_ticks = 0, .break_even_ticks = 1},
+    {.sleep_mode = PWR_SLEEP_STOP, .entry_ticks = 0, .exit_ticks = 1, .break_even_ticks = 5},
+};
+
+// The port's timer is the 32 bit mS HAL tick.
+#if (SCHED_TICK_HZ != 1000) || (SCHED_TIME_64_EN != 0)
+#error "The STM32L0 port only supports 32 bit time with a SCHED_TICK_HZ of 1000"
+#endif
 
 // IRQ Priority Mask
 static uint32_t primask_bit;
@@ -38,59 +57,80 @@ uint32_t sched_port_ms(void) {
   return (uint32_t)HAL_GetTick();
 }
 
+void sched_port_run_mode(uint8_t run_mode) {
+  // Only the handlers which need the fast clock run from the HSI.
+  if (run_mode >= PWR_RUN_HSI) {
+    pwr_run_hsi();
+  } else {
+    pwr_run_msi();
+  }
+}
+
+void sched_port_sleep_mode(uint8_t sleep_mode) {
+  sleep_limit = (sleep_mode > PWR_SLEEP_STOP) ? PWR_SLEEP_STOP : (pwr_sleep_t)sleep_mode;
+}
+
+uint8_t sched_port_sleep_states(const sched_port_sleep_state_t **pp_states) {
+  *pp_states = sleep_states;
+  return (uint8_t)(sizeof(sleep_states) / sizeof(sleep_states[0]));
+}
+
 void sched_port_sleep(uint32_t interval_ms) {
 
-#ifndef SLEEP_METHOD
-#error "The sleep type must be defined"
-#elif (SLEEP_METHOD == SLEEP_NONE)
-  /*
-   * This sleep method repeatably execute the scheduler event que without
-   * sleeping between tasks.  This is the simplest but most power intensive
-   * sleep implementation.
-   */
-
-#elif (SLEEP_METHOD == SLEEP_SYSTICK)
-  /*
-   * This implementation repeatably executes the scheduler event que
-   * stopping for up to 1mS during each function call.  Once put into the
-   * stop mode, the processor can be only be woken due to a hardware 
-   * interrupt at which point the function returns and the scheduler 
-   * executes any tasks with expired timers.  The systick timer is 
-   * configured to trigger an interrupt once per mS which ensures tasks 
-   * are executed as they expire with mS granularity.
-   */
-  HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
-
-#elif (SLEEP_METHOD == SLEEP_LPTIMER)
-  /*
-   * This implementation enters the processor's Stop Mode between active
-   * tasks.  The LPTIMER is configured to wake the processor once
-   * the next taks interval expires.  The sleep method provides a more
-   * aggressive power reduction technique.
-
-   * The systick timer is temporarily disabled in between active tasks and
-   * the Low Power Timer (LPTIM) is instead utilized for timing the sleep 
-   * intervals.  This method avoids the processor needlessly waking every mS 
-   * to check for task expiration.
-   */
-  pwr_stop_lptim(interval_ms);
-#else
-#error "Unrecognized Sleep Method"
-#endif
+  switch (sleep_limit) {
+  case PWR_SLEEP_NONE:
+    /*
+     * A started task needs the processor to keep running, the scheduler
+     * busy waits until the next task expires.  This is the simplest but most
+     * power intensive sleep method.
+     */
+    break;
+
+  case PWR_SLEEP_WFI:
+    /*
+     * A started task needs its peripheral clocks during the sleep.  The
+     * processor is stopped with the WFI instruction and woken by any
+     * interrupt including the 1 mS SysTick, at which point the scheduler
+     * checks for expired tasks and sleeps again if there are none.
+     */
+    pwr_sleep();
+    break;
+
+  default:
+    /*
+     * The processor's Stop Mode is entered between active tasks and the
+     * LPTIM is configured to wake the processor once the next task's
+     * interval expires.  The SysTick is disabled during the stop so the
+     * processor isn't needlessly woken every mS.  Intervals shorter than the
+     * stop's overhead fall back to the WFI sleep.
+     */
+    pwr_stop_lptim(interval_ms);
+    break;
+  }
+}
+
+sched_port_wake_t sched_port_sleep_until(uint32_t deadline_ms) {
+
+  int32_t remaining_ms = (int32_t)(deadline_ms - sched_port_ms());
+
+  if (remaining_ms > 0) {
+    /*
+     * Sleep for the time remaining until the deadline rather than waking
+     * every mS.  The SysTick counter is corrected after a stop so the
+     * remaining time can be checked to determine if the processor was woken
+     * early by a different interrupt.
+     */
+    sched_port_sleep((uint32_t)remaining_ms);
+    remaining_ms = (int32_t)(deadline_ms - sched_port_ms());
+  }
+
+  return (remaining_ms > 0) ? SCHED_PORT_WAKE_EARLY : SCHED_PORT_WAKE_DEADLINE;
 }
 
 void sched_port_init(void) {
 
-// Log the Sleep Method during scheduler init if enabled.
-#if (SLEEP_METHOD == SLEEP_NONE)
-  printf("Sleep Method: NONE\n");
-#elif (SLEEP_METHOD == SLEEP_SYSTICK)
-  printf("Sleep Method: SYSTICK\n");
-#elif (SLEEP_METHOD == SLEEP_LPTIMER)
-  printf("Sleep Method: LPTIMER\n");
-#else
-  printf("Sleep Method: Unrecognized\n");
-#endif
+  // Start from the deepest sleep until the scheduler sets the limit.
+  sleep_limit = PWR_SLEEP_STOP;
 
   // Initialize the Power Module
   pwr_init();
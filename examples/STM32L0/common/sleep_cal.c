@@ -0,0 +1,92 @@
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "sched_port.h"
+#include "sleep_cal.h"
+#include "stm32l0xx.h"
+#include "stm32l0xx_hal.h"
+
+// The sleep intervals each state is calibrated with (mS).
+static const uint32_t CAL_INTERVALS_MS[] = {1, 2, 3, 5, 10, 20, 50};
+
+#define CAL_INTERVAL_CNT (sizeof(CAL_INTERVALS_MS) / sizeof(CAL_INTERVALS_MS[0]))
+
+// Function for getting the time in uS from the mS HAL tick and the SysTick counter.
+static uint32_t cal_time_us(void) {
+  uint32_t tick_ms;
+  uint32_t count;
+
+  // Read the counter again if the tick was incremented while reading it.
+  do {
+    tick_ms = HAL_GetTick();
+    count = SysTick->VAL;
+  } while (tick_ms != HAL_GetTick());
+
+  // The SysTick counts down from its reload value once every mS.
+  uint32_t reload = SysTick->LOAD + 1;
+  return (tick_ms * 1000) + (((reload - 1 - count) * 1000) / reload);
+}
+
+// Function for waiting for the start of the next mS tick.
+static uint32_t cal_tick_align(void) {
+  uint32_t tick_ms = HAL_GetTick();
+  while (HAL_GetTick() == tick_ms) {
+    // Busy wait
+  }
+  return HAL_GetTick();
+}
+
+void sleep_cal_run(GPIO_TypeDef *p_marker_port, uint16_t marker_pin) {
+
+  const sched_port_sleep_state_t *p_states = NULL;
+  uint8_t state_cnt = sched_port_sleep_states(&p_states);
+
+  printf("Sleep State Calibration: %u States\n", state_cnt);
+  printf("Mode, Interval mS, Late Min uS, Late Avg uS, Late Max uS, Early Wakes\n");
+
+  for (uint8_t state = 0; state < state_cnt; state++) {
+
+    uint8_t sleep_mode = p_states[state].sleep_mode;
+
+    for (uint32_t index = 0; index < CAL_INTERVAL_CNT; index++) {
+
+      uint32_t interval_ms = CAL_INTERVALS_MS[index];
+      uint32_t late_min_us = UINT32_MAX;
+      uint32_t late_max_us = 0;
+      uint32_t late_sum_us = 0;
+      uint32_t early_cnt = 0;
+
+      for (uint32_t repeat = 0; repeat < SLEEP_CAL_REPEAT_CNT; repeat++) {
+
+        // Start each sleep on a tick boundary so the intervals are whole mS.
+        uint32_t deadline_ms = cal_tick_align() + interval_ms;
+
+        sched_port_sleep_mode(sleep_mode);
+        HAL_GPIO_WritePin(p_marker_port, marker_pin, GPIO_PIN_SET);
+        sched_port_wake_t wake = sched_port_sleep_until(deadline_ms);
+        HAL_GPIO_WritePin(p_marker_port, marker_pin, GPIO_PIN_RESET);
+
+        // Wakes before the deadline, by a different interrupt, aren't measured.
+        uint32_t late_us = cal_time_us() - (deadline_ms * 1000);
+        if ((wake != SCHED_PORT_WAKE_DEADLINE) || ((int32_t)late_us < 0)) {
+          early_cnt++;
+          continue;
+        }
+
+        late_min_us = (late_us < late_min_us) ? late_us : late_min_us;
+        late_max_us = (late_us > late_max_us) ? late_us : late_max_us;
+        late_sum_us += late_us;
+      }
+
+      uint32_t late_cnt = SLEEP_CAL_REPEAT_CNT - early_cnt;
+      uint32_t late_avg_us = (late_cnt > 0) ? (late_sum_us / late_cnt) : 0;
+      printf("%u, %lu, %lu, %lu, %lu, %lu\n", sleep_mode, (unsigned long)interval_ms,
+             (unsigned long)((late_cnt > 0) ? late_min_us : 0), (unsigned long)late_avg_us,
+             (unsigned long)late_max_us, (unsigned long)early_cnt);
+    }
+  }
+
+  printf("Sleep State Calibration: Done\n");
+}
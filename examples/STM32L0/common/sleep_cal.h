@@ -0,0 +1,47 @@
+/**
+ * STM32L0XX Sleep State Calibration Module
+ *
+ * The module provides a measurement harness for calibrating the latencies
+ * and break-even times of the port's sleep state table on real hardware.
+ *
+ * Each of the port's sleep states is used for a series of sleeps of each of
+ * the calibration intervals.  A GPIO marker is driven high for the duration
+ * of each sleep so the wake up latency can be measured with an oscilloscope
+ * and each state's sleep current with a current meter, and the wake up
+ * lateness measured from the SysTick is printed for every state and interval.
+ *
+ * The sleeps are made directly through the port's sleep functions, without
+ * the scheduler's early wake, so the measured lateness is the state's exit
+ * latency.
+ *
+ */
+
+#ifndef SLEEP_CAL_H__
+#define SLEEP_CAL_H__
+
+#include <stdint.h>
+#include "stm32l0xx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The number of sleeps made for each state and interval.
+#define SLEEP_CAL_REPEAT_CNT 50
+
+/**@brief Function for running the sleep state calibration.
+ *
+ * The power module must be initialized and the marker GPIO configured as an
+ * output before the calibration is run.  The function is blocking, it takes
+ * several seconds for each state of the port's sleep state table.
+ *
+ * @param[in] p_marker_port  The GPIO port of the marker output.
+ * @param[in] marker_pin     The GPIO pin of the marker output.
+ */
+void sleep_cal_run(GPIO_TypeDef *p_marker_port, uint16_t marker_pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLEEP_CAL_H__ */
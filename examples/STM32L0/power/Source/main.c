@@ -19,6 +19,7 @@
 
 #include "pwr_mode.h"
 #include "scheduler.h"
+#include "sleep_cal.h"
 #include "stm32l0xx.h"
 #include "stm32l0xx_hal.h"
 #include "stm32l0xx_ll_gpio.h"
@@ -26,6 +27,12 @@
 // Forward declaration.
 static void gpio_init(void);
 
+// Run the sleep state calibration before starting the scheduler?  The LED
+// output is used as the calibration's marker.
+#ifndef SLEEP_CAL_EN
+#define SLEEP_CAL_EN 0
+#endif
+
 // LED0 GPIO & Port Definition
 // These pin and port defintion may need to be updated for the target board's hardware
 
@@ -73,8 +80,18 @@ int main(void) {
   // First initialize the scheduler before configuring the tasks.
   sched_init();
 
+#if (SLEEP_CAL_EN != 0)
+  // Measure the latencies of the port's sleep state table.
+  sleep_cal_run(LED0_PORT, LED0_PIN);
+#endif
+
   // Configure and start the LED0 task to be called every 250 mS.
   sched_task_config(&led0_task, led0_task_handler, 250, true);
+
+  // The LED task runs from the MSI clock and allows the Stop Mode between
+  // toggles.  Lower the sleep mode to PWR_SLEEP_WFI or PWR_SLEEP_NONE to
+  // compare the sleep methods.
+  sched_task_power(&led0_task, PWR_RUN_MSI, PWR_SLEEP_STOP);
   sched_task_start(&led0_task);
 
   printf("STM32L0 LED Slow Blink Example\n"); 
@@ -0,0 +1,380 @@
+/*
+ * Hosted Linux Scheduler Support Functions
+ */
+
+#include <assert.h>
+#include <stdatomic.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+
+#include "sched_port_posix.h"
+
+#if (SCHED_INSTANCE_CNT != 1)
+#error "The POSIX port supports a single scheduler instance."
+#endif
+
+// The nS in a second.
+#define NS_PER_SEC (1000000000ULL)
+
+// The epoll tags of the timer and the wake event, the file descriptors use their index.
+#define TAG_TIMER (UINT32_MAX)
+#define TAG_WAKE (UINT32_MAX - 1)
+
+// A file descriptor which starts a task.
+typedef struct {
+  // The file descriptor.
+  int fd;
+  // The epoll events waited for.
+  uint32_t events;
+  // The epoll events last reported.
+  uint32_t revents;
+  // The task started when the file descriptor is ready.
+  sched_task_t *p_task;
+  // Is the entry used?
+  bool used;
+  // Was the file descriptor added to the epoll instance?
+  bool added;
+  // Is the file descriptor watched?  It isn't watched again until its task stops.
+  bool armed;
+} port_fd_t;
+
+// Mutex for scheduler exclusive access
+static pthread_mutex_t sched_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Mutex for the file descriptor table and the port's file descriptors.
+static pthread_mutex_t fd_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// The epoll instance the scheduler sleeps on, with its timer and wake event.
+static int epoll_fd = -1;
+static int timer_fd = -1;
+static int wake_fd = -1;
+
+// The file descriptors which start tasks.
+static port_fd_t port_fds[SCHED_PORT_POSIX_FD_MAX];
+
+// Is the scheduler sleeping, or about to sleep?
+static atomic_bool sleeping = false;
+
+// Was the scheduler asked to wake since its last sleep?
+static atomic_bool wake_pending = false;
+
+// A marker in each thread whose address identifies the thread.
+static _Thread_local char thread_marker;
+
+/* The marker of the thread which last slept, 0 before the first sleep.  The
+ * sleeping thread is recorded by each sleep since the scheduler can be
+ * started by a different thread than the one which initialized it.
+ */
+static atomic_uintptr_t sleep_thread = 0;
+
+void sched_port_lock(void) {
+  int ret = pthread_mutex_lock(&sched_mutex);
+  assert(ret == 0);
+  (void)ret;
+}
+
+void sched_port_free(void) {
+  int ret = pthread_mutex_unlock(&sched_mutex);
+  assert(ret == 0);
+  (void)ret;
+}
+
+// Function for getting the monotonic clock time in nS.
+static uint64_t port_ns(void) {
+  struct timespec time;
+  int ret = clock_gettime(CLOCK_MONOTONIC, &time);
+  assert(ret == 0);
+  (void)ret;
+  return ((uint64_t)time.tv_sec * NS_PER_SEC) + (uint64_t)time.tv_nsec;
+}
+
+// Function for getting the monotonic clock time in ticks, rounded down.
+static uint64_t port_ticks(void) {
+  uint64_t time_ns = port_ns();
+  // Split the conversion so fast tick rates don't overflow.
+  return ((time_ns / NS_PER_SEC) * SCHED_TICK_HZ) +
+         (((time_ns % NS_PER_SEC) * SCHED_TICK_HZ) / NS_PER_SEC);
+}
+
+uint32_t sched_port_ms(void) {
+  // Truncate rather than round so the timer never runs ahead of the clock.
+  return (uint32_t)(port_ns() / 1000000);
+}
+
+sched_time_t sched_port_ticks(void) {
+  return (sched_time_t)port_ticks();
+}
+
+// Function for setting the events an epoll instance waits for on a file descriptor.
+static bool port_watch(int op, int fd, uint32_t events, uint32_t tag) {
+  struct epoll_event event = {0};
+  event.events = events;
+  event.data.u32 = tag;
+  return epoll_ctl(epoll_fd, op, fd, &event) == 0;
+}
+
+/* Function for creating the epoll instance, its timer and its wake event if
+ * they aren't open.  Must be called with the fd mutex held.
+ */
+static void port_open(void) {
+  if (epoll_fd >= 0) {
+    return;
+  }
+
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+  wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  assert((epoll_fd >= 0) && (timer_fd >= 0) && (wake_fd >= 0));
+
+  bool watched = port_watch(EPOLL_CTL_ADD, timer_fd, EPOLLIN, TAG_TIMER) &&
+                 port_watch(EPOLL_CTL_ADD, wake_fd, EPOLLIN, TAG_WAKE);
+  assert(watched);
+  (void)watched;
+}
+
+/* Function for closing the epoll instance, its timer and its wake event.
+ * Must be called with the fd mutex held.
+ */
+static void port_close(void) {
+  if (epoll_fd < 0) {
+    return;
+  }
+
+  close(wake_fd);
+  close(timer_fd);
+  close(epoll_fd);
+  wake_fd = -1;
+  timer_fd = -1;
+  epoll_fd = -1;
+
+  // The file descriptors are added to the next epoll instance again.
+  for (uint32_t index = 0; index < SCHED_PORT_POSIX_FD_MAX; index++) {
+    port_fds[index].added = false;
+    port_fds[index].armed = false;
+  }
+}
+
+/* Function for watching the file descriptors whose tasks have stopped since
+ * they were last ready.  Must be called with the fd mutex held.
+ */
+static void port_fds_arm(void) {
+  for (uint32_t index = 0; index < SCHED_PORT_POSIX_FD_MAX; index++) {
+    port_fd_t *p_fd = &port_fds[index];
+    if (!p_fd->used || p_fd->armed || (sched_task_state(p_fd->p_task) == SCHED_TASK_ACTIVE)) {
+      continue;
+    }
+
+    // One shot events stop the file descriptor from being reported until it's armed again.
+    int op = p_fd->added ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+    if (port_watch(op, p_fd->fd, p_fd->events | EPOLLONESHOT, index)) {
+      p_fd->added = true;
+      p_fd->armed = true;
+    }
+  }
+}
+
+void sched_port_init(void) {
+  int ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  port_open();
+  pthread_mutex_unlock(&fd_mutex);
+  (void)ret;
+}
+
+void sched_port_deinit(void) {
+  int ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  port_close();
+  pthread_mutex_unlock(&fd_mutex);
+  (void)ret;
+
+  atomic_store(&sleep_thread, 0);
+}
+
+void sched_port_wake(void) {
+  // The scheduler checks for changes made by its own thread before it sleeps.
+  if (atomic_load(&sleep_thread) == (uintptr_t)&thread_marker) {
+    return;
+  }
+
+  /* The request is published before checking for a sleep and the sleep
+   * before checking for a request, so either the sleeping thread sees the
+   * request or the wake event is written.
+   */
+  atomic_store(&wake_pending, true);
+  if (atomic_load(&sleeping)) {
+    uint64_t value = 1;
+    ssize_t ret = write(wake_fd, &value, sizeof(value));
+    (void)ret;
+  }
+}
+
+/* Platform sleep until function which waits on the epoll instance until the
+ * timer reaches the deadline, another thread asks the scheduler to wake or a
+ * file descriptor's task is started.  A signal which interrupts the wait
+ * is reported as an early wake up.
+ */
+sched_port_wake_t sched_port_sleep_until(sched_time_t deadline_ms) {
+  atomic_store(&sleep_thread, (uintptr_t)&thread_marker);
+  atomic_store(&sleeping, true);
+  if (atomic_exchange(&wake_pending, false)) {
+    atomic_store(&sleeping, false);
+    return SCHED_PORT_WAKE_EARLY;
+  }
+
+  uint64_t now_ticks = port_ticks();
+  int32_t remaining_ms = (int32_t)(deadline_ms - (sched_time_t)now_ticks);
+  if (remaining_ms <= 0) {
+    atomic_store(&sleeping, false);
+    return SCHED_PORT_WAKE_DEADLINE;
+  }
+
+  // Arm the timer with the monotonic time of the first nS of the deadline's tick.
+  uint64_t deadline_ticks = now_ticks + (uint32_t)remaining_ms;
+  struct itimerspec timer = {0};
+  timer.it_value.tv_sec = (time_t)(deadline_ticks / SCHED_TICK_HZ);
+  timer.it_value.tv_nsec =
+      (long)((((deadline_ticks % SCHED_TICK_HZ) * NS_PER_SEC) + SCHED_TICK_HZ - 1) / SCHED_TICK_HZ);
+  int ret = timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &timer, NULL);
+  assert(ret == 0);
+  (void)ret;
+
+  ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  port_fds_arm();
+  pthread_mutex_unlock(&fd_mutex);
+
+  struct epoll_event events[SCHED_PORT_POSIX_FD_MAX + 2];
+  int event_cnt = epoll_wait(epoll_fd, events, SCHED_PORT_POSIX_FD_MAX + 2, -1);
+  atomic_store(&sleeping, false);
+
+  ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  for (int index = 0; index < event_cnt; index++) {
+    uint32_t tag = events[index].data.u32;
+    uint64_t value;
+
+    if (tag == TAG_TIMER) {
+      ret = (int)read(timer_fd, &value, sizeof(value));
+    } else if (tag == TAG_WAKE) {
+      ret = (int)read(wake_fd, &value, sizeof(value));
+    } else if ((tag < SCHED_PORT_POSIX_FD_MAX) && port_fds[tag].used && port_fds[tag].armed) {
+      // The file descriptor is ready, start its task.
+      port_fd_t *p_fd = &port_fds[tag];
+      p_fd->armed = false;
+      p_fd->revents = events[index].events;
+      sched_task_start(p_fd->p_task);
+    }
+  }
+  pthread_mutex_unlock(&fd_mutex);
+
+  /* The wake requests made before the wake up were for changes the scheduler
+   * checks for once the function returns.
+   */
+  atomic_store(&wake_pending, false);
+
+  remaining_ms = (int32_t)(deadline_ms - sched_port_ticks());
+  return (remaining_ms > 0) ? SCHED_PORT_WAKE_EARLY : SCHED_PORT_WAKE_DEADLINE;
+}
+
+void sched_port_sleep(uint32_t interval_ms) {
+  sched_time_t deadline_ms = sched_port_ticks() + interval_ms;
+  while (sched_port_sleep_until(deadline_ms) != SCHED_PORT_WAKE_DEADLINE) {
+    // Sleep for the rest of the interval.
+  }
+}
+
+bool sched_port_fd_add(int fd, uint32_t events, sched_task_t *p_task) {
+  if ((fd < 0) || (p_task == NULL)) {
+    return false;
+  }
+
+  int ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  (void)ret;
+
+  port_fd_t *p_free = NULL;
+  bool duplicate = false;
+  for (uint32_t index = 0; index < SCHED_PORT_POSIX_FD_MAX; index++) {
+    if (!port_fds[index].used) {
+      p_free = (p_free == NULL) ? &port_fds[index] : p_free;
+    } else if (port_fds[index].fd == fd) {
+      duplicate = true;
+    }
+  }
+
+  bool added = false;
+  if (!duplicate && (p_free != NULL)) {
+    /* The file descriptor is added disabled, to check that epoll supports
+     * it, and armed by the scheduler's next sleep.
+     */
+    port_open();
+    if (port_watch(EPOLL_CTL_ADD, fd, EPOLLONESHOT, (uint32_t)(p_free - port_fds))) {
+      p_free->fd = fd;
+      p_free->events = events;
+      p_free->revents = 0;
+      p_free->p_task = p_task;
+      p_free->used = true;
+      p_free->added = true;
+      p_free->armed = false;
+      added = true;
+    }
+  }
+
+  pthread_mutex_unlock(&fd_mutex);
+
+  // End a sleep in progress so the file descriptor is armed.
+  if (added) {
+    sched_port_wake();
+  }
+
+  return added;
+}
+
+bool sched_port_fd_remove(int fd) {
+  int ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  (void)ret;
+
+  bool removed = false;
+  for (uint32_t index = 0; index < SCHED_PORT_POSIX_FD_MAX; index++) {
+    port_fd_t *p_fd = &port_fds[index];
+    if (p_fd->used && (p_fd->fd == fd)) {
+      if (p_fd->added) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+      }
+      p_fd->used = false;
+      p_fd->added = false;
+      p_fd->armed = false;
+      removed = true;
+      break;
+    }
+  }
+
+  pthread_mutex_unlock(&fd_mutex);
+
+  return removed;
+}
+
+uint32_t sched_port_fd_events(int fd) {
+  int ret = pthread_mutex_lock(&fd_mutex);
+  assert(ret == 0);
+  (void)ret;
+
+  uint32_t revents = 0;
+  for (uint32_t index = 0; index < SCHED_PORT_POSIX_FD_MAX; index++) {
+    if (port_fds[index].used && (port_fds[index].fd == fd)) {
+      revents = port_fds[index].revents;
+      break;
+    }
+  }
+
+  pthread_mutex_unlock(&fd_mutex);
+
+  return revents;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file sched_port_posix.h
+ * @brief Hosted Linux platform support for the scheduler.
+ *
+ * The port runs the scheduler in a process on Linux.  The scheduler sleeps
+ * in epoll_wait() on a timerfd, armed with the absolute CLOCK_MONOTONIC time
+ * of the sleep deadline's tick, and an eventfd which other threads write to
+ * end the sleep.  Tasks started or stopped by other threads therefore wake
+ * the scheduler immediately, and the deadline is met without waking early
+ * to sleep again or waking up to a mS late.  The port can also start a task
+ * when a file descriptor, such as a socket, becomes ready, so I/O is handled
+ * by tasks without a separate poll loop.
+ *
+ * The scheduler lock is a pthread mutex.  The port supports a single
+ * scheduler instance, run by one thread, while any thread can start or stop
+ * its tasks.  The task post que rules still apply to posts.
+ */
+
+#ifndef SCHED_PORT_POSIX_H__
+#define SCHED_PORT_POSIX_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The maximum number of file descriptors which can trigger tasks.
+ */
+#ifndef SCHED_PORT_POSIX_FD_MAX
+#define SCHED_PORT_POSIX_FD_MAX (16)
+#endif
+
+/**
+ * @brief Function for starting a task when a file descriptor becomes ready.
+ *
+ * The port waits for the epoll events on the file descriptor while the
+ * scheduler sleeps and starts the task once one of them is reported, which
+ * ends the sleep.  The task should be a configured single shot task, usually
+ * with a 0 interval, whose handler services the file descriptor, for example
+ * by reading a non-blocking socket until it would block.  The file
+ * descriptor isn't watched again until the task has stopped, so a ready file
+ * descriptor doesn't wake the scheduler repeatedly before the task has run.
+ *
+ * The file descriptor is only watched while the scheduler sleeps, so it
+ * waits while the scheduler runs expired tasks.  The function can be called
+ * from any thread, before or after the scheduler is started.
+ *
+ * @param[in] fd      The file descriptor, which must remain open until it is
+ *                    removed.
+ * @param[in] events  The epoll events to wait for, for example EPOLLIN.
+ * @param[in] p_task  Pointer to the task to start.
+ *
+ * @retval True if the file descriptor was added.
+ * @retval False if the task pointer was NULL, the file descriptor was already
+ *         added, SCHED_PORT_POSIX_FD_MAX file descriptors were added or the
+ *         file descriptor can't be watched with epoll.
+ */
+bool sched_port_fd_add(int fd, uint32_t events, sched_task_t *p_task);
+
+/**
+ * @brief Function for no longer starting a task when a file descriptor
+ * becomes ready.
+ *
+ * The file descriptor's task isn't stopped, it may still run once if it
+ * was started before the file descriptor was removed.
+ *
+ * @param[in] fd  The file descriptor.
+ *
+ * @retval True if the file descriptor was removed.
+ * @retval False if the file descriptor wasn't added.
+ */
+bool sched_port_fd_remove(int fd);
+
+/**
+ * @brief Function for getting the epoll events last reported for a file
+ * descriptor, for use by its task's handler.
+ *
+ * @param[in] fd  The file descriptor.
+ *
+ * @return The epoll events reported when the file descriptor's task was last
+ *         started, 0 if the file descriptor wasn't added.
+ */
+uint32_t sched_port_fd_events(int fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_PORT_POSIX_H__
@@ -0,0 +1,615 @@
+/**
+ * @file sched_config.h
+ * @author Ben Wirz
+ * @brief Scheduler module build configuration defines.
+ *
+ * Each of the configuration defines has a default value which can be
+ * overridden by the end user, typically from the compiler command line.  The
+ * defines are placed in a header file, rather than in the scheduler source,
+ * since several of them modify the layout of the task data structure which
+ * must be consistent everywhere the scheduler's headers are included.
+ */
+
+#ifndef SCHED_CONFIG_H__
+#define SCHED_CONFIG_H__
+
+#include <stdint.h>
+
+/**
+ * @brief Definition to enable / disable clearing buffered task data.
+ *
+ * If SCHED_TASK_BUFF_CLEAR_EN is defined to be > 0, task data buffers
+ * will be cleared when they are configured.  The default implementation
+ * is to not clear the buffer but the end user can override this by defining
+ * SCHED_TASK_BUFF_CLEAR_EN to be 1 if desired.  Clearing large task data
+ * buffer can be expensive and is unnecessary for most applications since the
+ * buffer is overwritten when data is added.  Clearing the buffer can be
+ * useful for certain debugging purposes and it is therefore conditionally
+ * supported.
+ */
+#ifndef SCHED_TASK_BUFF_CLEAR_EN
+#define SCHED_TASK_BUFF_CLEAR_EN (0)
+#endif
+
+/**
+ * @brief Definition for the frequency of the scheduler's time base. (Hz)
+ *
+ * All of the scheduler's times, including task intervals, slack, the
+ * sched_port_sleep() intervals and SCHED_MS_MAX are in units of ticks of
+ * the sched_port_ticks() timer.  The default of 1000 Hz uses the port's mS
+ * timer so each tick is 1 mS and sched_port_ticks() defaults to
+ * sched_port_ms().  A higher frequency gives finer task timing at the cost of
+ * a shorter rollover period, 10000 Hz gives 100 uS ticks with an interval
+ * range of ~4.97 days.  The port must implement sched_port_ticks() for any
+ * other frequency.  The SCHED_MS_TO_TICKS() and SCHED_TICKS_TO_MS() helper
+ * macros convert between the units. 1 to 1000000 (Hz)
+ */
+#ifndef SCHED_TICK_HZ
+#define SCHED_TICK_HZ (1000)
+#endif
+
+/**
+ * @brief Definition to enable or disable 64 bit time.
+ *
+ * If SCHED_TIME_64_EN is defined to be != 0, the scheduler's sched_time_t
+ * time type, including each task's start time, interval and slack, is 64 bits
+ * wide and sched_port_ticks() must return a 64 bit tick count.  64 bit time
+ * never rolls over in practice so task intervals aren't limited to the 32 bit
+ * range of ~49.7 days at 1000 Hz and the heap que engine compares task
+ * expiration times directly.  64 bit time requires an additional 8 bytes of
+ * RAM per task, or 12 with task slack, and is disabled by default.
+ */
+#ifndef SCHED_TIME_64_EN
+#define SCHED_TIME_64_EN (0)
+#endif
+
+/// @brief The maximum value of the scheduler's sched_time_t time type.
+#if (SCHED_TIME_64_EN != 0)
+#define SCHED_TIME_MAX (UINT64_MAX)
+#else
+#define SCHED_TIME_MAX (UINT32_MAX)
+#endif
+
+/**
+ * @brief Definition for the maximum task interval time in ticks.
+ *
+ * The define sets the maximum task interval time in ticks, which are mS with
+ * the default SCHED_TICK_HZ.  The default value of SCHED_TIME_MAX, or half of
+ * it with 64 bit time, will be suitable for most applications but the end
+ * user can define a lower value should they need to limit task intervals.
+ * 64 bit task expiration times are computed as the start time plus the
+ * interval, so the interval is limited to half of the time range to leave
+ * the other half for the tick count.
+ */
+#ifndef SCHED_MS_MAX
+#if (SCHED_TIME_64_EN != 0)
+#define SCHED_MS_MAX (SCHED_TIME_MAX / 2)
+#else
+#define SCHED_MS_MAX (SCHED_TIME_MAX)
+#endif
+#endif
+
+/**
+ * @brief Definition to enable or disable Scheduler Task Pools.
+ *
+ * If SCHED_TASK_POOL_EN is defined to be != 0, scheduler task pool support
+ * will be enabled.  Task pools are enabled by default but the end user can
+ * disable them to reduce the scheduler's ROM footprint if support for them is
+ * not needed.  Each task records its pool in 4 spare bits of its flags so
+ * pools don't add to the size of a task.
+ */
+#ifndef SCHED_TASK_POOL_EN
+#define SCHED_TASK_POOL_EN (1)
+#endif
+
+/**
+ * @brief Definition for the maximum number of task pools.
+ *
+ * Each task pool is registered in a table of SCHED_TASK_POOL_MAX entries the
+ * first time a task is allocated from it, and each of its tasks stores the
+ * pool's index in the table.  sched_task_alloc() fails for a pool which
+ * can't be registered because the table is full.  Each entry requires one
+ * pointer of RAM. 1 to 15 (pools)
+ */
+#ifndef SCHED_TASK_POOL_MAX
+#define SCHED_TASK_POOL_MAX (4)
+#endif
+
+/**
+ * @brief Definition for the block size of task pool data arenas. (bytes)
+ *
+ * Task pools defined with the SCHED_TASK_ARENA_POOL_DEF() macro share a single
+ * data arena which is divided into blocks of SCHED_TASK_ARENA_BLOCK_SIZE bytes.
+ * Each sched_task_data() call reserves the smallest run of consecutive blocks
+ * which fits the data.  Smaller blocks waste less of the arena on rounding
+ * while larger blocks reduce the size of the arena's free block bitmap, which
+ * requires one bit per block, and the time taken to find a free run of
+ * blocks. 1 to UINT8_MAX (bytes)
+ */
+#ifndef SCHED_TASK_ARENA_BLOCK_SIZE
+#define SCHED_TASK_ARENA_BLOCK_SIZE (16)
+#endif
+
+/**
+ * @brief Definition to enable or disable the compact task layout.
+ *
+ * If SCHED_TASK_COMPACT_EN is defined to be != 0, each task stores a 16 bit
+ * handle in place of its next task pointer.  A handle is the task's offset
+ * from the start of a linker section holding every task, so all of the tasks
+ * must be defined with the SCHED_TASK_DEF(), SCHED_TASK_BUFF_DEF() or task
+ * pool macros, or with the SCHED_TASK_SECTION attribute.  sched_task_config()
+ * rejects any other task.  The section must be placed in the initialized RAM
+ * copied by the startup code, see the build configuration documentation.
+ *
+ * The data pointer and sizes of buffered tasks are moved into a data record
+ * and unbuffered tasks don't store data.  An unbuffered task is 4 bytes
+ * smaller on a typical 32-bit system and 8 bytes smaller on a 64-bit system
+ * while a buffered task and its record are 4, or 8, bytes larger.  It requires
+ * a GNU compatible toolchain and is disabled by default.
+ */
+#ifndef SCHED_TASK_COMPACT_EN
+#define SCHED_TASK_COMPACT_EN (0)
+#endif
+
+/**
+ * @brief Definition to enable or disable task caching.
+ *
+ * If SCHED_TASK_CACHE_EN is defined to be != 0, the scheduler will cache the
+ * soonest expiring tasks.  The cache is updated as tasks are started, updated
+ * or stopped which enables the scheduler to immediately check the next
+ * expiring task on wake up.  If the next task is unexpired, the scheduler can
+ * skip the task que search and immediately put the processor back to sleep.
+ * The caching optimization is enabled by default but can be disabled by end
+ * user if desired.  The number of cached tasks is set by
+ * SCHED_TASK_CACHE_SIZE.
+ *
+ * @note Task caching only applies to the SCHED_QUE_LIST que engine.  The
+ * other que engines always have the next expiring task available.
+ */
+#ifndef SCHED_TASK_CACHE_EN
+#define SCHED_TASK_CACHE_EN (1)
+#endif
+
+/**
+ * @brief Definition for the number of tasks stored by the task cache.
+ *
+ * The cache stores the soonest expiring tasks and is updated as tasks are
+ * started, updated or stopped.  The task que only needs to be searched once
+ * all of the cached tasks have expired or been stopped, so a larger cache
+ * reduces the number of searches at the cost of one pointer of RAM per
+ * task.  1 to UINT8_MAX (tasks)
+ */
+#ifndef SCHED_TASK_CACHE_SIZE
+#define SCHED_TASK_CACHE_SIZE (4)
+#endif
+
+/**
+ * @brief Definition to enable or disable batch task dispatch.
+ *
+ * If SCHED_TASK_BATCH_EN is defined to be != 0, the scheduler collects every
+ * expired task into a run list using a single time sample and then executes
+ * their handlers back to back.  Repeating tasks default to the
+ * SCHED_REPEAT_FIXED_RATE_SKIP repeat mode so they are re-armed from their
+ * scheduled expiration time rather than from the time their handler was
+ * called.  Tasks which expire together stay aligned and handler latency
+ * doesn't accumulate as drift.  Batch dispatch is disabled by default.
+ */
+#ifndef SCHED_TASK_BATCH_EN
+#define SCHED_TASK_BATCH_EN (0)
+#endif
+
+/**
+ * @brief Definition to enable or disable task slack.
+ *
+ * If SCHED_TASK_SLACK_EN is defined to be != 0, each task can be assigned a
+ * slack time with the sched_task_slack() function.  A task's handler may be
+ * called up to its slack time after the task expires.  The scheduler sleeps
+ * until the earliest time by which a task's slack will run out rather than
+ * until the next task expires so tasks with overlapping slack windows are
+ * executed on a single wake up.  Task slack requires an additional 4 bytes of
+ * RAM per task and is disabled by default.
+ */
+#ifndef SCHED_TASK_SLACK_EN
+#define SCHED_TASK_SLACK_EN (0)
+#endif
+
+/**
+ * @brief Definition for the number of task priority levels.
+ *
+ * If SCHED_TASK_PRIORITY_LEVELS is defined to be > 1, each task can be
+ * assigned a priority level from 0, the lowest, to
+ * SCHED_TASK_PRIORITY_LEVELS - 1, the highest, with the sched_task_priority()
+ * function.  When several tasks have expired, the handler of the highest
+ * priority expired task is called first.  Handlers run to completion so a
+ * higher priority task which expires while a handler is executing waits for
+ * the handler to return.  A single priority level is used by default.
+ * 1 to 8 (levels)
+ */
+#ifndef SCHED_TASK_PRIORITY_LEVELS
+#define SCHED_TASK_PRIORITY_LEVELS (1)
+#endif
+
+/**
+ * @brief Definition for the size of the task post que.
+ *
+ * If SCHED_TASK_POST_SIZE is defined to be != 0, tasks can be started,
+ * stopped or updated from an interrupt context with the sched_task_post_*()
+ * functions without taking the scheduler lock.  Each post is stored in a
+ * single producer, single consumer ring of SCHED_TASK_POST_SIZE entries which
+ * the scheduler drains from the main context before it executes the task que.
+ * Posts must only be made from a single context at a time, for example from
+ * interrupts of the same priority, since the producer side of the ring isn't
+ * locked.  The post que is disabled by default.
+ * 0 or a power of 2 from 2 to 32768 (posts)
+ */
+#ifndef SCHED_TASK_POST_SIZE
+#define SCHED_TASK_POST_SIZE (0)
+#endif
+
+/**
+ * @brief Definition to enable or disable event triggered tasks.
+ *
+ * If SCHED_EVENT_EN is defined to be != 0, a task can be bound to an event
+ * with the sched_task_event() function.  A started task which is bound to an
+ * event waits outside of the task que, costing no wake ups and no que search
+ * time, until the event is signaled with sched_event_signal(), typically from
+ * an interrupt.  The signal starts the first waiting task.  Signals made while
+ * no bound task is waiting are counted, up to the event's count limit, and
+ * start the next task to wait.  Events require an additional 2 pointers of
+ * RAM per task and are disabled by default.
+ */
+#ifndef SCHED_EVENT_EN
+#define SCHED_EVENT_EN (0)
+#endif
+
+/**
+ * @brief Definition to enable or disable message tasks.
+ *
+ * If SCHED_TASK_MSG_EN is defined to be != 0, tasks defined with the
+ * SCHED_TASK_MSG_DEF() macro store a fixed depth FIFO of messages.  Messages
+ * are added with sched_task_msg_post(), which starts the task if it is
+ * stopped, and the task's handler reads every pending message with
+ * sched_task_msg_read() so a burst of messages costs a single handler call.
+ * Message tasks require an additional pointer of RAM per task and are
+ * disabled by default.
+ */
+#ifndef SCHED_TASK_MSG_EN
+#define SCHED_TASK_MSG_EN (0)
+#endif
+
+/**
+ * @brief Definition for the number of scheduler instances.
+ *
+ * Each scheduler instance has its own task que and is run by its own call to
+ * sched_instance_start(), typically from a thread or processor core of its
+ * own.  The single instance API functions operate on the default instance,
+ * instance 0.  An idle instance can steal expired tasks from the que of an
+ * instance which is busy executing task handlers unless the task's affinity
+ * pins it to its instance.  Every instance shares the port lock and each
+ * instance stores its own que data.
+ * 1 to 8 (instances)
+ */
+#ifndef SCHED_INSTANCE_CNT
+#define SCHED_INSTANCE_CNT (1)
+#endif
+
+/**
+ * @brief Definition for the maximum time an idle instance sleeps between
+ * checks for tasks to steal from busy instances.
+ *
+ * A busy instance can't wake the other instances so an idle instance limits
+ * its sleep interval when more than one instance is configured.  Only used if
+ * SCHED_INSTANCE_CNT is > 1.
+ * 1 to INT32_MAX (ticks)
+ */
+#ifndef SCHED_INSTANCE_STEAL_MS
+#define SCHED_INSTANCE_STEAL_MS (10)
+#endif
+
+/**
+ * @brief Definition to enable or disable runtime statistics.
+ *
+ * If SCHED_STATS_EN is defined to be != 0, the scheduler tracks each task's
+ * handler call count, lateness, handler execution time and overrun count
+ * along with each instance's wake up count and sleep and awake times.  The
+ * statistics are read with the sched_task_stats() and sched_stats()
+ * functions.  Times are measured with sched_port_ticks() so their resolution
+ * is a single tick.  Runtime statistics require an additional 40 bytes of RAM
+ * per task on a typical 32-bit system and are disabled by default.
+ */
+#ifndef SCHED_STATS_EN
+#define SCHED_STATS_EN (0)
+#endif
+
+/**
+ * @brief Definition to enable or disable task execution budgets.
+ *
+ * If SCHED_TASK_BUDGET_EN is defined to be != 0, each task can be given an
+ * execution budget with the sched_task_budget() function.  The scheduler
+ * measures each handler call with sched_port_ticks() and a handler which runs
+ * longer than its task's budget is counted as a budget overrun and reported
+ * to the SCHED_HOOK_BUDGET_OVERRUN() hook.  An instance loop pass with a
+ * budget overrun doesn't call the SCHED_HOOK_WATCHDOG_KICK() hook.  Budgets
+ * require an additional 8 bytes of RAM per task on a typical 32-bit system
+ * and are disabled by default.
+ */
+#ifndef SCHED_TASK_BUDGET_EN
+#define SCHED_TASK_BUDGET_EN (0)
+#endif
+
+/**
+ * @brief Definition to enable or disable task power modes.
+ *
+ * If SCHED_TASK_POWER_EN is defined to be != 0, each task can be given the
+ * run mode its handler requires and the deepest sleep mode allowed while it
+ * is started with the sched_task_power() function.  The modes are numbered by
+ * the port, higher run modes are faster and higher sleep modes are deeper.
+ * The scheduler switches the run mode with sched_port_run_mode() before the
+ * handlers which need a different mode, returns to run mode 0 before
+ * sleeping and limits each sleep with sched_port_sleep_mode().  Power modes
+ * require an additional 2 bytes of RAM per task and are disabled by default.
+ */
+#ifndef SCHED_TASK_POWER_EN
+#define SCHED_TASK_POWER_EN (0)
+#endif
+
+/**
+ * @brief Definition for the number of sleep modes limited by task power modes.
+ *
+ * Each scheduler instance counts its started tasks by sleep mode so it finds
+ * the deepest allowed sleep mode without walking its task list.  Tasks can be
+ * given sleep modes from 0 to SCHED_SLEEP_MODE_CNT - 1 or SCHED_SLEEP_MODE_ANY
+ * with the sched_task_power() function.  Each sleep mode requires 4 bytes of
+ * RAM per instance. 1 to UINT8_MAX (sleep modes)
+ */
+#ifndef SCHED_SLEEP_MODE_CNT
+#define SCHED_SLEEP_MODE_CNT (4)
+#endif
+
+/**
+ * @brief Definition for the size of the event trace ring.
+ *
+ * If SCHED_TRACE_SIZE is defined to be != 0, the scheduler records task
+ * start, stop, expiration, handler enter and exit events along with sleep and
+ * wake events in a ring of SCHED_TRACE_SIZE entries.  Each event is
+ * timestamped with sched_port_ticks().  Events are written inside the
+ * scheduler's existing critical sections, sleeps are recorded without the
+ * lock and written in the loop's next critical section.  The oldest events
+ * are overwritten once the ring is full so recording an event never waits.
+ * The events are read with the sched_trace_read() function.  Each entry
+ * requires 12 bytes of RAM and, unless SCHED_TASK_COMPACT_EN is enabled, each
+ * task requires 2 bytes for its trace id.  The trace is disabled by default.
+ * 0 or a power of 2 from 2 to 32768 (events)
+ */
+#ifndef SCHED_TRACE_SIZE
+#define SCHED_TRACE_SIZE (0)
+#endif
+
+/**
+ * @brief Definition for the size of the handler storage of the C++ wrapper's
+ * tasks.
+ *
+ * The scheduler.hpp C++ wrapper stores each task's handler, a function
+ * pointer, a lambda or a bound member function, inside of the task's data
+ * buffer next to its payload rather than allocating it from the heap.  A
+ * handler larger than SCHED_CPP_HANDLER_SIZE fails to compile.  The default
+ * fits a lambda with up to 3 pointer captures or a bound member function.
+ * The define is only used by C++ code. (bytes)
+ */
+#ifndef SCHED_CPP_HANDLER_SIZE
+#define SCHED_CPP_HANDLER_SIZE (3 * sizeof(void *))
+#endif
+
+/**
+ * @brief Instrumentation hook called before a task's handler is called.
+ *
+ * The hook is called from the scheduler's context without the scheduler lock
+ * held, for example to toggle a GPIO or to record a trace event.  The hook
+ * does nothing by default.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+#ifndef SCHED_HOOK_HANDLER_ENTER
+#define SCHED_HOOK_HANDLER_ENTER(p_task)
+#endif
+
+/**
+ * @brief Instrumentation hook called after a task's handler returns.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+#ifndef SCHED_HOOK_HANDLER_EXIT
+#define SCHED_HOOK_HANDLER_EXIT(p_task)
+#endif
+
+/**
+ * @brief Instrumentation hook called before the scheduler sleeps.
+ *
+ * @param[in] deadline_ms  The time the scheduler will wake at the latest.
+ */
+#ifndef SCHED_HOOK_SLEEP_ENTER
+#define SCHED_HOOK_SLEEP_ENTER(deadline_ms)
+#endif
+
+/**
+ * @brief Instrumentation hook called after the scheduler wakes.
+ */
+#ifndef SCHED_HOOK_SLEEP_EXIT
+#define SCHED_HOOK_SLEEP_EXIT()
+#endif
+
+/**
+ * @brief Hook called after a task's handler runs longer than its budget.
+ *
+ * The hook is called from the scheduler's context without the scheduler lock
+ * held, once the handler has returned.  Task execution budgets must be
+ * enabled with SCHED_TASK_BUDGET_EN.  The hook does nothing by default.
+ *
+ * @param[in] p_task   Pointer to the task.
+ * @param[in] exec_ms  The handler's execution time. (ticks)
+ */
+#ifndef SCHED_HOOK_BUDGET_OVERRUN
+#define SCHED_HOOK_BUDGET_OVERRUN(p_task, exec_ms)
+#endif
+
+/**
+ * @brief Hook for refreshing a hardware watchdog from the scheduler loop.
+ *
+ * The hook is called by each running scheduler instance after it executes
+ * its expired tasks, before it sleeps, so a handler which never returns stops
+ * the refreshes.  With SCHED_TASK_BUDGET_EN enabled, the hook isn't called
+ * after a pass in which a handler overran its budget.  The watchdog period
+ * must be longer than the scheduler's longest sleep, which a repeating task
+ * can bound, unless the watchdog is paused while sleeping.  The hook does
+ * nothing by default.
+ */
+#ifndef SCHED_HOOK_WATCHDOG_KICK
+#define SCHED_HOOK_WATCHDOG_KICK()
+#endif
+
+/**
+ * @brief Definition for the repeat mode of newly configured tasks.
+ *
+ * Repeating tasks are re-armed according to their sched_repeat_mode_t repeat
+ * mode which can be changed with the sched_task_repeat_mode() function.  The
+ * default is SCHED_REPEAT_FIXED_DELAY, or SCHED_REPEAT_FIXED_RATE_SKIP if
+ * batch task dispatch is enabled.
+ */
+#ifndef SCHED_REPEAT_MODE_DEFAULT
+#if (SCHED_TASK_BATCH_EN != 0)
+#define SCHED_REPEAT_MODE_DEFAULT SCHED_REPEAT_FIXED_RATE_SKIP
+#else
+#define SCHED_REPEAT_MODE_DEFAULT SCHED_REPEAT_FIXED_DELAY
+#endif
+#endif
+
+/// @brief Linked list que engine, every active task is checked at each search.
+#define SCHED_QUE_LIST (0)
+
+/// @brief Binary min-heap que engine, ordered by the time until expiration.
+#define SCHED_QUE_HEAP (1)
+
+/// @brief Hierarchical timing wheel que engine, tasks are hashed by expiration.
+#define SCHED_QUE_WHEEL (2)
+
+/**
+ * @brief Definition for selecting the task que engine.
+ *
+ * The que engine determines how the scheduler finds the next expiring task.
+ *
+ * SCHED_QUE_LIST: The default engine walks the entire linked list of tasks
+ * during each task search.  It has the smallest ROM & RAM footprint and is
+ * the most efficient choice for applications with a small number of tasks.
+ *
+ * SCHED_QUE_HEAP: Active tasks are additionally stored in a binary min-heap
+ * ordered by their time until expiration.  The next expiring task is always
+ * available at the top of the heap so no search is required.  Starting,
+ * stopping or updating a task costs O(log N) which makes the heap engine a
+ * better choice for applications with a large number of tasks.
+ *
+ * SCHED_QUE_WHEEL: Active tasks are additionally stored in a hierarchical
+ * timing wheel.  Each wheel level divides time into slots which are
+ * SCHED_QUE_WHEEL_BITS wider than the level below.  A task is stored in the
+ * lowest level slot that its expiration time doesn't share with the current
+ * time and moves down to lower levels as time passes.  Starting, stopping or
+ * updating a task costs O(1) and each task moves through at most one slot per
+ * level before it expires.  The wheel engine is the best choice for
+ * applications with a large number of tasks with long intervals.
+ */
+#ifndef SCHED_QUE_ENGINE
+#define SCHED_QUE_ENGINE SCHED_QUE_LIST
+#endif
+
+/**
+ * @brief Definition for the maximum number of active tasks supported by the
+ * SCHED_QUE_HEAP que engine.
+ *
+ * The heap is statically allocated and requires one pointer per entry. The
+ * size must be greater than or equal to the maximum number of tasks which
+ * can be active at the same time.  A task can not be started if the heap is
+ * full.  1 to (UINT16_MAX - 1) (tasks)
+ */
+#ifndef SCHED_QUE_HEAP_SIZE
+#define SCHED_QUE_HEAP_SIZE (64)
+#endif
+
+/**
+ * @brief Definition for the number of time bits represented by each level of
+ * the SCHED_QUE_WHEEL que engine.
+ *
+ * Each wheel level has 2^SCHED_QUE_WHEEL_BITS slots and enough levels are
+ * used to cover the entire 32 bit mS time range.  Wider levels require more
+ * RAM for the slot list pointers while narrower levels increase the number of
+ * times each task must be moved before it expires.  The default of 5 bits
+ * requires 7 levels with a total of 198 list pointers. 2 to 5 (bits)
+ */
+#ifndef SCHED_QUE_WHEEL_BITS
+#define SCHED_QUE_WHEEL_BITS (5)
+#endif
+
+#if (SCHED_QUE_ENGINE != SCHED_QUE_LIST) && (SCHED_QUE_ENGINE != SCHED_QUE_HEAP) && \
+    (SCHED_QUE_ENGINE != SCHED_QUE_WHEEL)
+#error "Unrecognized SCHED_QUE_ENGINE"
+#endif
+
+#if (SCHED_MS_MAX > SCHED_TIME_MAX) || ((SCHED_TIME_64_EN != 0) && (SCHED_MS_MAX > (SCHED_TIME_MAX / 2)))
+#error "SCHED_MS_MAX is out of range"
+#endif
+
+#if (SCHED_TICK_HZ < 1) || (SCHED_TICK_HZ > 1000000)
+#error "SCHED_TICK_HZ is out of range"
+#endif
+
+#if (SCHED_QUE_HEAP_SIZE < 1) || (SCHED_QUE_HEAP_SIZE >= UINT16_MAX)
+#error "SCHED_QUE_HEAP_SIZE is out of range"
+#endif
+
+#if (SCHED_TASK_ARENA_BLOCK_SIZE < 1) || (SCHED_TASK_ARENA_BLOCK_SIZE > UINT8_MAX)
+#error "SCHED_TASK_ARENA_BLOCK_SIZE is out of range"
+#endif
+
+#if (SCHED_TASK_POOL_MAX < 1) || (SCHED_TASK_POOL_MAX > 15)
+#error "SCHED_TASK_POOL_MAX is out of range"
+#endif
+
+#if (SCHED_SLEEP_MODE_CNT < 1) || (SCHED_SLEEP_MODE_CNT > UINT8_MAX)
+#error "SCHED_SLEEP_MODE_CNT is out of range"
+#endif
+
+#if (SCHED_TASK_COMPACT_EN != 0) && !defined(__GNUC__)
+#error "SCHED_TASK_COMPACT_EN requires a GNU compatible toolchain"
+#endif
+
+#if (SCHED_TASK_CACHE_SIZE < 1) || (SCHED_TASK_CACHE_SIZE > UINT8_MAX)
+#error "SCHED_TASK_CACHE_SIZE is out of range"
+#endif
+
+#if (SCHED_TASK_POST_SIZE != 0) &&                                     \
+    ((SCHED_TASK_POST_SIZE < 2) || (SCHED_TASK_POST_SIZE > 32768) ||    \
+     ((SCHED_TASK_POST_SIZE & (SCHED_TASK_POST_SIZE - 1)) != 0))
+#error "SCHED_TASK_POST_SIZE must be 0 or a power of 2 from 2 to 32768"
+#endif
+
+#if (SCHED_TRACE_SIZE != 0) &&                                    \
+    ((SCHED_TRACE_SIZE < 2) || (SCHED_TRACE_SIZE > 32768) ||        \
+     ((SCHED_TRACE_SIZE & (SCHED_TRACE_SIZE - 1)) != 0))
+#error "SCHED_TRACE_SIZE must be 0 or a power of 2 from 2 to 32768"
+#endif
+
+#if (SCHED_TASK_PRIORITY_LEVELS < 1) || (SCHED_TASK_PRIORITY_LEVELS > 8)
+#error "SCHED_TASK_PRIORITY_LEVELS is out of range"
+#endif
+
+#if (SCHED_INSTANCE_CNT < 1) || (SCHED_INSTANCE_CNT > 8)
+#error "SCHED_INSTANCE_CNT is out of range"
+#endif
+
+#if (SCHED_INSTANCE_STEAL_MS < 1) || (SCHED_INSTANCE_STEAL_MS > INT32_MAX)
+#error "SCHED_INSTANCE_STEAL_MS is out of range"
+#endif
+
+#if (SCHED_QUE_WHEEL_BITS < 2) || (SCHED_QUE_WHEEL_BITS > 5)
+#error "SCHED_QUE_WHEEL_BITS is out of range"
+#endif
+
+#endif // SCHED_CONFIG_H__
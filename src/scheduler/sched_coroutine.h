@@ -0,0 +1,213 @@
+/**
+ * @file sched_coroutine.h
+ * @author Ben Wirz
+ * @brief Stackless coroutine task macros for the scheduler module.
+ *
+ * A coroutine task is a normal scheduler task whose handler is written as a
+ * sequence of steps separated by yield points.  At a yield point the handler
+ * saves its resume point, schedules its next call and returns so the other
+ * tasks can run.  The next call jumps straight to the resume point instead
+ * of running the handler from the top, so a long flash erase or a multi-step
+ * radio join can be written as straight line code without blocking the
+ * scheduler or re-running its setup code.
+ *
+ * The coroutines are protothread style, the resume point is a line number
+ * stored in a sched_coro_t and the handler is a switch statement on it.  The
+ * handler's local variables are not preserved across a yield point, state
+ * which must survive a yield should be static or stored in the task's data.
+ * A switch statement can't contain a yield point and only one yield point
+ * can be placed on a line.
+ *
+ * Coroutine tasks should be configured as non-repeating, the yield macros
+ * restart the task with the interval of the next step.  Once the coroutine
+ * ends the task stops and starting it again runs the coroutine from the
+ * beginning.
+ *
+ * @code
+ * static sched_coro_t join_coro;
+ *
+ * static void join_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+ * {
+ *   SCHED_CORO_BEGIN(&join_coro, p_task);
+ *
+ *   radio_join_request();
+ *   SCHED_CORO_YIELD_UNTIL(radio_join_accepted(), 10);
+ *   radio_key_request();
+ *   SCHED_CORO_YIELD_MS(100);
+ *
+ *   SCHED_CORO_END();
+ * }
+ * @endcode
+ */
+
+#ifndef SCHED_COROUTINE_H__
+#define SCHED_COROUTINE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "scheduler.h"
+#include "sched_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Coroutine state structure.
+ *
+ * Zero initialized coroutines start at the beginning.
+ */
+typedef struct
+{
+  /// @brief The line of the yield point to resume at, 0 at the beginning.
+  uint16_t resume;
+} sched_coro_t;
+
+/**
+ * @brief Macro for starting a coroutine's body, placed at the top of the task
+ * handler.
+ *
+ * @param[in] P_CORO  Pointer to the coroutine's state.
+ * @param[in] P_TASK  Pointer to the coroutine's task, the handler's task.
+ */
+#define SCHED_CORO_BEGIN(P_CORO, P_TASK)        \
+  {                                             \
+    sched_coro_t *p_coro_self__ = (P_CORO);     \
+    sched_task_t *p_coro_task__ = (P_TASK);     \
+    (void)p_coro_task__;                        \
+    switch (p_coro_self__->resume)              \
+    {                                           \
+      case 0:
+
+/**
+ * @brief Macro for ending a coroutine's body, placed at the bottom of the
+ * task handler.
+ *
+ * The coroutine is reset to the beginning and the task stops once the
+ * handler returns.
+ */
+#define SCHED_CORO_END()                        \
+    }                                           \
+    p_coro_self__->resume = 0;                  \
+  }
+
+/**
+ * @brief Macro for yielding the CPU to the other tasks for an interval.
+ *
+ * The task is restarted with the interval and the coroutine resumes after the
+ * yield point once the task expires.
+ *
+ * @param[in] MS  The interval before the coroutine resumes. (mS)
+ */
+#define SCHED_CORO_YIELD_MS(MS)                 \
+  do                                            \
+  {                                             \
+    p_coro_self__->resume = __LINE__;           \
+    sched_task_update(p_coro_task__, (MS));     \
+    return;                                     \
+    case __LINE__:;                             \
+  } while (0)
+
+/**
+ * @brief Macro for yielding the CPU to the other tasks, the coroutine resumes
+ * once the scheduler has checked the other tasks.
+ */
+#define SCHED_CORO_YIELD() SCHED_CORO_YIELD_MS(0)
+
+/**
+ * @brief Macro for yielding the CPU until a condition is true.
+ *
+ * The condition is checked at the yield point and then polled each time the
+ * task expires, the coroutine continues without yielding if the condition is
+ * already true.
+ *
+ * @param[in] COND     The condition to wait for.
+ * @param[in] POLL_MS  The interval between the condition checks. (mS)
+ */
+#define SCHED_CORO_YIELD_UNTIL(COND, POLL_MS)   \
+  do                                            \
+  {                                             \
+    p_coro_self__->resume = __LINE__;           \
+    case __LINE__:                              \
+    if (!(COND))                                \
+    {                                           \
+      sched_task_update(p_coro_task__, (POLL_MS)); \
+      return;                                   \
+    }                                           \
+  } while (0)
+
+#if (SCHED_EVENT_EN != 0)
+
+/**
+ * @brief Macro for yielding the CPU until an event is signaled.
+ *
+ * The task is bound to the event and waits for it, without being polled,
+ * once the handler returns.  A pending signal resumes the coroutine as soon
+ * as the scheduler wakes.  The task is unbound from the event when the
+ * coroutine resumes.
+ *
+ * @note Events must be enabled with the SCHED_EVENT_EN build configuration
+ * define.
+ *
+ * @param[in] P_EVENT  Pointer to the event.
+ */
+#define SCHED_CORO_WAIT_EVENT(P_EVENT)          \
+  do                                            \
+  {                                             \
+    p_coro_self__->resume = __LINE__;           \
+    sched_task_update(p_coro_task__, 0);        \
+    sched_task_event(p_coro_task__, (P_EVENT)); \
+    return;                                     \
+    case __LINE__:                              \
+    sched_task_event(p_coro_task__, NULL);      \
+  } while (0)
+
+#endif // (SCHED_EVENT_EN != 0)
+
+/**
+ * @brief Macro for ending a coroutine early.
+ *
+ * The coroutine is reset to the beginning and the task stops once the
+ * handler returns unless the handler restarted it.
+ */
+#define SCHED_CORO_EXIT()                       \
+  do                                            \
+  {                                             \
+    p_coro_self__->resume = 0;                  \
+    return;                                     \
+  } while (0)
+
+/**
+ * @brief Function for resetting a coroutine to the beginning.
+ *
+ * A task which was stopped part way through its coroutine resumes at its last
+ * yield point when it is started again unless its coroutine is reset.
+ *
+ * @param[in] p_coro  Pointer to the coroutine's state.
+ */
+static inline void sched_coro_reset(sched_coro_t *p_coro)
+{
+  if (p_coro != NULL)
+  {
+    p_coro->resume = 0;
+  }
+}
+
+/**
+ * @brief Function for determining if a coroutine is part way through its body.
+ *
+ * @param[in] p_coro  Pointer to the coroutine's state.
+ *
+ * @return True if the coroutine resumes at a yield point when its task is
+ *         called next else False.
+ */
+static inline bool sched_coro_running(const sched_coro_t *p_coro)
+{
+  return (p_coro != NULL) && (p_coro->resume != 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_COROUTINE_H__
@@ -22,6 +22,12 @@
 extern "C" {
 #endif
 
+// Macro for converting a time in mS to scheduler ticks.
+#define SCHED_MS_TO_TICKS(ms) ((sched_time_t)(((uint64_t)(ms) * SCHED_TICK_HZ) / 1000))
+
+// Macro for converting a time in scheduler ticks to mS.
+#define SCHED_TICKS_TO_MS(ticks) ((sched_time_t)(((uint64_t)(ticks) * 1000) / SCHED_TICK_HZ))
+
 // The number of mS in one second.
 #define SCHED_MS_SECOND ((uint32_t)(1000))
 
@@ -36,7 +42,9 @@ extern "C" {
 
 /**
  * @brief Function for converting an interval with days, hours, minutes, 
- * seconds and mS units into a interval with units of miliseconds.
+ * seconds and mS units into a interval with units of scheduler ticks.
+ *
+ * The ticks are equal to mS with the default SCHED_TICK_HZ.
  *
  * @param[in] days    The number of days.
  * @param[in] hours   The number of hours.
@@ -44,17 +52,17 @@ extern "C" {
  * @param[in] secs    The number of seconds.
  * @param[in] ms      The number of miliseconds.
  *
- * @return The interval in mS corresponding to the values.
+ * @return The interval in ticks corresponding to the values.
  */
-static inline uint32_t sched_ms(uint8_t days,
+static inline sched_time_t sched_ms(uint8_t days,
                                 uint8_t hours,
                                 uint8_t mins,
                                 uint8_t secs,
                                 uint8_t ms)
 {
-  return ((days * SCHED_MS_DAY) + (hours * SCHED_MS_HOUR) +
-          (mins * SCHED_MS_MINUTE) + (secs * SCHED_MS_SECOND) + ms) &
-         UINT32_MAX;
+  uint64_t interval_ms = ((uint64_t)days * SCHED_MS_DAY) + (hours * SCHED_MS_HOUR) +
+                         (mins * SCHED_MS_MINUTE) + (secs * SCHED_MS_SECOND) + ms;
+  return SCHED_MS_TO_TICKS(interval_ms);
 }
 
 /**
@@ -74,7 +82,11 @@ static inline bool sched_task_buffered(const sched_task_t *p_task)
   else
   {
     // Buffered tasks have non-zero buffer sizes.
+#if (SCHED_TASK_COMPACT_EN != 0)
+    return (p_task->p_buff != NULL) && (p_task->p_buff->buff_size > 0);
+#else
     return (p_task->buff_size > 0);
+#endif
   }
 }
 
@@ -119,11 +131,11 @@ bool sched_task_expired(const sched_task_t *p_task);
  *
  * @param[in] p_task  Pointer to the task.
  *
- * @retval The time in mS until the task expires.
+ * @retval The time in ticks until the task expires.
  * @retval 0 if the task has already expired.
  * @retval SCHED_MS_MAX if the task pointer is NULL or the task is inactive.
  */
-uint32_t sched_task_remaining_ms(const sched_task_t *p_task);
+sched_time_t sched_task_remaining_ms(const sched_task_t *p_task);
 
 /**
  * @brief Function for getting the time interval since the task was started.
@@ -134,10 +146,10 @@ uint32_t sched_task_remaining_ms(const sched_task_t *p_task);
  *
  * @param[in] p_task  Pointer to the task.
  *
- * @retval The time interval in mS since the task was started.
+ * @retval The time interval in ticks since the task was started.
  * @retval 0 if task pointer is NULL or the task is inactive.
  */
-uint32_t sched_task_elapsed_ms(const sched_task_t *p_task);
+sched_time_t sched_task_elapsed_ms(const sched_task_t *p_task);
 
 /**
  * @brief Function for comparing the expiration time of two tasks and returning
@@ -172,6 +184,16 @@ uint8_t sched_pool_allocated(const sched_task_pool_t *p_pool);
  */
 uint8_t sched_pool_free(const sched_task_pool_t *p_pool);
 
+/**
+ * @brief Function for determining the free space in a task pool's data arena.
+ *
+ * @param[in] p_pool  Pointer to pool configuration structure.
+ *
+ * @return The number of free bytes in the pool's data arena, which may not be
+ *         consecutive.  0 for pools without a data arena.
+ */
+uint32_t sched_pool_arena_free(const sched_task_pool_t *p_pool);
+
 /**
  * @brief Function for getting a scheduler task's state.
  *
@@ -188,10 +210,29 @@ static inline sched_task_state_t sched_task_state(const sched_task_t *p_task)
   }
   else
   {
-    return p_task->state;
+    return (sched_task_state_t)p_task->state;
   }
 }
 
+/**
+ * @brief Function for getting the scheduler instance whose que stores a task.
+ *
+ * @param[in] p_task  Pointer to the task.
+ *
+ * @retval  The task's scheduler instance.
+ * @retval  SCHED_INSTANCE_DEFAULT if the task pointer is NULL.
+ */
+static inline sched_instance_t sched_task_instance(const sched_task_t *p_task)
+{
+#if (SCHED_INSTANCE_CNT > 1)
+  if (p_task != NULL)
+  {
+    return p_task->instance;
+  }
+#endif
+  return SCHED_INSTANCE_DEFAULT;
+}
+
 #ifdef __cplusplus
 }
 #endif
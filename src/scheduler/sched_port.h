@@ -11,6 +11,7 @@
 #define SCHED_PORT_H__
 
 #include <stdint.h>
+#include "sched_types.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,10 +36,12 @@ void sched_port_lock(void);
 void sched_port_free(void);
 
 /**
- * @brief Mandatory platform-specific function for getting the current
+ * @brief Platform-specific function for getting the current
  * value of the mS timer to be utilized by the scheduler for task
  * timing.
  *
+ * The function is mandatory with the default SCHED_TICK_HZ and 32 bit time,
+ * otherwise the scheduler doesn't use it.
  * The timer counter must be monatomic, it should increment once for each mS of
  * real time after initialization with no discontinuities or jumps.  It is
  * expected to rollover to 0 after UINT32_MAX.
@@ -47,22 +50,181 @@ void sched_port_free(void);
  */
 uint32_t sched_port_ms(void);
 
+/**
+ * @brief Platform-specific function for getting the current value of the
+ * tick timer to be utilized by the scheduler for task timing.
+ *
+ * The timer counter must be monatomic, it should increment SCHED_TICK_HZ
+ * times per second of real time with no discontinuities or jumps.  It is
+ * expected to rollover to 0 after SCHED_TIME_MAX.
+ *
+ * With the default SCHED_TICK_HZ of 1000 and 32 bit time, the scheduler
+ * supplies a default implementation which returns sched_port_ms().  The
+ * function is mandatory for any other tick frequency or if SCHED_TIME_64_EN
+ * is enabled, in which case it must return a 64 bit tick count.
+ *
+ * @return The current timer value (ticks).
+ */
+sched_time_t sched_port_ticks(void);
+
+/**
+ * @brief The maximum time that the scheduler sleeps for at once. (ticks)
+ *
+ * Limiting the sleep time to half of the tick timer's range allows a sleep
+ * deadline to be compared with the current time across a timer rollover.
+ */
+#define SCHED_PORT_SLEEP_MS_MAX (INT32_MAX)
+
+/**
+ * @brief The reasons for returning from the sched_port_sleep_until()
+ * function.
+ */
+typedef enum
+{
+  /// @brief The sleep deadline was reached.
+  SCHED_PORT_WAKE_DEADLINE = 0x0,
+  /// @brief The processor woke before the sleep deadline was reached.
+  SCHED_PORT_WAKE_EARLY = 0x1
+} sched_port_wake_t;
+
 /**
  * @brief Optional platform-specific sleep function.
  *
  * If no user implementation is supplied, the scheduler will
  * simply busy wait between tasks.
  *
- * @param[in] interval_ms  The requested sleep interval (mS)
- *                         0 to SCHED_MS_MAX (mS)
+ * @param[in] interval_ms  The requested sleep interval (ticks)
+ *                         0 to SCHED_PORT_SLEEP_MS_MAX (ticks)
  */
 void sched_port_sleep(uint32_t interval_ms);
 
+/**
+ * @brief Optional platform-specific function for sleeping until the tick
+ * timer reaches a deadline.
+ *
+ * The function should return once the deadline is reached or if the
+ * processor is woken early, for example by an interrupt.  After an early
+ * wake up, the scheduler only searches its task que again if a task was
+ * started or stopped while it was sleeping, otherwise it immediately calls
+ * the function again with the same deadline.  Platforms with a wake up timer
+ * can program the timer directly with the deadline so the tick timer's
+ * interrupt doesn't need to run while the processor is idle.
+ *
+ * If no user implementation is supplied, the scheduler calls
+ * sched_port_sleep() with the time remaining until the deadline and checks
+ * the tick timer once it returns.
+ *
+ * @param[in] deadline_ms  The sched_port_ticks() timer value to sleep until,
+ *                         at most SCHED_PORT_SLEEP_MS_MAX after the current
+ *                         time. (ticks)
+ *
+ * @retval SCHED_PORT_WAKE_DEADLINE if the deadline was reached.
+ * @retval SCHED_PORT_WAKE_EARLY if the processor woke before the deadline.
+ */
+sched_port_wake_t sched_port_sleep_until(sched_time_t deadline_ms);
+
+/**
+ * @brief Optional platform-specific function for ending the scheduler's
+ * sleep early.
+ *
+ * The scheduler calls the function whenever a task is started, stopped or
+ * posted, or a scheduler instance is stopped, since the change might need to
+ * be serviced before the sleep deadline.  The function may be called from
+ * any context, including the scheduler's own, with or without the scheduler
+ * lock held, so it must be short and must not take the lock.
+ *
+ * Platforms whose sleep is ended by the interrupts which change the tasks
+ * don't need the function.  Hosted platforms, where tasks can be started by
+ * other threads, implement it to make a sleep in progress, or the next sleep
+ * if the scheduler isn't sleeping yet, return SCHED_PORT_WAKE_EARLY.
+ *
+ * If no user implementation is supplied, the function does nothing.
+ */
+void sched_port_wake(void);
+
+/**
+ * @brief Optional platform-specific function for switching the processor's
+ * run mode, for example its system clock.
+ *
+ * Only called with SCHED_TASK_POWER_EN enabled.  The scheduler calls the
+ * function without its lock held before a task handler which requires a
+ * different run mode than the current one and with run mode 0 before
+ * sleeping.  The run modes are defined by the platform, mode 0 is the lowest
+ * power mode.  If no user implementation is supplied, the run mode isn't
+ * changed.
+ *
+ * @param[in] run_mode  The run mode to switch to.
+ */
+void sched_port_run_mode(uint8_t run_mode);
+
+/**
+ * @brief Optional platform-specific function for limiting the depth of the
+ * scheduler's next sleep.
+ *
+ * Only called with SCHED_TASK_POWER_EN enabled.  The scheduler calls the
+ * function before each sleep with the deepest sleep mode allowed by all of
+ * its started tasks.  The platform should pick the deepest mode, no deeper
+ * than the limit, which is worthwhile for the time remaining until the sleep
+ * deadline.  If the platform supplies a sleep state table with
+ * sched_port_sleep_states(), the scheduler has already made the choice and
+ * the mode is the selected state's.  The sleep modes are defined by the
+ * platform, mode 0 doesn't sleep.  If no user implementation is supplied,
+ * the limit is ignored.
+ *
+ * @param[in] sleep_mode  The deepest allowed sleep mode.
+ */
+void sched_port_sleep_mode(uint8_t sleep_mode);
+
+/**
+ * @brief A platform sleep state's latencies, used by the scheduler to select
+ * the sleep state for each idle period.
+ *
+ * The latencies and break-even time should be measured on the target
+ * hardware, rounded up to whole ticks.
+ */
+typedef struct
+{
+  /// @brief The sleep mode passed to sched_port_sleep_mode() for the state.
+  uint8_t sleep_mode;
+
+  /// @brief The time from the start of the sleep until the state is entered. (ticks)
+  sched_time_t entry_ticks;
+
+  /// @brief The time from the wake up until the processor runs again. (ticks)
+  sched_time_t exit_ticks;
+
+  /**
+   * @brief The shortest idle period for which the state uses less energy,
+   * including its entry and exit, than the next shallower state. (ticks)
+   */
+  sched_time_t break_even_ticks;
+} sched_port_sleep_state_t;
+
+/**
+ * @brief Optional platform-specific function for getting the platform's sleep
+ * state table.
+ *
+ * Only called with SCHED_TASK_POWER_EN enabled.  Before each sleep, the
+ * scheduler selects the deepest state allowed by its started tasks whose
+ * break-even time and latencies fit in the time remaining until the next task
+ * expires.  The selected state's mode is passed to sched_port_sleep_mode() and
+ * the sleep deadline is moved earlier by the state's exit latency so the next
+ * task runs on time.  If no user implementation is supplied, there is no
+ * table and the allowed sleep mode is passed to sched_port_sleep_mode()
+ * instead.
+ *
+ * @param[out] pp_states  Set to the table, sorted from the shallowest to the
+ *                        deepest state.
+ *
+ * @return The number of states in the table, 0 for no table.
+ */
+uint8_t sched_port_sleep_states(const sched_port_sleep_state_t **pp_states);
+
 /**
  * @brief Optional platform-specific specific function for performing any
  * initialization required for scheduler operation.
  *
- * The mS timer should be set up and enabled here if not previously
+ * The mS or tick timer should be set up and enabled here if not previously
  * enabled.
  */
 void sched_port_init(void);
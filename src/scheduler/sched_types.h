@@ -11,11 +11,24 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include "sched_config.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief A type representing a scheduler time in ticks.
+ *
+ * The time type is 32 bits wide by default or 64 bits wide if
+ * SCHED_TIME_64_EN is enabled.
+ */
+#if (SCHED_TIME_64_EN != 0)
+typedef uint64_t sched_time_t;
+#else
+typedef uint32_t sched_time_t;
+#endif
+
 /**
  * @brief A type representing a scheduler task state.
  *
@@ -32,6 +45,15 @@ typedef enum
   SCHED_TASK_ACTIVE = 0x2,
   /// @brief The task's handler is executing.
   SCHED_TASK_EXECUTING = 0x3,
+  /**
+   * @brief The task is waiting for its event to be signaled.
+   *
+   * A started task which is bound to an event enters the SCHED_TASK_WAITING
+   * state if the event has no pending signals.  Waiting tasks aren't stored
+   * in the task que.  The task moves to the SCHED_TASK_ACTIVE state once the
+   * event is signaled.
+   */
+  SCHED_TASK_WAITING = 0x4,
   /**
    * @brief The task is in the proccess of stopping.
    *
@@ -42,6 +64,192 @@ typedef enum
   SCHED_TASK_STOPPING = 0x5
 } sched_task_state_t;
 
+/**
+ * @brief A type representing how a repeating task is re-armed after it
+ * expires.
+ *
+ * @note The enum values need to be explicitly set since they are stored as a
+ * 2 bit bit-field in the task structure.
+ */
+typedef enum
+{
+  /**
+   * @brief Fixed delay, the task is restarted when its handler is called.
+   *
+   * The interval is the minimum time between handler calls.  Any dispatch
+   * latency delays all of the following handler calls.
+   */
+  SCHED_REPEAT_FIXED_DELAY = 0x0,
+  /**
+   * @brief Fixed rate, the task is re-armed from its scheduled expiration.
+   *
+   * If the handler is delayed by more than the interval, the missed intervals
+   * are skipped and the next handler call remains aligned to the original
+   * schedule.
+   */
+  SCHED_REPEAT_FIXED_RATE_SKIP = 0x1,
+  /**
+   * @brief Fixed rate, the task is re-armed from its scheduled expiration.
+   *
+   * If the handler is delayed by more than the interval, the handler is
+   * called back to back once for each missed interval until the task catches
+   * up with its schedule.  The handler is always called once per interval on
+   * average.
+   */
+  SCHED_REPEAT_FIXED_RATE_CATCHUP = 0x2
+} sched_repeat_mode_t;
+
+/**
+ * @brief A type identifying a scheduler instance.
+ *
+ * Instances are numbered from 0 to SCHED_INSTANCE_CNT - 1.
+ */
+typedef uint8_t sched_instance_t;
+
+/// @brief The default scheduler instance used by the single instance API.
+#define SCHED_INSTANCE_DEFAULT (0)
+
+/// @brief The lowest run mode, the run mode of newly configured tasks.
+#define SCHED_RUN_MODE_LOW (0)
+
+/// @brief The deepest sleep mode, newly configured tasks allow any sleep mode.
+#define SCHED_SLEEP_MODE_ANY (UINT8_MAX)
+
+/**
+ * @brief A snapshot of a task's runtime statistics.
+ *
+ * The lateness is the time between a task's scheduled expiration and the
+ * call of its handler.  An overrun is counted when a repeating task's handler
+ * executes for its interval or longer since the task has expired again by the
+ * time the handler returns.
+ *
+ * @note Runtime statistics must be enabled with the SCHED_STATS_EN build
+ * configuration define.
+ */
+typedef struct
+{
+  /// @brief The number of handler calls.
+  uint32_t call_cnt;
+  /// @brief The number of handler overruns.
+  uint32_t overrun_cnt;
+  /// @brief The minimum lateness. (ticks)
+  sched_time_t late_min_ms;
+  /// @brief The maximum lateness. (ticks)
+  sched_time_t late_max_ms;
+  /// @brief The average lateness. (ticks)
+  sched_time_t late_avg_ms;
+  /// @brief The maximum handler execution time. (ticks)
+  sched_time_t exec_max_ms;
+  /// @brief The average handler execution time. (ticks)
+  sched_time_t exec_avg_ms;
+} sched_task_stats_t;
+
+/**
+ * @brief A snapshot of a scheduler instance's runtime statistics.
+ *
+ * @note Runtime statistics must be enabled with the SCHED_STATS_EN build
+ * configuration define.
+ */
+typedef struct
+{
+  /// @brief The number of times the instance woke from sleep.
+  uint32_t wake_cnt;
+  /// @brief The total time the instance has slept. (ticks)
+  uint64_t sleep_ms;
+  /// @brief The total time the instance has been awake while running. (ticks)
+  uint64_t awake_ms;
+} sched_stats_t;
+
+/**
+ * @brief The trace event types.
+ */
+typedef enum
+{
+  /// @brief A task was started or restarted.
+  SCHED_TRACE_TASK_START = 0x0,
+  /// @brief A task was stopped.
+  SCHED_TRACE_TASK_STOP = 0x1,
+  /**
+   * @brief A task expired.  The event is timestamped with the task's
+   * scheduled expiration and recorded when its handler is dispatched.
+   */
+  SCHED_TRACE_TASK_EXPIRE = 0x2,
+  /// @brief A task's handler was called.
+  SCHED_TRACE_HANDLER_ENTER = 0x3,
+  /// @brief A task's handler returned.
+  SCHED_TRACE_HANDLER_EXIT = 0x4,
+  /// @brief The scheduler instance went to sleep.
+  SCHED_TRACE_SLEEP_ENTER = 0x5,
+  /// @brief The scheduler instance woke from sleep.
+  SCHED_TRACE_WAKE = 0x6
+} sched_trace_event_t;
+
+/**
+ * @brief A trace event record.
+ *
+ * The record only has fixed width fields so that a dump of the records can
+ * be decoded on a different machine with the same byte order.
+ *
+ * @note The trace must be enabled with the SCHED_TRACE_SIZE build
+ * configuration define.
+ */
+typedef struct
+{
+  /// @brief The low 32 bits of the event time. (ticks)
+  uint32_t time_ms;
+  /// @brief The task's trace id, see sched_task_trace_id(), 0 for sleep and wake events.
+  uint32_t task_id;
+  /// @brief The event sequence number, gaps indicate overwritten events.
+  uint16_t seq;
+  /// @brief The event type. (sched_trace_event_t)
+  uint8_t event;
+  /// @brief The scheduler instance which recorded the event.
+  uint8_t instance;
+} sched_trace_t;
+
+/**
+ * @brief The runtime statistics stored in each task.
+ *
+ * The totals are stored rather than the averages so the statistics can be
+ * updated without a division in the handler call path.
+ */
+typedef struct
+{
+  /// @brief The number of handler calls.
+  uint32_t call_cnt;
+  /// @brief The number of handler overruns.
+  uint32_t overrun_cnt;
+  /// @brief The minimum lateness. (ticks)
+  sched_time_t late_min_ms;
+  /// @brief The maximum lateness. (ticks)
+  sched_time_t late_max_ms;
+  /// @brief The maximum handler execution time. (ticks)
+  sched_time_t exec_max_ms;
+  /// @brief The total lateness. (ticks)
+  uint64_t late_total_ms;
+  /// @brief The total handler execution time. (ticks)
+  uint64_t exec_total_ms;
+} sched_task_stats_data_t;
+
+#if (SCHED_TASK_COMPACT_EN != 0)
+/**
+ * @brief The data record of a buffered task with the compact task layout.
+ *
+ * The compact task layout keeps the data of buffered tasks in a record
+ * outside of the task so unbuffered tasks don't store a data pointer or data
+ * sizes.  The record is defined by the buffered task and task pool macros.
+ */
+typedef struct _sched_task_buff
+{
+  /// @brief Pointer to the task's data buffer.
+  uint8_t *p_data;
+  /// @brief Size of the data buffer. (bytes)
+  uint8_t buff_size;
+  /// @brief Size of the stored data. (bytes)
+  uint8_t data_size;
+} sched_task_buff_t;
+#endif
+
 /**
  * @brief A data structure for a single scheduler task.
  *
@@ -56,14 +264,16 @@ typedef enum
 typedef struct _sched_task
 {
 
-  /// @brief The task start time (mS).
-  uint32_t start_ms;
+  /// @brief The task start time (ticks).
+  sched_time_t start_ms;
 
-  /// @brief The task interval (mS).
-  uint32_t interval_ms;
+  /// @brief The task interval (ticks).
+  sched_time_t interval_ms;
 
+#if (SCHED_TASK_COMPACT_EN == 0)
   /// @brief The next task in the linked list.
   struct _sched_task *p_next;
+#endif
 
   /**
    * @brief Pointer to the task's handler function.
@@ -71,6 +281,18 @@ typedef struct _sched_task
    */
   void *p_handler;
 
+#if (SCHED_TASK_COMPACT_EN != 0)
+  /// @brief Pointer to a buffered task's data record, NULL for unbuffered tasks.
+  struct _sched_task_buff *p_buff;
+
+  /**
+   * @brief The handle of the next task in the linked list.
+   *
+   * The handle is the next task's offset from the start of the task section
+   * in 32 bit words plus one.  A handle of 0 indicates no next task.
+   */
+  uint16_t next_handle;
+#else
   /// @brief Pointer to the user data.
   uint8_t *p_data;
 
@@ -89,16 +311,129 @@ typedef struct _sched_task
    * stored in the task and will always be less than or equal to buff_size.
    */
   uint8_t data_size;
+#endif
 
   /// @brief Is the task repeating?
   bool repeat : 1;
 
+  /// @brief The repeating task's re-arm mode. (sched_repeat_mode_t)
+  uint8_t repeat_mode : 2;
+
   /// @brief Has the task been been allocated?  Only used for task pools.
   volatile bool allocated : 1;
 
   /// @brief The task's current state. (sched_task_state_t) 
   volatile uint8_t state : 4;
 
+  /// @brief Is the task linked into its instance's task list?
+  volatile bool listed : 1;
+
+#if (SCHED_TASK_POOL_EN != 0)
+  /**
+   * @brief The index of the pool the task was allocated from in the pool
+   * table plus one.
+   *
+   * Tasks which aren't part of a pool have a pool index of 0.
+   */
+  uint8_t pool_index : 4;
+#endif
+
+#if (SCHED_TASK_BATCH_EN != 0)
+  /// @brief Is the task waiting to be executed by the current batch?
+  volatile bool dispatch : 1;
+#endif
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+  /// @brief The task's priority level, 0 is the lowest.
+  uint8_t priority : 3;
+#endif
+
+#if (SCHED_INSTANCE_CNT > 1)
+  /// @brief The scheduler instance whose que stores the task. (sched_instance_t)
+  volatile uint8_t instance : 3;
+
+  /// @brief Is the task pinned to its instance?  Pinned tasks aren't stolen.
+  bool pinned : 1;
+#endif
+
+#if (SCHED_EVENT_EN != 0)
+  /// @brief The event the task is bound to, NULL for none.
+  struct _sched_event *p_event;
+
+  /// @brief The next task in the event's wait list.
+  struct _sched_task *p_wait_next;
+#endif
+
+#if (SCHED_TASK_MSG_EN != 0)
+  /// @brief The task's message FIFO, NULL for tasks without messages.
+  struct _sched_msg_fifo *p_msg;
+#endif
+
+#if (SCHED_TASK_SLACK_EN != 0)
+  /**
+   * @brief The time the task's handler call may be delayed after it expires
+   * so that it can share a wake up with other tasks. (ticks)
+   */
+  sched_time_t slack_ms;
+#endif
+
+#if (SCHED_STATS_EN != 0)
+  /// @brief The task's runtime statistics.
+  sched_task_stats_data_t stats;
+#endif
+
+#if (SCHED_TASK_BUDGET_EN != 0)
+  /// @brief The task's handler execution budget, 0 for none. (ticks)
+  sched_time_t budget_ms;
+
+  /// @brief The number of handler calls which ran longer than the budget.
+  uint32_t budget_overrun_cnt;
+#endif
+
+#if (SCHED_TASK_POWER_EN != 0)
+  /// @brief The run mode the task's handler requires, 0 is the lowest.
+  uint8_t run_mode;
+
+  /// @brief The deepest sleep mode allowed while the task is started.
+  uint8_t sleep_mode;
+#endif
+
+#if (SCHED_TRACE_SIZE != 0) && (SCHED_TASK_COMPACT_EN == 0)
+  /// @brief The id which identifies the task in trace events, given when first configured.
+  uint16_t trace_id;
+#endif
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+  /**
+   * @brief The task's position in the que heap plus one.
+   *
+   * A value of 0 indicates that the task is not currently stored in the heap
+   * which allows statically defined tasks to be zero initialized.
+   */
+  uint16_t heap_pos;
+#endif
+
+#if (SCHED_TASK_BATCH_EN != 0)
+  /// @brief The next task in the batch run list.
+  struct _sched_task *p_run_next;
+#endif
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+  /// @brief The next task in the task's timing wheel list.
+  struct _sched_task *p_wheel_next;
+
+  /**
+   * @brief The previous task in the task's timing wheel list.
+   *
+   * The first task in a list stores the last task in the list so tasks can
+   * be added to the end of the list.
+   */
+  struct _sched_task *p_wheel_prev;
+
+  /// @brief The index of the timing wheel list storing the task.
+  uint8_t wheel_list;
+#endif
+
 } sched_task_t;
 
 /**
@@ -112,25 +447,174 @@ typedef struct _sched_task
  */
 typedef void (*sched_handler_t)(sched_task_t *p_task, void *p_data, uint8_t data_size);
 
+/**
+ * @brief The configuration of a task in a static task table.
+ *
+ * Entries should be defined with the SCHED_TASK_ENTRY() macro inside of a
+ * SCHED_TASK_TABLE_DEF() table.
+ */
+typedef struct
+{
+  /// @brief The task's handler function.
+  sched_handler_t handler;
+  /// @brief The task interval. (ticks)
+  sched_time_t interval_ms;
+  /// @brief Is the task repeating?
+  bool repeat;
+  /// @brief The task's priority level, 0 is the lowest.
+  uint8_t priority;
+  /// @brief Is the task started along with the table?
+  bool start;
+} sched_task_entry_t;
+
+/**
+ * @brief A static task table.
+ *
+ * A table should be defined with the SCHED_TASK_TABLE_DEF() macro.  The
+ * table's tasks are stored in a single array, in the order of their entries.
+ */
+typedef struct
+{
+  /// @brief Pointer to the table's constant task entries.
+  const sched_task_entry_t *p_entries;
+  /// @brief Pointer to the array of the table's tasks.
+  sched_task_t *p_tasks;
+  /// @brief The number of tasks in the table.
+  uint8_t task_cnt;
+} sched_task_table_t;
+
 /**
  * @brief Buffered task pool configuration structure.
  *
  * A task pool should be defined with the SCHED_TASK_POOL_DEF() macro.
  */
-typedef struct
+typedef struct _sched_task_pool
 {
   /// @brief Pointer to the shared pool data buffer.
   uint8_t *p_data;
   /// @brief Pointer to the array of tasks in the pool.
   sched_task_t *p_tasks;
-  /// @brief Size of the data buffer for each task. (bytes)
+#if (SCHED_TASK_COMPACT_EN != 0)
+  /// @brief Pointer to the array of the tasks' data records.
+  sched_task_buff_t *p_buffs;
+#endif
+  /**
+   * @brief Pointer to the pool's free task bitmap.
+   *
+   * Each bit is set while the task at the same index in the pool is free so
+   * a free task can be found without searching the tasks.
+   */
+  uint32_t *p_free;
+  /**
+   * @brief Pointer to the free block bitmap of the pool's data arena.
+   *
+   * Each bit is set while the arena block at the same index is free.  Pools
+   * with a fixed data buffer for each task have a NULL arena bitmap pointer.
+   */
+  uint32_t *p_arena_free;
+  /// @brief The number of blocks in the pool's data arena.
+  uint16_t arena_blocks;
+  /// @brief The number of free blocks in the pool's data arena.
+  volatile uint16_t arena_free_cnt;
+  /// @brief Size of the data buffer for each task, 0 for arena pools. (bytes)
   uint8_t buff_size;
   /// @brief The number of tasks in the pool.
   uint8_t task_cnt;
+  /// @brief The number of free tasks in the pool.
+  volatile uint8_t free_cnt;
   /// @brief Has the pool been initialized?
   bool initialized : 1;
 } sched_task_pool_t;
 
+/**
+ * @brief An event which starts the tasks bound to it when signaled.
+ *
+ * An event should be defined with the SCHED_EVENT_DEF() macro.  Started tasks
+ * which are bound to the event wait in the event's wait list, in the order
+ * they started waiting, rather than in the task que.
+ *
+ * @note Events must be enabled with the SCHED_EVENT_EN build configuration
+ * define.
+ */
+typedef struct _sched_event
+{
+  /// @brief The first task in the wait list, NULL if no task is waiting.
+  sched_task_t *p_wait;
+  /// @brief The number of pending signals.
+  volatile uint16_t count;
+  /// @brief The maximum number of pending signals, 1 for a binary event.
+  uint16_t count_max;
+} sched_event_t;
+
+/**
+ * @brief A message task's FIFO of messages.
+ *
+ * The FIFO should be defined with the SCHED_TASK_MSG_DEF() macro.  Each
+ * message is stored in a fixed size slot along with its size.
+ *
+ * @note Message tasks must be enabled with the SCHED_TASK_MSG_EN build
+ * configuration define.
+ */
+typedef struct _sched_msg_fifo
+{
+  /// @brief Pointer to the message slots, msg_cnt slots of msg_size bytes.
+  uint8_t *p_buff;
+  /// @brief Pointer to the size of the message stored in each slot.
+  uint8_t *p_sizes;
+  /// @brief The size of each message slot. (bytes)
+  uint8_t msg_size;
+  /// @brief The number of message slots.
+  uint8_t msg_cnt;
+  /// @brief The slot index of the oldest message.
+  volatile uint8_t head;
+  /// @brief The number of pending messages.
+  volatile uint8_t pending;
+} sched_msg_fifo_t;
+
+/**
+ * @brief Attribute for placing a task in the task section.
+ *
+ * The compact task layout links the tasks with handles relative to the start
+ * of the task section.  The task definition macros place their tasks in the
+ * section, tasks or task arrays defined directly must be given the attribute.
+ * The GNU linker provides the __start_sched_tasks and __stop_sched_tasks
+ * symbols for the section, other linkers must define them.  The section must
+ * be placed in initialized RAM.  The attribute is empty unless
+ * SCHED_TASK_COMPACT_EN is enabled.
+ *
+ * @code
+ * static SCHED_TASK_SECTION sched_task_t tasks[TASK_CNT];
+ * @endcode
+ */
+#if (SCHED_TASK_COMPACT_EN != 0)
+#define SCHED_TASK_SECTION __attribute__((section("sched_tasks"), used))
+#else
+#define SCHED_TASK_SECTION
+#endif
+
+/**
+ * @brief Macros for defining and initializing the data fields of a task.
+ *
+ * The compact task layout stores a buffered task's data pointer and sizes in
+ * a data record, defined with SCHED_TASK_BUFF_REC_DEF(), rather than in the
+ * task.  Unbuffered tasks don't have a record.  Otherwise the fields are
+ * stored in the task and no record is defined.  Used by the task definition
+ * macros.
+ */
+#if (SCHED_TASK_COMPACT_EN != 0)
+#define SCHED_TASK_BUFF_REC_DEF(REC_ID, P_DATA, BUFF_SIZE) \
+  static sched_task_buff_t REC_ID = {.p_data = (P_DATA), .buff_size = (BUFF_SIZE), .data_size = 0};
+#define SCHED_TASK_DATA_INIT(P_REC, P_DATA, BUFF_SIZE) .p_buff = (P_REC)
+#define SCHED_POOL_RECS_DEF(RECS_ID, TASK_CNT) static sched_task_buff_t RECS_ID[TASK_CNT];
+#define SCHED_POOL_RECS_INIT(RECS_ID) .p_buffs = (RECS_ID),
+#else
+#define SCHED_TASK_BUFF_REC_DEF(REC_ID, P_DATA, BUFF_SIZE)
+#define SCHED_TASK_DATA_INIT(P_REC, P_DATA, BUFF_SIZE) \
+  .p_data = (P_DATA), .buff_size = (BUFF_SIZE), .data_size = 0
+#define SCHED_POOL_RECS_DEF(RECS_ID, TASK_CNT)
+#define SCHED_POOL_RECS_INIT(RECS_ID)
+#endif
+
 /**
  * @brief Macro for selecting the smaller of two numbers.
  *
@@ -147,6 +631,31 @@ typedef struct
  */
 #define SCHED_MAX(a, b) (((a) > (b)) ? (a) : (b))
 
+/**
+ * @brief Macro for checking a condition at compile time.
+ *
+ * @param[in] expr  The constant expression which must be true.
+ * @param[in] msg   The error message if the expression is false.
+ */
+#ifdef __cplusplus
+#define SCHED_STATIC_ASSERT(expr, msg) static_assert(expr, msg)
+#else
+#define SCHED_STATIC_ASSERT(expr, msg) _Static_assert(expr, msg)
+#endif
+
+/**
+ * @brief The maximum number of tasks in a static task table.
+ *
+ * A table is limited to UINT8_MAX tasks.  With the SCHED_QUE_HEAP que engine
+ * a table must also fit in the que heap since each of its tasks can be
+ * started.
+ */
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+#define SCHED_TASK_TABLE_MAX SCHED_MIN(SCHED_QUE_HEAP_SIZE, UINT8_MAX)
+#else
+#define SCHED_TASK_TABLE_MAX UINT8_MAX
+#endif
+
 /**
  * @brief Macro for limiting a buffer size parameter to the valid range.
  *
@@ -165,6 +674,43 @@ typedef struct
  */
 #define SCHED_TASK_LIMIT(value) ((uint8_t)SCHED_MIN(SCHED_MAX(value, 1), UINT8_MAX))
 
+/**
+ * @brief Macro for limiting an event count parameter to the valid range.
+ *
+ * Event counts are limited to be greater than 0 and less than UINT16_MAX.
+ *
+ * @param[in] value The event count value to limit.
+ */
+#define SCHED_EVENT_LIMIT(value) ((uint16_t)SCHED_MIN(SCHED_MAX(value, 1), UINT16_MAX))
+
+/**
+ * @brief Macro for calculating the number of 32 bit words in a task pool's
+ * free task bitmap.
+ *
+ * @param[in] value The task count of the pool.
+ */
+#define SCHED_POOL_FREE_WORDS(value) ((SCHED_TASK_LIMIT(value) + 31) / 32)
+
+/**
+ * @brief Macro for calculating the number of blocks in a task pool data arena.
+ *
+ * The arena size is rounded up to a whole number of
+ * SCHED_TASK_ARENA_BLOCK_SIZE blocks and limited to 1 to UINT16_MAX blocks.
+ *
+ * @param[in] value The arena size. (bytes)
+ */
+#define SCHED_ARENA_BLOCKS(value) \
+  ((uint16_t)SCHED_MIN(SCHED_MAX(((value) + SCHED_TASK_ARENA_BLOCK_SIZE - 1) / \
+                                     SCHED_TASK_ARENA_BLOCK_SIZE, 1), UINT16_MAX))
+
+/**
+ * @brief Macro for calculating the number of 32 bit words in a task pool data
+ * arena's free block bitmap.
+ *
+ * @param[in] value The arena size. (bytes)
+ */
+#define SCHED_ARENA_FREE_WORDS(value) ((SCHED_ARENA_BLOCKS(value) + 31) / 32)
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,60 +7,39 @@
 #include <string.h>
 #include "scheduler.h"
 
-/***** Scheduler Configuration Defines *****/
+/***** Scheduler Configuration Checks *****/
 
-/**
- * @brief Definition to enable / disable clearing buffered task data.
- *
- * If SCHED_TASK_BUFF_CLEAR_EN is defined to be > 0, task data buffers
- * will be cleared when they are configured.  The default implementation
- * is to not clear the buffer but the end user can override this by defining
- * SCHED_TASK_BUFF_CLEAR_EN to be 1 if desired.  Clearing large task data
- * buffer can be expensive and is unnecessary for most applications since the
- * buffer is overwritten when data is added.  Clearing the buffer can be
- * useful for certain debugging purposes and it is therefore conditionally 
- * supported.
+/* The build configuration defines are located in the sched_config.h header
+ * so that the task structure layout is consistent across all modules.  The
+ * task cache is only utilized by the linked list que engine.
  */
-#ifndef SCHED_TASK_BUFF_CLEAR_EN
-#define SCHED_TASK_BUFF_CLEAR_EN (0)
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST) && (SCHED_TASK_CACHE_EN != 0)
+#define SCHED_QUE_CACHE_EN (1)
+#else
+#define SCHED_QUE_CACHE_EN (0)
 #endif
 
-/**
- * @brief Definition for the maximum task interval time in mS.
- *
- * The define sets the maximum task interval time in mS.  The default value
- * of UINT32_MAX will be suitable for most applications but the end user
- * can define a lower value should they need to limit task intervals.
- */
-#ifndef SCHED_MS_MAX
-#define SCHED_MS_MAX (UINT32_MAX)
-#endif
+#if (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+/// @brief The number of slots in each timing wheel level.
+#define WHEEL_SLOTS (1UL << SCHED_QUE_WHEEL_BITS)
 
-/**
- * @brief Definition to enable or disable Scheduler Task Pools.
- *
- * If SCHED_TASK_POOL_EN is defined to be != 0, scheduler task pool support
- * will be enabled.  Task pools are enabled by default but the end user can
- * disable them to reduce the scheduler's ROM footprint if support for them is 
- * not needed.
- */
-#ifndef SCHED_TASK_POOL_EN
-#define SCHED_TASK_POOL_EN (1)
-#endif
+/// @brief The number of timing wheel levels required to cover 32 bits.
+#define WHEEL_LEVELS ((32 + SCHED_QUE_WHEEL_BITS - 1) / SCHED_QUE_WHEEL_BITS)
 
-/**
- * @brief Definition to enable or disable task caching.
- *
- * If SCHED_TASK_CACHE_EN is defined to be != 0, the scheduler will save the
- * next expiring task during each task service loop.  This will improve the
- * efficiency of the task search in many case by enabling the scheduler to
- * immediately check the next expiring task on wake up.  If the cached task is
- * unexpired, the scheduler can skip the task que search and immediately put
- * the processor back to sleep.  The caching optimization is enabled by default
- * but can be disabled by end user if desired.
- */
-#ifndef SCHED_TASK_CACHE_EN
-#define SCHED_TASK_CACHE_EN (1)
+/// @brief The number of slots used in the highest timing wheel level.
+#define WHEEL_TOP_SLOTS (1UL << (32 - (SCHED_QUE_WHEEL_BITS * (WHEEL_LEVELS - 1))))
+
+/// @brief The index of the list of expired tasks.
+#define WHEEL_LIST_READY (0)
+
+/// @brief The index of the first slot list.
+#define WHEEL_LIST_SLOTS (1)
+
+/// @brief The index of the list of tasks which expire after the mS time rolls over.
+#define WHEEL_LIST_OVERFLOW (WHEEL_LIST_SLOTS + ((WHEEL_LEVELS - 1) * WHEEL_SLOTS) + WHEEL_TOP_SLOTS)
+
+/// @brief The total number of timing wheel lists.
+#define WHEEL_LIST_CNT (WHEEL_LIST_OVERFLOW + 1)
 #endif
 
 /***** Scheduler Module Internal Data *****/
@@ -78,6 +57,53 @@ typedef enum
   SCHED_STATE_STOPPING,
 } sched_state_t;
 
+#if (SCHED_TASK_POST_SIZE != 0)
+
+/**
+ * @brief Task post que operations.
+ */
+typedef enum
+{
+  /// @brief Start the task with sched_task_start().
+  POST_START = 0,
+  /// @brief Stop the task with sched_task_stop().
+  POST_STOP,
+  /// @brief Update the task's interval with sched_task_update().
+  POST_UPDATE,
+} post_op_t;
+
+/**
+ * @brief A task post que entry.
+ */
+typedef struct
+{
+  /// @brief Pointer to the posted task.
+  sched_task_t *p_task;
+  /// @brief The new task interval for a POST_UPDATE operation. (ticks)
+  sched_time_t interval_ms;
+  /// @brief The posted operation. (post_op_t)
+  uint8_t op;
+} post_t;
+
+/**
+ * @brief Macro for a memory barrier between writing a post que entry and
+ * publishing the updated ring index, or between reading the ring index and
+ * reading the entry.
+ *
+ * The lock free post que can't work without the barrier, so the build fails
+ * on compilers which provide neither C11 atomics nor the GNU builtins.
+ */
+#if (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define POST_BARRIER() atomic_thread_fence(memory_order_seq_cst)
+#elif defined(__GNUC__)
+#define POST_BARRIER() __sync_synchronize()
+#else
+#error "The task post que requires a memory barrier, C11 atomics or the GNU builtins."
+#endif
+
+#endif // (SCHED_TASK_POST_SIZE != 0)
+
 /**
  * @brief The scheduler's internal data structure.
  *
@@ -102,18 +128,97 @@ typedef struct
    */
   volatile sched_task_t *p_tail;
 
-#if (SCHED_TASK_CACHE_EN != 0)
   /**
-   * @brief The updated flag tracks whether any active tasks have had their
-   * intervals updated since the scheduler's task que was last serviced.  A
-   * task with an updated interval could invalidate the cached next task.  The
-   * updated flag indicates that the cached next task should be ignored and
-   * the next task search repeated by the scheduler during the task service
-   * loop.
+   * @brief Does the task list hold stopped tasks which should be unlinked?
+   *
+   * Stopped tasks are unlinked by the instance's loop between que searches
+   * rather than when they are stopped, so a task can be stopped from any
+   * context without searching the singly linked list.
+   */
+  volatile bool prune;
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+  /**
+   * @brief The que heap of active tasks.
+   *
+   * The heap is ordered by each task's time until expiration so the next
+   * expiring task is always stored at the top of the heap at index 0.  Tasks
+   * are stored in the heap while they are in the active, executing or
+   * stopping states.
+   */
+  sched_task_t *p_heap[SCHED_QUE_HEAP_SIZE];
+
+  /// @brief The number of tasks currently stored in the heap.
+  uint16_t heap_cnt;
+#endif
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+  /**
+   * @brief The timing wheel's task lists.
+   *
+   * Tasks are stored in the wheel while they are in the active, executing or
+   * stopping states.
+   */
+  sched_task_t *p_wheel[WHEEL_LIST_CNT];
+
+  /// @brief Bitmaps of the occupied slots in each level of the wheel.
+  uint32_t wheel_bitmap[WHEEL_LEVELS];
+
+  /// @brief The time which the wheel has been advanced to. (mS)
+  sched_time_t wheel_ms;
+#endif
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+  /**
+   * @brief The updated flag tracks whether any tasks have been started,
+   * stopped or had their intervals updated since the scheduler's task que was
+   * last searched.  A task update could invalidate the cached next task or
+   * the next task found by a search in progress.  The updated flag indicates
+   * that the next task search should be repeated by the scheduler during the
+   * task service loop.
    */
   volatile bool updated;
 #endif
 
+  /**
+   * @brief The que updated flag tracks whether any tasks have been started
+   * or stopped since the scheduler last searched its task que.  The flag
+   * indicates that the que should be searched again if the scheduler wakes
+   * before its sleep deadline.
+   */
+  volatile bool que_updated;
+
+#if (SCHED_TASK_POST_SIZE != 0)
+  /**
+   * @brief The task post que ring.
+   *
+   * Posts are written at the head index by the posting context and read at
+   * the tail index by the scheduler.  The free running indices are only
+   * written by one side each so no lock is needed.
+   */
+  post_t posts[SCHED_TASK_POST_SIZE];
+
+  /// @brief The post que head index, only written by the posting context.
+  volatile uint16_t post_head;
+
+  /// @brief The post que tail index, only written by the scheduler.
+  volatile uint16_t post_tail;
+#endif
+
+#if (SCHED_QUE_CACHE_EN != 0)
+  /// @brief The cached soonest expiring tasks, ordered by expiration.
+  sched_task_t *p_cache[SCHED_TASK_CACHE_SIZE];
+
+  /// @brief The number of cached tasks.
+  uint8_t cache_cnt;
+
+  /// @brief Is the cache valid?  An invalid cache must be refilled.
+  bool cache_valid;
+
+  /// @brief Are all of the active tasks cached?
+  bool cache_all;
+#endif
+
   /**
    * @brief The module's current state.
    *
@@ -121,19 +226,145 @@ typedef struct
    * from an interrupt context.
    */
   volatile sched_state_t state;
+
+#if (SCHED_INSTANCE_CNT > 1)
+  /**
+   * @brief Is the instance busy executing its task que?
+   *
+   * Idle instances only steal tasks from the ques of busy instances since an
+   * idle instance executes its own tasks as soon as they expire.
+   */
+  volatile bool busy;
+#endif
+
+#if (SCHED_STATS_EN != 0)
+  /**
+   * @brief The instance's runtime statistics.
+   *
+   * The time since the start of the current awake or sleep period is added
+   * when a snapshot is taken.
+   */
+  sched_stats_t stats;
+
+  /// @brief The time the current awake or sleep period started. (ticks)
+  sched_time_t stats_mark_ms;
+
+  /// @brief Is the instance running its task que?
+  bool stats_running;
+
+  /// @brief Is the instance sleeping?
+  bool stats_sleeping;
+#endif
+
+#if (SCHED_TASK_BUDGET_EN != 0)
+  /// @brief Did a handler overrun its budget during the current loop pass?
+  bool budget_overrun;
+#endif
+
+#if (SCHED_TASK_POWER_EN != 0)
+  /// @brief The run mode the instance last switched the processor to.
+  uint8_t run_mode;
+
+  /// @brief The number of the instance's started tasks in each sleep mode.
+  uint32_t sleep_cnt[SCHED_SLEEP_MODE_CNT];
+#endif
+
+#if (SCHED_TRACE_SIZE != 0)
+  /**
+   * @brief The start and end times of the instance's last sleep. (ticks)
+   *
+   * The times are only accessed by the instance's loop, which records them
+   * without the lock and writes them to the trace ring in its next critical
+   * section.
+   */
+  sched_time_t trace_sleep_ms;
+  sched_time_t trace_wake_ms;
+
+  /// @brief Is the last sleep waiting to be written to the trace ring?
+  bool trace_sleep_pending;
+#endif
 } scheduler_t;
 
-// The scheduler module's internal data.
-static scheduler_t scheduler = {
-    .p_head = NULL,
-    .p_tail = NULL,
-#if (SCHED_TASK_CACHE_EN != 0)
-    .updated = false,
+/* The scheduler instances' internal data.  Every instance is zero
+ * initialized which leaves it stopped with an empty task que.
+ */
+static scheduler_t sched_instances[SCHED_INSTANCE_CNT];
+
+/**
+ * @brief Internal function for getting the scheduler instance whose que
+ * stores a task.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return Pointer to the task's scheduler instance.
+ */
+static inline scheduler_t *task_sched(const sched_task_t *p_task)
+{
+#if (SCHED_INSTANCE_CNT > 1)
+  return &sched_instances[p_task->instance];
+#else
+  (void)p_task;
+  return &sched_instances[SCHED_INSTANCE_DEFAULT];
 #endif
-    .state = SCHED_STATE_STOPPED};
+}
+
+/**
+ * @brief Internal function for marking an instance's que as updated.
+ *
+ * The port is asked to end a sleep in progress since a task started or
+ * stopped by another thread doesn't wake a hosted platform by itself.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static inline void que_updated_set(scheduler_t *p_sched)
+{
+  p_sched->que_updated = true;
+  sched_port_wake();
+}
+
+/**
+ * @brief Internal function for checking if a task is active in an instance's
+ * task list.
+ *
+ * A task list search made without exclusive access can continue into the
+ * list of a different instance if a task is moved during the search.  The
+ * tasks of the other instance are skipped.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task   Pointer to the task.
+ * @return True if the task is active and stored in the instance else False.
+ */
+static inline bool task_list_active(const scheduler_t *p_sched, const sched_task_t *p_task)
+{
+  return (p_task->state == SCHED_TASK_ACTIVE) && (task_sched(p_task) == p_sched);
+}
 
 /***** Internal Scheduler Task Helper Macro's. *****/
 
+/**
+ * @brief Macros for accessing a task's data pointer, buffer size and data
+ * size.
+ *
+ * The compact task layout stores the fields in the data record of a buffered
+ * task, so the fields can only be accessed if TASK_DATA_STORED() is true.
+ * Unbuffered tasks don't have a record and don't store data.  Otherwise the
+ * fields are stored in every task.
+ *
+ * @note The task pointer is not NULL checked
+ *
+ * @param[in] p_task   Pointer to the task.
+ */
+#if (SCHED_TASK_COMPACT_EN != 0)
+#define TASK_DATA_STORED(p_task) ((p_task)->p_buff != NULL)
+#define TASK_DATA(p_task) ((p_task)->p_buff->p_data)
+#define TASK_BUFF_SIZE(p_task) ((p_task)->p_buff->buff_size)
+#define TASK_DATA_SIZE(p_task) ((p_task)->p_buff->data_size)
+#else
+#define TASK_DATA_STORED(p_task) (true)
+#define TASK_DATA(p_task) ((p_task)->p_data)
+#define TASK_BUFF_SIZE(p_task) ((p_task)->buff_size)
+#define TASK_DATA_SIZE(p_task) ((p_task)->data_size)
+#endif
+
 /**
  * @brief Macro for checking if a task is buffered.
  *
@@ -143,7 +374,7 @@ static scheduler_t scheduler = {
  * @return             True if the task is buffered.
  *                     False if the task is unbuffered.
  */
-#define TASK_BUFFERED(p_task) ((p_task)->buff_size > 0)
+#define TASK_BUFFERED(p_task) (TASK_DATA_STORED(p_task) && (TASK_BUFF_SIZE(p_task) > 0))
 
 /**
  * @brief Macro for safely checking if a task is buffered.
@@ -184,7 +415,7 @@ static scheduler_t scheduler = {
  * @param[in] p_task   Pointer to the task.
  * @return             True if the task is expired else False.
  */
-#define TASK_EXPIRED(p_task) ((sched_port_ms() - (p_task)->start_ms) >= (p_task)->interval_ms)
+#define TASK_EXPIRED(p_task) ((sched_port_ticks() - (p_task)->start_ms) >= (p_task)->interval_ms)
 
 /**
  * @brief Macro for safely checking if a task has expired.
@@ -195,869 +426,5268 @@ static scheduler_t scheduler = {
  */
 #define TASK_EXPIRED_SAFE(p_task) (TASK_ACTIVE_SAFE(p_task) && TASK_EXPIRED(p_task))
 
-/***** Internal Scheduler Task Helper Functions. *****/
-
 /**
- * @brief Internal function for setting a task's interval.
+ * @brief Macro for getting a task's priority level.
  *
- * The tasks repeating status should be set prior to making the function call.
+ * @note The task pointer is not NULL checked
  *
- * @note: The task pointer is not NULL checked.
+ * @param[in] p_task   Pointer to the task.
+ * @return             The task's priority level, always 0 if task priorities
+ *                     are disabled.
+ */
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+#define TASK_PRIORITY(p_task) ((p_task)->priority)
+#else
+#define TASK_PRIORITY(p_task) (0)
+#endif
+
+/***** Internal Bitmap Helper Functions *****/
+
+/**
+ * @brief Internal function for finding the lowest set bit in a bitmap.
  *
- * @param[in] p_task    Pointer to the task.
- * @param[in] interval_ms  The new interval to store.
+ * @param[in] bitmap  The bitmap, must not be 0.
+ * @return The index of the lowest set bit.
  */
-static inline void task_interval_set(sched_task_t *p_task, uint32_t interval_ms)
+static inline uint32_t bit_first(uint32_t bitmap)
 {
-
-  if (p_task->repeat && (interval_ms == 0))
+  assert(bitmap != 0);
+#if defined(__GNUC__)
+  return (uint32_t)__builtin_ctz(bitmap);
+#else
+  uint32_t index = 0;
+  while ((bitmap & 0x1) == 0)
   {
-    /* Repeating tasks must have an interval > 0.  A repeating task with an
-     * interval of 0 would repeatably be executed by the scheduler and starve
-     * other tasks of processor time.
-     */
-    p_task->interval_ms = 1;
+    bitmap >>= 1;
+    index++;
   }
-  else
-  {
-#if (SCHED_MS_MAX < UINT32_MAX)
-    // Limit the interval to the max interval if one is defined.
-    if (interval_ms > SCHED_MS_MAX)
-    {
-      p_task->interval_ms = SCHED_MS_MAX;
-    }
-    else
-    {
-      p_task->interval_ms = interval_ms;
-    }
-#else
-    p_task->interval_ms = interval_ms;
+  return index;
 #endif
-  }
 }
 
 /**
- * @brief Internal function for checking the time since a task was started.
+ * @brief Internal function for finding the highest set bit in a bitmap.
  *
- * @note: The task pointer is not NULL checked and the task is assumed to be
- * active.
- *
- * @param[in] p_task  Pointer to the task.
- * @param[in] now_time_ms  The current time in mS.
- * @return The time since the task was started.
+ * @param[in] bitmap  The bitmap, must not be 0.
+ * @return The index of the highest set bit.
  */
-static inline uint32_t task_time_elapsed_ms(const sched_task_t *p_task, uint32_t now_time_ms)
+static inline uint32_t bit_last(uint32_t bitmap)
 {
-  return now_time_ms - p_task->start_ms;
+  assert(bitmap != 0);
+#if defined(__GNUC__)
+  return 31 - (uint32_t)__builtin_clz(bitmap);
+#else
+  uint32_t index = 0;
+  while (bitmap > 1)
+  {
+    bitmap >>= 1;
+    index++;
+  }
+  return index;
+#endif
 }
 
+/***** Internal Task Link Functions *****/
+
+#if (SCHED_TASK_COMPACT_EN != 0)
+
+/// @brief The unit of a task handle's offset. (bytes)
+#define HANDLE_UNIT (sizeof(uint32_t))
+
+/* The bounds of the task section, provided by the linker.  The symbols are
+ * weak so a build without any tasks still links.
+ */
+extern sched_task_t __start_sched_tasks[] __attribute__((weak));
+extern sched_task_t __stop_sched_tasks[] __attribute__((weak));
+
 /**
- * @brief Internal function for checking if a task has expired.
- *
- * @note: The task pointer is not NULL checked and the task is assumed to be
- * active.
+ * @brief Internal function for checking if an object can be referenced by a
+ * handle relative to the start of its section.
  *
- * @param[in] p_task        Pointer to the task.
- * @param[in] now_time_ms   The current time in mS.
- * @return  The time until the task expires or 0 if it is already expired.
+ * @param[in] p_start  Pointer to the start of the section.
+ * @param[in] p_stop   Pointer to the end of the section.
+ * @param[in] p_obj    Pointer to the object.
+ * @return True if the object is stored in the section within the handle range.
  */
-static inline bool task_time_expired(const sched_task_t *p_task, uint32_t now_time_ms)
+static inline bool handle_valid(const void *p_start, const void *p_stop, const void *p_obj)
 {
-  return (now_time_ms - p_task->start_ms) >= p_task->interval_ms;
+  uintptr_t start = (uintptr_t)p_start;
+  uintptr_t obj = (uintptr_t)p_obj;
+
+  return (p_start != NULL) && (obj >= start) && (obj < (uintptr_t)p_stop) &&
+         (((obj - start) % HANDLE_UNIT) == 0) &&
+         (((obj - start) / HANDLE_UNIT) < (UINT16_MAX - 1));
 }
 
 /**
- * @brief Internal function for calculating the time until a task expires.
- *
- * @note: The task is assumed to be active and the task pointer is not NULL
- * checked.
+ * @brief Internal function for converting an object pointer to a handle.
  *
- * @param[in] p_task        Pointer to the task.
- * @param[in] now_time_ms   The current time in mS.
- * @return  The time until the task expires or 0 if it is already expired.
+ * @param[in] p_start  Pointer to the start of the object's section.
+ * @param[in] p_obj    Pointer to the object, NULL for none.
+ * @return The object's handle, 0 for none.
  */
-static inline uint32_t task_time_remaining_ms(const sched_task_t *p_task, uint32_t now_time_ms)
+static inline uint16_t handle_get(const void *p_start, const void *p_obj)
 {
-  uint32_t elapsed_ms = now_time_ms - p_task->start_ms;
-  if (p_task->interval_ms > elapsed_ms)
-  {
-    return p_task->interval_ms - elapsed_ms;
-  }
-  else
+  if (p_obj == NULL)
   {
     return 0;
   }
+  return (uint16_t)((((uintptr_t)p_obj - (uintptr_t)p_start) / HANDLE_UNIT) + 1);
 }
 
-/***** External Scheduler Task Helper Functions *****/
-
-bool sched_task_expired(const sched_task_t *p_task)
+/**
+ * @brief Internal function for converting a handle to an object pointer.
+ *
+ * @param[in] p_start  Pointer to the start of the object's section.
+ * @param[in] handle   The object's handle, 0 for none.
+ * @return Pointer to the object, NULL for none.
+ */
+static inline void *handle_ptr(void *p_start, uint16_t handle)
 {
-
-  if (TASK_ACTIVE_SAFE(p_task))
-  {
-    return (sched_port_ms() - p_task->start_ms) >= p_task->interval_ms;
-  }
-  else
+  if (handle == 0)
   {
-    return false;
+    return NULL;
   }
+  return (uint8_t *)p_start + ((uint32_t)(handle - 1) * HANDLE_UNIT);
 }
 
-uint32_t sched_task_remaining_ms(const sched_task_t *p_task)
-{
-
-  if (TASK_ACTIVE_SAFE(p_task))
-  {
-    uint32_t elapsed_ms = sched_port_ms() - p_task->start_ms;
-
-    if (elapsed_ms < p_task->interval_ms)
-    {
-      return p_task->interval_ms - elapsed_ms;
-    }
-    else
-    {
-      // Expired
-      return 0;
-    }
-  }
-  else
-  {
-    return SCHED_MS_MAX;
-  }
-}
+#endif // (SCHED_TASK_COMPACT_EN != 0)
 
-uint32_t sched_task_elapsed_ms(const sched_task_t *p_task)
+/**
+ * @brief Internal function for getting the next task in a task's list.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return Pointer to the next task, NULL if it is the last task.
+ */
+static inline sched_task_t *task_next(const sched_task_t *p_task)
 {
-
-  if (TASK_ACTIVE_SAFE(p_task))
-  {
-    return sched_port_ms() - p_task->start_ms;
-  }
-  else
-  {
-    return 0;
-  }
+#if (SCHED_TASK_COMPACT_EN != 0)
+  return (sched_task_t *)handle_ptr(__start_sched_tasks, p_task->next_handle);
+#else
+  return p_task->p_next;
+#endif
 }
 
-sched_task_t *sched_task_compare(const sched_task_t *p_task_a, const sched_task_t *p_task_b)
+/**
+ * @brief Internal function for setting the next task in a task's list.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @param[in] p_next  Pointer to the next task, NULL for none.
+ */
+static inline void task_next_set(sched_task_t *p_task, const sched_task_t *p_next)
+{
+#if (SCHED_TASK_COMPACT_EN != 0)
+  p_task->next_handle = handle_get(__start_sched_tasks, p_next);
+#else
+  p_task->p_next = (sched_task_t *)p_next;
+#endif
+}
+
+/**
+ * @brief Internal function for checking if a task can be linked into a task
+ * list.
+ *
+ * Every task can be linked unless the compact task layout is enabled, in which
+ * case the task must be stored in the task section.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return True if the task can be linked else False.
+ */
+static inline bool task_linkable(const sched_task_t *p_task)
+{
+#if (SCHED_TASK_COMPACT_EN != 0)
+  return handle_valid(__start_sched_tasks, __stop_sched_tasks, p_task);
+#else
+  (void)p_task;
+  return true;
+#endif
+}
+
+/***** Internal Trace Functions *****/
+
+#if (SCHED_TRACE_SIZE != 0)
+
+/* The trace ring is shared by every instance since the instances share the
+ * port lock.  The head and tail are free running event counts.
+ */
+static sched_trace_t trace_ring[SCHED_TRACE_SIZE];
+static uint32_t trace_head;
+static uint32_t trace_tail;
+
+#if (SCHED_TASK_COMPACT_EN == 0)
+/// @brief The trace id given to the next task configured, 0 is never used.
+static uint16_t trace_id_next;
+#endif
+
+/**
+ * @brief Internal function for getting the id which identifies a task in the
+ * trace events.
+ *
+ * The compact task layout identifies a task by its handle in the task
+ * section, otherwise a task is given an id when it is first configured.
+ *
+ * @param[in] p_task  Pointer to the task, NULL for none.
+ * @return The task's trace id, 0 for none.
+ */
+static inline uint32_t trace_task_id(const sched_task_t *p_task)
+{
+  if (p_task == NULL)
+  {
+    return 0;
+  }
+#if (SCHED_TASK_COMPACT_EN != 0)
+  return handle_get(__start_sched_tasks, p_task);
+#else
+  return p_task->trace_id;
+#endif
+}
+
+/**
+ * @brief Internal function for recording a trace event.
+ *
+ * The oldest event is overwritten if the ring is full.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched   Pointer to the scheduler instance recording the event.
+ * @param[in] event     The event type.
+ * @param[in] p_task    Pointer to the event's task, NULL for none.
+ * @param[in] time_ms   The event time. (ticks)
+ */
+static void trace_write(const scheduler_t *p_sched,
+                        sched_trace_event_t event,
+                        const sched_task_t *p_task,
+                        sched_time_t time_ms)
+{
+  sched_trace_t *p_trace = &trace_ring[trace_head & (SCHED_TRACE_SIZE - 1)];
+
+  p_trace->time_ms = (uint32_t)time_ms;
+  p_trace->task_id = trace_task_id(p_task);
+  p_trace->seq = (uint16_t)trace_head;
+  p_trace->event = (uint8_t)event;
+  p_trace->instance = (uint8_t)(p_sched - sched_instances);
+
+  trace_head++;
+  if ((trace_head - trace_tail) > SCHED_TRACE_SIZE)
+  {
+    trace_tail = trace_head - SCHED_TRACE_SIZE;
+  }
+}
+
+/**
+ * @brief Internal function for writing an instance's last sleep to the trace
+ * ring.
+ *
+ * The instance's loop records its sleeps without taking the lock, so a
+ * sleep is written by the loop's next critical section.  Sleeps which end
+ * early without a task change are recorded as one sleep.
+ *
+ * @note The scheduler must be locked prior to calling the function and the
+ * function must only be called by the instance's loop.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static void trace_sleep_write(scheduler_t *p_sched)
+{
+  if (p_sched->trace_sleep_pending)
+  {
+    trace_write(p_sched, SCHED_TRACE_SLEEP_ENTER, NULL, p_sched->trace_sleep_ms);
+    trace_write(p_sched, SCHED_TRACE_WAKE, NULL, p_sched->trace_wake_ms);
+    p_sched->trace_sleep_pending = false;
+  }
+}
+
+#define TRACE(p_sched, event, p_task, time_ms) trace_write((p_sched), (event), (p_task), (time_ms))
+#define TRACE_SLEEP(p_sched) trace_sleep_write(p_sched)
+#else
+#define TRACE(p_sched, event, p_task, time_ms)
+#define TRACE_SLEEP(p_sched)
+#endif // (SCHED_TRACE_SIZE != 0)
+
+#if (SCHED_TASK_POOL_EN != 0)
+
+/* The table of the pools which tasks have been allocated from.  A task
+ * stores its pool's index in the table so the table can't shrink.
+ */
+static sched_task_pool_t *pool_table[SCHED_TASK_POOL_MAX];
+static uint8_t pool_cnt;
+
+/**
+ * @brief Internal function for getting the pool a task was allocated from.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return Pointer to the task's pool, NULL if it isn't part of a pool.
+ */
+static inline sched_task_pool_t *task_pool(const sched_task_t *p_task)
+{
+  return (p_task->pool_index != 0) ? pool_table[p_task->pool_index - 1] : NULL;
+}
+
+#endif // (SCHED_TASK_POOL_EN != 0)
+
+/***** Internal Scheduler Task Helper Functions. *****/
+
+/**
+ * @brief Internal function for setting a task's interval.
+ *
+ * The tasks repeating status should be set prior to making the function call.
+ *
+ * @note: The task pointer is not NULL checked.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[in] interval_ms  The new interval to store.
+ */
+static inline void task_interval_set(sched_task_t *p_task, sched_time_t interval_ms)
+{
+
+  if (p_task->repeat && (interval_ms == 0))
+  {
+    /* Repeating tasks must have an interval > 0.  A repeating task with an
+     * interval of 0 would repeatably be executed by the scheduler and starve
+     * other tasks of processor time.
+     */
+    p_task->interval_ms = 1;
+  }
+  else
+  {
+#if (SCHED_MS_MAX < SCHED_TIME_MAX)
+    // Limit the interval to the max interval if one is defined.
+    if (interval_ms > SCHED_MS_MAX)
+    {
+      p_task->interval_ms = SCHED_MS_MAX;
+    }
+    else
+    {
+      p_task->interval_ms = interval_ms;
+    }
+#else
+    p_task->interval_ms = interval_ms;
+#endif
+  }
+}
+
+/**
+ * @brief Internal function for checking the time since a task was started.
+ *
+ * @note: The task pointer is not NULL checked and the task is assumed to be
+ * active.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @param[in] now_time_ms  The current time in mS.
+ * @return The time since the task was started.
+ */
+static inline sched_time_t task_time_elapsed_ms(const sched_task_t *p_task, sched_time_t now_time_ms)
+{
+  return now_time_ms - p_task->start_ms;
+}
+
+/**
+ * @brief Internal function for checking if a task has expired.
+ *
+ * @note: The task pointer is not NULL checked and the task is assumed to be
+ * active.
+ *
+ * @param[in] p_task        Pointer to the task.
+ * @param[in] now_time_ms   The current time in mS.
+ * @return  The time until the task expires or 0 if it is already expired.
+ */
+static inline bool task_time_expired(const sched_task_t *p_task, sched_time_t now_time_ms)
+{
+  return (now_time_ms - p_task->start_ms) >= p_task->interval_ms;
+}
+
+/**
+ * @brief Internal function for calculating the time until a task expires.
+ *
+ * @note: The task is assumed to be active and the task pointer is not NULL
+ * checked.
+ *
+ * @param[in] p_task        Pointer to the task.
+ * @param[in] now_time_ms   The current time in mS.
+ * @return  The time until the task expires or 0 if it is already expired.
+ */
+static inline sched_time_t task_time_remaining_ms(const sched_task_t *p_task, sched_time_t now_time_ms)
+{
+  sched_time_t elapsed_ms = now_time_ms - p_task->start_ms;
+  if (p_task->interval_ms > elapsed_ms)
+  {
+    return p_task->interval_ms - elapsed_ms;
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+/**
+ * @brief Internal function for calculating the time until the scheduler must
+ * wake up to execute a task.
+ *
+ * The task's handler may be delayed by up to its slack time after the task
+ * expires.
+ *
+ * @note: The task is assumed to be active and the task pointer is not NULL
+ * checked.
+ *
+ * @param[in] p_task        Pointer to the task.
+ * @param[in] now_time_ms   The current time in mS.
+ * @return  The time until the task's slack runs out in mS, limited to
+ *          SCHED_MS_MAX.
+ */
+static inline sched_time_t task_time_wake_ms(const sched_task_t *p_task, sched_time_t now_time_ms)
+{
+  sched_time_t remaining_ms = task_time_remaining_ms(p_task, now_time_ms);
+#if (SCHED_TASK_SLACK_EN != 0)
+  if (p_task->slack_ms > (SCHED_MS_MAX - remaining_ms))
+  {
+    return SCHED_MS_MAX;
+  }
+  return remaining_ms + p_task->slack_ms;
+#else
+  return remaining_ms;
+#endif
+}
+
+/**
+ * @brief Internal function for re-arming an expired repeating task according
+ * to its repeat mode.
+ *
+ * Fixed rate tasks are re-armed from their scheduled expiration time.  The
+ * skip mode advances the start time by whole intervals to the latest
+ * scheduled expiration at or before the current time so any missed intervals
+ * are skipped.  The catch up mode advances the start time by a single
+ * interval so the task remains expired until it has caught up.  A fixed rate
+ * task with an interval of 0 is re-armed as a fixed delay task to prevent it
+ * from being continuously expired.
+ *
+ * @note: The task is assumed to be expired and the task pointer is not NULL
+ * checked.
+ *
+ * @param[in] p_task        Pointer to the task.
+ * @param[in] now_time_ms   The time the task was found to be expired. (mS)
+ */
+static inline void task_time_rearm(sched_task_t *p_task, sched_time_t now_time_ms)
+{
+  if ((p_task->repeat_mode == SCHED_REPEAT_FIXED_DELAY) || (p_task->interval_ms == 0))
+  {
+    p_task->start_ms = now_time_ms;
+  }
+  else if (p_task->repeat_mode == SCHED_REPEAT_FIXED_RATE_CATCHUP)
+  {
+    p_task->start_ms += p_task->interval_ms;
+  }
+  else
+  {
+    sched_time_t elapsed_ms = task_time_elapsed_ms(p_task, now_time_ms);
+    p_task->start_ms += elapsed_ms - (elapsed_ms % p_task->interval_ms);
+  }
+}
+
+#if (SCHED_TASK_POOL_EN != 0)
+
+/**
+ * @brief Macro for checking if a task was allocated from an arena pool.
+ *
+ * @note: The task pointer is not NULL checked.
+ *
+ * @param[in] p_task  Pointer to the task.
+ *
+ * @retval True if the task's data is stored in a pool's data arena.
+ * @retval False otherwise.
+ */
+#define TASK_ARENA(p_task) \
+  ((task_pool(p_task) != NULL) && (task_pool(p_task)->p_arena_free != NULL))
+
+/**
+ * @brief Internal function for setting the free status of a run of arena
+ * blocks.
+ *
+ * Must be called with exclusive access to the scheduler's data structure.
+ *
+ * @param[in] p_pool  Pointer to the arena pool.
+ * @param[in] first   The index of the first block in the run.
+ * @param[in] cnt     The number of blocks in the run.
+ * @param[in] release True to mark the blocks as free, false to mark them as
+ *                    reserved.
+ */
+static void arena_blocks_mark(sched_task_pool_t *p_pool, uint32_t first,
+                              uint32_t cnt, bool release)
+{
+  assert((first + cnt) <= p_pool->arena_blocks);
+
+  for (uint32_t block = first; block < (first + cnt); block++)
+  {
+    uint32_t mask = 1UL << (block % 32);
+    if (release)
+    {
+      assert((p_pool->p_arena_free[block / 32] & mask) == 0);
+      p_pool->p_arena_free[block / 32] |= mask;
+    }
+    else
+    {
+      p_pool->p_arena_free[block / 32] &= ~mask;
+    }
+  }
+
+  if (release)
+  {
+    p_pool->arena_free_cnt += cnt;
+  }
+  else
+  {
+    p_pool->arena_free_cnt -= cnt;
+  }
+}
+
+/**
+ * @brief Internal function for reserving space from a pool's data arena.
+ *
+ * The first run of consecutive free blocks which is large enough for the
+ * data is reserved.  Fully reserved bitmap words are skipped without
+ * checking each of their blocks.  Must be called with exclusive access to the
+ * scheduler's data structure.
+ *
+ * @param[in] p_pool  Pointer to the arena pool.
+ * @param[in] size    The size of the space to reserve, must be > 0. (bytes)
+ *
+ * @retval Pointer to the reserved space.
+ * @retval NULL if the arena doesn't have enough consecutive free space.
+ */
+static uint8_t *arena_reserve(sched_task_pool_t *p_pool, uint8_t size)
+{
+  assert(size > 0);
+
+  uint32_t cnt = (size + SCHED_TASK_ARENA_BLOCK_SIZE - 1) / SCHED_TASK_ARENA_BLOCK_SIZE;
+  if (cnt > p_pool->arena_free_cnt)
+  {
+    return NULL;
+  }
+
+  // The number of consecutive free blocks found before the current block.
+  uint32_t run = 0;
+  uint32_t block = 0;
+
+  // The unused bits of the last bitmap word are never set.
+  while (block < p_pool->arena_blocks)
+  {
+    uint32_t bitmap = p_pool->p_arena_free[block / 32] >> (block % 32);
+    if (bitmap == 0)
+    {
+      // The remaining blocks of the word are reserved, skip to the next word.
+      run = 0;
+      block = (block - (block % 32)) + 32;
+    }
+    else if ((bitmap & 0x1) == 0)
+    {
+      // Skip to the next free block in the word.
+      run = 0;
+      block += bit_first(bitmap);
+    }
+    else
+    {
+      run++;
+      block++;
+      if (run == cnt)
+      {
+        uint32_t first = block - cnt;
+        arena_blocks_mark(p_pool, first, cnt, false);
+        return &p_pool->p_data[first * SCHED_TASK_ARENA_BLOCK_SIZE];
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Internal function for returning an arena task's data space to its
+ * pool's data arena.
+ *
+ * Tasks without reserved space are unaffected.  Must be called with exclusive
+ * access to the scheduler's data structure.
+ *
+ * @note: The task pointer is not NULL checked.
+ *
+ * @param[in] p_task  Pointer to an arena pool task.
+ */
+static void arena_release(sched_task_t *p_task)
+{
+  assert(TASK_ARENA(p_task));
+
+  if (TASK_BUFF_SIZE(p_task) > 0)
+  {
+    sched_task_pool_t *p_pool = task_pool(p_task);
+    uint32_t first = (uint32_t)(TASK_DATA(p_task) - p_pool->p_data) / SCHED_TASK_ARENA_BLOCK_SIZE;
+    uint32_t cnt = (TASK_BUFF_SIZE(p_task) + SCHED_TASK_ARENA_BLOCK_SIZE - 1) /
+                   SCHED_TASK_ARENA_BLOCK_SIZE;
+    arena_blocks_mark(p_pool, first, cnt, true);
+  }
+
+  TASK_DATA(p_task) = NULL;
+  TASK_BUFF_SIZE(p_task) = 0;
+  TASK_DATA_SIZE(p_task) = 0;
+}
+
+#else
+
+// Tasks can't be allocated from an arena pool when task pools are disabled.
+#define TASK_ARENA(p_task) (false)
+
+#endif // (SCHED_TASK_POOL_EN != 0)
+
+/**
+ * @brief Internal function for returning a stopped task to its task pool.
+ *
+ * Tasks which weren't allocated from a pool are unaffected.  Must be called
+ * with exclusive access to the scheduler's data structure.
+ *
+ * @note: The task pointer is not NULL checked.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+static inline void task_pool_release(sched_task_t *p_task)
+{
+  if (!p_task->allocated)
+  {
+    return;
+  }
+  p_task->allocated = false;
+
+#if (SCHED_TASK_POOL_EN != 0)
+  sched_task_pool_t *p_pool = task_pool(p_task);
+  assert(p_pool != NULL);
+  uint32_t index = (uint32_t)(p_task - p_pool->p_tasks);
+  assert(index < p_pool->task_cnt);
+
+  // Return the task's data space to the pool's arena.
+  if (TASK_ARENA(p_task))
+  {
+    arena_release(p_task);
+  }
+
+  // Mark the task as free in the pool's bitmap.
+  p_pool->p_free[index / 32] |= (1UL << (index % 32));
+  p_pool->free_cnt++;
+#endif
+}
+
+/***** External Scheduler Task Helper Functions *****/
+
+bool sched_task_expired(const sched_task_t *p_task)
+{
+
+  if (TASK_ACTIVE_SAFE(p_task))
+  {
+    return (sched_port_ticks() - p_task->start_ms) >= p_task->interval_ms;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+sched_time_t sched_task_remaining_ms(const sched_task_t *p_task)
+{
+
+  if (TASK_ACTIVE_SAFE(p_task))
+  {
+    sched_time_t elapsed_ms = sched_port_ticks() - p_task->start_ms;
+
+    if (elapsed_ms < p_task->interval_ms)
+    {
+      return p_task->interval_ms - elapsed_ms;
+    }
+    else
+    {
+      // Expired
+      return 0;
+    }
+  }
+  else
+  {
+    return SCHED_MS_MAX;
+  }
+}
+
+sched_time_t sched_task_elapsed_ms(const sched_task_t *p_task)
+{
+
+  if (TASK_ACTIVE_SAFE(p_task))
+  {
+    return sched_port_ticks() - p_task->start_ms;
+  }
+  else
+  {
+    return 0;
+  }
+}
+
+sched_task_t *sched_task_compare(const sched_task_t *p_task_a, const sched_task_t *p_task_b)
 {
 
   if (TASK_ACTIVE_SAFE(p_task_a))
   {
-    if (TASK_ACTIVE_SAFE(p_task_b))
+    if (TASK_ACTIVE_SAFE(p_task_b))
+    {
+      // Both tasks are active, compare the remaining time.
+      if (sched_task_remaining_ms(p_task_a) <= sched_task_remaining_ms(p_task_b))
+      {
+        return (sched_task_t *)p_task_a;
+      }
+      else
+      {
+        return (sched_task_t *)p_task_b;
+      }
+    }
+    else
+    {
+      // Only Task A is active.
+      return (sched_task_t *)p_task_a;
+    }
+  }
+  else if (TASK_ACTIVE_SAFE(p_task_b))
+  {
+    // Only Task B is active
+    return (sched_task_t *)p_task_b;
+  }
+  else
+  {
+    // Neither task is active.
+    return NULL;
+  }
+}
+
+/***** Internal Scheduler Functions *****/
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+
+/**
+ * @brief Function for atomically getting a copy of the updated flag and 
+ * clearing it in one function call.
+ *
+ * After taking exclusive access to the scheduler's data structure, the 
+ * function makes a copy of updated flag, clears the flag, releases exclusive 
+ * access and returns the original flag value.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return  The value of the updated flag before it was cleared.
+ */
+static inline bool sched_updated_get_clear(scheduler_t *p_sched)
+{
+  sched_port_lock();
+  bool updated = p_sched->updated;
+  p_sched->updated = false;
+  sched_port_free();
+  return updated;
+}
+
+#endif // (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+
+/***** Internal Task Que Engine Functions *****/
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+
+/* The heap is ordered by each task's time until expiration calculated
+ * relative to a common time value.  The remaining time calculation is
+ * roll over safe and it is monotonic for all tasks as time advances.  A task
+ * which expires before another at one point in time will still expire before
+ * it at any later point in time, or both will have expired, so the heap
+ * ordering remains valid without the need to periodically reorder the heap.
+ *
+ * All of the heap functions must be called with exclusive access to the
+ * scheduler's data structure.
+ */
+
+/**
+ * @brief Internal function for checking if a task expires before another.
+ *
+ * @param[in] p_task_a      Pointer to the first task.
+ * @param[in] p_task_b      Pointer to the second task.
+ * @param[in] now_time_ms   The current time in mS.
+ * @return True if task A expires before task B else False.
+ */
+static inline bool heap_task_before(const sched_task_t *p_task_a,
+                                    const sched_task_t *p_task_b,
+                                    sched_time_t now_time_ms)
+{
+#if (SCHED_TIME_64_EN != 0)
+  // 64 bit times don't roll over so the expiration times can be compared directly.
+  (void)now_time_ms;
+  return (p_task_a->start_ms + p_task_a->interval_ms) <
+         (p_task_b->start_ms + p_task_b->interval_ms);
+#else
+  return task_time_remaining_ms(p_task_a, now_time_ms) <
+         task_time_remaining_ms(p_task_b, now_time_ms);
+#endif
+}
+
+/**
+ * @brief Internal function for storing a task at a heap index.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @param[in] index   The heap index.
+ */
+static inline void heap_task_place(scheduler_t *p_sched, sched_task_t *p_task, uint32_t index)
+{
+  p_sched->p_heap[index] = p_task;
+  p_task->heap_pos = (uint16_t)(index + 1);
+}
+
+/**
+ * @brief Internal function for moving a task towards the top of the heap
+ * until it no longer expires before its parent.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] index         The heap index of the task.
+ * @param[in] now_time_ms   The current time in mS.
+ */
+static void heap_sift_up(scheduler_t *p_sched, uint32_t index, sched_time_t now_time_ms)
+{
+  assert(index < p_sched->heap_cnt);
+  sched_task_t *p_task = p_sched->p_heap[index];
+
+  while (index > 0)
+  {
+    uint32_t parent = (index - 1) / 2;
+    if (!heap_task_before(p_task, p_sched->p_heap[parent], now_time_ms))
+    {
+      break;
+    }
+    // Move the parent down to make room for the task.
+    heap_task_place(p_sched, p_sched->p_heap[parent], index);
+    index = parent;
+  }
+  heap_task_place(p_sched, p_task, index);
+}
+
+/**
+ * @brief Internal function for moving a task towards the bottom of the heap
+ * until neither of its children expire before it.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] index         The heap index of the task.
+ * @param[in] now_time_ms   The current time in mS.
+ */
+static void heap_sift_down(scheduler_t *p_sched, uint32_t index, sched_time_t now_time_ms)
+{
+  assert(index < p_sched->heap_cnt);
+  sched_task_t *p_task = p_sched->p_heap[index];
+
+  while (true)
+  {
+    uint32_t child = (2 * index) + 1;
+    if (child >= p_sched->heap_cnt)
+    {
+      break;
+    }
+    // Select the child which expires first.
+    if (((child + 1) < p_sched->heap_cnt) &&
+        heap_task_before(p_sched->p_heap[child + 1], p_sched->p_heap[child], now_time_ms))
+    {
+      child++;
+    }
+    if (!heap_task_before(p_sched->p_heap[child], p_task, now_time_ms))
+    {
+      break;
+    }
+    // Move the child up to make room for the task.
+    heap_task_place(p_sched, p_sched->p_heap[child], index);
+    index = child;
+  }
+  heap_task_place(p_sched, p_task, index);
+}
+
+/**
+ * @brief Internal function for checking if a task is stored in the heap.
+ *
+ * The heap entry at the task's position must refer back to the task.
+ * Checking the entry, rather than just the position, prevents a copy of a
+ * task's data structure from being mistaken for the original task.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @return True if the task is stored in the heap else False.
+ */
+static inline bool heap_task_stored(scheduler_t *p_sched, const sched_task_t *p_task)
+{
+  return (p_task->heap_pos != 0) && (p_task->heap_pos <= p_sched->heap_cnt) &&
+         (p_sched->p_heap[p_task->heap_pos - 1] == p_task);
+}
+
+/**
+ * @brief Internal function for calculating the time until the scheduler must
+ * wake up to execute one of the tasks in a heap sub-tree.
+ *
+ * A task which expires no sooner than the wake up time found so far can't
+ * reduce it and neither can its children so they aren't visited.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] index         The heap index of the sub-tree's top task.
+ * @param[in] now_time_ms   The current time in mS.
+ * @param[in] wake_ms       The wake up time found so far in mS.
+ * @return The time until the scheduler must wake up in mS.
+ */
+static sched_time_t heap_wake_ms(scheduler_t *p_sched,
+                                 uint32_t index,
+                                 sched_time_t now_time_ms,
+                                 sched_time_t wake_ms)
+{
+  if ((index < p_sched->heap_cnt) &&
+      (task_time_remaining_ms(p_sched->p_heap[index], now_time_ms) < wake_ms))
+  {
+    wake_ms = SCHED_MIN(wake_ms, task_time_wake_ms(p_sched->p_heap[index], now_time_ms));
+    wake_ms = heap_wake_ms(p_sched, (2 * index) + 1, now_time_ms, wake_ms);
+    wake_ms = heap_wake_ms(p_sched, (2 * index) + 2, now_time_ms, wake_ms);
+  }
+  return wake_ms;
+}
+
+/**
+ * @brief Internal function for adding a task to the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @return True if the task was added.
+ *         False if the task could not be added since the heap was full.
+ */
+static bool que_task_add(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+  assert(!heap_task_stored(p_sched, p_task));
+
+  if (p_sched->heap_cnt >= SCHED_QUE_HEAP_SIZE)
+  {
+    return false;
+  }
+
+  // Add the task to the end of the heap and move it to its position.
+  uint32_t index = p_sched->heap_cnt++;
+  heap_task_place(p_sched, p_task, index);
+  heap_sift_up(p_sched, index, sched_port_ticks());
+  return true;
+}
+
+/**
+ * @brief Internal function for updating a task's position in the que
+ * after its time until expiration has changed.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void que_task_update(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (!heap_task_stored(p_sched, p_task))
+  {
+    // The task isn't stored in the heap.
+    return;
+  }
+
+  sched_time_t now_time_ms = sched_port_ticks();
+  heap_sift_up(p_sched, p_task->heap_pos - 1, now_time_ms);
+  heap_sift_down(p_sched, p_task->heap_pos - 1, now_time_ms);
+}
+
+/**
+ * @brief Internal function for removing a task from the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void que_task_remove(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (!heap_task_stored(p_sched, p_task))
+  {
+    // The task isn't stored in the heap.
+    return;
+  }
+
+  uint32_t index = p_task->heap_pos - 1;
+  p_task->heap_pos = 0;
+  p_sched->heap_cnt--;
+
+  if (index < p_sched->heap_cnt)
+  {
+    // Fill the vacated position with the last task in the heap.
+    sched_time_t now_time_ms = sched_port_ticks();
+    sched_task_t *p_last_task = p_sched->p_heap[p_sched->heap_cnt];
+    heap_task_place(p_sched, p_last_task, index);
+    heap_sift_up(p_sched, index, now_time_ms);
+    heap_sift_down(p_sched, p_last_task->heap_pos - 1, now_time_ms);
+  }
+}
+
+/**
+ * @brief Internal function for removing all tasks from the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static inline void que_reset(scheduler_t *p_sched)
+{
+  p_sched->heap_cnt = 0;
+}
+
+/**
+ * @brief Internal function for marking a task as not stored in any que.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+static inline void que_task_clear(sched_task_t *p_task)
+{
+  p_task->heap_pos = 0;
+}
+
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+
+/* The timing wheel divides the 32 bit mS time range into levels of
+ * SCHED_QUE_WHEEL_BITS each.  A task is stored in the level of the highest
+ * bit which differs between its expiration time and the wheel's time, in the
+ * slot selected by its expiration time's bits for that level.  The task's
+ * slot is always later than the wheel's current slot in the same level.
+ *
+ * As the wheel's time advances to the start of an occupied slot, the slot's
+ * tasks are reinserted and move down to a lower level, or to the ready list
+ * once they have expired.  The wheel's time only stops at occupied slots so
+ * long periods of time can be skipped at once.  Tasks which expire after the
+ * mS time rolls over are stored in the overflow list until the roll over.
+ * With 64 bit time, the levels cover the low 32 bits of the time and the
+ * overflow list stores the tasks which expire after the low 32 bits roll over.
+ *
+ * The slot lists of each level are stored consecutively after the ready list
+ * and followed by the overflow list.  A bitmap for each level tracks which
+ * of its slots are occupied.
+ *
+ * All of the wheel functions must be called with exclusive access to the
+ * scheduler's data structure.
+ */
+
+/**
+ * @brief Internal function for getting the index of a level's slot list.
+ *
+ * @param[in] level   The wheel level.
+ * @param[in] slot    The slot within the level.
+ * @return The list index.
+ */
+static inline uint32_t wheel_list_index(uint32_t level, uint32_t slot)
+{
+  return WHEEL_LIST_SLOTS + (level * WHEEL_SLOTS) + slot;
+}
+
+/**
+ * @brief Internal function for setting or clearing a slot list's bit in
+ * its level's bitmap.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] list      The list index.
+ * @param[in] occupied  Is the list occupied?
+ */
+static inline void wheel_bitmap_set(scheduler_t *p_sched, uint32_t list, bool occupied)
+{
+  if ((list >= WHEEL_LIST_SLOTS) && (list < WHEEL_LIST_OVERFLOW))
+  {
+    uint32_t level = (list - WHEEL_LIST_SLOTS) / WHEEL_SLOTS;
+    uint32_t mask = 1UL << ((list - WHEEL_LIST_SLOTS) % WHEEL_SLOTS);
+
+    if (occupied)
+    {
+      p_sched->wheel_bitmap[level] |= mask;
+    }
+    else
+    {
+      p_sched->wheel_bitmap[level] &= ~mask;
+    }
+  }
+}
+
+/**
+ * @brief Internal function for checking if a task is stored in the wheel.
+ *
+ * The task must be the first task in its list or be referred to by the
+ * previous task.  Checking the list, rather than just the list index,
+ * prevents a copy of a task's data structure from being mistaken for the
+ * original task.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @return True if the task is stored in the wheel else False.
+ */
+static inline bool wheel_task_stored(scheduler_t *p_sched, const sched_task_t *p_task)
+{
+  if (p_task->wheel_list >= WHEEL_LIST_CNT)
+  {
+    return false;
+  }
+
+  const sched_task_t *p_head = p_sched->p_wheel[p_task->wheel_list];
+
+  if (p_head == p_task)
+  {
+    return true;
+  }
+
+  return (p_head != NULL) && (p_task->p_wheel_prev != NULL) &&
+         (p_task->p_wheel_prev->p_wheel_next == p_task);
+}
+
+/**
+ * @brief Internal function for adding a task to the end of a wheel list.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @param[in] list    The list index.
+ */
+static void wheel_list_append(scheduler_t *p_sched, sched_task_t *p_task, uint32_t list)
+{
+  assert(list < WHEEL_LIST_CNT);
+  sched_task_t *p_head = p_sched->p_wheel[list];
+
+  p_task->wheel_list = (uint8_t)list;
+  p_task->p_wheel_next = NULL;
+
+  if (p_head == NULL)
+  {
+    // The task is the only task in the list, it is both the head and tail.
+    p_task->p_wheel_prev = p_task;
+    p_sched->p_wheel[list] = p_task;
+    wheel_bitmap_set(p_sched, list, true);
+  }
+  else
+  {
+    // The head task's previous task is the list's tail.
+    sched_task_t *p_tail = p_head->p_wheel_prev;
+    p_tail->p_wheel_next = p_task;
+    p_task->p_wheel_prev = p_tail;
+    p_head->p_wheel_prev = p_task;
+  }
+}
+
+/**
+ * @brief Internal function for removing a task from its wheel list.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task, must be stored in the wheel.
+ */
+static void wheel_list_remove(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  uint32_t list = p_task->wheel_list;
+  sched_task_t *p_head = p_sched->p_wheel[list];
+  sched_task_t *p_next = p_task->p_wheel_next;
+
+  if (p_task == p_head)
+  {
+    p_sched->p_wheel[list] = p_next;
+
+    if (p_next == NULL)
+    {
+      wheel_bitmap_set(p_sched, list, false);
+    }
+    else
+    {
+      // The new head task stores the list's tail.
+      p_next->p_wheel_prev = p_task->p_wheel_prev;
+    }
+  }
+  else
+  {
+    p_task->p_wheel_prev->p_wheel_next = p_next;
+
+    if (p_next == NULL)
+    {
+      // The task was the list's tail.
+      p_head->p_wheel_prev = p_task->p_wheel_prev;
+    }
+    else
+    {
+      p_next->p_wheel_prev = p_task->p_wheel_prev;
+    }
+  }
+
+  p_task->p_wheel_next = NULL;
+  p_task->p_wheel_prev = NULL;
+}
+
+/**
+ * @brief Internal function for inserting a task into the wheel based on its
+ * time until expiration relative to the wheel's time.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void wheel_task_insert(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  sched_time_t wheel_ms = p_sched->wheel_ms;
+  sched_time_t remaining_ms = task_time_remaining_ms(p_task, wheel_ms);
+  uint64_t expire_ms = (uint64_t)wheel_ms + remaining_ms;
+  uint32_t list;
+
+  if (remaining_ms == 0)
+  {
+    list = WHEEL_LIST_READY;
+  }
+  else if ((expire_ms >> 32) != ((uint64_t)wheel_ms >> 32))
+  {
+    // The task expires after the low 32 bits of the time roll over.
+    list = WHEEL_LIST_OVERFLOW;
+  }
+  else
+  {
+    uint32_t level = bit_last((uint32_t)(expire_ms ^ wheel_ms)) / SCHED_QUE_WHEEL_BITS;
+    uint32_t slot = ((uint32_t)expire_ms >> (level * SCHED_QUE_WHEEL_BITS)) & (WHEEL_SLOTS - 1);
+    list = wheel_list_index(level, slot);
+  }
+
+  wheel_list_append(p_sched, p_task, list);
+}
+
+/**
+ * @brief Internal function for finding the wheel list with the next
+ * expiring tasks, excluding the ready list.
+ *
+ * Every task stored in a lower level expires before all of the tasks stored
+ * in the higher levels and the overflow list.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return The list index or WHEEL_LIST_CNT if the wheel is empty.
+ */
+static uint32_t wheel_list_next(scheduler_t *p_sched)
+{
+  for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+  {
+    uint32_t bitmap = p_sched->wheel_bitmap[level];
+
+    if (bitmap != 0)
+    {
+      return wheel_list_index(level, bit_first(bitmap));
+    }
+  }
+
+  if (p_sched->p_wheel[WHEEL_LIST_OVERFLOW] != NULL)
+  {
+    return WHEEL_LIST_OVERFLOW;
+  }
+
+  return WHEEL_LIST_CNT;
+}
+
+/**
+ * @brief Internal function for calculating the time from the wheel's time
+ * until the start of a list's slot.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] list  The list index of a slot or the overflow list.
+ * @return The time until the start of the slot in mS.
+ */
+static uint64_t wheel_list_wait_ms(scheduler_t *p_sched, uint32_t list)
+{
+  // The wheel's slots cover the low 32 bits of the time.
+  uint64_t wheel_ms = (uint32_t)p_sched->wheel_ms;
+
+  if (list == WHEEL_LIST_OVERFLOW)
+  {
+    // The overflow list's slot starts when the low 32 bits roll over.
+    return (1ULL << 32) - wheel_ms;
+  }
+
+  uint32_t level = (list - WHEEL_LIST_SLOTS) / WHEEL_SLOTS;
+  uint32_t slot = (list - WHEEL_LIST_SLOTS) % WHEEL_SLOTS;
+  uint32_t shift = level * SCHED_QUE_WHEEL_BITS;
+
+  // The slot starts within the wheel time's block of the next higher level.
+  uint64_t block_ms = (wheel_ms >> (shift + SCHED_QUE_WHEEL_BITS)) << (shift + SCHED_QUE_WHEEL_BITS);
+  uint64_t slot_ms = block_ms + ((uint64_t)slot << shift);
+  return slot_ms - wheel_ms;
+}
+
+/**
+ * @brief Internal function for advancing the wheel's time.
+ *
+ * The tasks stored in each slot reached along the way are reinserted into
+ * the wheel.  Expired tasks are moved to the ready list.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] now_time_ms  The current time in mS.
+ */
+static void wheel_advance(scheduler_t *p_sched, sched_time_t now_time_ms)
+{
+  sched_time_t advance_ms = now_time_ms - p_sched->wheel_ms;
+
+  while (advance_ms > 0)
+  {
+    uint32_t list = wheel_list_next(p_sched);
+
+    if (list == WHEEL_LIST_CNT)
+    {
+      // The wheel is empty.
+      break;
+    }
+
+    uint64_t wait_ms = wheel_list_wait_ms(p_sched, list);
+
+    if (wait_ms > advance_ms)
+    {
+      // No slots are reached before the current time.
+      break;
+    }
+
+    p_sched->wheel_ms += wait_ms;
+    advance_ms -= wait_ms;
+
+    // Detach the slot's tasks from the slot and reinsert them.
+    sched_task_t *p_task = p_sched->p_wheel[list];
+    p_sched->p_wheel[list] = NULL;
+    wheel_bitmap_set(p_sched, list, false);
+
+    while (p_task != NULL)
+    {
+      sched_task_t *p_next = p_task->p_wheel_next;
+      wheel_task_insert(p_sched, p_task);
+      p_task = p_next;
+    }
+  }
+
+  p_sched->wheel_ms += advance_ms;
+}
+
+/**
+ * @brief Internal function for calculating the time until the scheduler must
+ * wake up to execute one of the tasks stored in a list.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] list          The list index.
+ * @param[in] now_time_ms   The current time in mS.
+ * @param[in] wake_ms       The wake up time found so far in mS.
+ * @return The time until the scheduler must wake up in mS.
+ */
+static sched_time_t wheel_list_wake_ms(scheduler_t *p_sched,
+                                       uint32_t list,
+                                       sched_time_t now_time_ms,
+                                       sched_time_t wake_ms)
+{
+  for (sched_task_t *p_task = p_sched->p_wheel[list]; p_task != NULL;
+       p_task = p_task->p_wheel_next)
+  {
+    wake_ms = SCHED_MIN(wake_ms, task_time_wake_ms(p_task, now_time_ms));
+  }
+  return wake_ms;
+}
+
+/**
+ * @brief Internal function for calculating the time until the scheduler must
+ * wake up to execute one of the tasks stored in the wheel.
+ *
+ * The occupied lists are visited in order of expiration.  The tasks in a list
+ * whose slot starts no sooner than the wake up time found so far can't reduce
+ * it and neither can the tasks in any of the later lists.
+ *
+ * @note The wheel must have been advanced to the current time.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] now_time_ms  The current time in mS.
+ * @return The time until the scheduler must wake up in mS, 0 if a task is
+ *         ready or SCHED_MS_MAX if the wheel is empty.
+ */
+static sched_time_t wheel_wake_ms(scheduler_t *p_sched, sched_time_t now_time_ms)
+{
+  if (p_sched->p_wheel[WHEEL_LIST_READY] != NULL)
+  {
+    return 0;
+  }
+
+  sched_time_t wake_ms = SCHED_MS_MAX;
+
+  for (uint32_t level = 0; level < WHEEL_LEVELS; level++)
+  {
+    uint32_t bitmap = p_sched->wheel_bitmap[level];
+
+    while (bitmap != 0)
+    {
+      uint32_t list = wheel_list_index(level, bit_first(bitmap));
+
+      if (wheel_list_wait_ms(p_sched, list) >= wake_ms)
+      {
+        return wake_ms;
+      }
+      wake_ms = wheel_list_wake_ms(p_sched, list, now_time_ms, wake_ms);
+
+      // Clear the lowest occupied slot's bit.
+      bitmap &= bitmap - 1;
+    }
+  }
+
+  if ((p_sched->p_wheel[WHEEL_LIST_OVERFLOW] != NULL) &&
+      (wheel_list_wait_ms(p_sched, WHEEL_LIST_OVERFLOW) < wake_ms))
+  {
+    wake_ms = wheel_list_wake_ms(p_sched, WHEEL_LIST_OVERFLOW, now_time_ms, wake_ms);
+  }
+
+  return wake_ms;
+}
+
+/**
+ * @brief Internal function for adding a task to the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @return Always true since the wheel can store any number of tasks.
+ */
+static bool que_task_add(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+  assert(!wheel_task_stored(p_sched, p_task));
+
+  // Advance the wheel so the task is inserted relative to the current time.
+  wheel_advance(p_sched, sched_port_ticks());
+  wheel_task_insert(p_sched, p_task);
+  return true;
+}
+
+/**
+ * @brief Internal function for updating a task's position in the que
+ * after its time until expiration has changed.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void que_task_update(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (!wheel_task_stored(p_sched, p_task))
+  {
+    // The task isn't stored in the wheel.
+    return;
+  }
+
+  wheel_list_remove(p_sched, p_task);
+  wheel_advance(p_sched, sched_port_ticks());
+  wheel_task_insert(p_sched, p_task);
+}
+
+/**
+ * @brief Internal function for removing a task from the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void que_task_remove(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (wheel_task_stored(p_sched, p_task))
+  {
+    wheel_list_remove(p_sched, p_task);
+  }
+}
+
+/**
+ * @brief Internal function for removing all tasks from the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static void que_reset(scheduler_t *p_sched)
+{
+  memset(p_sched->p_wheel, 0, sizeof(p_sched->p_wheel));
+  memset(p_sched->wheel_bitmap, 0, sizeof(p_sched->wheel_bitmap));
+}
+
+/**
+ * @brief Internal function for marking a task as not stored in any que.
+ *
+ * A task without a previous task is only stored in the wheel if it is the
+ * first task in its list.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+static inline void que_task_clear(sched_task_t *p_task)
+{
+  p_task->p_wheel_next = NULL;
+  p_task->p_wheel_prev = NULL;
+}
+
+#elif (SCHED_QUE_CACHE_EN != 0)
+
+/* The task cache stores the soonest expiring active tasks ordered by their
+ * time until expiration.  Every active task which isn't stored in the cache
+ * expires no sooner than the last cached task.  The cache is fixed up as
+ * tasks are started, updated and stopped so the next expiring task is
+ * always the first cached task.  The task que only needs to be searched to
+ * refill the cache once every cached task has been removed or if the cache
+ * was invalidated by a task update while it was being refilled.
+ *
+ * All of the cache functions must be called with exclusive access to the
+ * scheduler's data structure.
+ */
+
+/**
+ * @brief Internal function for invalidating the task cache.
+ *
+ * The updated flag is set so a cache refill in progress will be repeated.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static inline void cache_invalidate(scheduler_t *p_sched)
+{
+  p_sched->cache_valid = false;
+  p_sched->updated = true;
+}
+
+/**
+ * @brief Internal function for removing a task from the cache.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void cache_task_remove(scheduler_t *p_sched, const sched_task_t *p_task)
+{
+  uint32_t index = 0;
+
+  while ((index < p_sched->cache_cnt) && (p_sched->p_cache[index] != p_task))
+  {
+    index++;
+  }
+
+  if (index == p_sched->cache_cnt)
+  {
+    // The task isn't stored in the cache.
+    return;
+  }
+
+  // Move the later expiring tasks forward to fill the vacated position.
+  p_sched->cache_cnt--;
+  memmove(&p_sched->p_cache[index], &p_sched->p_cache[index + 1],
+          (p_sched->cache_cnt - index) * sizeof(sched_task_t *));
+
+  if ((p_sched->cache_cnt == 0) && !p_sched->cache_all)
+  {
+    // The next expiring task is unknown once the cache is empty.
+    cache_invalidate(p_sched);
+  }
+}
+
+/**
+ * @brief Internal function for adding a task to the cache if it expires no
+ * later than the last cached task.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task, must not be stored in the cache.
+ */
+static void cache_task_insert(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  sched_time_t now_time_ms = sched_port_ticks();
+  sched_time_t task_ms = task_time_remaining_ms(p_task, now_time_ms);
+  uint32_t cnt = p_sched->cache_cnt;
+
+  if ((cnt > 0) && (task_ms > task_time_remaining_ms(p_sched->p_cache[cnt - 1], now_time_ms)))
+  {
+    if (p_sched->cache_all && (cnt < SCHED_TASK_CACHE_SIZE))
+    {
+      // Every task is cached and there is room to add the task at the end.
+      p_sched->p_cache[p_sched->cache_cnt++] = p_task;
+    }
+    else
+    {
+      // The task expires after the last cached task so it isn't cached.
+      p_sched->cache_all = false;
+    }
+    return;
+  }
+
+  if (cnt == 0)
+  {
+    // An empty cache is only valid if every task is cached.
+    assert(p_sched->cache_all);
+  }
+
+  if (cnt == SCHED_TASK_CACHE_SIZE)
+  {
+    // The last cached task is dropped to make room for the task.
+    cnt--;
+    p_sched->cache_all = false;
+  }
+
+  // Find the task's position in order of expiration.
+  uint32_t index = 0;
+  while ((index < cnt) && (task_time_remaining_ms(p_sched->p_cache[index], now_time_ms) <= task_ms))
+  {
+    index++;
+  }
+
+  // Move the later expiring tasks back to make room for the task.
+  memmove(&p_sched->p_cache[index + 1], &p_sched->p_cache[index],
+          (cnt - index) * sizeof(sched_task_t *));
+  p_sched->p_cache[index] = p_task;
+  p_sched->cache_cnt = (uint8_t)(cnt + 1);
+}
+
+/**
+ * @brief Internal function for calculating the time until the scheduler must
+ * wake up to execute one of the cached tasks.
+ *
+ * The tasks which aren't cached expire no sooner than the last cached task so
+ * none of them can be delayed beyond its expiration.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] now_time_ms   The current time in mS.
+ * @return The time until the scheduler must wake up in mS, or SCHED_MS_MAX
+ *         if the cache is empty.
+ */
+static sched_time_t cache_wake_ms(scheduler_t *p_sched, sched_time_t now_time_ms)
+{
+  uint32_t cnt = p_sched->cache_cnt;
+
+  if (cnt == 0)
+  {
+    return SCHED_MS_MAX;
+  }
+
+#if (SCHED_TASK_SLACK_EN != 0)
+  sched_time_t wake_ms = SCHED_MS_MAX;
+
+  if (!p_sched->cache_all)
+  {
+    wake_ms = task_time_remaining_ms(p_sched->p_cache[cnt - 1], now_time_ms);
+  }
+
+  for (uint32_t index = 0; index < cnt; index++)
+  {
+    wake_ms = SCHED_MIN(wake_ms, task_time_wake_ms(p_sched->p_cache[index], now_time_ms));
+  }
+
+  return wake_ms;
+#else
+  return task_time_remaining_ms(p_sched->p_cache[0], now_time_ms);
+#endif
+}
+
+/**
+ * @brief Internal function for refilling the cache by searching the que for
+ * the soonest expiring active tasks.
+ *
+ * The search is performed without exclusive access to the que.  It is
+ * repeated if the cache was invalidated by a task update during the search.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static void cache_refill(scheduler_t *p_sched)
+{
+  bool updated;
+
+  do
+  {
+    sched_task_t *p_tasks[SCHED_TASK_CACHE_SIZE];
+    sched_time_t tasks_ms[SCHED_TASK_CACHE_SIZE];
+    uint32_t cnt = 0;
+    bool all = true;
+
+    // Clear the updated flag to detect any updates during the search.
+    sched_updated_get_clear(p_sched);
+
+    // A single time value is used so the tasks are ordered consistently.
+    sched_time_t now_time_ms = sched_port_ticks();
+
+    for (sched_task_t *p_search_task = (sched_task_t *)p_sched->p_head;
+         p_search_task != NULL; p_search_task = task_next(p_search_task))
+    {
+      // Filter on active tasks.
+      if (!task_list_active(p_sched, p_search_task))
+      {
+        continue;
+      }
+
+      sched_time_t search_task_ms = task_time_remaining_ms(p_search_task, now_time_ms);
+      uint32_t index = cnt;
+
+      if (cnt == SCHED_TASK_CACHE_SIZE)
+      {
+        all = false;
+        if (search_task_ms >= tasks_ms[cnt - 1])
+        {
+          // The task expires after all of the found tasks.
+          continue;
+        }
+        // The last found task is dropped to make room for the task.
+        index--;
+      }
+      else
+      {
+        cnt++;
+      }
+
+      // Insert the task in order of expiration.
+      while ((index > 0) && (search_task_ms < tasks_ms[index - 1]))
+      {
+        p_tasks[index] = p_tasks[index - 1];
+        tasks_ms[index] = tasks_ms[index - 1];
+        index--;
+      }
+      p_tasks[index] = p_search_task;
+      tasks_ms[index] = search_task_ms;
+    }
+
+    sched_port_lock();
+
+    // Only store the found tasks if no tasks were updated during the search.
+    updated = p_sched->updated;
+    if (!updated)
+    {
+      memcpy(p_sched->p_cache, p_tasks, cnt * sizeof(sched_task_t *));
+      p_sched->cache_cnt = (uint8_t)cnt;
+      p_sched->cache_all = all;
+      p_sched->cache_valid = true;
+    }
+
+    sched_port_free();
+
+  } while (updated);
+}
+
+/**
+ * @brief Internal function for adding a task to the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ * @return Always true.
+ */
+static bool que_task_add(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (!p_sched->cache_valid)
+  {
+    p_sched->updated = true;
+    return true;
+  }
+
+  cache_task_insert(p_sched, p_task);
+  return true;
+}
+
+/**
+ * @brief Internal function for updating a task's position in the que
+ * after its time until expiration or its state has changed.
+ *
+ * Only active tasks are cached.  An executing task is added back to the cache
+ * when its handler returns.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void que_task_update(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (!p_sched->cache_valid)
+  {
+    p_sched->updated = true;
+    return;
+  }
+
+  cache_task_remove(p_sched, p_task);
+
+  if (p_sched->cache_valid && (p_task->state == SCHED_TASK_ACTIVE))
+  {
+    cache_task_insert(p_sched, p_task);
+  }
+}
+
+/**
+ * @brief Internal function for removing a task from the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void que_task_remove(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (!p_sched->cache_valid)
+  {
+    p_sched->updated = true;
+    return;
+  }
+
+  cache_task_remove(p_sched, p_task);
+}
+
+/**
+ * @brief Internal function for removing all tasks from the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static inline void que_reset(scheduler_t *p_sched)
+{
+  p_sched->cache_cnt = 0;
+  p_sched->cache_valid = false;
+}
+
+/**
+ * @brief Internal function for marking a task as not stored in any que.
+ *
+ * The cached tasks are cleared by que_reset() so tasks don't store their
+ * place in the cache.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+static inline void que_task_clear(sched_task_t *p_task)
+{
+  // Empty
+}
+
+#else
+
+// The linked list que engine doesn't maintain a task index.
+static inline bool que_task_add(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  return true;
+}
+
+static inline void que_task_update(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  // Empty
+}
+
+static inline void que_task_remove(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  // Empty
+}
+
+static inline void que_reset(scheduler_t *p_sched)
+{
+  // Empty
+}
+
+static inline void que_task_clear(sched_task_t *p_task)
+{
+  // Empty
+}
+
+#endif // (SCHED_QUE_ENGINE)
+
+/**
+ * @brief Internal function for adding a task to the end of an instance's
+ * task list.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task   Pointer to the task.
+ */
+static void task_list_append(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  // The new task will be the last one in the list.
+  task_next_set(p_task, NULL);
+  p_task->listed = true;
+
+  if (p_sched->p_head == NULL)
+  {
+    /* No other tasks exists in the list, the new task will be both the
+     * head & tail task.
+     */
+    p_sched->p_head = p_task;
+  }
+  else
+  {
+    /* The head task has already been set so this task will be the next task
+     * for the current tail task.
+     */
+    assert(p_sched->p_tail != NULL);
+    task_next_set((sched_task_t *)p_sched->p_tail, p_task);
+  }
+  // Set the new task to the tail task so it is added to the end of the list.
+  p_sched->p_tail = p_task;
+}
+
+/**
+ * @brief Internal function for unlinking a task from an instance's task list
+ * given the task before it.
+ *
+ * The unlinked task's next task is left unchanged so a list search made
+ * without exclusive access which is currently at the task can continue.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched      Pointer to the scheduler instance.
+ * @param[in] p_prev_task  Pointer to the previous task, NULL for the head task.
+ * @param[in] p_task       Pointer to the task, must be stored in the list.
+ */
+static void task_list_unlink(scheduler_t *p_sched, sched_task_t *p_prev_task,
+                             sched_task_t *p_task)
+{
+  if (p_prev_task == NULL)
+  {
+    p_sched->p_head = task_next(p_task);
+  }
+  else
+  {
+    task_next_set(p_prev_task, task_next(p_task));
+  }
+
+  if (p_sched->p_tail == p_task)
+  {
+    p_sched->p_tail = p_prev_task;
+  }
+
+  p_task->listed = false;
+}
+
+/**
+ * @brief Internal function for unlinking the stopped tasks from an instance's
+ * task list.
+ *
+ * Tasks are only marked for removal when they are stopped since a singly
+ * linked list must be searched to unlink a task.  The instance's loop calls
+ * the function between que searches, so no search of the instance's own list
+ * is in progress, and the list is only walked if a task was stopped since
+ * the last call.  Tasks are linked again when they are started.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static void task_list_prune(scheduler_t *p_sched)
+{
+  if (!p_sched->prune)
+  {
+    return;
+  }
+
+  /* Take exclusive access for the walk since tasks can be appended or moved
+   * to another instance from a different context.
+   */
+  sched_port_lock();
+
+  TRACE_SLEEP(p_sched);
+  p_sched->prune = false;
+
+  sched_task_t *p_prev_task = NULL;
+  sched_task_t *p_task = p_sched->p_head;
+
+  while (p_task != NULL)
+  {
+    sched_task_t *p_next_task = task_next(p_task);
+
+    if (p_task->state == SCHED_TASK_STOPPED)
+    {
+      task_list_unlink(p_sched, p_prev_task, p_task);
+    }
+    else
+    {
+      p_prev_task = p_task;
+    }
+    p_task = p_next_task;
+  }
+
+  sched_port_free();
+}
+
+/**
+ * @brief Internal function for marking a stopped task for removal from its
+ * instance's task list.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task  Pointer to the task.
+ */
+static inline void task_list_prune_mark(const sched_task_t *p_task)
+{
+  if (p_task->listed)
+  {
+    task_sched(p_task)->prune = true;
+  }
+}
+
+/**
+ * @brief Internal function for counting a task which has started in its
+ * instance's sleep mode counts.
+ *
+ * Tasks which allow any sleep mode don't limit the sleep and aren't counted.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched  Pointer to the task's scheduler instance.
+ * @param[in] p_task   Pointer to the task.
+ */
+static inline void power_task_add(scheduler_t *p_sched, const sched_task_t *p_task)
+{
+#if (SCHED_TASK_POWER_EN != 0)
+  if (p_task->sleep_mode < SCHED_SLEEP_MODE_CNT)
+  {
+    p_sched->sleep_cnt[p_task->sleep_mode]++;
+  }
+#else
+  (void)p_sched;
+  (void)p_task;
+#endif
+}
+
+/**
+ * @brief Internal function for removing a task which has stopped from its
+ * instance's sleep mode counts.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched  Pointer to the task's scheduler instance.
+ * @param[in] p_task   Pointer to the task.
+ */
+static inline void power_task_remove(scheduler_t *p_sched, const sched_task_t *p_task)
+{
+#if (SCHED_TASK_POWER_EN != 0)
+  if (p_task->sleep_mode < SCHED_SLEEP_MODE_CNT)
+  {
+    assert(p_sched->sleep_cnt[p_task->sleep_mode] > 0);
+    p_sched->sleep_cnt[p_task->sleep_mode]--;
+  }
+#else
+  (void)p_sched;
+  (void)p_task;
+#endif
+}
+
+#if (SCHED_INSTANCE_CNT > 1)
+
+/**
+ * @brief Internal function for removing a task from an instance's task list.
+ *
+ * The list is searched for the previous task since the list is singly linked.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_task   Pointer to the task, must be stored in the list.
+ */
+static void task_list_remove(scheduler_t *p_sched, sched_task_t *p_task)
+{
+  sched_task_t *p_prev_task = NULL;
+  sched_task_t *p_current_task = p_sched->p_head;
+
+  while (p_current_task != p_task)
+  {
+    assert(p_current_task != NULL);
+    p_prev_task = p_current_task;
+    p_current_task = task_next(p_current_task);
+  }
+
+  task_list_unlink(p_sched, p_prev_task, p_task);
+}
+
+/**
+ * @brief Internal function for moving a stopped, waiting or active task to a
+ * different scheduler instance.
+ *
+ * An active task is moved from the que of its current instance to the que
+ * of the new instance.  A search of the current instance's task list in
+ * progress is repeated since the task's next task pointer changes.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[in] instance  The new instance.
+ * @return True if the task was moved.
+ *         False if the task could not be added to the new instance's que.
+ */
+static bool task_move(sched_task_t *p_task, sched_instance_t instance)
+{
+  assert((p_task->state == SCHED_TASK_STOPPED) || (p_task->state == SCHED_TASK_ACTIVE) ||
+         (p_task->state == SCHED_TASK_WAITING));
+  assert(instance < SCHED_INSTANCE_CNT);
+
+  scheduler_t *p_from = task_sched(p_task);
+  scheduler_t *p_to = &sched_instances[instance];
+
+  if (p_from == p_to)
+  {
+    return true;
+  }
+
+  sched_instance_t from_instance = p_task->instance;
+  bool queued = (p_task->state == SCHED_TASK_ACTIVE);
+
+  bool listed = p_task->listed;
+
+  if (queued)
+  {
+    que_task_remove(p_from, p_task);
+  }
+  if (listed)
+  {
+    task_list_remove(p_from, p_task);
+    task_list_append(p_to, p_task);
+    if (p_task->state == SCHED_TASK_STOPPED)
+    {
+      // The new instance unlinks the stopped task.
+      p_to->prune = true;
+    }
+  }
+  p_task->instance = instance;
+
+#if (SCHED_TASK_BATCH_EN != 0)
+  // A moved task isn't executed by its previous instance's batch.
+  p_task->dispatch = false;
+#endif
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+  p_from->updated = true;
+#endif
+
+  if (queued)
+  {
+    if (!que_task_add(p_to, p_task))
+    {
+      // Return the task to its previous instance whose que has room for it.
+      if (listed)
+      {
+        task_list_remove(p_to, p_task);
+        task_list_append(p_from, p_task);
+      }
+      p_task->instance = from_instance;
+      bool added = que_task_add(p_from, p_task);
+      assert(added);
+      (void)added;
+      return false;
+    }
+
+    // The task might expire before the new instance's sleep deadline.
+    que_updated_set(p_to);
+  }
+
+  // An active or waiting task limits the new instance's sleep.
+  if (p_task->state != SCHED_TASK_STOPPED)
+  {
+    power_task_remove(p_from, p_task);
+    power_task_add(p_to, p_task);
+  }
+
+  return true;
+}
+
+#endif // (SCHED_INSTANCE_CNT > 1)
+
+/**
+ * @brief Internal function for starting a task.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return True if the task was started else False.
+ */
+static bool task_start(sched_task_t *p_task)
+{
+  assert(p_task != NULL);
+
+  if (p_task->state == SCHED_TASK_UNINIT)
+  {
+    // A task must be configured before it can be started.
+    return false;
+  }
+
+  scheduler_t *p_sched = task_sched(p_task);
+
+  if (p_sched->state != SCHED_STATE_ACTIVE)
+  {
+    /* Tasks keep their configuration once the scheduler stops, but can't be
+     * started until it is initialized again since the task list is cleared.
+     */
+    return false;
+  }
+
+  // Store the start time as now.
+  p_task->start_ms = sched_port_ticks();
+
+#if (SCHED_TASK_BATCH_EN != 0)
+  // A restarted task is no longer expired so it isn't executed by a batch.
+  p_task->dispatch = false;
+#endif
+
+  if (p_task->state == SCHED_TASK_STOPPED)
+  {
+    // Stopped tasks are added to the que when they are started.
+    if (!que_task_add(p_sched, p_task))
+    {
+      return false;
+    }
+
+    // A stopped task which has been unlinked from the task list is linked again.
+    if (!p_task->listed)
+    {
+      task_list_append(p_sched, p_task);
+    }
+
+    // The started task limits the instance's sleep.
+    power_task_add(p_sched, p_task);
+  }
+  else
+  {
+    // Update the task's position in the que since the start time changed.
+    que_task_update(p_sched, p_task);
+  }
+
+  if ((p_task->state == SCHED_TASK_STOPPED) || (p_task->state == SCHED_TASK_ACTIVE))
+  {
+    // Set the task to active if it is currently stopped.
+    p_task->state = SCHED_TASK_ACTIVE;
+
+    // The task might expire before the scheduler's sleep deadline.
+    que_updated_set(p_sched);
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST) && (SCHED_QUE_CACHE_EN == 0)
+    /* Set the updated flag to indicate that the newly started or restarted
+     * task might have invalidated the next expiring task found by a search.
+     */
+    p_sched->updated = true;
+#endif
+  }
+  else if (p_task->state == SCHED_TASK_STOPPING)
+  {
+    /* Set the task to executing if it is currently stopping. This could happen
+     * if the task is started inside an ISR while executing its handler or
+     * more commonly if a non-repeating task restarts itself inside its
+     * own handler.  Don't set the updated flag in the case since the cached
+     * next expiring task will be updated on handler return if needed.
+     */
+    p_task->state = SCHED_TASK_EXECUTING;
+  }
+
+  TRACE(p_sched, SCHED_TRACE_TASK_START, p_task, p_task->start_ms);
+
+  return true;
+}
+
+/***** Internal Event Functions *****/
+
+#if (SCHED_EVENT_EN != 0)
+
+/**
+ * @brief Internal function for adding a task to the end of its event's wait
+ * list.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task  Pointer to the task, it must be bound to an event.
+ */
+static void event_wait_append(sched_task_t *p_task)
+{
+  sched_event_t *p_event = p_task->p_event;
+  assert(p_event != NULL);
+
+  // Signals start the waiting tasks in the order they started waiting.
+  sched_task_t **pp_link = &p_event->p_wait;
+  while (*pp_link != NULL)
+  {
+    pp_link = &(*pp_link)->p_wait_next;
+  }
+  p_task->p_wait_next = NULL;
+  *pp_link = p_task;
+
+  // A stopped task which starts waiting limits the instance's sleep.
+  if (p_task->state == SCHED_TASK_STOPPED)
+  {
+    power_task_add(task_sched(p_task), p_task);
+  }
+
+  p_task->state = SCHED_TASK_WAITING;
+}
+
+/**
+ * @brief Internal function for removing a waiting task from its event's wait
+ * list.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task  Pointer to the task, it must be waiting.
+ */
+static void event_wait_remove(sched_task_t *p_task)
+{
+  sched_event_t *p_event = p_task->p_event;
+  assert((p_event != NULL) && (p_task->state == SCHED_TASK_WAITING));
+
+  sched_task_t **pp_link = &p_event->p_wait;
+  while (*pp_link != p_task)
+  {
+    assert(*pp_link != NULL);
+    pp_link = &(*pp_link)->p_wait_next;
+  }
+  *pp_link = p_task->p_wait_next;
+  p_task->p_wait_next = NULL;
+
+  p_task->state = SCHED_TASK_STOPPED;
+  power_task_remove(task_sched(p_task), p_task);
+  task_list_prune_mark(p_task);
+}
+
+/**
+ * @brief Internal function for taking a pending signal from an event.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_event  Pointer to the event.
+ * @return True if a pending signal was taken else False.
+ */
+static inline bool event_take(sched_event_t *p_event)
+{
+  if (p_event->count == 0)
+  {
+    return false;
+  }
+  p_event->count--;
+  return true;
+}
+
+#endif // (SCHED_EVENT_EN != 0)
+
+/**
+ * @brief Internal function for starting a task from the task functions.
+ *
+ * A stopped task which is bound to an event takes a pending signal from the
+ * event and is started, otherwise it waits for the event.  A waiting task
+ * keeps waiting.  Any other task is started or restarted as usual.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return True if the task was started or is waiting else False.
+ */
+static bool task_start_event(sched_task_t *p_task)
+{
+#if (SCHED_EVENT_EN != 0)
+  if (p_task->state == SCHED_TASK_WAITING)
+  {
+    return true;
+  }
+
+  if ((p_task->state == SCHED_TASK_STOPPED) && (p_task->p_event != NULL))
+  {
+    if (!event_take(p_task->p_event))
+    {
+      // The waiting task costs no que search time until it is signaled.
+      event_wait_append(p_task);
+      return true;
+    }
+
+    if (!task_start(p_task))
+    {
+      // Return the signal to the event if the que is full.
+      p_task->p_event->count++;
+      return false;
+    }
+    return true;
+  }
+#endif
+
+  return task_start(p_task);
+}
+
+/**
+ * @brief Internal function for removing all tasks from the scheduler's que.
+ *
+ * Every task in the task list is stopped and unlinked.  The tasks keep their
+ * configuration.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static void sched_clear_que(scheduler_t *p_sched)
+{
+
+  // Get exclusive que access.
+  sched_port_lock();
+
+  // Write out a sleep which ended with the stop.
+  TRACE_SLEEP(p_sched);
+
+  // Walk through the task list starting at the head.
+  sched_task_t *p_current_task = (sched_task_t *)p_sched->p_head;
+
+  while (p_current_task != NULL)
+  {
+#if (SCHED_EVENT_EN != 0)
+    // Waiting tasks leave their event's wait list.
+    if (p_current_task->state == SCHED_TASK_WAITING)
+    {
+      event_wait_remove(p_current_task);
+    }
+#endif
+
+    /* Stop and unlink each task.  The que is reset below so the task must
+     * also forget its place in the que.
+     */
+    p_current_task->state = SCHED_TASK_STOPPED;
+    p_current_task->listed = false;
+    que_task_clear(p_current_task);
+
+    // Move to the next task in the linked list
+    p_current_task = task_next(p_current_task);
+  }
+
+  // Clear the task references.
+  p_sched->p_head = NULL;
+  p_sched->p_tail = NULL;
+  p_sched->prune = false;
+  que_reset(p_sched);
+#if (SCHED_TASK_POWER_EN != 0)
+  // None of the instance's tasks are started.
+  memset(p_sched->sleep_cnt, 0x00, sizeof(p_sched->sleep_cnt));
+#endif
+
+  // Release the que lock.
+  sched_port_free();
+}
+
+/**
+ * @brief Internal function for checking if any scheduler instance is running.
+ *
+ * @return True if any instance is active or stopping else False.
+ */
+static bool sched_instances_running(void)
+{
+  for (uint32_t instance = 0; instance < SCHED_INSTANCE_CNT; instance++)
+  {
+    if (sched_instances[instance].state != SCHED_STATE_STOPPED)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Internal function for completing a scheduler stop.
+ *
+ * The function is called once the scheduler finishes executing all expired 
+ * task's handlers to complete a scheduler stop.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ */
+static void sched_stop_finalize(scheduler_t *p_sched)
+{
+  if (p_sched->state == SCHED_STATE_STOPPING)
+  {
+    // Clear the que.
+    sched_clear_que(p_sched);
+
+    sched_port_lock();
+    p_sched->state = SCHED_STATE_STOPPED;
+    bool last = !sched_instances_running();
+    sched_port_free();
+
+    // Perform any platform-specific deinitialization last, once for all instances.
+    if (last)
+    {
+      sched_port_deinit();
+    }
+  }
+}
+
+#if (SCHED_STATS_EN != 0)
+
+/**
+ * @brief Internal function for updating a task's runtime statistics after a
+ * handler call.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[in] late_ms   The handler call's lateness. (ticks)
+ * @param[in] exec_ms   The handler's execution time. (ticks)
+ */
+static void task_stats_update(sched_task_t *p_task, sched_time_t late_ms, sched_time_t exec_ms)
+{
+  sched_task_stats_data_t *p_stats = &p_task->stats;
+
+  if (p_stats->call_cnt == 0)
+  {
+    p_stats->late_min_ms = late_ms;
+  }
+  else
+  {
+    p_stats->late_min_ms = SCHED_MIN(p_stats->late_min_ms, late_ms);
+  }
+  p_stats->late_max_ms = SCHED_MAX(p_stats->late_max_ms, late_ms);
+  p_stats->exec_max_ms = SCHED_MAX(p_stats->exec_max_ms, exec_ms);
+  p_stats->late_total_ms += late_ms;
+  p_stats->exec_total_ms += exec_ms;
+  p_stats->call_cnt++;
+
+  // A repeating task has expired again if its handler ran for its interval.
+  if (p_task->repeat && (exec_ms >= p_task->interval_ms))
+  {
+    p_stats->overrun_cnt++;
+  }
+}
+
+/**
+ * @brief Internal function for ending an instance's current awake or sleep
+ * period.
+ *
+ * @param[in] p_sched   Pointer to the scheduler instance.
+ * @param[in] sleeping  True if the instance is about to sleep, False if it
+ *                      is awake.
+ */
+static void sched_stats_mark(scheduler_t *p_sched, bool sleeping)
+{
+  sched_time_t now_time_ms = sched_port_ticks();
+
+  sched_port_lock();
+
+  if (p_sched->stats_running)
+  {
+    sched_time_t period_ms = now_time_ms - p_sched->stats_mark_ms;
+    if (p_sched->stats_sleeping)
+    {
+      p_sched->stats.sleep_ms += period_ms;
+      p_sched->stats.wake_cnt++;
+    }
+    else
+    {
+      p_sched->stats.awake_ms += period_ms;
+    }
+  }
+
+  p_sched->stats_mark_ms = now_time_ms;
+  p_sched->stats_sleeping = sleeping;
+
+  sched_port_free();
+}
+
+#endif // (SCHED_STATS_EN != 0)
+
+#if (SCHED_TASK_POWER_EN != 0)
+
+/**
+ * @brief Internal function for switching the processor's run mode.
+ *
+ * The port is only called if the run mode changes so a run of handlers which
+ * require the same mode doesn't switch the clocks between them.
+ *
+ * @param[in] p_sched   Pointer to the scheduler instance.
+ * @param[in] run_mode  The run mode to switch to.
+ */
+static void power_run_mode_set(scheduler_t *p_sched, uint8_t run_mode)
+{
+  if (p_sched->run_mode != run_mode)
+  {
+    p_sched->run_mode = run_mode;
+    sched_port_run_mode(run_mode);
+  }
+}
+
+/**
+ * @brief Internal function for preparing the processor's power modes before
+ * the instance sleeps.
+ *
+ * The processor returns to the lowest run mode and the deepest sleep mode
+ * allowed by the instance's started tasks is found.  Every started task is
+ * considered, not only the next to expire, since a task waiting for a
+ * peripheral's interrupt must be able to wake the processor before it
+ * expires.  The started tasks are counted by sleep mode as they start and
+ * stop so the lowest mode with a started task is found without walking the
+ * task list.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ *
+ * @return The deepest allowed sleep mode.
+ */
+static uint8_t power_sleep_prepare(scheduler_t *p_sched)
+{
+  power_run_mode_set(p_sched, SCHED_RUN_MODE_LOW);
+
+  // Take exclusive access so the counts can't change during the search.
+  sched_port_lock();
+
+  uint8_t sleep_mode = 0;
+  while ((sleep_mode < SCHED_SLEEP_MODE_CNT) && (p_sched->sleep_cnt[sleep_mode] == 0))
+  {
+    sleep_mode++;
+  }
+
+  sched_port_free();
+
+  return (sleep_mode < SCHED_SLEEP_MODE_CNT) ? sleep_mode : SCHED_SLEEP_MODE_ANY;
+}
+
+/**
+ * @brief Internal function for selecting the sleep state for the time
+ * remaining until a sleep deadline.
+ *
+ * The deepest state of the port's sleep state table which is allowed by the
+ * sleep limit and is worthwhile for the remaining time is selected.  A state
+ * is worthwhile if the remaining time is at least its break-even time and is
+ * longer than its entry and exit latencies.  The processor is woken early by
+ * the state's exit latency so it runs again by the deadline.  Without a
+ * table, the port selects the state from the limit.
+ *
+ * @param[in] sleep_limit  The deepest allowed sleep mode.
+ * @param[in] deadline_ms  The time the next task expires. (ticks)
+ *
+ * @return The time to wake at. (ticks)
+ */
+static sched_time_t power_sleep_select(uint8_t sleep_limit, sched_time_t deadline_ms)
+{
+  const sched_port_sleep_state_t *p_states = NULL;
+  uint8_t state_cnt = sched_port_sleep_states(&p_states);
+
+  if ((state_cnt == 0) || (p_states == NULL))
+  {
+    sched_port_sleep_mode(sleep_limit);
+    return deadline_ms;
+  }
+
+  // A deadline which has already passed leaves no time to sleep.
+  sched_time_t remaining_ms = deadline_ms - sched_port_ticks();
+  if (remaining_ms > SCHED_PORT_SLEEP_MS_MAX)
+  {
+    remaining_ms = 0;
+  }
+
+  // The states are sorted from the shallowest to the deepest.
+  uint8_t sleep_mode = 0;
+  sched_time_t exit_ms = 0;
+  for (uint8_t index = 0; index < state_cnt; index++)
+  {
+    const sched_port_sleep_state_t *p_state = &p_states[index];
+    if ((p_state->sleep_mode <= sleep_limit) && (remaining_ms >= p_state->break_even_ticks) &&
+        (remaining_ms > p_state->entry_ticks + p_state->exit_ticks))
+    {
+      sleep_mode = p_state->sleep_mode;
+      exit_ms = p_state->exit_ticks;
+    }
+  }
+
+  sched_port_sleep_mode(sleep_mode);
+  return deadline_ms - exit_ms;
+}
+
+#endif // (SCHED_TASK_POWER_EN != 0)
+
+/**
+ * @brief Internal function for executing an expired task's handler function.
+ *
+ * Note that the task is not checked for expiration.  The handler isn't called
+ * if the task was stopped, executed or moved to a different scheduler
+ * instance after it was found to be expired.
+ *
+ * @param[in] p_sched       Pointer to the executing scheduler instance.
+ * @param[in] p_task        Pointer to the task.
+ * @param[in] now_time_ms   The time the task was found to be expired. (mS)
+ */
+static void task_execute_handler(scheduler_t *p_sched, sched_task_t *p_task,
+                                 sched_time_t now_time_ms)
+{
+
+  assert(p_task != NULL);
+
+  /* Take exclusive access while updating the task state so the update can't
+   * be interrupted by a task stop or start from a different context.
+   */
+  sched_port_lock();
+
+  // Write out the sleep which ended before the call.
+  TRACE_SLEEP(p_sched);
+
+  if ((p_task->state != SCHED_TASK_ACTIVE) || (task_sched(p_task) != p_sched))
+  {
+    sched_port_free();
+    return;
+  }
+
+  // The task's scheduled expiration is only known before it is re-armed.
+  TRACE(p_sched, SCHED_TRACE_TASK_EXPIRE, p_task, p_task->start_ms + p_task->interval_ms);
+
+#if (SCHED_STATS_EN != 0) || (SCHED_TASK_BUDGET_EN != 0)
+  sched_time_t call_ms = sched_port_ticks();
+#endif
+#if (SCHED_STATS_EN != 0)
+  // Find the lateness before a repeating task is re-armed.
+  sched_time_t elapsed_ms = task_time_elapsed_ms(p_task, call_ms);
+  sched_time_t late_ms = (elapsed_ms > p_task->interval_ms) ? (elapsed_ms - p_task->interval_ms) : 0;
+#endif
+
+#if (SCHED_EVENT_EN != 0)
+  if (p_task->p_event != NULL)
+  {
+    /* A task bound to an event will be in the executing state while inside
+     * of its handler.  It waits for its event again once the handler returns.
+     */
+    p_task->state = SCHED_TASK_EXECUTING;
+  }
+  else
+#endif
+  if (p_task->repeat)
+  {
+    /* A repeating task will be in the executing state while inside of
+     * its handler.
+     */
+    p_task->state = SCHED_TASK_EXECUTING;
+
+    /* Re-arm the task before calling the handler so the handler's
+     * execution time doesn't introduce error.  The start time only needs
+     * to be updated for repeating tasks.
+     */
+    task_time_rearm(p_task, now_time_ms);
+
+    // Update the task's position in the que since the start time changed.
+    que_task_update(p_sched, p_task);
+  }
+  else
+  {
+    /* A non-repeating task will be in the stopping state while executing
+     * its handler.  It will be stopped once the handler returns.
+     */
+    p_task->state = SCHED_TASK_STOPPING;
+  }
+
+  TRACE(p_sched, SCHED_TRACE_HANDLER_ENTER, p_task, sched_port_ticks());
+
+#if (SCHED_TASK_POWER_EN != 0)
+  uint8_t run_mode = p_task->run_mode;
+#endif
+
+  sched_port_free();
+
+#if (SCHED_TASK_POWER_EN != 0)
+  // Switch the run mode before the handler, outside of the lock.
+  power_run_mode_set(p_sched, run_mode);
+#endif
+
+  // Call the task's handler function.
+  sched_handler_t handler = (sched_handler_t)p_task->p_handler;
+  assert(handler != NULL);
+  SCHED_HOOK_HANDLER_ENTER(p_task);
+  if (TASK_DATA_STORED(p_task))
+  {
+    handler(p_task, TASK_DATA(p_task), TASK_DATA_SIZE(p_task));
+  }
+  else
+  {
+    handler(p_task, NULL, 0);
+  }
+  SCHED_HOOK_HANDLER_EXIT(p_task);
+
+#if (SCHED_STATS_EN != 0) || (SCHED_TASK_BUDGET_EN != 0)
+  sched_time_t exec_ms = sched_port_ticks() - call_ms;
+#endif
+
+#if (SCHED_TASK_BUDGET_EN != 0)
+  // A handler which runs past its budget delays every other expired task.
+  bool over_budget = (p_task->budget_ms != 0) && (exec_ms > p_task->budget_ms);
+  if (over_budget)
+  {
+    SCHED_HOOK_BUDGET_OVERRUN(p_task, exec_ms);
+  }
+#endif
+
+  sched_port_lock();
+
+#if (SCHED_TASK_BUDGET_EN != 0)
+  if (over_budget)
+  {
+    p_task->budget_overrun_cnt++;
+    p_sched->budget_overrun = true;
+  }
+#endif
+
+#if (SCHED_STATS_EN != 0)
+  task_stats_update(p_task, late_ms, exec_ms);
+#endif
+
+  TRACE(p_sched, SCHED_TRACE_HANDLER_EXIT, p_task, sched_port_ticks());
+
+  // Update the task state after the handler finishes.
+#if (SCHED_EVENT_EN != 0)
+  if ((p_task->state == SCHED_TASK_EXECUTING) && (p_task->p_event != NULL) &&
+      !event_take(p_task->p_event))
+  {
+    /* A task bound to an event waits for the event again unless a signal
+     * arrived while its handler was executing.
+     */
+    que_task_remove(p_sched, p_task);
+    event_wait_append(p_task);
+  }
+  else if (p_task->state == SCHED_TASK_EXECUTING)
+  {
+    // Executing tasks move back to the active state.
+    p_task->state = SCHED_TASK_ACTIVE;
+    if (p_task->p_event != NULL)
+    {
+      // The pending signal starts the task's interval from now.
+      p_task->start_ms = sched_port_ticks();
+    }
+    // Update the task's position in the que since its state changed.
+    que_task_update(p_sched, p_task);
+  }
+#else
+  if (p_task->state == SCHED_TASK_EXECUTING)
+  {
+    // Executing tasks move back to the active state.
+    p_task->state = SCHED_TASK_ACTIVE;
+    // Update the task's position in the que since its state changed.
+    que_task_update(p_sched, p_task);
+  }
+#endif
+  else
+  {
+    assert(p_task->state == SCHED_TASK_STOPPING);
+    // Stopping tasks move to the stopped state.
+    p_task->state = SCHED_TASK_STOPPED;
+    power_task_remove(p_sched, p_task);
+    TRACE(p_sched, SCHED_TRACE_TASK_STOP, p_task, sched_port_ticks());
+    // A task is no longer allocated once stopped.
+    task_pool_release(p_task);
+    // Stopped tasks are removed from the que and later from the task list.
+    que_task_remove(p_sched, p_task);
+    task_list_prune_mark(p_task);
+  }
+
+  sched_port_free();
+}
+
+#if (SCHED_TASK_BATCH_EN != 0)
+
+/**
+ * @brief A batch run list of expired tasks.
+ */
+typedef struct
+{
+  /// @brief The first task in the list.
+  sched_task_t *p_head;
+  /// @brief The last task in the list.
+  sched_task_t *p_tail;
+} run_list_t;
+
+/**
+ * @brief Internal function for adding an expired task to the end of a batch
+ * run list.
+ *
+ * @param[in] p_list  Pointer to the run list.
+ * @param[in] p_task  Pointer to the task.
+ */
+static void run_list_append(run_list_t *p_list, sched_task_t *p_task)
+{
+  p_task->dispatch = true;
+  p_task->p_run_next = NULL;
+
+  if (p_list->p_head == NULL)
+  {
+    p_list->p_head = p_task;
+  }
+  else
+  {
+    p_list->p_tail->p_run_next = p_task;
+  }
+  p_list->p_tail = p_task;
+}
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+
+/**
+ * @brief Internal function for collecting the expired tasks in a heap
+ * sub-tree.
+ *
+ * The children of an unexpired task can't be expired so only the expired
+ * tasks and their children are visited.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_list        Pointer to the run list.
+ * @param[in] index         The heap index of the sub-tree's top task.
+ * @param[in] now_time_ms   The batch time in mS.
+ */
+static void heap_expired_collect(scheduler_t *p_sched,
+                                 run_list_t *p_list,
+                                 uint32_t index,
+                                 sched_time_t now_time_ms)
+{
+  if ((index < p_sched->heap_cnt) && task_time_expired(p_sched->p_heap[index], now_time_ms))
+  {
+    run_list_append(p_list, p_sched->p_heap[index]);
+    heap_expired_collect(p_sched, p_list, (2 * index) + 1, now_time_ms);
+    heap_expired_collect(p_sched, p_list, (2 * index) + 2, now_time_ms);
+  }
+}
+
+/**
+ * @brief Internal function for collecting every expired task in the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_list        Pointer to the run list.
+ * @param[in] now_time_ms   The batch time in mS.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS if no tasks are expired.
+ */
+static sched_time_t que_expired_collect(scheduler_t *p_sched,
+                                        run_list_t *p_list,
+                                        sched_time_t now_time_ms)
+{
+  sched_port_lock();
+
+  sched_time_t next_task_ms = SCHED_MS_MAX;
+  if (p_sched->heap_cnt > 0)
+  {
+    next_task_ms = heap_wake_ms(p_sched, 0, now_time_ms, SCHED_MS_MAX);
+    heap_expired_collect(p_sched, p_list, 0, now_time_ms);
+  }
+
+  sched_port_free();
+  return next_task_ms;
+}
+
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+
+/**
+ * @brief Internal function for collecting every expired task in the que.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_list        Pointer to the run list.
+ * @param[in] now_time_ms   The batch time in mS.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS if no tasks are expired.
+ */
+static sched_time_t que_expired_collect(scheduler_t *p_sched,
+                                        run_list_t *p_list,
+                                        sched_time_t now_time_ms)
+{
+  sched_port_lock();
+
+  // Advancing the wheel moves every expired task to the ready list.
+  wheel_advance(p_sched, now_time_ms);
+
+  for (sched_task_t *p_task = p_sched->p_wheel[WHEEL_LIST_READY]; p_task != NULL;
+       p_task = p_task->p_wheel_next)
+  {
+    run_list_append(p_list, p_task);
+  }
+
+  sched_time_t next_task_ms = wheel_wake_ms(p_sched, now_time_ms);
+
+  sched_port_free();
+  return next_task_ms;
+}
+
+#else
+
+/**
+ * @brief Internal function for collecting every expired task in the que.
+ *
+ * The task que is searched without exclusive access.  The search is repeated
+ * if any tasks were updated while it was in progress and no expired tasks
+ * were found since the next expiring task may have changed.  If task caching
+ * is enabled, the search is skipped if the first cached task is unexpired.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @param[in] p_list        Pointer to the run list.
+ * @param[in] now_time_ms   The batch time in mS.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS if no tasks are expired.
+ */
+static sched_time_t que_expired_collect(scheduler_t *p_sched,
+                                        run_list_t *p_list,
+                                        sched_time_t now_time_ms)
+{
+#if (SCHED_QUE_CACHE_EN != 0)
+  if (!p_sched->cache_valid)
+  {
+    cache_refill(p_sched);
+  }
+
+  sched_port_lock();
+
+  bool valid = p_sched->cache_valid;
+  sched_time_t cache_task_ms = SCHED_MS_MAX;
+
+  if (valid && (p_sched->cache_cnt > 0))
+  {
+    cache_task_ms = task_time_remaining_ms(p_sched->p_cache[0], now_time_ms);
+  }
+
+  if (valid && (cache_task_ms > 0))
+  {
+    // The first cached task is unexpired so every task is unexpired.
+    cache_task_ms = cache_wake_ms(p_sched, now_time_ms);
+  }
+
+  sched_port_free();
+
+  if (valid && (cache_task_ms > 0))
+  {
+    return cache_task_ms;
+  }
+#endif
+
+  sched_time_t next_task_ms;
+
+  do
+  {
+    // Clear the updated flag since the search is about to start.
+    sched_updated_get_clear(p_sched);
+    next_task_ms = SCHED_MS_MAX;
+
+    for (sched_task_t *p_search_task = (sched_task_t *)p_sched->p_head;
+         p_search_task != NULL; p_search_task = task_next(p_search_task))
+    {
+      // Filter on active tasks.
+      if (task_list_active(p_sched, p_search_task))
+      {
+        sched_time_t search_task_ms = task_time_remaining_ms(p_search_task, now_time_ms);
+
+        if (search_task_ms == 0)
+        {
+          sched_port_lock();
+          run_list_append(p_list, p_search_task);
+          sched_port_free();
+        }
+        next_task_ms = SCHED_MIN(next_task_ms, task_time_wake_ms(p_search_task, now_time_ms));
+      }
+    }
+  } while ((p_list->p_head == NULL) && sched_updated_get_clear(p_sched));
+
+  return next_task_ms;
+}
+
+#endif // (SCHED_QUE_ENGINE)
+
+/**
+ * @brief Internal function for executing tasks in the scheduler's task que
+ * which have expired intervals.
+ *
+ * Every expired task is collected into a run list using a single time sample
+ * and their handlers are then executed back to back in order of priority,
+ * highest first.  A collected task is skipped if it was stopped or restarted
+ * by a preceding handler.  The batch is repeated until no expired tasks are
+ * found.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS or SCHED_MS_MAX if no active tasks were found.
+ */
+static sched_time_t sched_execute_que(scheduler_t *p_sched)
+{
+  while (true)
+  {
+    // Sample the time once for the entire batch.
+    sched_time_t now_time_ms = sched_port_ticks();
+
+    run_list_t run_list = {.p_head = NULL, .p_tail = NULL};
+    sched_time_t next_task_ms = que_expired_collect(p_sched, &run_list, now_time_ms);
+
+    if (run_list.p_head == NULL)
+    {
+      // Sleep until the next task must be executed.
+      return next_task_ms;
+    }
+
+    // Dispatch the run list once per priority level, highest first.
+    for (int32_t level = SCHED_TASK_PRIORITY_LEVELS - 1; level >= 0; level--)
+    {
+      sched_task_t *p_run_task = run_list.p_head;
+
+      while (p_run_task != NULL)
+      {
+        sched_task_t *p_next_run_task = p_run_task->p_run_next;
+
+        if (TASK_PRIORITY(p_run_task) == level)
+        {
+          sched_port_lock();
+          bool dispatch = p_run_task->dispatch && (p_run_task->state == SCHED_TASK_ACTIVE);
+          p_run_task->dispatch = false;
+          sched_port_free();
+
+          if (dispatch)
+          {
+            task_execute_handler(p_sched, p_run_task, now_time_ms);
+          }
+        }
+
+        p_run_task = p_next_run_task;
+      }
+    }
+  }
+}
+
+#elif (SCHED_QUE_CACHE_EN != 0)
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+
+/**
+ * @brief Internal function for finding the highest priority expired task.
+ *
+ * The expired tasks are stored at the start of the cache.  If every cached
+ * task has expired and some of the active tasks aren't cached, the task list
+ * is also searched since the uncached tasks may have expired too.  Of the
+ * expired tasks with the same priority, the first found is selected.
+ *
+ * @note The scheduler must be locked prior to calling the function.
+ *
+ * @param[in] p_sched       Pointer to the scheduler instance.
+ * @param[in] now_time_ms   The current time in mS.
+ * @return Pointer to the highest priority expired task, NULL if none.
+ */
+static sched_task_t *cache_priority_first(scheduler_t *p_sched, sched_time_t now_time_ms)
+{
+  sched_task_t *p_first_task = NULL;
+  uint32_t index = 0;
+
+  for (; index < p_sched->cache_cnt; index++)
+  {
+    sched_task_t *p_task = p_sched->p_cache[index];
+
+    if (!task_time_expired(p_task, now_time_ms))
+    {
+      break;
+    }
+    if ((p_first_task == NULL) || (TASK_PRIORITY(p_task) > TASK_PRIORITY(p_first_task)))
+    {
+      p_first_task = p_task;
+    }
+  }
+
+  if ((index == p_sched->cache_cnt) && !p_sched->cache_all)
+  {
+    for (sched_task_t *p_task = p_sched->p_head; p_task != NULL; p_task = task_next(p_task))
+    {
+      if (task_list_active(p_sched, p_task) && task_time_expired(p_task, now_time_ms) &&
+          ((p_first_task == NULL) || (TASK_PRIORITY(p_task) > TASK_PRIORITY(p_first_task))))
+      {
+        p_first_task = p_task;
+      }
+    }
+  }
+
+  return p_first_task;
+}
+
+#endif // (SCHED_TASK_PRIORITY_LEVELS > 1)
+
+/**
+ * @brief Internal function for executing tasks in the scheduler's task que
+ * which have expired intervals.
+ *
+ * The first cached task is the next expiring task.  The function repeatably
+ * executes the first cached task while it is expired, or the highest priority
+ * expired task if task priorities are enabled.  The cache is refilled by
+ * searching the task que if it has become invalid.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS or SCHED_MS_MAX if no active tasks were found.
+ */
+static sched_time_t sched_execute_que(scheduler_t *p_sched)
+{
+  while (true)
+  {
+    if (!p_sched->cache_valid)
+    {
+      cache_refill(p_sched);
+    }
+
+    sched_port_lock();
+
+    sched_time_t now_time_ms = sched_port_ticks();
+    sched_task_t *p_next_task = NULL;
+    sched_time_t next_task_ms = SCHED_MS_MAX;
+    bool valid = p_sched->cache_valid;
+
+    if (valid && (p_sched->cache_cnt > 0))
+    {
+      p_next_task = p_sched->p_cache[0];
+      next_task_ms = task_time_remaining_ms(p_next_task, now_time_ms);
+
+      if (next_task_ms > 0)
+      {
+        next_task_ms = cache_wake_ms(p_sched, now_time_ms);
+      }
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+      else
+      {
+        p_next_task = cache_priority_first(p_sched, now_time_ms);
+      }
+#endif
+    }
+
+    sched_port_free();
+
+    if (!valid)
+    {
+      // The cache was invalidated after it was refilled.
+      continue;
+    }
+
+    if ((p_next_task == NULL) || (next_task_ms > 0))
+    {
+      // Sleep until the next task must be executed.
+      return next_task_ms;
+    }
+
+    // Only active tasks are cached outside of a handler call.
+    assert(p_next_task->state == SCHED_TASK_ACTIVE);
+    task_execute_handler(p_sched, p_next_task, now_time_ms);
+  }
+}
+
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+
+/**
+ * @brief Internal function for executing tasks in the scheduler's task que
+ * which have expired intervals.
+ *
+ * The function services any expired task in the que and finds the next
+ * expiring task.  The search is repeated if any tasks were updated while it
+ * was in progress.  If task priorities are enabled, the highest priority
+ * expired task found by a search is executed once the search completes and
+ * the search is then repeated.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS or SCHED_MS_MAX if no active tasks were found.
+ */
+static sched_time_t sched_execute_que(scheduler_t *p_sched)
+{
+  // The next expiring task.
+  sched_task_t *p_next_task = NULL;
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+  // The highest priority expired task found by the search.
+  sched_task_t *p_run_task = NULL;
+#endif
+
+  // Clear the updated flag since the search is about to start.
+  sched_updated_get_clear(p_sched);
+
+  do
+  {
+    // Clear the next task since its either been serviced or is invalid.
+    p_next_task = NULL;
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+    p_run_task = NULL;
+#endif
+
+    // Get the current time.
+    sched_time_t now_time_ms = sched_port_ticks();
+
+    /* The next task's time until the scheduler must wake up.  The wake up
+     * time is stored in addition the task pointer.  This improves the task
+     * loop efficiency since the  loop does not have to recalculate the
+     * interval each time through the loop.
+     */
+    sched_time_t next_task_ms = SCHED_TIME_MAX;
+
+    // Start searching for the next expiring task at the start of the linked list.
+    sched_task_t *p_search_task = (sched_task_t *)p_sched->p_head;
+
+    while (p_search_task != NULL)
+    {
+
+      // Filter on active tasks.
+      if (task_list_active(p_sched, p_search_task))
+      {
+
+        // Calculate the search task's remaining time.
+        sched_time_t search_task_ms = task_time_remaining_ms(p_search_task, now_time_ms);
+
+        if (search_task_ms == 0)
+        {
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+          // Keep the first expired task found with the highest priority.
+          if ((p_run_task == NULL) || (TASK_PRIORITY(p_search_task) > TASK_PRIORITY(p_run_task)))
+          {
+            p_run_task = p_search_task;
+          }
+          p_search_task = task_next(p_search_task);
+#else
+          /* Execute the search task's handler if the task has expired.
+           *
+           * Note that the scheduler only moves to the next task in the list
+           * once the task is unexpired.  The search task's expiration time is
+           * recalculated each time its handler returns since the task interval
+           * may have been modified inside the handler.  This carries the risk
+           * that an an always expiring task could potentially starve the other
+           * tasks of processor cycles if it were to repeatably restart itself
+           * with an expired interval inside its own handler.
+           */
+          task_execute_handler(p_sched, p_search_task, now_time_ms);
+
+          /* Refresh the current time after the handler returns.  A task
+           * restarted inside of its handler has a start time later than the
+           * previous time value which would otherwise calculate as expired.
+           */
+          now_time_ms = sched_port_ticks();
+#endif
+        }
+        else
+        {
+          /* If the scheduler must wake up for the search task before the
+           * previously found next task, it becomes the next task.
+           */
+          sched_time_t search_wake_ms = task_time_wake_ms(p_search_task, now_time_ms);
+          if (search_wake_ms < next_task_ms)
+          {
+            p_next_task = p_search_task;
+            next_task_ms = search_wake_ms;
+          }
+          // Move to the next task in the list
+          p_search_task = task_next(p_search_task);
+        }
+      }
+      else
+      {
+        // Move to the next task in the list if the search task is inactive.
+        p_search_task = task_next(p_search_task);
+      }
+    }
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+    if (p_run_task != NULL)
+    {
+      // Execute the highest priority expired task and then search again.
+      task_execute_handler(p_sched, p_run_task, now_time_ms);
+    }
+#endif
+
+    /* A task handler or an interrupt may have started or stopped a task which
+     * was already passed by the search.  Repeat the search if so since the
+     * next expiring task may have changed.
+     */
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+  } while (sched_updated_get_clear(p_sched) || (p_run_task != NULL));
+#else
+  } while (sched_updated_get_clear(p_sched));
+#endif
+
+  /* Recalculate the next task's wake up time using the current mS timer
+   * value to improve the accuracy of the sleep interval in cases were the task
+   * execution time was significant.
+   */
+  if (TASK_ACTIVE_SAFE(p_next_task))
+  {
+    return task_time_wake_ms(p_next_task, sched_port_ticks());
+  }
+  return SCHED_MS_MAX;
+}
+
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+
+/**
+ * @brief Internal function for finding the highest priority expired task in
+ * a heap sub-tree.
+ *
+ * The children of an unexpired task can't be expired so only the expired
+ * tasks and their children are visited.  Of the expired tasks with the same
+ * priority, the first found is selected.
+ *
+ * @param[in] p_sched       Pointer to the scheduler instance.
+ * @param[in] index         The heap index of the sub-tree's top task.
+ * @param[in] now_time_ms   The current time in mS.
+ * @param[in] p_first_task  The highest priority expired task found so far.
+ * @return Pointer to the highest priority expired task, NULL if none.
+ */
+static sched_task_t *heap_priority_first(scheduler_t *p_sched,
+                                         uint32_t index,
+                                         sched_time_t now_time_ms,
+                                         sched_task_t *p_first_task)
+{
+  if ((index < p_sched->heap_cnt) && task_time_expired(p_sched->p_heap[index], now_time_ms))
+  {
+    sched_task_t *p_task = p_sched->p_heap[index];
+
+    if ((p_first_task == NULL) || (TASK_PRIORITY(p_task) > TASK_PRIORITY(p_first_task)))
+    {
+      p_first_task = p_task;
+    }
+    p_first_task = heap_priority_first(p_sched, (2 * index) + 1, now_time_ms, p_first_task);
+    p_first_task = heap_priority_first(p_sched, (2 * index) + 2, now_time_ms, p_first_task);
+  }
+  return p_first_task;
+}
+
+#endif // (SCHED_TASK_PRIORITY_LEVELS > 1)
+
+/**
+ * @brief Internal function for executing tasks in the scheduler's task que
+ * which have expired intervals.
+ *
+ * The next expiring task is always stored at the top of the heap.  The
+ * function repeatably executes the top task while it is expired, or the
+ * highest priority expired task if task priorities are enabled.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS or SCHED_MS_MAX if no active tasks were found.
+ */
+static sched_time_t sched_execute_que(scheduler_t *p_sched)
+{
+  while (true)
+  {
+    sched_port_lock();
+
+    // The heap's top task is the next expiring task.
+    sched_time_t now_time_ms = sched_port_ticks();
+    sched_task_t *p_next_task = NULL;
+    sched_time_t next_task_ms = SCHED_MS_MAX;
+
+    if (p_sched->heap_cnt > 0)
+    {
+      p_next_task = p_sched->p_heap[0];
+      next_task_ms = task_time_remaining_ms(p_next_task, now_time_ms);
+
+      if (next_task_ms > 0)
+      {
+        next_task_ms = heap_wake_ms(p_sched, 0, now_time_ms, SCHED_MS_MAX);
+      }
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+      else
+      {
+        p_next_task = heap_priority_first(p_sched, 0, now_time_ms, NULL);
+      }
+#endif
+    }
+
+    sched_port_free();
+
+    if ((p_next_task == NULL) || (next_task_ms > 0))
+    {
+      // Sleep until the next task must be executed.
+      return next_task_ms;
+    }
+
+    // Only active tasks are stored in the heap outside of a handler call.
+    assert(p_next_task->state == SCHED_TASK_ACTIVE);
+    task_execute_handler(p_sched, p_next_task, now_time_ms);
+  }
+}
+
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+
+/**
+ * @brief Internal function for executing tasks in the scheduler's task que
+ * which have expired intervals.
+ *
+ * The wheel is advanced to the current time which moves any expired tasks to
+ * the ready list.  The function repeatably executes the first ready task, or
+ * the first ready task with the highest priority if task priorities are
+ * enabled, until the ready list is empty.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @return The time until the scheduler must wake up to execute the next task
+ *         in mS or SCHED_MS_MAX if no active tasks were found.
+ */
+static sched_time_t sched_execute_que(scheduler_t *p_sched)
+{
+  while (true)
+  {
+    sched_port_lock();
+
+    sched_time_t now_time_ms = sched_port_ticks();
+    wheel_advance(p_sched, now_time_ms);
+
+    // The first ready task is the next task to execute.
+    sched_task_t *p_next_task = p_sched->p_wheel[WHEEL_LIST_READY];
+    sched_time_t next_task_ms = wheel_wake_ms(p_sched, now_time_ms);
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+    for (sched_task_t *p_task = p_next_task; p_task != NULL; p_task = p_task->p_wheel_next)
+    {
+      if (TASK_PRIORITY(p_task) > TASK_PRIORITY(p_next_task))
+      {
+        p_next_task = p_task;
+      }
+    }
+#endif
+
+    sched_port_free();
+
+    if (next_task_ms > 0)
+    {
+      // Sleep until the next task must be executed.
+      return next_task_ms;
+    }
+
+    // Only active tasks are stored in the wheel outside of a handler call.
+    assert(p_next_task->state == SCHED_TASK_ACTIVE);
+    task_execute_handler(p_sched, p_next_task, now_time_ms);
+  }
+}
+
+#endif // (SCHED_QUE_ENGINE)
+
+#if (SCHED_INSTANCE_CNT > 1)
+
+/**
+ * @brief Internal function for stealing an expired task from the que of a
+ * scheduler instance which is busy executing task handlers.
+ *
+ * The first expired task found which isn't pinned to its instance is moved
+ * to the stealing instance's que so it is executed by the stealing instance.
+ * At most one task is stolen per call so the work is shared between all of
+ * the idle instances.
+ *
+ * @param[in] p_sched  Pointer to the stealing scheduler instance.
+ * @return 0 if a task was stolen, else the time until the next unpinned task
+ *         of a busy instance expires in mS or SCHED_MS_MAX if there is none.
+ */
+static sched_time_t sched_steal(scheduler_t *p_sched)
+{
+  sched_instance_t instance = (sched_instance_t)(p_sched - sched_instances);
+  sched_time_t steal_ms = SCHED_MS_MAX;
+
+  // Take exclusive access since the busy instance's que is searched and updated.
+  sched_port_lock();
+
+  sched_time_t now_time_ms = sched_port_ticks();
+
+  for (uint32_t busy_instance = 0; busy_instance < SCHED_INSTANCE_CNT; busy_instance++)
+  {
+    scheduler_t *p_busy = &sched_instances[busy_instance];
+
+    if ((p_busy == p_sched) || !p_busy->busy || (p_busy->state != SCHED_STATE_ACTIVE))
+    {
+      continue;
+    }
+
+    for (sched_task_t *p_task = p_busy->p_head; p_task != NULL; p_task = task_next(p_task))
+    {
+      // Filter on active tasks which aren't pinned to their instance.
+      if ((p_task->state != SCHED_TASK_ACTIVE) || p_task->pinned)
+      {
+        continue;
+      }
+
+      sched_time_t task_ms = task_time_remaining_ms(p_task, now_time_ms);
+
+      if (task_ms > 0)
+      {
+        steal_ms = SCHED_MIN(steal_ms, task_ms);
+      }
+      else if (task_move(p_task, instance))
+      {
+        sched_port_free();
+        return 0;
+      }
+    }
+  }
+
+  sched_port_free();
+  return steal_ms;
+}
+
+#endif // (SCHED_INSTANCE_CNT > 1)
+
+/***** External Scheduler Task Functions *****/
+
+bool sched_task_config(sched_task_t *p_task, sched_handler_t handler,
+                       sched_time_t interval_ms, bool repeat)
+{
+
+  // A pointer to the task and its handler must be supplied.
+  if ((p_task == NULL) || (handler == NULL))
+  {
+    return false;
+  }
+
+  if (!task_linkable(p_task))
+  {
+    // The compact task layout can only link tasks stored in the task section.
+    return false;
+  }
+
+  /* New tasks are added to the default instance's que.  Previously
+   * configured tasks remain in their current instance's que.
+   */
+  scheduler_t *p_sched = (p_task->state == SCHED_TASK_UNINIT)
+                             ? &sched_instances[SCHED_INSTANCE_DEFAULT]
+                             : task_sched(p_task);
+
+  if (p_sched->state == SCHED_STATE_STOPPED)
+  {
+    // Task's can only be configured after the scheduler has been initialized.
+    return false;
+  }
+
+  if (p_task->state == SCHED_TASK_UNINIT)
+  {
+
+    /* The new task is linked into the scheduler's task list when it is
+     * started.
+     */
+    p_task->listed = false;
+
+    // The task is not stored in the que until it is started.
+    que_task_clear(p_task);
+#if (SCHED_INSTANCE_CNT > 1)
+    // The task is unpinned in the default instance until it is moved.
+    p_task->instance = SCHED_INSTANCE_DEFAULT;
+    p_task->pinned = false;
+#endif
+#if (SCHED_TRACE_SIZE != 0) && (SCHED_TASK_COMPACT_EN == 0)
+    // The task keeps its trace id while it is reconfigured.
+    trace_id_next = (trace_id_next == UINT16_MAX) ? 1 : (trace_id_next + 1);
+    p_task->trace_id = trace_id_next;
+#endif
+  }
+  else if (p_task->state != SCHED_TASK_STOPPED)
+  {
+    // A task can only be configured in the uninitialized or stopped states.
+    return false;
+  }
+
+  // Clear the task data buffer.
+#if (SCHED_TASK_BUFF_CLEAR_EN != 0)
+  if (TASK_BUFFERED(p_task))
+  {
+    memset(TASK_DATA(p_task), 0x00, TASK_BUFF_SIZE(p_task));
+  }
+#endif
+
+  // Store the task handler.
+  p_task->p_handler = handler;
+
+  // Store the repeating status.
+  p_task->repeat = repeat;
+  p_task->repeat_mode = SCHED_REPEAT_MODE_DEFAULT;
+#if (SCHED_TASK_SLACK_EN != 0)
+  p_task->slack_ms = 0;
+#endif
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+  p_task->priority = 0;
+#endif
+#if (SCHED_STATS_EN != 0)
+  memset(&p_task->stats, 0x00, sizeof(p_task->stats));
+#endif
+#if (SCHED_TASK_BUDGET_EN != 0)
+  p_task->budget_ms = 0;
+  p_task->budget_overrun_cnt = 0;
+#endif
+#if (SCHED_TASK_POWER_EN != 0)
+  p_task->run_mode = SCHED_RUN_MODE_LOW;
+  p_task->sleep_mode = SCHED_SLEEP_MODE_ANY;
+#endif
+#if (SCHED_EVENT_EN != 0)
+  p_task->p_event = NULL;
+  p_task->p_wait_next = NULL;
+#endif
+#if (SCHED_TASK_MSG_EN != 0)
+  // Discard any pending messages.
+  if (p_task->p_msg != NULL)
+  {
+    p_task->p_msg->head = 0;
+    p_task->p_msg->pending = 0;
+  }
+#endif
+
+  // Store the task interval.
+  task_interval_set(p_task, interval_ms);
+
+  // Tasks will always be in the stopped state after configuration.
+  p_task->state = SCHED_TASK_STOPPED;
+
+  return true;
+}
+
+bool sched_task_repeat_mode(sched_task_t *p_task, sched_repeat_mode_t mode)
+{
+
+  // A pointer to the task must be supplied and the mode must be valid.
+  if ((p_task == NULL) || (mode > SCHED_REPEAT_FIXED_RATE_CATCHUP))
+  {
+    return false;
+  }
+
+  // Take exclusive access so the mode can't change while the task is re-armed.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  if (configured)
+  {
+    p_task->repeat_mode = mode;
+  }
+
+  sched_port_free();
+
+  return configured;
+}
+
+bool sched_task_slack(sched_task_t *p_task, sched_time_t slack_ms)
+{
+#if (SCHED_TASK_SLACK_EN != 0)
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+  // Take exclusive access since the slack is used by the task que search.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  if (configured)
+  {
+    p_task->slack_ms = SCHED_MIN(slack_ms, SCHED_MS_MAX);
+
+    // A reduced slack time may move the scheduler's wake up time forward.
+    que_updated_set(task_sched(p_task));
+  }
+
+  sched_port_free();
+
+  return configured;
+#else
+  return false;
+#endif
+}
+
+bool sched_task_priority(sched_task_t *p_task, uint8_t priority)
+{
+
+  // A pointer to the task must be supplied and the priority must be valid.
+  if ((p_task == NULL) || (priority >= SCHED_TASK_PRIORITY_LEVELS))
+  {
+    return false;
+  }
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+  // Take exclusive access since the priority is used by the task que search.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  if (configured)
+  {
+    p_task->priority = priority;
+  }
+
+  sched_port_free();
+
+  return configured;
+#else
+  // Every task has the single priority level.
+  return (p_task->state != SCHED_TASK_UNINIT);
+#endif
+}
+
+bool sched_task_move(sched_task_t *p_task, sched_instance_t instance)
+{
+
+  // A pointer to the task and a valid instance must be supplied.
+  if ((p_task == NULL) || (instance >= SCHED_INSTANCE_CNT))
+  {
+    return false;
+  }
+
+#if (SCHED_INSTANCE_CNT > 1)
+  // Take exclusive access since the task's que may need to be updated.
+  sched_port_lock();
+
+  /* The task must be stopped or active outside of its handler and the new
+   * instance must have been initialized.
+   */
+  bool moved = false;
+  if (((p_task->state == SCHED_TASK_STOPPED) || (p_task->state == SCHED_TASK_ACTIVE) ||
+       (p_task->state == SCHED_TASK_WAITING)) &&
+      (sched_instances[instance].state != SCHED_STATE_STOPPED))
+  {
+    moved = task_move(p_task, instance);
+  }
+
+  sched_port_free();
+
+  return moved;
+#else
+  // Every task is stored in the default instance's que.
+  return (p_task->state != SCHED_TASK_UNINIT);
+#endif
+}
+
+bool sched_task_affinity(sched_task_t *p_task, bool pinned)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+#if (SCHED_INSTANCE_CNT > 1)
+  // Take exclusive access since the affinity is used by task stealing.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  if (configured)
+  {
+    p_task->pinned = pinned;
+  }
+
+  sched_port_free();
+
+  return configured;
+#else
+  // Tasks are never stolen by a single instance.
+  return (p_task->state != SCHED_TASK_UNINIT);
+#endif
+}
+
+bool sched_task_stats(const sched_task_t *p_task, sched_task_stats_t *p_stats)
+{
+
+  // Pointers to the task and the snapshot must be supplied.
+  if ((p_task == NULL) || (p_stats == NULL))
+  {
+    return false;
+  }
+
+#if (SCHED_STATS_EN != 0)
+  // Take exclusive access so the statistics can't change during the copy.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  sched_task_stats_data_t stats = p_task->stats;
+
+  sched_port_free();
+
+  if (!configured)
+  {
+    return false;
+  }
+
+  p_stats->call_cnt = stats.call_cnt;
+  p_stats->overrun_cnt = stats.overrun_cnt;
+  p_stats->late_min_ms = stats.late_min_ms;
+  p_stats->late_max_ms = stats.late_max_ms;
+  p_stats->exec_max_ms = stats.exec_max_ms;
+  p_stats->late_avg_ms = (stats.call_cnt == 0) ? 0 : (sched_time_t)(stats.late_total_ms / stats.call_cnt);
+  p_stats->exec_avg_ms = (stats.call_cnt == 0) ? 0 : (sched_time_t)(stats.exec_total_ms / stats.call_cnt);
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool sched_task_stats_clear(sched_task_t *p_task)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+#if (SCHED_STATS_EN != 0)
+  // Take exclusive access since the statistics are updated after each handler call.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  if (configured)
+  {
+    memset(&p_task->stats, 0x00, sizeof(p_task->stats));
+  }
+
+  sched_port_free();
+
+  return configured;
+#else
+  return false;
+#endif
+}
+
+bool sched_task_budget(sched_task_t *p_task, sched_time_t budget_ms)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+#if (SCHED_TASK_BUDGET_EN != 0)
+  // Take exclusive access since the overrun count is updated after each handler call.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT);
+  if (configured)
+  {
+    p_task->budget_ms = budget_ms;
+    p_task->budget_overrun_cnt = 0;
+  }
+
+  sched_port_free();
+
+  return configured;
+#else
+  (void)budget_ms;
+  return false;
+#endif
+}
+
+uint32_t sched_task_budget_overruns(const sched_task_t *p_task)
+{
+#if (SCHED_TASK_BUDGET_EN != 0)
+  return (p_task != NULL) ? p_task->budget_overrun_cnt : 0;
+#else
+  return 0; // Task budgets are disabled, always return 0.
+#endif
+}
+
+bool sched_task_power(sched_task_t *p_task, uint8_t run_mode, uint8_t sleep_mode)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+#if (SCHED_TASK_POWER_EN != 0)
+  // Take exclusive access since the modes are read by the scheduler's loop.
+  sched_port_lock();
+
+  bool configured = (p_task->state != SCHED_TASK_UNINIT) &&
+                    ((sleep_mode < SCHED_SLEEP_MODE_CNT) || (sleep_mode == SCHED_SLEEP_MODE_ANY));
+  if (configured)
+  {
+    // A started task is counted in its new sleep mode.
+    bool started = (p_task->state != SCHED_TASK_STOPPED);
+    if (started)
+    {
+      power_task_remove(task_sched(p_task), p_task);
+    }
+    p_task->run_mode = run_mode;
+    p_task->sleep_mode = sleep_mode;
+    if (started)
+    {
+      power_task_add(task_sched(p_task), p_task);
+    }
+  }
+
+  sched_port_free();
+
+  return configured;
+#else
+  (void)run_mode;
+  (void)sleep_mode;
+  return false;
+#endif
+}
+
+bool sched_task_start(sched_task_t *p_task)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+  // Take exclusive access since the task que may need to be updated.
+  sched_port_lock();
+  bool started = task_start_event(p_task);
+  sched_port_free();
+
+  return started;
+}
+
+bool sched_task_update(sched_task_t *p_task, sched_time_t interval_ms)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+  sched_port_lock();
+
+  // Store the new interval.
+  task_interval_set(p_task, interval_ms);
+
+  // Start the task.
+  bool started = task_start_event(p_task);
+
+  sched_port_free();
+
+  return started;
+}
+
+/**
+ * @brief Internal function for reserving space for data in a stopped task's
+ * data buffer.
+ *
+ * Arena pool tasks return any previously reserved space to the pool's arena
+ * and then reserve data_size bytes.  Buffered tasks use their own buffer.  The
+ * task's data size is reset to 0 until the data is committed.
+ *
+ * @note: The task pointer is not NULL checked and the task must be stopped.
+ *
+ * @param[in] p_task     Pointer to the task.
+ * @param[in] data_size  The size of the data to reserve space for. (bytes)
+ *
+ * @retval Pointer to the reserved space.
+ * @retval NULL if the task is unbuffered, data_size is 0 or the space isn't
+ *         available.
+ */
+static uint8_t *task_data_reserve(sched_task_t *p_task, uint8_t data_size)
+{
+  assert(p_task->state == SCHED_TASK_STOPPED);
+
+#if (SCHED_TASK_POOL_EN != 0)
+  if (TASK_ARENA(p_task))
+  {
+    // Take exclusive access since the arena is shared by the pool's tasks.
+    sched_port_lock();
+
+    // Return any previously reserved space before reserving space for the data.
+    arena_release(p_task);
+    if (p_task->allocated && (data_size > 0))
+    {
+      TASK_DATA(p_task) = arena_reserve(task_pool(p_task), data_size);
+      if (TASK_DATA(p_task) != NULL)
+      {
+        TASK_BUFF_SIZE(p_task) = data_size;
+      }
+    }
+
+    sched_port_free();
+
+    return TASK_DATA(p_task);
+  }
+#endif
+
+  if (!TASK_BUFFERED(p_task))
+  {
+    return NULL;
+  }
+
+  TASK_DATA_SIZE(p_task) = 0;
+
+  if ((data_size == 0) || (data_size > TASK_BUFF_SIZE(p_task)))
+  {
+    return NULL;
+  }
+
+  return TASK_DATA(p_task);
+}
+
+uint8_t *sched_task_data_reserve(sched_task_t *p_task, uint8_t data_size)
+{
+
+  // Data can only be reserved for stopped tasks.
+  if ((p_task == NULL) || (p_task->state != SCHED_TASK_STOPPED))
+  {
+    return NULL;
+  }
+
+  return task_data_reserve(p_task, data_size);
+}
+
+uint8_t sched_task_data_commit(sched_task_t *p_task, uint8_t data_size)
+{
+
+  // Data can only be committed to stopped buffered tasks.
+  if ((p_task == NULL) || (p_task->state != SCHED_TASK_STOPPED) ||
+      !TASK_BUFFERED(p_task))
+  {
+    return 0;
+  }
+
+  // Limit the data size to the reserved buffer size.
+  TASK_DATA_SIZE(p_task) = SCHED_MIN(data_size, TASK_BUFF_SIZE(p_task));
+
+  return TASK_DATA_SIZE(p_task);
+}
+
+uint8_t sched_task_data(sched_task_t *p_task, const void *p_data, uint8_t data_size)
+{
+
+  // Data can only be set for stopped tasks.
+  if ((p_task == NULL) || (p_task->state != SCHED_TASK_STOPPED))
+  {
+    return 0;
+  }
+
+  if (TASK_BUFFERED(p_task) || TASK_ARENA(p_task))
+  {
+    // Limit the data size to a buffered task's buffer size.
+    if (!TASK_ARENA(p_task))
     {
-      // Both tasks are active, compare the remaining time.
-      if (sched_task_remaining_ms(p_task_a) <= sched_task_remaining_ms(p_task_b))
+      data_size = SCHED_MIN(data_size, TASK_BUFF_SIZE(p_task));
+    }
+
+    if (p_data == NULL)
+    {
+      data_size = 0;
+    }
+
+    // Reserve space in the task's buffer and copy the data into it.
+    uint8_t *p_buff = task_data_reserve(p_task, data_size);
+    if (p_buff == NULL)
+    {
+      return sched_task_data_commit(p_task, 0);
+    }
+    memcpy(p_buff, (uint8_t *)p_data, data_size);
+    return sched_task_data_commit(p_task, data_size);
+  }
+  else if (TASK_DATA_STORED(p_task))
+  {
+    // Just set the data pointer and data size for an unbuffered task.
+    TASK_DATA(p_task) = (uint8_t *)p_data;
+    TASK_DATA_SIZE(p_task) = data_size;
+  }
+  else
+  {
+    // Unbuffered tasks don't store data with the compact task layout.
+    return 0;
+  }
+
+  // Return the data size.
+  return TASK_DATA_SIZE(p_task);
+}
+
+bool sched_task_stop(sched_task_t *p_task)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+  // Take exclusive access since the task que may need to be updated.
+  sched_port_lock();
+
+  if (p_task->state == SCHED_TASK_UNINIT)
+  {
+
+    // A task must have been previously initialized.
+    sched_port_free();
+    return false;
+  }
+  else if (p_task->state == SCHED_TASK_ACTIVE)
+  {
+
+    // Active task can move to the stopped state immediately.
+    p_task->state = SCHED_TASK_STOPPED;
+
+#if (SCHED_TASK_BATCH_EN != 0)
+    // A stopped task isn't executed by a batch.
+    p_task->dispatch = false;
+#endif
+
+    // A task is no longer allocated once stopped.
+    task_pool_release(p_task);
+
+    // Stopped tasks are removed from the que and later from the task list.
+    scheduler_t *p_sched = task_sched(p_task);
+    que_task_remove(p_sched, p_task);
+    task_list_prune_mark(p_task);
+    power_task_remove(p_sched, p_task);
+
+    // The stopped task may have been the next expiring task.
+    que_updated_set(p_sched);
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST) && (SCHED_QUE_CACHE_EN == 0)
+    p_sched->updated = true;
+#endif
+
+    TRACE(p_sched, SCHED_TRACE_TASK_STOP, p_task, sched_port_ticks());
+  }
+  else if (p_task->state == SCHED_TASK_EXECUTING)
+  {
+    /* Executing tasks move to the stopping state since their
+     * handlers are currently executing. The stop will complete
+     * after the handler returns.
+     */
+    p_task->state = SCHED_TASK_STOPPING;
+  }
+#if (SCHED_EVENT_EN != 0)
+  else if (p_task->state == SCHED_TASK_WAITING)
+  {
+    // Waiting tasks aren't stored in the que, they only leave the wait list.
+    event_wait_remove(p_task);
+
+    // A task is no longer allocated once stopped.
+    task_pool_release(p_task);
+
+    TRACE(task_sched(p_task), SCHED_TRACE_TASK_STOP, p_task, sched_port_ticks());
+  }
+#endif
+
+  sched_port_free();
+
+  return true;
+}
+
+/***** Scheduler Message Task Functions *****/
+
+#if (SCHED_TASK_MSG_EN != 0)
+
+uint8_t sched_task_msg_post(sched_task_t *p_task, const void *p_data, uint8_t data_size)
+{
+
+  // A message task and a message must be supplied.
+  if ((p_task == NULL) || (p_task->p_msg == NULL) || (p_data == NULL) || (data_size == 0))
+  {
+    return 0;
+  }
+
+  // Take exclusive access since the FIFO is shared with the task's handler.
+  sched_port_lock();
+
+  sched_msg_fifo_t *p_msg = p_task->p_msg;
+
+  if ((p_task->state == SCHED_TASK_UNINIT) || (p_msg->pending >= p_msg->msg_cnt))
+  {
+    // The task must be configured and the FIFO must have a free slot.
+    sched_port_free();
+    return 0;
+  }
+
+  /* Start a stopped task, or restart a task which is stopping inside of its
+   * handler.  Active tasks are left alone so the messages are collected.
+   */
+  if ((p_task->state == SCHED_TASK_STOPPED) || (p_task->state == SCHED_TASK_STOPPING))
+  {
+    if (!task_start_event(p_task))
+    {
+      sched_port_free();
+      return 0;
+    }
+  }
+
+  uint8_t slot = (uint8_t)((p_msg->head + p_msg->pending) % p_msg->msg_cnt);
+  uint8_t msg_size = SCHED_MIN(data_size, p_msg->msg_size);
+  memcpy(&p_msg->p_buff[slot * p_msg->msg_size], p_data, msg_size);
+  p_msg->p_sizes[slot] = msg_size;
+  p_msg->pending++;
+
+  sched_port_free();
+
+  return msg_size;
+}
+
+uint8_t sched_task_msg_read(sched_task_t *p_task, void *p_data, uint8_t buff_size)
+{
+
+  // A message task and a buffer must be supplied.
+  if ((p_task == NULL) || (p_task->p_msg == NULL) || (p_data == NULL))
+  {
+    return 0;
+  }
+
+  // Take exclusive access since messages may be posted from an interrupt.
+  sched_port_lock();
+
+  sched_msg_fifo_t *p_msg = p_task->p_msg;
+  uint8_t msg_size = 0;
+
+  if (p_msg->pending > 0)
+  {
+    uint8_t slot = p_msg->head;
+    msg_size = SCHED_MIN(p_msg->p_sizes[slot], buff_size);
+    memcpy(p_data, &p_msg->p_buff[slot * p_msg->msg_size], msg_size);
+
+    p_msg->head = (uint8_t)((slot + 1) % p_msg->msg_cnt);
+    p_msg->pending--;
+  }
+
+  sched_port_free();
+
+  return msg_size;
+}
+
+uint8_t sched_task_msg_pending(const sched_task_t *p_task)
+{
+  return ((p_task != NULL) && (p_task->p_msg != NULL)) ? p_task->p_msg->pending : 0;
+}
+
+#else // (SCHED_TASK_MSG_EN != 0)
+
+uint8_t sched_task_msg_post(sched_task_t *p_task, const void *p_data, uint8_t data_size)
+{
+  return 0; // Message tasks are disabled, always return 0.
+}
+
+uint8_t sched_task_msg_read(sched_task_t *p_task, void *p_data, uint8_t buff_size)
+{
+  return 0; // Message tasks are disabled, always return 0.
+}
+
+uint8_t sched_task_msg_pending(const sched_task_t *p_task)
+{
+  return 0; // Message tasks are disabled, always return 0.
+}
+
+#endif // (SCHED_TASK_MSG_EN != 0)
+
+/***** Scheduler Event Functions *****/
+
+bool sched_task_event(sched_task_t *p_task, sched_event_t *p_event)
+{
+
+  // A pointer to the task must be supplied.
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+#if (SCHED_EVENT_EN != 0)
+  // Take exclusive access since the task's state could change.
+  sched_port_lock();
+
+  bool success = true;
+  if (p_task->state == SCHED_TASK_STOPPED)
+  {
+    p_task->p_event = p_event;
+  }
+  else if ((p_task->state == SCHED_TASK_EXECUTING) || (p_task->state == SCHED_TASK_STOPPING))
+  {
+    /* The task is bound or unbound from inside of its own handler, the new
+     * binding takes effect once the handler returns.
+     */
+    if (p_event != NULL)
+    {
+      // A bound task waits for its event once the handler returns.
+      p_task->state = SCHED_TASK_EXECUTING;
+    }
+    else if (p_task->p_event != NULL)
+    {
+      if (p_task->repeat)
       {
-        return (sched_task_t *)p_task_a;
+        // A repeating task's next interval starts from now.
+        p_task->start_ms = sched_port_ticks();
+        que_task_update(task_sched(p_task), p_task);
       }
       else
       {
-        return (sched_task_t *)p_task_b;
+        // A non-repeating task is stopped unless the handler restarts it.
+        p_task->state = SCHED_TASK_STOPPING;
       }
     }
-    else
+    p_task->p_event = p_event;
+  }
+  else
+  {
+    // An active or waiting task can't be bound or unbound.
+    success = false;
+  }
+
+  sched_port_free();
+
+  return success;
+#else
+  (void)p_event;
+  return false;
+#endif
+}
+
+bool sched_event_signal(sched_event_t *p_event)
+{
+
+  // A pointer to the event must be supplied.
+  if (p_event == NULL)
+  {
+    return false;
+  }
+
+#if (SCHED_EVENT_EN != 0)
+  // Take exclusive access since the signaled task is added to the que.
+  sched_port_lock();
+
+  bool signaled = true;
+  sched_task_t *p_task = p_event->p_wait;
+
+  if (p_task != NULL)
+  {
+    // Start the first waiting task, which marks its instance's que as updated.
+    event_wait_remove(p_task);
+    if (!task_start(p_task))
     {
-      // Only Task A is active.
-      return (sched_task_t *)p_task_a;
+      // The task keeps waiting at the front of the list if the que is full.
+      p_task->p_wait_next = p_event->p_wait;
+      p_event->p_wait = p_task;
+      p_task->state = SCHED_TASK_WAITING;
+      power_task_add(task_sched(p_task), p_task);
+      signaled = false;
     }
   }
-  else if (TASK_ACTIVE_SAFE(p_task_b))
+  else if (p_event->count < SCHED_EVENT_LIMIT(p_event->count_max))
   {
-    // Only Task B is active
-    return (sched_task_t *)p_task_b;
+    // Count the signal for the next task to wait.
+    p_event->count++;
   }
   else
   {
-    // Neither task is active.
-    return NULL;
+    // The count limit was reached, the signal is lost.
+    signaled = false;
   }
+
+  sched_port_free();
+
+  return signaled;
+#else
+  return false;
+#endif
 }
 
-/***** Internal Scheduler Functions *****/
+uint16_t sched_event_count(const sched_event_t *p_event)
+{
+  return (p_event != NULL) ? p_event->count : 0;
+}
+
+/***** Scheduler Task Post Que Functions *****/
 
-#if (SCHED_TASK_CACHE_EN != 0)
+#if (SCHED_TASK_POST_SIZE != 0)
 
 /**
- * @brief Function for atomically getting a copy of the updated flag and 
- * clearing it in one function call.
+ * @brief Internal function for adding an operation to the task post que.
  *
- * After taking exclusive access to the scheduler's data structure, the 
- * function makes a copy of updated flag, clears the flag, releases exclusive 
- * access and returns the original flag value.
+ * The function doesn't take the scheduler lock.  It must only be called from
+ * a single context at a time.  Each scheduler instance has its own post que
+ * ring.
  *
- * @return  The value of the updated flag before it was cleared.
+ * @param[in] p_task       Pointer to the task.
+ * @param[in] op           The operation to post.
+ * @param[in] interval_ms  The new interval for a POST_UPDATE. (ticks)
+ *
+ * @retval True if the operation was posted.
+ * @retval False if the task pointer was NULL or the que was full.
  */
-static inline bool sched_updated_get_clear(void)
+static bool task_post(sched_task_t *p_task, post_op_t op, sched_time_t interval_ms)
 {
-  sched_port_lock();
-  bool updated = scheduler.updated;
-  scheduler.updated = false;
-  sched_port_free();
-  return updated;
+  if (p_task == NULL)
+  {
+    return false;
+  }
+
+  // Posts are drained by the instance whose que stores the task.
+  scheduler_t *p_sched = task_sched(p_task);
+
+  uint16_t head = p_sched->post_head;
+  if ((uint16_t)(head - p_sched->post_tail) >= SCHED_TASK_POST_SIZE)
+  {
+    // The que is full.
+    return false;
+  }
+
+  post_t *p_post = &p_sched->posts[head & (SCHED_TASK_POST_SIZE - 1)];
+  p_post->p_task = p_task;
+  p_post->interval_ms = interval_ms;
+  p_post->op = op;
+
+  // The entry must be written before it is published to the scheduler.
+  POST_BARRIER();
+  p_sched->post_head = head + 1;
+
+  // End the instance's sleep so the post is applied.
+  sched_port_wake();
+
+  return true;
 }
 
 /**
- * @brief Function for atomically setting the scheduler's updated flag.
+ * @brief Internal function for checking if the task post que is empty.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
+ * @retval True if no posts are waiting.
+ * @retval False otherwise.
  */
-static inline void sched_updated_set(void)
-{
-  sched_port_lock();
-  scheduler.updated = true;
-  sched_port_free();
-}
-
-#else
-static inline void sched_updated_set(void)
+static inline bool post_que_empty(scheduler_t *p_sched)
 {
-  // Empty
+  return p_sched->post_head == p_sched->post_tail;
 }
 
-#endif // (SCHED_TASK_CACHE_EN != 0)
-
 /**
- * @brief Internal function for removing all tasks from the scheduler's que.
+ * @brief Internal function for applying every waiting task post.
+ *
+ * Must be called from the main context.  The posts are applied in order with
+ * the normal task functions which take the scheduler lock as usual.
+ *
+ * @param[in] p_sched  Pointer to the scheduler instance.
  */
-static void sched_clear_que(void)
+static void post_que_drain(scheduler_t *p_sched)
 {
+  uint16_t tail = p_sched->post_tail;
 
-  // Get exclusive que access.
-  sched_port_lock();
+  while (tail != p_sched->post_head)
+  {
+    // The entry must be read after reading the published head index.
+    POST_BARRIER();
+    post_t post = p_sched->posts[tail & (SCHED_TASK_POST_SIZE - 1)];
 
-  // Walk through the task list starting at the head.
-  sched_task_t *p_current_task = (sched_task_t *)scheduler.p_head;
+    // The entry must be copied before it is released to the posting context.
+    POST_BARRIER();
+    tail++;
+    p_sched->post_tail = tail;
 
-  while (p_current_task != NULL)
-  {
-    // Set each task as uninitialized.
-    p_current_task->state = SCHED_TASK_UNINIT;
+    switch (post.op)
+    {
+    case POST_START:
+      sched_task_start(post.p_task);
+      break;
 
-    // Move to the next task in the linked list
-    p_current_task = p_current_task->p_next;
-  }
+    case POST_STOP:
+      sched_task_stop(post.p_task);
+      break;
 
-  // Clear the task references.
-  scheduler.p_head = NULL;
-  scheduler.p_tail = NULL;
+    case POST_UPDATE:
+      sched_task_update(post.p_task, post.interval_ms);
+      break;
 
-  // Release the que lock.
-  sched_port_free();
+    default:
+      assert(false);
+      break;
+    }
+  }
 }
 
-/**
- * @brief Internal function for completing a scheduler stop.
- *
- * The function is called once the scheduler finishes executing all expired 
- * task's handlers to complete a scheduler stop.
- */
-static void sched_stop_finalize(void)
+bool sched_task_post_start(sched_task_t *p_task)
 {
-  if (scheduler.state == SCHED_STATE_STOPPING)
-  {
-    // Clear the que.
-    sched_clear_que();
+  return task_post(p_task, POST_START, 0);
+}
 
-    // Perform any platform-specific deinitialization last.
-    sched_port_deinit();
+bool sched_task_post_stop(sched_task_t *p_task)
+{
+  return task_post(p_task, POST_STOP, 0);
+}
 
-    scheduler.state = SCHED_STATE_STOPPED;
-  }
+bool sched_task_post_update(sched_task_t *p_task, sched_time_t interval_ms)
+{
+  return task_post(p_task, POST_UPDATE, interval_ms);
 }
-/**
- * @brief Internal function for executing an expired task's handler function.
- *
- * Note that the task is not checked to be active or for expiration.
- */
-static void task_execute_handler(sched_task_t *p_task)
+
+#else // (SCHED_TASK_POST_SIZE != 0)
+
+// The post que is always empty when disabled.
+static inline bool post_que_empty(scheduler_t *p_sched)
 {
+  return true;
+}
 
-  assert(p_task != NULL);
-  if (p_task->repeat)
-  {
-    /* A repeating task will be in the executing state while inside of
-     * its handler.
-     */
-    p_task->state = SCHED_TASK_EXECUTING;
+static inline void post_que_drain(scheduler_t *p_sched)
+{
+  // Empty
+}
 
-    /* Update the start time before calling the handler so the handler's
-     * execution time doesn't introduce error.  The start time only needs
-     * to be updated for repeating tasks.
-     */
-    p_task->start_ms = sched_port_ms();
-  }
-  else
-  {
-    /* A non-repeating task will be in the stopping state while executing
-     * its handler.  It will be stopped once the handler returns.
-     */
-    p_task->state = SCHED_TASK_STOPPING;
-  }
+bool sched_task_post_start(sched_task_t *p_task)
+{
+  return false; // The post que is disabled, always return false.
+}
 
-  // Call the task's handler function.
-  sched_handler_t handler = (sched_handler_t)p_task->p_handler;
-  assert(handler != NULL);
-  handler(p_task, p_task->p_data, p_task->data_size);
+bool sched_task_post_stop(sched_task_t *p_task)
+{
+  return false; // The post que is disabled, always return false.
+}
 
-  // Update the task state after the handler finishes.
-  if (p_task->state == SCHED_TASK_EXECUTING)
-  {
-    // Executing tasks move back to the active state.
-    p_task->state = SCHED_TASK_ACTIVE;
-  }
-  else
-  {
-    assert(p_task->state == SCHED_TASK_STOPPING);
-    // Stopping tasks move to the stopped state.
-    p_task->state = SCHED_TASK_STOPPED;
-    // A task is no longer allocated once its stopped.
-    p_task->allocated = false;
-  }
+bool sched_task_post_update(sched_task_t *p_task, sched_time_t interval_ms)
+{
+  return false; // The post que is disabled, always return false.
 }
 
+#endif // (SCHED_TASK_POST_SIZE != 0)
+
+/***** Scheduler Task Pool Functions *****/
+
+#if (SCHED_TASK_POOL_EN != 0)
+
 /**
- * @brief Internal function for executing tasks in the scheduler's task que
- * which have expired intervals.
+ * @brief Internal function for initializing a scheduler task pool.
  *
- * The function first checks the cached next task for expiration.  If it is
- * valid and unexpired, the function returns immediately.
+ * Every task in the pool is marked as free in the pool's free task bitmap.
+ * Must be called with exclusive access to the scheduler's data structure.
  *
- * If cached next task has expired or is invalid, the function services any
- * expired task in the que and stores next expiring task for future use.
- *
- * @return The time until expiration of the next expiring task in mS or
- *         SCHED_MS_MAX if no active tasks were found.
+ * @param[in] p_pool      Pointer to the task pool.
+ * @param[in] pool_index  The pool's index in the pool table plus one.
  */
-static uint32_t sched_execute_que(void)
+static void sched_task_pool_init(sched_task_pool_t *p_pool, uint8_t pool_index)
 {
 
-  // Get the current time.
-  uint32_t now_time_ms = sched_port_ms();
-
-#if (SCHED_TASK_CACHE_EN != 0)
-  // Store next expiring task statically to persist it across calls.
-  static sched_task_t *p_next_task = NULL;
+  assert(p_pool != NULL);
+  assert(p_pool->p_data != NULL);
+  assert(p_pool->p_tasks != NULL);
+  assert(p_pool->p_free != NULL);
+#if (SCHED_TASK_COMPACT_EN != 0)
+  assert(p_pool->p_buffs != NULL);
+#endif
 
-  // Check the updated flag and clear it.
-  if (!sched_updated_get_clear())
+  for (uint8_t index = 0; index < p_pool->task_cnt; index++)
   {
-    // No tasks have been been updated so attempt to service the cached next task.
-    if ((p_next_task != NULL) && (p_next_task->state == SCHED_TASK_ACTIVE))
-    {
+    sched_task_t *p_task = &p_pool->p_tasks[index];
 
-      // Calculate the cached task's time until expiration.
-      uint32_t cache_task_ms = task_time_remaining_ms(p_next_task, now_time_ms);
+#if (SCHED_TASK_COMPACT_EN != 0)
+    // The task's data is stored in its data record.
+    p_task->p_buff = &p_pool->p_buffs[index];
+#endif
 
-      if (cache_task_ms == 0)
-      {
-        // The cached next task has expired, execute its handler.
-        task_execute_handler(p_next_task);
-      }
-      else
-      {
-        /* The next task has not expired yet so return the time remaining until
-         * expiration so the processor can go back to sleep.
-         */
-        return cache_task_ms;
-      }
+    /* Set the task's data pointer to the buffer location, arena pool tasks
+     * don't have a buffer until their data is set.
+     */
+    if (p_pool->p_arena_free == NULL)
+    {
+      TASK_DATA(p_task) = p_pool->p_data + (index * p_pool->buff_size);
+    }
+    else
+    {
+      TASK_DATA(p_task) = NULL;
     }
-  }
-  // Clear the cached next task since its either been serviced or is invalid.
-  p_next_task = NULL;
-#else
-  // The next expiring task, doesn't need to be static if the cache is disabled.
-  sched_task_t *p_next_task = NULL;
-#endif
 
-  /* The next expiring task's time until expiration.  The time until
-   * expiration is stored in addition the task pointer.  This improves the
-   * task loop efficiency since the  loop does not have to recalculate the
-   * interval each time through the loop.
-   */
-  uint32_t next_task_ms = UINT32_MAX;
+    // Set the task's buffer size.
+    TASK_BUFF_SIZE(p_task) = p_pool->buff_size;
 
-  // Start searching for the next expiring task at the start of the linked list.
-  sched_task_t *p_search_task = (sched_task_t *)scheduler.p_head;
+    p_task->pool_index = pool_index;
+    p_task->allocated = false;
+    p_task->state = SCHED_TASK_UNINIT;
+  }
 
-  while (p_search_task != NULL)
+  // Set a free bit for each task, the unused bits of the last word stay clear.
+  uint32_t word_cnt = SCHED_POOL_FREE_WORDS(p_pool->task_cnt);
+  for (uint32_t word = 0; word < word_cnt; word++)
   {
+    uint32_t bit_cnt = p_pool->task_cnt - (word * 32);
+    p_pool->p_free[word] = (bit_cnt >= 32) ? UINT32_MAX : ((1UL << bit_cnt) - 1);
+  }
+  p_pool->free_cnt = p_pool->task_cnt;
 
-    // Filter on active tasks.
-    if (p_search_task->state == SCHED_TASK_ACTIVE)
-    {
-
-      // Calculate the search task's remaining time.
-      uint32_t search_task_ms = task_time_remaining_ms(p_search_task, now_time_ms);
-
-      if (search_task_ms == 0)
-      {
-        /* Execute the search task's handler if the task has expired.
-         *
-         * Note that the scheduler only moves to the next task in the list
-         * once the task is unexpired.  The search task's expiration time is
-         * recalculated each time its handler returns since the task interval
-         * may have been modified inside the handler.  This carries the risk
-         * that an an always expiring task could potentially starve the other
-         * tasks of processor cycles if it were to repeatably restart itself
-         * with an expired interval inside its own handler.
-         */
-        task_execute_handler(p_search_task);
-      }
-      else
-      {
-        /* If the search task expires before the previously found next expiring
-         * task, it becomes the next expiring task.
-         */
-        if (search_task_ms < next_task_ms)
-        {
-          p_next_task = p_search_task;
-          next_task_ms = search_task_ms;
-        }
-        // Move to the next task in the list
-        p_search_task = p_search_task->p_next;
-      }
-    }
-    else
+  // Set a free bit for each block of the data arena.
+  if (p_pool->p_arena_free != NULL)
+  {
+    assert(p_pool->arena_blocks > 0);
+    word_cnt = (p_pool->arena_blocks + 31) / 32;
+    for (uint32_t word = 0; word < word_cnt; word++)
     {
-      // Move to the next task in the list if the search task is inactive.
-      p_search_task = p_search_task->p_next;
+      uint32_t bit_cnt = p_pool->arena_blocks - (word * 32);
+      p_pool->p_arena_free[word] = (bit_cnt >= 32) ? UINT32_MAX : ((1UL << bit_cnt) - 1);
     }
+    p_pool->arena_free_cnt = p_pool->arena_blocks;
   }
 
-  /* Recalculate the next task's expiration time using the current mS timer
-   * value to improve the accuracy of the sleep interval in cases were the task
-   * execution time was significant.
-   */
-  return sched_task_remaining_ms(p_next_task);
+  p_pool->initialized = true;
 }
 
-/***** External Scheduler Task Functions *****/
-
-bool sched_task_config(sched_task_t *p_task, sched_handler_t handler,
-                       uint32_t interval_ms, bool repeat)
+sched_task_t *sched_task_alloc(sched_task_pool_t *p_pool)
 {
 
-  // A pointer to the task and its handler must be supplied.
-  if ((p_task == NULL) || (handler == NULL))
+  // A pool's tasks must be linkable, only the first task needs to be checked.
+  if ((p_pool == NULL) || !task_linkable(p_pool->p_tasks))
   {
-    return false;
+    return NULL;
   }
 
-  if (scheduler.state == SCHED_STATE_STOPPED)
-  {
-    // Task's can only be configured after the scheduler has been initialized.
-    return false;
-  }
+  sched_task_t *p_task = NULL;
 
-  if (p_task->state == SCHED_TASK_UNINIT)
+  /* Acquire the scheduler lock so the pool can be initialized and the task
+   * can be allocated without interruption.
+   */
+  sched_port_lock();
+
+  // Allocated tasks are configured in the default instance's que.
+  if (sched_instances[SCHED_INSTANCE_DEFAULT].state == SCHED_STATE_ACTIVE)
   {
 
-    /* Add the task to the scheduler's que if it hasn't been previously added.
-     * The new task will be the last one in the list so its next task will
-     * always be NULL.
+    /* Register and initialize the pool of buffered tasks if not previously
+     * initialized, a pool can't be used once the pool table is full.
      */
-    p_task->p_next = NULL;
-
-    // Take exclusive write access of scheduler's task que.
-    sched_port_lock();
-
-    if (scheduler.p_head == NULL)
+    if ((p_pool->initialized == false) && (pool_cnt < SCHED_TASK_POOL_MAX))
     {
-      /* No other tasks exists in the list, the new task will be both the
-       * head & tail task.
-       */
-      scheduler.p_head = p_task;
+      pool_table[pool_cnt++] = p_pool;
+      sched_task_pool_init(p_pool, pool_cnt);
     }
-    else
+
+    if (p_pool->initialized && (p_pool->free_cnt > 0))
     {
-      /* The head task has already been set so this task will be the next task
-       * for the current tail task.
-       */
-      assert(scheduler.p_tail != NULL);
-      scheduler.p_tail->p_next = p_task;
-    }
-    // Set the new task to the tail task so it is added to the end of the list.
-    scheduler.p_tail = p_task;
 
-    // Release the task que exclusive access.
-    sched_port_free();
-  }
-  else if (p_task->state != SCHED_TASK_STOPPED)
-  {
-    // A task can only be configured in the uninitialized or stopped states.
-    return false;
-  }
+      // Find the first bitmap word with a free task.
+      uint32_t word = 0;
+      while (p_pool->p_free[word] == 0)
+      {
+        word++;
+        assert(word < SCHED_POOL_FREE_WORDS(p_pool->task_cnt));
+      }
 
-  // Clear the task data buffer.
-#if (SCHED_TASK_BUFF_CLEAR_EN != 0)
-  if (TASK_BUFFERED(p_task))
-  {
-    memset(p_task->p_data, 0x00, p_task->buff_size);
-  }
-#endif
+      // Take the lowest free task in the word.
+      uint32_t bit = bit_first(p_pool->p_free[word]);
+      p_pool->p_free[word] &= ~(1UL << bit);
+      p_pool->free_cnt--;
 
-  // Store the task handler.
-  p_task->p_handler = handler;
+      p_task = &p_pool->p_tasks[(word * 32) + bit];
+      assert(!p_task->allocated);
 
-  // Store the repeating status.
-  p_task->repeat = repeat;
+      // Mark the task as allocated.
+      p_task->allocated = true;
 
-  // Store the task interval.
-  task_interval_set(p_task, interval_ms);
+      // Reset the task data size.
+      TASK_DATA_SIZE(p_task) = 0;
+    }
+  }
 
-  // Tasks will always be in the stopped state after configuration.
-  p_task->state = SCHED_TASK_STOPPED;
+  sched_port_free();
 
-  return true;
+  // Return the allocated task, NULL if the pool has no free tasks.
+  return p_task;
 }
 
-bool sched_task_start(sched_task_t *p_task)
+uint8_t sched_pool_allocated(const sched_task_pool_t *p_pool)
 {
 
-  // A pointer to the task must be supplied.
-  if (p_task == NULL)
+  if ((p_pool == NULL) || (p_pool->initialized == false))
   {
-    return false;
+    return 0;
   }
 
-  if (p_task->state == SCHED_TASK_UNINIT)
+  return p_pool->task_cnt - p_pool->free_cnt;
+}
+
+uint8_t sched_pool_free(const sched_task_pool_t *p_pool)
+{
+  if (p_pool == NULL)
   {
-    // A task must be configured before it can be started.
-    return false;
+    return 0;
   }
-  else if (p_task->state == SCHED_TASK_STOPPED)
-  {
-    // Set the task to active if it is currently stopped.
-    p_task->state = SCHED_TASK_ACTIVE;
 
-    /* Set the updated flag to indicate that the newly started task might
-     * have invalidated the cached expiring task.
-     */
-    sched_updated_set();
+  // Every task in an uninitialized pool is free.
+  if (p_pool->initialized == false)
+  {
+    return p_pool->task_cnt;
   }
-  else if (p_task->state == SCHED_TASK_STOPPING)
+
+  return p_pool->free_cnt;
+}
+
+uint32_t sched_pool_arena_free(const sched_task_pool_t *p_pool)
+{
+  if ((p_pool == NULL) || (p_pool->p_arena_free == NULL))
   {
-    /* Set the task to executing if it is currently stopping. This could happen
-     * if the task is started inside an ISR while executing its handler or
-     * more commonly if a non-repeating task restarts itself inside its
-     * own handler.  Don't set the updated flag in the case since the cached
-     * next expiring task will be updated on handler return if needed.
-     */
-    p_task->state = SCHED_TASK_EXECUTING;
+    return 0;
   }
 
-  // Store the start time as now.
-  p_task->start_ms = sched_port_ms();
+  // Every block of an uninitialized pool's arena is free.
+  uint32_t free_cnt = p_pool->initialized ? p_pool->arena_free_cnt : p_pool->arena_blocks;
+  return free_cnt * SCHED_TASK_ARENA_BLOCK_SIZE;
+}
 
-  return true;
+#else // (SCHED_TASK_POOL_EN != 0)
+
+sched_task_t *sched_task_alloc(sched_task_pool_t *p_pool)
+{
+  return NULL; // Task pools are disabled, always return NULL.
 }
 
-bool sched_task_update(sched_task_t *p_task, uint32_t interval_ms)
+uint8_t sched_pool_allocated(const sched_task_pool_t *p_pool)
+{
+  return 0; // Task pools are disabled, always return 0.
+}
+
+uint8_t sched_pool_free(const sched_task_pool_t *p_pool)
+{
+  return 0; // Task pools are disabled, always return 0.
+}
+
+uint32_t sched_pool_arena_free(const sched_task_pool_t *p_pool)
+{
+  return 0; // Task pools are disabled, always return 0.
+}
+#endif
+
+/***** Scheduler Task Table Functions *****/
+
+bool sched_task_table_start(const sched_task_table_t *p_table)
 {
 
-  // A pointer to the task must be supplied.
-  if (p_task == NULL)
+  if ((p_table == NULL) || (p_table->p_entries == NULL) || (p_table->p_tasks == NULL))
   {
     return false;
   }
-  // Store the new interval.
-  task_interval_set(p_task, interval_ms);
-
-  // Start the task.
-  return sched_task_start(p_task);
-}
-
-uint8_t sched_task_data(sched_task_t *p_task, const void *p_data, uint8_t data_size)
-{
 
-  // Data can only be set for stopped tasks.
-  if ((p_task == NULL) || (p_task->state != SCHED_TASK_STOPPED))
+  // The entries must be listed from the highest priority to the lowest.
+  for (uint8_t index = 0; index < p_table->task_cnt; index++)
   {
-    return 0;
+    const sched_task_entry_t *p_entry = &p_table->p_entries[index];
+    if ((p_entry->handler == NULL) || (p_entry->priority >= SCHED_TASK_PRIORITY_LEVELS) ||
+        ((index > 0) && (p_entry->priority > p_table->p_entries[index - 1].priority)))
+    {
+      return false;
+    }
   }
 
-  // Store the data size.
-  p_task->data_size = data_size;
+  /* Take exclusive access once for the whole table.  The started tasks are
+   * appended to the task list in the order of the table, so the task list
+   * steps through the table's array in order.
+   */
+  sched_port_lock();
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+  // The number of table tasks started in each instance's que heap.
+  uint16_t heap_add_cnt[SCHED_INSTANCE_CNT] = {0};
+#endif
 
-  if (TASK_BUFFERED(p_task))
+  /* Check every task before changing any of them so that the table is
+   * either started as a whole or left unchanged.
+   */
+  bool success = true;
+  for (uint8_t index = 0; success && (index < p_table->task_cnt); index++)
   {
-    // Limit the data size to the task buffer size.
-    if (p_task->data_size > p_task->buff_size)
+    sched_task_t *p_task = &p_table->p_tasks[index];
+
+    // New tasks are configured in the default instance as with sched_task_config().
+    scheduler_t *p_sched = (p_task->state == SCHED_TASK_UNINIT)
+                               ? &sched_instances[SCHED_INSTANCE_DEFAULT]
+                               : task_sched(p_task);
+
+    success = ((p_task->state == SCHED_TASK_UNINIT) || (p_task->state == SCHED_TASK_STOPPED)) &&
+              task_linkable(p_task) && (p_sched->state != SCHED_STATE_STOPPED);
+
+    if (success && p_table->p_entries[index].start)
     {
-      p_task->data_size = p_task->buff_size;
+      success = (p_sched->state == SCHED_STATE_ACTIVE);
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+      uint16_t *p_add_cnt = &heap_add_cnt[p_sched - sched_instances];
+      (*p_add_cnt)++;
+      success = success && ((p_sched->heap_cnt + *p_add_cnt) <= SCHED_QUE_HEAP_SIZE);
+#endif
     }
+  }
 
-    if (p_data == NULL)
+  // Once checked, configuring and starting the tasks can't fail.
+  for (uint8_t index = 0; success && (index < p_table->task_cnt); index++)
+  {
+    const sched_task_entry_t *p_entry = &p_table->p_entries[index];
+    sched_task_t *p_task = &p_table->p_tasks[index];
+
+    success = sched_task_config(p_task, p_entry->handler, p_entry->interval_ms, p_entry->repeat);
+    if (!success)
     {
-      p_task->data_size = 0;
+      break;
     }
-    else
+
+#if (SCHED_TASK_PRIORITY_LEVELS > 1)
+    p_task->priority = p_entry->priority;
+#endif
+    if (p_entry->start)
     {
-      // Copy the data into the task data buffer.
-      memcpy(p_task->p_data, (uint8_t *)p_data, p_task->data_size);
+      success = task_start_event(p_task);
     }
   }
-  else
-  {
-    // Just set the data pointer for an unbuffered task.
-    p_task->p_data = (uint8_t *)p_data;
-  }
 
-  // Return the data size.
-  return p_task->data_size;
+  sched_port_free();
+
+  return success;
 }
 
-bool sched_task_stop(sched_task_t *p_task)
+/***** External Scheduler Functions *****/
+
+void sched_instance_init(sched_instance_t instance)
 {
 
-  // A pointer to the task must be supplied.
-  if (p_task == NULL)
+  if (instance >= SCHED_INSTANCE_CNT)
   {
-    return false;
+    return;
   }
 
-  if (p_task->state == SCHED_TASK_UNINIT)
-  {
+  scheduler_t *p_sched = &sched_instances[instance];
 
-    // A task must have been previously initialized.
-    return false;
-  }
-  else if (p_task->state == SCHED_TASK_ACTIVE)
+  // Start the scheduler instance if not currently running.
+  if (p_sched->state == SCHED_STATE_STOPPED)
   {
 
-    // Active task can move to the stopped state immediately.
-    p_task->state = SCHED_TASK_STOPPED;
+    // Perform any platform-specific initialization first, once for all instances.
+    if (!sched_instances_running())
+    {
+      sched_port_init();
+    }
 
-    // A task is no longer allocated once stopped.
-    p_task->allocated = false;
-  }
-  else if (p_task->state == SCHED_TASK_EXECUTING)
-  {
-    /* Executing tasks move to the stopping state since their
-     * handlers are currently executing. The stop will complete
-     * after the handler returns.
-     */
-    p_task->state = SCHED_TASK_STOPPING;
+    // Clear the task references.
+    p_sched->p_head = NULL;
+    p_sched->p_tail = NULL;
+    p_sched->prune = false;
+    que_reset(p_sched);
+#if (SCHED_TASK_POST_SIZE != 0)
+    // Discard any posts left from a previous run.
+    p_sched->post_tail = p_sched->post_head;
+#endif
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+    p_sched->updated = false;
+#endif
+#if (SCHED_STATS_EN != 0)
+    memset(&p_sched->stats, 0x00, sizeof(p_sched->stats));
+    p_sched->stats_running = false;
+#endif
+#if (SCHED_TASK_BUDGET_EN != 0)
+    p_sched->budget_overrun = false;
+#endif
+#if (SCHED_TASK_POWER_EN != 0)
+    p_sched->run_mode = SCHED_RUN_MODE_LOW;
+    memset(p_sched->sleep_cnt, 0x00, sizeof(p_sched->sleep_cnt));
+#endif
+    p_sched->state = SCHED_STATE_ACTIVE;
   }
-
-  return true;
 }
 
-/***** Scheduler Task Pool Functions *****/
+void sched_instance_start(sched_instance_t instance)
+{
 
-#if (SCHED_TASK_POOL_EN != 0)
+  if (instance >= SCHED_INSTANCE_CNT)
+  {
+    return;
+  }
 
-// Internal function for initializing a scheduler task pool.
-static void sched_task_pool_init(sched_task_pool_t *p_pool)
-{
+  scheduler_t *p_sched = &sched_instances[instance];
 
-  assert(p_pool != NULL);
-  assert(p_pool->p_data != NULL);
-  assert(p_pool->p_tasks != NULL);
+#if (SCHED_STATS_EN != 0)
+  // The instance is awake from the start.
+  sched_stats_mark(p_sched, false);
+  p_sched->stats_running = true;
+#endif
 
-  for (uint8_t index = 0; index < p_pool->task_cnt; index++)
+  /* Repeatably execute any expired tasks in the instance's task list,
+   * sleeping in between, until the instance is stopped.
+   */
+  while (p_sched->state == SCHED_STATE_ACTIVE)
   {
 
-    // Set the task's data pointer to the buffer location.
-    p_pool->p_tasks[index].p_data = p_pool->p_data + (index * p_pool->buff_size);
+    // Clear the que updated flag since the que is about to be searched.
+    p_sched->que_updated = false;
 
-    // Set the task's buffer size.
-    p_pool->p_tasks[index].buff_size = p_pool->buff_size;
+    // Apply any task starts, stops or updates posted from an interrupt.
+    post_que_drain(p_sched);
 
-    p_pool->p_tasks[index].allocated = false;
-    p_pool->p_tasks[index].state = SCHED_TASK_UNINIT;
-  }
+    // Unlink the tasks stopped since the last search from the task list.
+    task_list_prune(p_sched);
 
-  p_pool->initialized = true;
-}
+#if (SCHED_INSTANCE_CNT > 1)
+    p_sched->busy = true;
+#endif
 
-sched_task_t *sched_task_alloc(sched_task_pool_t *p_pool)
-{
+    // Execute tasks in the que with expired task intervals.
+    sched_time_t next_task_ms = sched_execute_que(p_sched);
 
-  if (p_pool == NULL)
-  {
-    return NULL;
-  }
+    // Only refresh the watchdog if every handler returned within its budget.
+#if (SCHED_TASK_BUDGET_EN != 0)
+    if (!p_sched->budget_overrun)
+    {
+      SCHED_HOOK_WATCHDOG_KICK();
+    }
+    p_sched->budget_overrun = false;
+#else
+    SCHED_HOOK_WATCHDOG_KICK();
+#endif
 
-  if (scheduler.state == SCHED_STATE_ACTIVE)
-  {
+#if (SCHED_INSTANCE_CNT > 1)
+    p_sched->busy = false;
+
+    if (next_task_ms > 0)
+    {
+      /* The instance is idle, steal an expired task from a busy instance
+       * and check back for more tasks to steal while sleeping.
+       */
+      sched_time_t steal_ms = sched_steal(p_sched);
+      next_task_ms = SCHED_MIN(next_task_ms, SCHED_MIN(steal_ms, SCHED_INSTANCE_STEAL_MS));
+    }
+#endif
 
-    // Initialize the pool of buffered tasks if not previously initialized.
-    if (p_pool->initialized == false)
+    if (next_task_ms == 0)
     {
-      sched_task_pool_init(p_pool);
+      continue;
     }
 
-    // Pointer to the current and last tasks in the pool.
-    sched_task_t *p_task_cur = p_pool->p_tasks;
-    sched_task_t *p_task_last = &p_pool->p_tasks[p_pool->task_cnt];
+    sched_time_t deadline_ms = sched_port_ticks() + SCHED_MIN(next_task_ms, SCHED_PORT_SLEEP_MS_MAX);
+#if (SCHED_TASK_POWER_EN != 0)
+    bool power_ready = false;
+    uint8_t sleep_limit = SCHED_SLEEP_MODE_ANY;
+#endif
 
-    // Search for the first unallocated task.
-    do
+    /* Sleep using the platform-specific sleep method until the next task
+     * expires.  If the processor wakes early, the que only needs to be
+     * searched again if a task was started, stopped or posted.  Don't sleep
+     * if the instance was stopped by a task handler.
+     */
+    while ((p_sched->state == SCHED_STATE_ACTIVE) && !p_sched->que_updated &&
+           post_que_empty(p_sched))
     {
-      if (!p_task_cur->allocated)
+#if (SCHED_TASK_POWER_EN != 0)
+      // The power modes only need to be prepared once per loop pass.
+      if (!power_ready)
+      {
+        sleep_limit = power_sleep_prepare(p_sched);
+        power_ready = true;
+      }
+
+      // The sleep state is selected again for the time left after an early wake.
+      sched_time_t wake_ms = power_sleep_select(sleep_limit, deadline_ms);
+#else
+      sched_time_t wake_ms = deadline_ms;
+#endif
+      SCHED_HOOK_SLEEP_ENTER(wake_ms);
+#if (SCHED_STATS_EN != 0)
+      sched_stats_mark(p_sched, true);
+#endif
+#if (SCHED_TRACE_SIZE != 0)
+      /* The sleep is recorded without the lock so tracing doesn't add a
+       * critical section to each sleep.  An early wake without a task change
+       * extends the recorded sleep.
+       */
+      if (!p_sched->trace_sleep_pending)
       {
+        p_sched->trace_sleep_ms = sched_port_ticks();
+      }
+#endif
 
-        /* Acquire the scheduler lock so the task can be allocated
-         * without interruption.
-         */
-        sched_port_lock();
+      sched_port_wake_t wake = sched_port_sleep_until(wake_ms);
 
-        // Check that the task is still unallocated
-        if (p_task_cur->allocated)
-        {
+#if (SCHED_TRACE_SIZE != 0)
+      p_sched->trace_wake_ms = sched_port_ticks();
+      p_sched->trace_sleep_pending = true;
+#endif
+#if (SCHED_STATS_EN != 0)
+      sched_stats_mark(p_sched, false);
+#endif
+      SCHED_HOOK_SLEEP_EXIT();
 
-          /* The task allocation status must have been changed
-           * from a different context before the task could be
-           * allocated. Release the lock and continue the search.
-           */
-          sched_port_free();
-        }
-        else
-        {
+      if (wake == SCHED_PORT_WAKE_DEADLINE)
+      {
+        break;
+      }
+    }
+  }
 
-          // Mark the task as allocated.
-          p_task_cur->allocated = true;
+#if (SCHED_STATS_EN != 0)
+  // End the final awake period.
+  sched_stats_mark(p_sched, false);
+  p_sched->stats_running = false;
+#endif
 
-          // Release the lock
-          sched_port_free();
+#if (SCHED_TASK_POWER_EN != 0)
+  // Leave the processor in the lowest run mode.
+  power_run_mode_set(p_sched, SCHED_RUN_MODE_LOW);
+#endif
 
-          // Reset the task data size.
-          p_task_cur->data_size = 0;
+  // Finish stopping the instance before returning.
+  sched_stop_finalize(p_sched);
+}
 
-          // Return the allocated task.
-          return p_task_cur;
-        }
-      }
-      // Increment the task pointer
-      p_task_cur++;
+void sched_instance_stop(sched_instance_t instance)
+{
 
-    } while (p_task_cur <= p_task_last);
+  if (instance >= SCHED_INSTANCE_CNT)
+  {
+    return;
   }
 
-  // No unallocated tasks were found.
-  return NULL;
+  scheduler_t *p_sched = &sched_instances[instance];
+
+  // Move to the stopping state if not already stopped.
+  if (p_sched->state != SCHED_STATE_STOPPED)
+  {
+    p_sched->state = SCHED_STATE_STOPPING;
+    sched_port_wake();
+  }
 }
 
-uint8_t sched_pool_allocated(const sched_task_pool_t *p_pool)
+bool sched_instance_stats(sched_instance_t instance, sched_stats_t *p_stats)
 {
 
-  if ((p_pool == NULL) || (p_pool->initialized == false))
+  // A valid instance and a pointer to the snapshot must be supplied.
+  if ((instance >= SCHED_INSTANCE_CNT) || (p_stats == NULL))
   {
-    return 0;
+    return false;
   }
 
-  // Count of the allocated pool tasks.
-  uint8_t alloc_count = 0;
+#if (SCHED_STATS_EN != 0)
+  scheduler_t *p_sched = &sched_instances[instance];
+  sched_time_t now_time_ms = sched_port_ticks();
 
-  // Pointer to the current and last tasks in the pool.
-  sched_task_t *p_task_cur = p_pool->p_tasks;
-  sched_task_t *p_task_last = &p_pool->p_tasks[p_pool->task_cnt];
+  // Take exclusive access so the statistics can't change during the copy.
+  sched_port_lock();
 
-  do
+  *p_stats = p_sched->stats;
+
+  // Include the current awake or sleep period.
+  if (p_sched->stats_running)
   {
-    if (!p_task_cur->allocated)
+    sched_time_t period_ms = now_time_ms - p_sched->stats_mark_ms;
+    if (p_sched->stats_sleeping)
+    {
+      p_stats->sleep_ms += period_ms;
+    }
+    else
     {
-      alloc_count++;
+      p_stats->awake_ms += period_ms;
     }
-    // Increment the task pointer
-    p_task_cur++;
+  }
 
-  } while (p_task_cur <= p_task_last);
+  sched_port_free();
 
-  return alloc_count;
+  return true;
+#else
+  return false;
+#endif
 }
 
-uint8_t sched_pool_free(const sched_task_pool_t *p_pool)
+bool sched_instance_stats_clear(sched_instance_t instance)
 {
-  if (p_pool == NULL)
+
+  if (instance >= SCHED_INSTANCE_CNT)
+  {
+    return false;
+  }
+
+#if (SCHED_STATS_EN != 0)
+  scheduler_t *p_sched = &sched_instances[instance];
+  sched_time_t now_time_ms = sched_port_ticks();
+
+  // Take exclusive access since the statistics are updated by the instance.
+  sched_port_lock();
+
+  memset(&p_sched->stats, 0x00, sizeof(p_sched->stats));
+  p_sched->stats_mark_ms = now_time_ms;
+
+  sched_port_free();
+
+  return true;
+#else
+  return false;
+#endif
+}
+
+uint32_t sched_instance_task_cnt(sched_instance_t instance)
+{
+
+  if (instance >= SCHED_INSTANCE_CNT)
   {
     return 0;
   }
-  return p_pool->task_cnt - sched_pool_allocated(p_pool);
+
+  scheduler_t *p_sched = &sched_instances[instance];
+  uint32_t task_cnt = 0;
+
+  // Take exclusive access so the list can't change during the count.
+  sched_port_lock();
+
+  for (sched_task_t *p_task = p_sched->p_head; p_task != NULL; p_task = task_next(p_task))
+  {
+    task_cnt++;
+  }
+
+  sched_port_free();
+
+  return task_cnt;
 }
 
-#else // (SCHED_TASK_POOL_EN != 0)
+void sched_init(void)
+{
+  sched_instance_init(SCHED_INSTANCE_DEFAULT);
+}
 
-sched_task_t *sched_task_alloc(sched_task_pool_t *p_pool)
+void sched_start(void)
 {
-  return NULL; // Task pools are disabled, always return NULL.
+  sched_instance_start(SCHED_INSTANCE_DEFAULT);
 }
 
-uint8_t sched_pool_allocated(const sched_task_pool_t *p_pool)
+void sched_stop(void)
 {
-  return 0; // Task pools are disabled, always return 0.
+  sched_instance_stop(SCHED_INSTANCE_DEFAULT);
 }
 
-uint8_t sched_pool_free(const sched_task_pool_t *p_pool)
+bool sched_stats(sched_stats_t *p_stats)
 {
-  return 0; // Task pools are disabled, always return 0.
+  return sched_instance_stats(SCHED_INSTANCE_DEFAULT, p_stats);
 }
-#endif
 
-/***** External Scheduler Functions *****/
+bool sched_stats_clear(void)
+{
+  return sched_instance_stats_clear(SCHED_INSTANCE_DEFAULT);
+}
 
-void sched_init(void)
+uint32_t sched_task_cnt(void)
+{
+  return sched_instance_task_cnt(SCHED_INSTANCE_DEFAULT);
+}
+
+uint32_t sched_trace_read(sched_trace_t *p_events, uint32_t event_cnt)
 {
 
-  // Start the scheduler if not currently running.
-  if (scheduler.state == SCHED_STATE_STOPPED)
+  // A pointer to the event buffer must be supplied.
+  if (p_events == NULL)
   {
+    return 0;
+  }
 
-    // Perform any platform-specific initialization first.
-    sched_port_init();
+#if (SCHED_TRACE_SIZE != 0)
+  // Take exclusive access so events aren't overwritten during the copy.
+  sched_port_lock();
 
-    // Clear the task references.
-    scheduler.p_head = NULL;
-    scheduler.p_tail = NULL;
-#if (SCHED_TASK_CACHE_EN != 0)
-    scheduler.updated = false;
-#endif
-    scheduler.state = SCHED_STATE_ACTIVE;
+  uint32_t read_cnt = 0;
+  while ((read_cnt < event_cnt) && (trace_tail != trace_head))
+  {
+    p_events[read_cnt++] = trace_ring[trace_tail & (SCHED_TRACE_SIZE - 1)];
+    trace_tail++;
   }
+
+  sched_port_free();
+
+  return read_cnt;
+#else
+  (void)event_cnt;
+  return 0;
+#endif
 }
 
-void sched_start(void)
+uint32_t sched_task_trace_id(const sched_task_t *p_task)
 {
-
-  /* Repeatably execute any expired tasks in the scheduler's task list,
-   * sleeping in between, until the scheduler is stopped.
-   */
-  while (scheduler.state == SCHED_STATE_ACTIVE)
+#if (SCHED_TRACE_SIZE != 0)
+  if ((p_task == NULL) || (p_task->state == SCHED_TASK_UNINIT))
   {
+    return 0;
+  }
+  return trace_task_id(p_task);
+#else
+  (void)p_task;
+  return 0;
+#endif
+}
 
-    // Execute tasks in the que with expired task intervals.
-    uint32_t next_task_ms = sched_execute_que();
+/***** Weak implementations of the optional port functions. *****/
 
-    /* Sleep using the platform-specific sleep method until the next task
-     * expires.
-     */
-    if (next_task_ms > 0)
-    {
-      sched_port_sleep(next_task_ms);
-    }
-  }
+#if (SCHED_TICK_HZ == 1000) && (SCHED_TIME_64_EN == 0)
+__attribute__((weak)) sched_time_t sched_port_ticks(void)
+{
+  // The scheduler's ticks are the port's mS timer by default.
+  return sched_port_ms();
+}
+#endif
 
-  // Finish stopping the scheduler before returning.
-  sched_stop_finalize();
+__attribute__((weak)) void sched_port_sleep(uint32_t interval_ms)
+{
+  // Empty
 }
 
-void sched_stop(void)
+__attribute__((weak)) sched_port_wake_t sched_port_sleep_until(sched_time_t deadline_ms)
 {
-  // Move to the stopping state if not already stopped.
-  if (scheduler.state != SCHED_STATE_STOPPED)
+  int32_t remaining_ms = (int32_t)(deadline_ms - sched_port_ticks());
+
+  if (remaining_ms > 0)
   {
-    scheduler.state = SCHED_STATE_STOPPING;
+    sched_port_sleep((uint32_t)remaining_ms);
+    remaining_ms = (int32_t)(deadline_ms - sched_port_ticks());
   }
+
+  return (remaining_ms > 0) ? SCHED_PORT_WAKE_EARLY : SCHED_PORT_WAKE_DEADLINE;
 }
 
-/***** Weak implementations of the optional port functions. *****/
+__attribute__((weak)) void sched_port_wake(void)
+{
+  // Empty, interrupts end the sleep.
+}
 
-__attribute__((weak)) void sched_port_sleep(uint32_t interval_ms)
+__attribute__((weak)) void sched_port_run_mode(uint8_t run_mode)
+{
+  // Empty
+}
+
+__attribute__((weak)) void sched_port_sleep_mode(uint8_t sleep_mode)
 {
   // Empty
 }
 
+__attribute__((weak)) uint8_t sched_port_sleep_states(const sched_port_sleep_state_t **pp_states)
+{
+  // No sleep state table, the port selects the sleep state.
+  return 0;
+}
+
 __attribute__((weak)) void sched_port_init(void){
     // Empty
 };
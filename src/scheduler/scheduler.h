@@ -34,21 +34,20 @@ extern "C" {
  * An unbuffered task can also be used for tasks which do not require that
  * data be passed to their handlers.  For example, an LED blink task may not
  * need to store task data since the LED's output pin can simply be inverted 
- * during each handler call.
+ * during each handler call.  With SCHED_TASK_COMPACT_EN enabled, unbuffered
+ * tasks don't store data.
  *
  * @note Since the macro statically allocates a task, it should only be invoked
  * once per task.
  *
  * @param[in] TASK_ID  Unique task name.
  */
-#define SCHED_TASK_DEF(TASK_ID)   \
-  static sched_task_t TASK_ID = { \
-      .p_data = NULL,             \
-      .buff_size = 0,             \
-      .data_size = 0,             \
-      .repeat = false,            \
-      .allocated = false,         \
-      .state = SCHED_TASK_UNINIT, \
+#define SCHED_TASK_DEF(TASK_ID)                      \
+  static SCHED_TASK_SECTION sched_task_t TASK_ID = { \
+      SCHED_TASK_DATA_INIT(NULL, NULL, 0),           \
+      .repeat = false,                               \
+      .allocated = false,                            \
+      .state = SCHED_TASK_UNINIT,                    \
   }
 
 /**
@@ -66,17 +65,57 @@ extern "C" {
  * @param[in] BUFF_SIZE   The maximum buffer size available to store task data.
  *                        1 to 255 (bytes)
  */
-#define SCHED_TASK_BUFF_DEF(TASK_ID, BUFF_SIZE)               \
-  static uint8_t TASK_ID##_BUFF[SCHED_BUFF_LIMIT(BUFF_SIZE)]; \
-  static sched_task_t TASK_ID = {                             \
-      .p_data = TASK_ID##_BUFF,                               \
-      .buff_size = SCHED_BUFF_LIMIT(BUFF_SIZE),               \
-      .data_size = 0,                                         \
-      .repeat = false,                                        \
-      .allocated = false,                                     \
-      .state = SCHED_TASK_UNINIT,                             \
+#define SCHED_TASK_BUFF_DEF(TASK_ID, BUFF_SIZE)                          \
+  static uint8_t TASK_ID##_BUFF[SCHED_BUFF_LIMIT(BUFF_SIZE)];            \
+  SCHED_TASK_BUFF_REC_DEF(TASK_ID##_REC, TASK_ID##_BUFF,                 \
+                          SCHED_BUFF_LIMIT(BUFF_SIZE))                   \
+  static SCHED_TASK_SECTION sched_task_t TASK_ID = {                     \
+      SCHED_TASK_DATA_INIT(&TASK_ID##_REC, TASK_ID##_BUFF,               \
+                           SCHED_BUFF_LIMIT(BUFF_SIZE)),                 \
+      .repeat = false,                                                   \
+      .allocated = false,                                                \
+      .state = SCHED_TASK_UNINIT,                                        \
   }
 
+#if (SCHED_TASK_MSG_EN != 0)
+/**
+ * @brief Macro for defining a message task.
+ *
+ * A message task and a FIFO of MSG_CNT message slots of MSG_SIZE bytes are
+ * defined by the macro.  Messages are added to the FIFO with
+ * sched_task_msg_post(), for example from an interrupt, and read by the
+ * task's handler with sched_task_msg_read().  The task itself is unbuffered,
+ * data added with sched_task_data() is passed to its handler by reference.
+ *
+ * @note Since this macro statically allocates a task and its message FIFO, it
+ * should only be invoked once per task.  Message tasks must be enabled with
+ * the SCHED_TASK_MSG_EN build configuration define.
+ *
+ * @param[in] TASK_ID   Unique task name.
+ * @param[in] MSG_SIZE  The maximum size of each message. 1 to 255 (bytes)
+ * @param[in] MSG_CNT   The number of messages the FIFO can store.
+ *                      1 to 255 (messages)
+ */
+#define SCHED_TASK_MSG_DEF(TASK_ID, MSG_SIZE, MSG_CNT)                        \
+  static uint8_t TASK_ID##_MSG_BUFF[SCHED_TASK_LIMIT(MSG_CNT) *              \
+                                    SCHED_BUFF_LIMIT(MSG_SIZE)];             \
+  static uint8_t TASK_ID##_MSG_SIZES[SCHED_TASK_LIMIT(MSG_CNT)];             \
+  static sched_msg_fifo_t TASK_ID##_MSG = {                                  \
+      .p_buff = TASK_ID##_MSG_BUFF,                                          \
+      .p_sizes = TASK_ID##_MSG_SIZES,                                        \
+      .msg_size = SCHED_BUFF_LIMIT(MSG_SIZE),                                \
+      .msg_cnt = SCHED_TASK_LIMIT(MSG_CNT),                                  \
+      .head = 0,                                                             \
+      .pending = 0};                                                         \
+  static SCHED_TASK_SECTION sched_task_t TASK_ID = {                         \
+      SCHED_TASK_DATA_INIT(NULL, NULL, 0),                                   \
+      .repeat = false,                                                       \
+      .allocated = false,                                                    \
+      .state = SCHED_TASK_UNINIT,                                            \
+      .p_msg = &TASK_ID##_MSG,                                               \
+  }
+#endif
+
 /**
  * @brief Macro for defining a pool of buffered scheduler tasks.
  *
@@ -101,14 +140,173 @@ extern "C" {
 #define SCHED_TASK_POOL_DEF(POOL_ID, BUFF_SIZE, TASK_CNT)          \
   static uint8_t POOL_ID##_BUFF[SCHED_TASK_LIMIT(TASK_CNT) *       \
                                 SCHED_BUFF_LIMIT(BUFF_SIZE)];      \
-  static sched_task_t POOL_ID##_TASKS[SCHED_TASK_LIMIT(TASK_CNT)]; \
+  static SCHED_TASK_SECTION sched_task_t                          \
+      POOL_ID##_TASKS[SCHED_TASK_LIMIT(TASK_CNT)];                 \
+  static uint32_t POOL_ID##_FREE[SCHED_POOL_FREE_WORDS(TASK_CNT)];  \
+  SCHED_POOL_RECS_DEF(POOL_ID##_RECS, SCHED_TASK_LIMIT(TASK_CNT))  \
   static sched_task_pool_t POOL_ID = {                             \
       .p_data = POOL_ID##_BUFF,                                    \
       .p_tasks = POOL_ID##_TASKS,                                  \
+      SCHED_POOL_RECS_INIT(POOL_ID##_RECS)                         \
+      .p_free = POOL_ID##_FREE,                                    \
+      .p_arena_free = NULL,                                        \
+      .arena_blocks = 0,                                           \
       .buff_size = SCHED_BUFF_LIMIT(BUFF_SIZE),                    \
       .task_cnt = SCHED_TASK_LIMIT(TASK_CNT),                      \
       .initialized = false}
 
+/**
+ * @brief Macro for defining a pool of scheduler tasks which share a data arena.
+ *
+ * The pool's tasks don't have their own data buffers.  Instead, each
+ * sched_task_data() call on a task allocated from the pool reserves just
+ * enough space for the data from a data arena shared by all of the pool's
+ * tasks.  The arena is divided into blocks of SCHED_TASK_ARENA_BLOCK_SIZE
+ * bytes and each task's data is stored in a run of consecutive blocks.  The
+ * space is returned to the arena when the task stops.
+ *
+ * An arena pool is a better choice than a SCHED_TASK_POOL_DEF() pool when the
+ * size of the task data varies widely, since the RAM required is set by the
+ * total size of the data stored by the active tasks rather than by the number
+ * of tasks times the largest data size.
+ *
+ * @note Since the macro statically allocates the pool, it should only be
+ * invoked once per pool.
+ *
+ * @param[in] POOL_ID     Unique pool name.
+ * @param[in] ARENA_SIZE  The size of the data arena shared by all of the
+ *                        tasks, rounded up to a whole number of
+ *                        SCHED_TASK_ARENA_BLOCK_SIZE blocks. (bytes)
+ * @param[in] TASK_CNT    The number of tasks available in the pool.
+ *                        1 to 255 (tasks)
+ */
+#define SCHED_TASK_ARENA_POOL_DEF(POOL_ID, ARENA_SIZE, TASK_CNT)              \
+  static uint8_t POOL_ID##_BUFF[SCHED_ARENA_BLOCKS(ARENA_SIZE) *              \
+                                SCHED_TASK_ARENA_BLOCK_SIZE];                 \
+  static uint32_t POOL_ID##_ARENA_FREE[SCHED_ARENA_FREE_WORDS(ARENA_SIZE)];   \
+  static SCHED_TASK_SECTION sched_task_t                                     \
+      POOL_ID##_TASKS[SCHED_TASK_LIMIT(TASK_CNT)];                            \
+  static uint32_t POOL_ID##_FREE[SCHED_POOL_FREE_WORDS(TASK_CNT)];             \
+  SCHED_POOL_RECS_DEF(POOL_ID##_RECS, SCHED_TASK_LIMIT(TASK_CNT))              \
+  static sched_task_pool_t POOL_ID = {                                        \
+      .p_data = POOL_ID##_BUFF,                                               \
+      .p_tasks = POOL_ID##_TASKS,                                             \
+      SCHED_POOL_RECS_INIT(POOL_ID##_RECS)                                    \
+      .p_free = POOL_ID##_FREE,                                               \
+      .p_arena_free = POOL_ID##_ARENA_FREE,                                   \
+      .arena_blocks = SCHED_ARENA_BLOCKS(ARENA_SIZE),                         \
+      .buff_size = 0,                                                         \
+      .task_cnt = SCHED_TASK_LIMIT(TASK_CNT),                                 \
+      .initialized = false}
+
+/**
+ * @brief Macro for defining an event.
+ *
+ * Tasks are bound to the event with the sched_task_event() function.  Each
+ * sched_event_signal() call starts the first bound task which is waiting for
+ * the event.  Signals made while no bound task is waiting are counted, up to
+ * COUNT_MAX, so a burst of signals isn't lost.  A COUNT_MAX of 1 defines a
+ * binary event whose pending signals are merged.
+ *
+ * @note Since the macro statically allocates an event, it should only be
+ * invoked once per event.  Events must be enabled with the SCHED_EVENT_EN
+ * build configuration define.
+ *
+ * @param[in] EVENT_ID   Unique event name.
+ * @param[in] COUNT_MAX  The maximum number of pending signals.
+ *                       1 to 65535 (signals)
+ */
+#define SCHED_EVENT_DEF(EVENT_ID, COUNT_MAX)       \
+  static sched_event_t EVENT_ID = {                \
+      .p_wait = NULL,                              \
+      .count = 0,                                  \
+      .count_max = SCHED_EVENT_LIMIT(COUNT_MAX),   \
+  }
+
+/**
+ * @brief Macro for defining a task entry of a static task table.
+ *
+ * @param[in] HANDLER      The task's handler function.
+ * @param[in] INTERVAL_MS  The task interval. (ticks)
+ * @param[in] REPEAT       True for a repeating task else False for a single
+ *                         shot task.
+ * @param[in] PRIORITY     The task's priority level, 0 is the lowest.
+ * @param[in] START        True to start the task along with the table.
+ */
+#define SCHED_TASK_ENTRY(HANDLER, INTERVAL_MS, REPEAT, PRIORITY, START) \
+  {                                                                    \
+      .handler = (HANDLER),                                            \
+      .interval_ms = (INTERVAL_MS),                                    \
+      .repeat = (REPEAT),                                              \
+      .priority = (PRIORITY),                                          \
+      .start = (START),                                                \
+  }
+
+/**
+ * @brief Macro for defining a static task table.
+ *
+ * A static task table defines a fixed set of unbuffered tasks whose
+ * configuration is known at build time.  The entries, defined with the
+ * SCHED_TASK_ENTRY() macro, are stored as constants and the tasks are stored
+ * in a single array in the order of their entries.  The whole table is
+ * configured and started by a single sched_task_table_start() call rather
+ * than a sched_task_config() and sched_task_start() call for each task.
+ *
+ * The entries must be listed from the highest priority to the lowest.  The
+ * started tasks are linked into the task list in the order of the table so
+ * the task que search steps through the table's array in order, and of the
+ * expired tasks with the same priority, the first entry is called first.
+ *
+ * The number of tasks is checked at compile time against
+ * SCHED_TASK_TABLE_MAX and is available as a constant with the
+ * SCHED_TASK_TABLE_CNT() macro.  A table's task is accessed with the
+ * SCHED_TASK_TABLE_TASK() macro given its entry index.
+ *
+ * @code
+ * enum { LED_TASK, SENSOR_TASK };
+ *
+ * SCHED_TASK_TABLE_DEF(app_tasks,
+ *                      SCHED_TASK_ENTRY(led_handler, 500, true, 1, true),
+ *                      SCHED_TASK_ENTRY(sensor_handler, 1000, false, 0, false));
+ *
+ * sched_task_table_start(&app_tasks);
+ * sched_task_start(SCHED_TASK_TABLE_TASK(app_tasks, SENSOR_TASK));
+ * @endcode
+ *
+ * @note Since the macro statically allocates the table's tasks, it should
+ * only be invoked once per table.
+ *
+ * @param[in] TABLE_ID  Unique table name.
+ * @param[in] ...       The table's SCHED_TASK_ENTRY() entries.
+ */
+#define SCHED_TASK_TABLE_DEF(TABLE_ID, ...)                                       \
+  static const sched_task_entry_t TABLE_ID##_ENTRIES[] = {__VA_ARGS__};           \
+  SCHED_STATIC_ASSERT((sizeof(TABLE_ID##_ENTRIES) / sizeof(sched_task_entry_t)) <= \
+                          SCHED_TASK_TABLE_MAX,                                   \
+                      "The task table has more than SCHED_TASK_TABLE_MAX tasks"); \
+  static SCHED_TASK_SECTION sched_task_t                                         \
+      TABLE_ID##_TASKS[sizeof(TABLE_ID##_ENTRIES) / sizeof(sched_task_entry_t)];  \
+  static const sched_task_table_t TABLE_ID = {                                    \
+      .p_entries = TABLE_ID##_ENTRIES,                                            \
+      .p_tasks = TABLE_ID##_TASKS,                                                \
+      .task_cnt = (uint8_t)(sizeof(TABLE_ID##_ENTRIES) / sizeof(sched_task_entry_t))}
+
+/**
+ * @brief Macro for getting the number of tasks in a static task table as a
+ * constant expression.
+ *
+ * @param[in] TABLE_ID  The table name.
+ */
+#define SCHED_TASK_TABLE_CNT(TABLE_ID) (sizeof(TABLE_ID##_ENTRIES) / sizeof(sched_task_entry_t))
+
+/**
+ * @brief Macro for getting a pointer to a static task table's task.
+ *
+ * @param[in] TABLE_ID  The table name.
+ * @param[in] INDEX     The index of the task's entry.
+ */
+#define SCHED_TASK_TABLE_TASK(TABLE_ID, INDEX) (&TABLE_ID##_TASKS[INDEX])
+
 /**
  * @brief Function for allocating a buffered scheduler task from a task pool.
  *
@@ -123,14 +321,47 @@ extern "C" {
  * for reuse at the next sched_task_alloc() call.  Allocated task must be
  * configured before use.
  *
+ * Free tasks are tracked by a bitmap so allocating and freeing a task takes
+ * constant time regardless of the number of tasks in the pool.  The lowest
+ * indexed free task is always allocated.
+ *
+ * Each pool is registered in the scheduler's pool table the first time a
+ * task is allocated from it.  The table holds SCHED_TASK_POOL_MAX pools.
+ *
  * @param[in] p_pool  Pointer to the task pool structure.
  *
  * @retval A pointer to the allocated task.
  * @retval NULL if no free tasks are available which would typically indicating
- *         that the pool's task count needs to be increased.
+ *         that the pool's task count needs to be increased, or if the pool
+ *         can't be registered because the pool table is full.
  */
 sched_task_t *sched_task_alloc(sched_task_pool_t *p_pool);
 
+/**
+ * @brief Function for configuring and starting the tasks of a static task
+ * table.
+ *
+ * Every task of the table is configured from its entry and the tasks whose
+ * entries are marked to start are started, with exclusive access taken once
+ * for the whole table.  The table can be started again once all of its tasks
+ * have stopped, for example after the scheduler was stopped.  Tasks which
+ * are stopped and started again after the table is started are linked at the
+ * end of the task list.  Every task is checked before any of them is
+ * changed, so if the table can't be started, for example since the que heap
+ * can't store all of the tasks to start, none of its tasks are configured or
+ * started.
+ *
+ * @param[in] p_table  Pointer to the task table.
+ *
+ * @retval True if the table was started.
+ * @retval False if the table was not started because the table pointer was
+ *         NULL, an entry's handler was NULL, an entry's priority was invalid,
+ *         the entries weren't listed from the highest priority to the lowest,
+ *         one of the tasks hasn't stopped, the scheduler has not been
+ *         initialized or a task could not be added to the task que.
+ */
+bool sched_task_table_start(const sched_task_table_t *p_table);
+
 /**
  * @brief Function for configuring or reconfiguring a scheduler task.
  *
@@ -138,29 +369,259 @@ sched_task_t *sched_task_alloc(sched_task_pool_t *p_pool);
  * stopped.  The function can be used to reconfigure a previously configured
  * task but the task stop must complete before doing so.
  *
- * The scheduler must be initialized prior to configuring a task.
+ * The scheduler must be initialized prior to configuring a task.  New tasks
+ * are added to the default instance's que, a previously configured task
+ * remains in its current instance's que.
  *
- * The task interval for a repeating task is the desired time in mS between
+ * The task interval for a repeating task is the desired time in ticks between
  * task handler calls.   The interval for a non-repeating task is the time
  * delay from now until the task handler is called. An interval of 0 will
  * result in handler being called as soon as possible.
  *
  * @param[in] p_task        Pointer to the task.
  * @param[in] handler       Task handler function.
- * @param[in] interval_ms   The task interval (mS).
+ * @param[in] interval_ms   The task interval (ticks).
  * @param[in] repeat        True for a repeating tasks else False for single
  *                          shot tasks.
  *
  * @retval True if the configuration succeeded.
  * @retval False if the configuration failed because the task's has not been
- *         stopped, the task pointer was NULL, the task handler was NULL or
- *         the scheduler has not been initialized.
+ *         stopped, the task pointer was NULL, the task handler was NULL, the
+ *         scheduler has not been initialized or the compact task layout is
+ *         enabled and the task isn't stored in the task section.
  */
 bool sched_task_config(sched_task_t *p_task,
                        sched_handler_t handler,
-                       uint32_t interval_ms,
+                       sched_time_t interval_ms,
                        bool repeat);
 
+/**
+ * @brief Function for setting how a repeating task is re-armed after it
+ * expires.
+ *
+ * Tasks are configured with the SCHED_REPEAT_MODE_DEFAULT repeat mode.  The
+ * repeat mode can be changed at any time after the task has been configured
+ * and takes effect at the task's next expiration.  The repeat mode has no
+ * effect on non-repeating tasks.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @param[in] mode    The repeat mode.
+ *
+ * @retval True if the repeat mode was set.
+ * @retval False if the repeat mode could not be set because the task has not
+ *         been configured, the task pointer was NULL or the mode was invalid.
+ */
+bool sched_task_repeat_mode(sched_task_t *p_task, sched_repeat_mode_t mode);
+
+/**
+ * @brief Function for setting a task's slack time.
+ *
+ * The task's handler may be called up to its slack time after the task
+ * expires.  The scheduler groups tasks with overlapping slack windows so they
+ * are executed on a single wake up rather than on several wake ups in quick
+ * succession.  Tasks are configured with a slack time of 0 so their handlers
+ * are called as soon as they expire.  The slack time can be changed at any
+ * time after the task has been configured.
+ *
+ * @note Task slack must be enabled with the SCHED_TASK_SLACK_EN build
+ * configuration define.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[in] slack_ms  The slack time in ticks, limited to SCHED_MS_MAX.
+ *
+ * @retval True if the slack time was set.
+ * @retval False if the slack time could not be set because the task has not
+ *         been configured, the task pointer was NULL or task slack is
+ *         disabled.
+ */
+bool sched_task_slack(sched_task_t *p_task, sched_time_t slack_ms);
+
+/**
+ * @brief Function for setting a task's priority level.
+ *
+ * When several tasks have expired, the handler of the highest priority task
+ * is called first.  Expired tasks with the same priority are called in the
+ * order of the task que.  Handlers run to completion so a high priority task
+ * which expires while a lower priority handler is executing is called once
+ * that handler returns.  Tasks are configured with the lowest priority of 0.
+ *
+ * @note Task priorities must be enabled with the SCHED_TASK_PRIORITY_LEVELS
+ * build configuration define, only priority 0 is valid otherwise.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[in] priority  The priority level, 0 (lowest) to
+ *                      SCHED_TASK_PRIORITY_LEVELS - 1 (highest).
+ *
+ * @retval True if the priority was set.
+ * @retval False if the priority could not be set because the task has not
+ *         been configured, the task pointer was NULL or the priority is
+ *         invalid.
+ */
+bool sched_task_priority(sched_task_t *p_task, uint8_t priority);
+
+/**
+ * @brief Function for moving a task to a different scheduler instance.
+ *
+ * The task's handler is called by the new instance from then on.  A task can
+ * only be moved while it is stopped, waiting for its event or while it is
+ * active outside of its handler.  Moving a task requires a search of its
+ * current instance's task list.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[in] instance  The new instance, it must have been initialized.
+ *
+ * @retval True if the task was moved or is already stored in the instance.
+ * @retval False if the task could not be moved because the task has not been
+ *         configured, the task pointer was NULL, the task is executing or
+ *         stopping, the instance is invalid or isn't initialized or the new
+ *         instance's que is full.
+ */
+bool sched_task_move(sched_task_t *p_task, sched_instance_t instance);
+
+/**
+ * @brief Function for setting a task's instance affinity.
+ *
+ * An idle scheduler instance may steal an expired task from the que of an
+ * instance which is busy executing task handlers.  A stolen task is moved to
+ * the idle instance's que so a repeating task keeps being executed by the
+ * idle instance.  A pinned task is never stolen, its handler is always called
+ * by its own instance.  Tasks are configured unpinned.  Repeating tasks which
+ * share data with the other tasks of their instance should be pinned.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @param[in] pinned  True to pin the task to its instance else False.
+ *
+ * @retval True if the affinity was set.
+ * @retval False if the affinity could not be set because the task has not
+ *         been configured or the task pointer was NULL.
+ */
+bool sched_task_affinity(sched_task_t *p_task, bool pinned);
+
+/**
+ * @brief Function for binding a task to an event.
+ *
+ * Once bound, starting the task takes a pending signal from the event if one
+ * is available, otherwise the task waits in the SCHED_TASK_WAITING state,
+ * outside of the task que, until the event is signaled.  A signaled task is
+ * started and its handler is called after its interval, an interval of 0
+ * calls the handler as soon as the scheduler wakes.  Once the handler
+ * returns, the task takes the next pending signal or waits for the event
+ * again until it is stopped.  The task's repeat setting isn't used, bound
+ * tasks should be configured as non-repeating since repeating tasks have a
+ * minimum interval of 1 tick.  Configuring a task unbinds it from its event.
+ *
+ * A task can also be bound or unbound from inside of its own handler, which
+ * takes effect once the handler returns.  Binding the task makes it wait for
+ * the event.  Unbinding a non-repeating task stops it unless the handler
+ * restarts it, an unbound repeating task's next interval starts from now.
+ *
+ * @note Events must be enabled with the SCHED_EVENT_EN build configuration
+ * define.
+ *
+ * @param[in] p_task   Pointer to the task.
+ * @param[in] p_event  Pointer to the event, NULL to unbind the task.
+ *
+ * @retval True if the task was bound or unbound.
+ * @retval False if the task could not be bound because the task is active
+ *         or waiting, the task pointer was NULL or events are disabled.
+ */
+bool sched_task_event(sched_task_t *p_task, sched_event_t *p_event);
+
+/**
+ * @brief Function for taking a snapshot of a task's runtime statistics.
+ *
+ * The statistics are updated after each handler call and are cleared when
+ * the task is configured.  Taking a snapshot only copies the statistics and
+ * calculates the averages so it can be called from any context.
+ *
+ * @note Runtime statistics must be enabled with the SCHED_STATS_EN build
+ * configuration define.
+ *
+ * @param[in] p_task    Pointer to the task.
+ * @param[out] p_stats  Pointer to the snapshot.
+ *
+ * @retval True if the snapshot was taken.
+ * @retval False if the snapshot could not be taken because the task has not
+ *         been configured, either pointer was NULL or runtime statistics are
+ *         disabled.
+ */
+bool sched_task_stats(const sched_task_t *p_task, sched_task_stats_t *p_stats);
+
+/**
+ * @brief Function for clearing a task's runtime statistics.
+ *
+ * @param[in] p_task  Pointer to the task.
+ *
+ * @retval True if the statistics were cleared.
+ * @retval False if the statistics could not be cleared because the task has
+ *         not been configured, the task pointer was NULL or runtime
+ *         statistics are disabled.
+ */
+bool sched_task_stats_clear(sched_task_t *p_task);
+
+/**
+ * @brief Function for setting a task's handler execution budget.
+ *
+ * A handler call which runs longer than the budget is counted as a budget
+ * overrun and reported to the SCHED_HOOK_BUDGET_OVERRUN() hook.  The loop
+ * pass of the overrun doesn't call the SCHED_HOOK_WATCHDOG_KICK() hook.
+ * Tasks are configured without a budget.  Setting the budget clears the
+ * task's overrun count.
+ *
+ * @note Task budgets must be enabled with the SCHED_TASK_BUDGET_EN build
+ * configuration define.
+ *
+ * @param[in] p_task     Pointer to the task.
+ * @param[in] budget_ms  The budget in ticks, 0 for none.
+ *
+ * @retval True if the budget was set.
+ * @retval False if the budget could not be set because the task has not been
+ *         configured, the task pointer was NULL or task budgets are disabled.
+ */
+bool sched_task_budget(sched_task_t *p_task, sched_time_t budget_ms);
+
+/**
+ * @brief Function for getting the number of a task's handler calls which ran
+ * longer than its budget.
+ *
+ * @note Task budgets must be enabled with the SCHED_TASK_BUDGET_EN build
+ * configuration define.
+ *
+ * @param[in] p_task  Pointer to the task.
+ *
+ * @return The number of budget overruns since the budget was set, 0 if the
+ *         task pointer was NULL or task budgets are disabled.
+ */
+uint32_t sched_task_budget_overruns(const sched_task_t *p_task);
+
+/**
+ * @brief Function for setting the power modes a task requires.
+ *
+ * The scheduler switches to the task's run mode before its handler is called,
+ * for example to run a task which talks to a fast peripheral from a faster
+ * clock, and returns to the lowest run mode before sleeping.  While the task
+ * is started, active or waiting for an event, the scheduler doesn't sleep
+ * deeper than the task's sleep mode, for example to keep the clock of a
+ * peripheral which wakes the task running.  The modes are numbered by the
+ * platform port.  Tasks are configured with SCHED_RUN_MODE_LOW and
+ * SCHED_SLEEP_MODE_ANY.
+ *
+ * @note Task power modes must be enabled with the SCHED_TASK_POWER_EN build
+ * configuration define.
+ *
+ * @param[in] p_task      Pointer to the task.
+ * @param[in] run_mode    The run mode the task's handler requires.
+ * @param[in] sleep_mode  The deepest sleep mode allowed while the task is
+ *                        started.
+ *
+ * @retval True if the power modes were set.
+ * @retval False if the power modes could not be set because the task has not
+ *         been configured, the sleep mode is neither below
+ *         SCHED_SLEEP_MODE_CNT nor SCHED_SLEEP_MODE_ANY, the task pointer was
+ *         NULL or task power modes are disabled.
+ */
+bool sched_task_power(sched_task_t *p_task, uint8_t run_mode, uint8_t sleep_mode);
+
 /**
  * @brief Function for updating a task's user data.
  *
@@ -174,6 +635,8 @@ bool sched_task_config(sched_task_t *p_task,
  * and data size are stored in the task but the actual data is not copied into
  * the task since unbuffered tasks don't have internal data buffers.  The
  * referenced task data must still be valid when the task's handler is called.
+ * With SCHED_TASK_COMPACT_EN enabled, unbuffered tasks don't store data and 0
+ * is returned.
  *
  * Buffered Tasks:
  *
@@ -184,6 +647,15 @@ bool sched_task_config(sched_task_t *p_task,
  * is limited to be less than or equal to the task's buffer size which was was
  * supplied to the SCHED_TASK_BUFF_DEF() macro.
  *
+ * Arena Pool Tasks:
+ *
+ * Tasks allocated from a pool defined with the SCHED_TASK_ARENA_POOL_DEF()
+ * macro reserve data_size bytes from the pool's shared data arena and the user
+ * data is then copied into the reserved space.  Any space reserved by a
+ * previous call is returned to the arena first.  If the arena doesn't have
+ * enough consecutive free space for the data, no data is stored and 0 is
+ * returned.  The reserved space is returned to the arena when the task stops.
+ *
  * A task must be stopped before its data can be updated to avoid potential
  * data access conflicts. Attempts to update a task's data which is not
  * currently stopped will return 0 indicating that the task data was not
@@ -205,6 +677,130 @@ uint8_t sched_task_data(sched_task_t *p_task,
                         const void *p_data,
                         uint8_t data_size);
 
+/**
+ * @brief Function for reserving space for a task's data in its internal
+ * buffer.
+ *
+ * The function and sched_task_data_commit() allow a producer to write the
+ * task's data, or have a DMA transfer write it, directly into the task's
+ * internal buffer rather than building the data in its own buffer and having
+ * sched_task_data() copy it.  The pointer returned by the function is only
+ * valid until the task is started or configured, or data is reserved again.
+ * The data isn't supplied to the task handler until it has been committed with
+ * sched_task_data_commit().  The task data size is reset to 0 until then.
+ *
+ * The same state rules as sched_task_data() apply, space can only be reserved
+ * in tasks which are stopped.
+ *
+ * Buffered Tasks:
+ *
+ * A pointer to the task's internal buffer is returned if data_size is less
+ * than or equal to the task's buffer size.
+ *
+ * Arena Pool Tasks:
+ *
+ * data_size bytes are reserved from the pool's shared data arena after
+ * returning any space previously reserved by the task.
+ *
+ * Typical usage:
+ * @code
+ * uint8_t *p_buff = sched_task_data_reserve(p_task, size);
+ * if (p_buff != NULL)
+ * {
+ *   // Write up to size bytes of data to p_buff.
+ *   sched_task_data_commit(p_task, size);
+ *   sched_task_start(p_task);
+ * }
+ * @endcode
+ *
+ * @param[in] p_task     Pointer to the task.
+ * @param[in] data_size  The size of the space to reserve. 1 to 255 (bytes)
+ *
+ * @retval Pointer to the reserved space in the task's buffer.
+ * @retval NULL if the task pointer is NULL, the task isn't stopped, the task
+ *         is unbuffered, data_size is 0 or data_size exceeds the available
+ *         space.
+ */
+uint8_t *sched_task_data_reserve(sched_task_t *p_task, uint8_t data_size);
+
+/**
+ * @brief Function for committing data written to a task's reserved buffer
+ * space.
+ *
+ * The committed data size is supplied to the task handler along with a
+ * pointer to the task's buffer once the task expires.  The data must have been
+ * written to the space returned by sched_task_data_reserve() before it is
+ * committed.
+ *
+ * @param[in] p_task     Pointer to the task.
+ * @param[in] data_size  The size of the data written. (bytes)
+ *
+ * @retval The committed data size which is limited to the task's buffer size
+ *         or to the arena space reserved for an arena pool task.
+ * @retval 0 if the task pointer is NULL, the task isn't stopped or the task
+ *         has no reserved buffer space.
+ */
+uint8_t sched_task_data_commit(sched_task_t *p_task, uint8_t data_size);
+
+/**
+ * @brief Function for adding a message to a message task's FIFO.
+ *
+ * The message is copied into the FIFO and a stopped task is started so its
+ * handler is called after its interval.  An active task isn't restarted, so
+ * the interval sets how long the task collects messages before its handler
+ * is called.  A task whose handler is executing is restarted as usual and
+ * called again once its handler returns.  Pending messages are kept when the
+ * task is stopped and discarded when it is configured.  The function takes
+ * the scheduler lock, it can be called from an interrupt context on ports
+ * whose lock disables interrupts.
+ *
+ * @note Message tasks must be enabled with the SCHED_TASK_MSG_EN build
+ * configuration define.
+ *
+ * @param[in] p_task     Pointer to a task defined with SCHED_TASK_MSG_DEF().
+ * @param[in] p_data     Pointer to the message.
+ * @param[in] data_size  The size of the message. (bytes)
+ *
+ * @retval The size of the message copied into the FIFO which may be less than
+ *         data_size if data_size exceeds the task's message size.
+ * @retval 0 if the message wasn't added because the FIFO is full, the task
+ *         isn't a configured message task, a pointer was NULL, data_size is 0
+ *         or the task could not be started.
+ */
+uint8_t sched_task_msg_post(sched_task_t *p_task, const void *p_data, uint8_t data_size);
+
+/**
+ * @brief Function for reading the oldest message from a message task's FIFO.
+ *
+ * The message is copied and removed from the FIFO.  The task's handler
+ * should read every pending message each time it is called, for example
+ * until the function returns 0, since a burst of messages posted while the
+ * task is active only results in a single handler call.
+ *
+ * @note Message tasks must be enabled with the SCHED_TASK_MSG_EN build
+ * configuration define.
+ *
+ * @param[in] p_task     Pointer to a task defined with SCHED_TASK_MSG_DEF().
+ * @param[out] p_data    Pointer to the buffer for the message.
+ * @param[in] buff_size  The size of the buffer. (bytes)
+ *
+ * @retval The size of the message copied which may be less than the size of
+ *         the message if it exceeds buff_size.
+ * @retval 0 if the FIFO is empty, the task isn't a message task or a pointer
+ *         was NULL.
+ */
+uint8_t sched_task_msg_read(sched_task_t *p_task, void *p_data, uint8_t buff_size);
+
+/**
+ * @brief Function for getting the number of pending messages of a message
+ * task.
+ *
+ * @param[in] p_task  Pointer to the task.
+ * @return The number of pending messages, 0 if the task isn't a message task
+ *         or the task pointer was NULL.
+ */
+uint8_t sched_task_msg_pending(const sched_task_t *p_task);
+
 /**
  * @brief Function for updating a task with a new interval and starting it.
  *
@@ -213,13 +809,14 @@ uint8_t sched_task_data(sched_task_t *p_task,
  *
  * @param[in] p_task        Pointer to the task to add to the scheduler.
  * @param[in] interval_ms   Task interval for a repeating task or a delay for
- *                          single-shot task (mS).
+ *                          single-shot task (ticks).
  *
  * @retval True if the interval was successfully updated.
  * @retval False if the interval could not be updated because it was not
- *         previously configured or the task pointer was NULL.
+ *         previously configured, the task pointer was NULL or the
+ *         SCHED_QUE_HEAP engine's heap was full.
  */
-bool sched_task_update(sched_task_t *p_task, uint32_t interval_ms);
+bool sched_task_update(sched_task_t *p_task, sched_time_t interval_ms);
 
 /**
  * @brief Function for starting a scheduler task.
@@ -235,7 +832,8 @@ bool sched_task_update(sched_task_t *p_task, uint32_t interval_ms);
  *
  * @retval True if the task was successfully started.
  * @retval False if the task could not be started because it has not previously
- *         been configured or the task pointer was NULL.
+ *         been configured, the task pointer was NULL or the SCHED_QUE_HEAP
+ *         engine's heap was full.
  */
 bool sched_task_start(sched_task_t *p_task);
 
@@ -253,9 +851,180 @@ bool sched_task_start(sched_task_t *p_task);
  */
 bool sched_task_stop(sched_task_t *p_task);
 
+/**
+ * @brief Function for posting a task start from an interrupt context.
+ *
+ * The start is added to the task post que without taking the scheduler lock
+ * and is applied with sched_task_start() by the scheduler from the main
+ * context before it next executes the task que.  Posting avoids disabling
+ * interrupts in high priority interrupt handlers.  Posts are applied in the
+ * order they were made and a posted task's interval starts when the post is
+ * applied.
+ *
+ * @note The post que has a single producer.  Posts must only be made from one
+ * context at a time, for example from interrupts of the same priority which
+ * can't preempt each other.  The post is added to the post que of the task's
+ * scheduler instance.  The post que is enabled by defining
+ * SCHED_TASK_POST_SIZE to be != 0.
+ *
+ * @param[in] p_task  Pointer to the task to start.
+ *
+ * @retval True if the start was posted.
+ * @retval False if the task pointer was NULL, the post que was full or the
+ *         post que is disabled.  The result of the start itself isn't known
+ *         until it is applied.
+ */
+bool sched_task_post_start(sched_task_t *p_task);
+
+/**
+ * @brief Function for posting a task stop from an interrupt context.
+ *
+ * The stop is applied with sched_task_stop() by the scheduler from the main
+ * context.  See sched_task_post_start() for the post que rules.
+ *
+ * @param[in] p_task  Pointer to the task to stop.
+ *
+ * @retval True if the stop was posted.
+ * @retval False if the task pointer was NULL, the post que was full or the
+ *         post que is disabled.
+ */
+bool sched_task_post_stop(sched_task_t *p_task);
+
+/**
+ * @brief Function for posting a task interval update from an interrupt
+ * context.
+ *
+ * The update is applied with sched_task_update() by the scheduler from the
+ * main context which restarts the task with the new interval.  See
+ * sched_task_post_start() for the post que rules.
+ *
+ * @param[in] p_task       Pointer to the task to update.
+ * @param[in] interval_ms  The new task interval in ticks.
+ *
+ * @retval True if the update was posted.
+ * @retval False if the task pointer was NULL, the post que was full or the
+ *         post que is disabled.
+ */
+bool sched_task_post_update(sched_task_t *p_task, sched_time_t interval_ms);
+
+/**
+ * @brief Function for signaling an event.
+ *
+ * The first task waiting for the event is started, otherwise the signal is
+ * counted and the next bound task to wait takes it.  The signal marks the
+ * started task's instance as updated so the scheduler searches its que again
+ * once it wakes.  The function takes the scheduler lock, it can be called
+ * from an interrupt context on ports whose lock disables interrupts.  The
+ * interrupt itself must wake the processor from sched_port_sleep_until().
+ *
+ * @note Events must be enabled with the SCHED_EVENT_EN build configuration
+ * define.
+ *
+ * @param[in] p_event  Pointer to the event.
+ *
+ * @retval True if a waiting task was started or the signal was counted.
+ * @retval False if the signal was lost because the event's count limit was
+ *         reached, the event pointer was NULL or events are disabled.
+ */
+bool sched_event_signal(sched_event_t *p_event);
+
+/**
+ * @brief Function for getting the number of pending signals of an event.
+ *
+ * @param[in] p_event  Pointer to the event.
+ * @return The number of pending signals, 0 if the event pointer was NULL.
+ */
+uint16_t sched_event_count(const sched_event_t *p_event);
+
+/**
+ * @brief Function for initializing a scheduler instance.
+ *
+ * The platform-specific initialization is performed when the first instance
+ * is initialized.  Note that if the instance was previously started and then
+ * stopped, this function should not be called until the stop completes as
+ * indicated by the sched_instance_start() function returning.
+ *
+ * @param[in] instance  The instance, from 0 to SCHED_INSTANCE_CNT - 1.
+ */
+void sched_instance_init(sched_instance_t instance);
+
+/**
+ * @brief Function for starting a scheduler instance.
+ *
+ * The function repeatably executes the instance's scheduled tasks as they
+ * expire.  While idle, the instance steals expired tasks which aren't pinned
+ * from the ques of instances busy executing task handlers.  Each instance
+ * must be started from its own thread or processor core.  The function does
+ * not return, once called, until the instance is stopped.
+ *
+ * @param[in] instance  The instance, from 0 to SCHED_INSTANCE_CNT - 1.
+ */
+void sched_instance_start(sched_instance_t instance);
+
+/**
+ * @brief Function for stopping a scheduler instance.
+ *
+ * Note the function call may not immediately stop the instance.  The instance
+ * will finish executing any expired task before completing the stop.  The
+ * tasks stored in the instance's que are stopped once it stops.  The
+ * platform-specific deinitialization is performed when the last instance
+ * stops.
+ *
+ * @param[in] instance  The instance, from 0 to SCHED_INSTANCE_CNT - 1.
+ */
+void sched_instance_stop(sched_instance_t instance);
+
+/**
+ * @brief Function for taking a snapshot of a scheduler instance's runtime
+ * statistics.
+ *
+ * The statistics are cleared when the instance is initialized.  The sleep
+ * and awake times only increase while the instance is started.
+ *
+ * @note Runtime statistics must be enabled with the SCHED_STATS_EN build
+ * configuration define.
+ *
+ * @param[in] instance  The instance, from 0 to SCHED_INSTANCE_CNT - 1.
+ * @param[out] p_stats  Pointer to the snapshot.
+ *
+ * @retval True if the snapshot was taken.
+ * @retval False if the snapshot could not be taken because the instance is
+ *         invalid, the snapshot pointer was NULL or runtime statistics are
+ *         disabled.
+ */
+bool sched_instance_stats(sched_instance_t instance, sched_stats_t *p_stats);
+
+/**
+ * @brief Function for clearing a scheduler instance's runtime statistics.
+ *
+ * @param[in] instance  The instance, from 0 to SCHED_INSTANCE_CNT - 1.
+ *
+ * @retval True if the statistics were cleared.
+ * @retval False if the statistics could not be cleared because the instance
+ *         is invalid or runtime statistics are disabled.
+ */
+bool sched_instance_stats_clear(sched_instance_t instance);
+
+/**
+ * @brief Function for counting the tasks linked into a scheduler instance's
+ * task list.
+ *
+ * A task is linked into the list when it is started.  A stopped task is
+ * unlinked by the instance's loop before its next que search, so the count
+ * tracks the started tasks rather than every task ever configured.  The list
+ * is walked with the scheduler locked.
+ *
+ * @param[in] instance  The instance, from 0 to SCHED_INSTANCE_CNT - 1.
+ *
+ * @return The number of linked tasks, 0 if the instance is invalid.
+ */
+uint32_t sched_instance_task_cnt(sched_instance_t instance);
+
 /**
  * @brief Function for initializing the scheduler module.
  *
+ * Initializes the default instance, SCHED_INSTANCE_DEFAULT.
+ *
  * Note that if the scheduler module was previously started and then stopped,
  * this function should not be called until the stop completes as indicated
  * by the sched_start() function returning.
@@ -265,6 +1034,8 @@ void sched_init(void);
 /**
  * @brief Function for starting the scheduler.
  *
+ * Starts the default instance, SCHED_INSTANCE_DEFAULT.
+ *
  * The function repeatably executes scheduled tasks as they expire.
  * This function must be called from the main context, typically after
  * all platform initialization has completed. The function does not
@@ -275,11 +1046,85 @@ void sched_start(void);
 /**
  * @brief Function for stopping the scheduler module.
  *
+ * Stops the default instance, SCHED_INSTANCE_DEFAULT.
+ *
  * Note the function call may not immediately stop the scheduler. The scheduler
  * will finish executing any expired task before completing the stop.
  */
 void sched_stop(void);
 
+/**
+ * @brief Function for taking a snapshot of the scheduler's runtime
+ * statistics.
+ *
+ * Takes a snapshot of the default instance, SCHED_INSTANCE_DEFAULT.
+ *
+ * @param[out] p_stats  Pointer to the snapshot.
+ *
+ * @retval True if the snapshot was taken.
+ * @retval False if the snapshot pointer was NULL or runtime statistics are
+ *         disabled.
+ */
+bool sched_stats(sched_stats_t *p_stats);
+
+/**
+ * @brief Function for clearing the scheduler's runtime statistics.
+ *
+ * Clears the statistics of the default instance, SCHED_INSTANCE_DEFAULT.
+ *
+ * @retval True if the statistics were cleared.
+ * @retval False if runtime statistics are disabled.
+ */
+bool sched_stats_clear(void);
+
+/**
+ * @brief Function for counting the tasks linked into the scheduler's task
+ * list.
+ *
+ * Counts the tasks of the default instance, SCHED_INSTANCE_DEFAULT.
+ *
+ * @return The number of linked tasks.
+ */
+uint32_t sched_task_cnt(void);
+
+/**
+ * @brief Function for reading the oldest events from the trace ring.
+ *
+ * The events are copied oldest first and are removed from the ring.  Gaps
+ * in the events' sequence numbers indicate events which were overwritten
+ * before they were read.  The events can be dumped as an array of
+ * sched_trace_t records for offline analysis, the test/POSIX/projects/
+ * trace_decode tool converts such a dump into a Chrome trace JSON timeline.
+ *
+ * @note The trace must be enabled with the SCHED_TRACE_SIZE build
+ * configuration define.
+ *
+ * @param[out] p_events   Pointer to the buffer for the events.
+ * @param[in] event_cnt   The maximum number of events to read.
+ *
+ * @return The number of events read, always 0 if the trace is disabled.
+ */
+uint32_t sched_trace_read(sched_trace_t *p_events, uint32_t event_cnt);
+
+/**
+ * @brief Function for getting the id which identifies a task in the trace
+ * events.
+ *
+ * With the compact task layout the id is the task's handle in the task
+ * section, otherwise the task is given an id when it is first configured.
+ * The id stays the same while the task is reconfigured, so it can be used to
+ * name the task's events in a decoded trace.
+ *
+ * @note The trace must be enabled with the SCHED_TRACE_SIZE build
+ * configuration define.
+ *
+ * @param[in] p_task  Pointer to the task.
+ *
+ * @return The task's trace id, 0 if the task isn't configured or the trace
+ *         is disabled.
+ */
+uint32_t sched_task_trace_id(const sched_task_t *p_task);
+
 #ifdef __cplusplus
 }
 #endif
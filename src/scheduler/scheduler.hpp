@@ -0,0 +1,396 @@
+/**
+ * @file scheduler.hpp
+ * @author Ben Wirz
+ * @brief Header only C++ wrapper for the scheduler module with typed task
+ * payloads.
+ *
+ * The wrapper's tasks carry a payload of a fixed type which is constructed
+ * in place in the task's data buffer, rather than copied into it byte by
+ * byte, and is passed to the task's handler by reference.  A handler can be
+ * a function, a lambda or a member function of an object and is stored in
+ * the task's data buffer next to the payload, so no heap allocation is made
+ * and no cast or data size check is needed in the handler.
+ *
+ * The payload and handler sizes are checked at compile time.  Together they
+ * must fit in a task buffer, which is limited by SCHED_BUFF_LIMIT(), and the
+ * handler must fit in SCHED_CPP_HANDLER_SIZE bytes.  Payloads and handlers
+ * must be trivially destructible since a task can be stopped or
+ * reconfigured without running a destructor, and handlers must also be
+ * trivially copyable.
+ *
+ * The wrapper's tasks are scheduler tasks, they are started, stopped and
+ * executed by the scheduler in the same way as the tasks defined in C and
+ * the C functions which control a task, such as sched_task_priority(), can
+ * be used on them through task_ref::get().  Since the task's data buffer
+ * holds the handler, the C functions which write a task's configuration or
+ * data, sched_task_config(), sched_task_data(), sched_task_data_reserve() and
+ * sched_task_data_commit(), must not be used on the wrapper's tasks, they
+ * would overwrite the stored handler.  Use config() and emplace() instead.
+ *
+ * @code
+ * struct sample_t
+ * {
+ *   uint8_t channel;
+ *   uint16_t value;
+ * };
+ *
+ * static sched::task<sample_t> sample_task;
+ *
+ * sample_task.config([](sched::task_ref<sample_t> task, sample_t &sample) {
+ *   log_sample(sample.channel, sample.value);
+ * }, 100, false);
+ * sample_task.emplace(uint8_t(2), uint16_t(adc_read(2)));
+ * sample_task.start();
+ * @endcode
+ */
+
+#ifndef SCHEDULER_HPP__
+#define SCHEDULER_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "scheduler.h"
+
+namespace sched
+{
+
+template <typename Payload>
+class task_ref;
+
+namespace detail
+{
+
+/**
+ * @brief The contents of a wrapper task's data buffer.
+ *
+ * The handler and its invoker are stored ahead of the payload so the
+ * storage of a small payload is packed after them.
+ */
+template <typename Payload>
+struct slot
+{
+  /// @brief The function which calls the stored handler.
+  void (*p_invoke)(void *p_handler, task_ref<Payload> task, Payload &payload);
+
+  /// @brief The storage of the handler.
+  alignas(void *) unsigned char handler[SCHED_CPP_HANDLER_SIZE];
+
+  /// @brief The storage of the payload, constructed in place.
+  alignas(Payload) unsigned char payload[sizeof(Payload)];
+};
+
+/**
+ * @brief Function for getting the payload stored in a slot.
+ *
+ * @param[in] p_slot  Pointer to the slot.
+ *
+ * @return Pointer to the payload.
+ */
+template <typename Payload>
+inline Payload *slot_payload(slot<Payload> *p_slot)
+{
+#if (__cplusplus >= 201703L)
+  return std::launder(reinterpret_cast<Payload *>(p_slot->payload));
+#else
+  return reinterpret_cast<Payload *>(p_slot->payload);
+#endif
+}
+
+/**
+ * @brief Function for calling a stored handler of a given type.
+ *
+ * @param[in] p_handler  Pointer to the stored handler.
+ * @param[in] task       The handler's task.
+ * @param[in] payload    The task's payload.
+ */
+template <typename Payload, typename Handler>
+void invoke(void *p_handler, task_ref<Payload> task, Payload &payload)
+{
+  (*static_cast<Handler *>(p_handler))(task, payload);
+}
+
+/**
+ * @brief The scheduler handler of every wrapper task with a given payload
+ * type, calls the handler stored in the task's data buffer.
+ *
+ * @param[in] p_task     Pointer to the task.
+ * @param[in] p_data     Pointer to the task's data buffer, its slot.
+ * @param[in] data_size  Unused, the slot's size is fixed.
+ */
+template <typename Payload>
+void dispatch(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  (void)data_size;
+  slot<Payload> *p_slot = static_cast<slot<Payload> *>(p_data);
+  p_slot->p_invoke(p_slot->handler, task_ref<Payload>(p_task), *slot_payload(p_slot));
+}
+
+} // namespace detail
+
+/**
+ * @brief A reference to a wrapper task with a payload of a given type.
+ *
+ * References are passed to the task handlers and returned by
+ * task_pool::alloc().  A reference is only valid for tasks whose data buffer
+ * was set up by a task or task_pool of the same payload type.
+ */
+template <typename Payload>
+class task_ref
+{
+  static_assert(sizeof(detail::slot<Payload>) == SCHED_BUFF_LIMIT(sizeof(detail::slot<Payload>)),
+                "The payload and handler don't fit in a task buffer");
+  static_assert(std::is_trivially_destructible<Payload>::value,
+                "The payload must be trivially destructible");
+
+public:
+  /**
+   * @brief Constructor for a reference to a task.
+   *
+   * @param[in] p_task  Pointer to the task, nullptr for no task.
+   */
+  explicit task_ref(sched_task_t *p_task = nullptr) : p_task_(p_task) {}
+
+  /// @brief Does the reference refer to a task?
+  explicit operator bool() const { return p_task_ != nullptr; }
+
+  /**
+   * @brief Get a pointer to the task for use with the scheduler's C functions.
+   *
+   * @note sched_task_config() and the task data functions must not be used
+   * with the pointer since the task's data buffer holds the handler.
+   */
+  sched_task_t *get() const { return p_task_; }
+
+  /**
+   * @brief Function for configuring the task with a handler.
+   *
+   * The handler is called as handler(task_ref<Payload> task, Payload &payload)
+   * and is stored in the task's data buffer.  The task must be stopped.
+   *
+   * @param[in] handler      The handler, a function or a lambda.
+   * @param[in] interval_ms  The task interval. (ticks)
+   * @param[in] repeat       True for a repeating task else False for a single
+   *                         shot task.
+   *
+   * @retval True if the configuration succeeded.
+   * @retval False if the configuration failed, see sched_task_config().
+   */
+  template <typename Handler>
+  bool config(Handler handler, sched_time_t interval_ms, bool repeat) const
+  {
+    static_assert(sizeof(Handler) <= SCHED_CPP_HANDLER_SIZE,
+                  "The handler is larger than SCHED_CPP_HANDLER_SIZE");
+    static_assert(alignof(Handler) <= alignof(void *), "The handler's alignment is too large");
+    static_assert(std::is_trivially_copyable<Handler>::value &&
+                      std::is_trivially_destructible<Handler>::value,
+                  "The handler must be trivially copyable and destructible");
+
+    if (!sched_task_config(p_task_, &detail::dispatch<Payload>, interval_ms, repeat))
+    {
+      return false;
+    }
+
+    // The handler is stored after the configuration, which may clear the buffer.
+    detail::slot<Payload> *p_slot = slot();
+    if (p_slot == nullptr)
+    {
+      return false;
+    }
+    ::new (static_cast<void *>(p_slot->handler)) Handler(handler);
+    p_slot->p_invoke = &detail::invoke<Payload, Handler>;
+
+    return true;
+  }
+
+  /**
+   * @brief Function for configuring the task with a member function handler.
+   *
+   * The member function is called on the object, which must remain valid
+   * while the task is configured.
+   *
+   * @param[in] object       The handler's object.
+   * @param[in] p_method     The handler, a member function of the object.
+   * @param[in] interval_ms  The task interval. (ticks)
+   * @param[in] repeat       True for a repeating task else False for a single
+   *                         shot task.
+   *
+   * @retval True if the configuration succeeded.
+   * @retval False if the configuration failed, see sched_task_config().
+   */
+  template <typename Object>
+  bool config(Object &object, void (Object::*p_method)(task_ref task, Payload &payload),
+              sched_time_t interval_ms, bool repeat) const
+  {
+    Object *p_object = &object;
+    return config([p_object, p_method](task_ref task, Payload &payload)
+                  { (p_object->*p_method)(task, payload); },
+                  interval_ms, repeat);
+  }
+
+  /**
+   * @brief Function for constructing the task's payload in place.
+   *
+   * The payload is constructed in the task's data buffer from the arguments
+   * with list initialization.  The task must be configured and stopped.
+   *
+   * @param[in] args  The payload's constructor arguments or members.
+   *
+   * @retval Pointer to the constructed payload.
+   * @retval nullptr if the task isn't stopped.
+   */
+  template <typename... Args>
+  Payload *emplace(Args &&...args) const
+  {
+    detail::slot<Payload> *p_slot = slot();
+    if (p_slot == nullptr)
+    {
+      return nullptr;
+    }
+
+    Payload *p_payload =
+        ::new (static_cast<void *>(p_slot->payload)) Payload{std::forward<Args>(args)...};
+    sched_task_data_commit(p_task_, sizeof(detail::slot<Payload>));
+
+    return p_payload;
+  }
+
+  /// @brief Start the task, see sched_task_start().
+  bool start() const { return sched_task_start(p_task_); }
+
+  /// @brief Stop the task, see sched_task_stop().
+  bool stop() const { return sched_task_stop(p_task_); }
+
+  /// @brief Restart the task with a new interval, see sched_task_update().
+  bool update(sched_time_t interval_ms) const { return sched_task_update(p_task_, interval_ms); }
+
+  /// @brief Get the task's state, see sched_task_state().
+  sched_task_state_t state() const { return sched_task_state(p_task_); }
+
+private:
+  /**
+   * @brief Function for getting the slot in the stopped task's data buffer.
+   *
+   * @return Pointer to the slot, nullptr if the task isn't stopped.
+   */
+  detail::slot<Payload> *slot() const
+  {
+    return reinterpret_cast<detail::slot<Payload> *>(
+        sched_task_data_reserve(p_task_, sizeof(detail::slot<Payload>)));
+  }
+
+  /// @brief Pointer to the task.
+  sched_task_t *p_task_;
+};
+
+/**
+ * @brief A task with a payload of a given type.
+ *
+ * The task and its data buffer are stored in the object, which should be
+ * statically allocated.  With SCHED_TASK_COMPACT_EN enabled, the object
+ * must be given the SCHED_TASK_SECTION attribute.
+ */
+template <typename Payload>
+class task : public task_ref<Payload>
+{
+public:
+  task() : task_ref<Payload>(&task_), task_(), buff_()
+  {
+#if (SCHED_TASK_COMPACT_EN != 0)
+    buff_rec_.p_data = buff_;
+    buff_rec_.buff_size = sizeof(detail::slot<Payload>);
+    buff_rec_.data_size = 0;
+    task_.p_buff = &buff_rec_;
+#else
+    task_.p_data = buff_;
+    task_.buff_size = sizeof(detail::slot<Payload>);
+#endif
+    task_.state = SCHED_TASK_UNINIT;
+  }
+
+  task(const task &) = delete;
+  task &operator=(const task &) = delete;
+
+private:
+  /// @brief The scheduler task.
+  sched_task_t task_;
+
+  /// @brief The task's data buffer, holding its slot.
+  alignas(detail::slot<Payload>) uint8_t buff_[sizeof(detail::slot<Payload>)];
+
+#if (SCHED_TASK_COMPACT_EN != 0)
+  /// @brief The task's data record.
+  sched_task_buff_t buff_rec_;
+#endif
+};
+
+#if (SCHED_TASK_POOL_EN != 0) && (SCHED_TASK_COMPACT_EN == 0)
+
+/**
+ * @brief A pool of tasks with a payload of a given type.
+ *
+ * The pool is a scheduler task pool whose data buffer holds a slot for each
+ * task.  Allocated tasks are returned to the pool when they stop, in the
+ * same way as the tasks of a SCHED_TASK_POOL_DEF() pool.  The pool should be
+ * statically allocated.
+ *
+ * @note The pool isn't available with the compact task layout since its
+ * tasks are stored in the object rather than in the task section.
+ */
+template <typename Payload, uint8_t TaskCnt>
+class task_pool
+{
+  static_assert(TaskCnt > 0, "The pool must have at least one task");
+
+public:
+  task_pool() : tasks_(), buff_(), free_(), pool_()
+  {
+    pool_.p_data = buff_;
+    pool_.p_tasks = tasks_;
+    pool_.p_free = free_;
+    pool_.p_arena_free = nullptr;
+    pool_.arena_blocks = 0;
+    pool_.buff_size = sizeof(detail::slot<Payload>);
+    pool_.task_cnt = TaskCnt;
+    pool_.initialized = false;
+  }
+
+  task_pool(const task_pool &) = delete;
+  task_pool &operator=(const task_pool &) = delete;
+
+  /**
+   * @brief Function for allocating a task from the pool, see
+   * sched_task_alloc().
+   *
+   * @return A reference to the task, which must be configured before use, or
+   *         an empty reference if no tasks are free.
+   */
+  task_ref<Payload> alloc() { return task_ref<Payload>(sched_task_alloc(&pool_)); }
+
+  /// @brief Get the number of allocated tasks, see sched_pool_allocated().
+  uint8_t allocated() const { return sched_pool_allocated(&pool_); }
+
+  /// @brief Get the number of free tasks, see sched_pool_free().
+  uint8_t free() const { return sched_pool_free(&pool_); }
+
+private:
+  /// @brief The pool's tasks.
+  sched_task_t tasks_[TaskCnt];
+
+  /// @brief The pool's data buffer, holding a slot for each task.
+  alignas(detail::slot<Payload>) uint8_t buff_[TaskCnt * sizeof(detail::slot<Payload>)];
+
+  /// @brief The pool's free task bitmap.
+  uint32_t free_[SCHED_POOL_FREE_WORDS(TaskCnt)];
+
+  /// @brief The scheduler task pool.
+  sched_task_pool_t pool_;
+};
+
+#endif
+
+} // namespace sched
+
+#endif // SCHEDULER_HPP__
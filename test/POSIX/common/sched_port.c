@@ -6,7 +6,6 @@
 #include <stdio.h>
 #include <time.h>
 #include <assert.h>
-#include <math.h>
 
 #include <pthread.h>
 
@@ -31,19 +30,62 @@ uint32_t sched_port_ms(void) {
   int ret = clock_gettime(CLOCK_MONOTONIC, &time);
   assert(ret == 0);
   // Convert the current time to mS
-  uint64_t time_ms = (time.tv_sec * 1000) + lround(time.tv_nsec/1e6);
+  uint64_t time_ms = ((uint64_t)time.tv_sec * 1000) + (time.tv_nsec / 1000000);
   // Limit the returned value.
   return (uint32_t) time_ms & UINT32_MAX;
   
 }
 
+sched_time_t sched_port_ticks(void) {
+  // Get the current time.
+  struct timespec time;
+  int ret = clock_gettime(CLOCK_MONOTONIC, &time);
+  assert(ret == 0);
+  // Convert the current time to ticks
+  uint64_t time_ticks = ((uint64_t)time.tv_sec * SCHED_TICK_HZ) +
+                        (((uint64_t)time.tv_nsec * SCHED_TICK_HZ) / 1000000000);
+  // Limit the returned value.
+  return (sched_time_t) time_ticks;
+}
+
+// Function for adding a time interval in ticks to a timespec.
+static void timespec_add_ticks(struct timespec *p_ts, uint32_t interval_ticks) {
+  p_ts->tv_sec += interval_ticks / SCHED_TICK_HZ;
+  p_ts->tv_nsec += ((uint64_t)(interval_ticks % SCHED_TICK_HZ) * 1000000000) / SCHED_TICK_HZ;
+  if (p_ts->tv_nsec >= 1000000000) {
+    p_ts->tv_sec++;
+    p_ts->tv_nsec -= 1000000000;
+  }
+}
+
 /* Platform sleep function which attempts to sleep
  * for the supplied interval.  Note that nanosleep() 
  * can be woken by any thread signal.
  */
 void sched_port_sleep(uint32_t interval_ms) {
-  struct timespec ts;
-  ts.tv_sec = interval_ms / 1000;
-  ts.tv_nsec = (interval_ms % 1000) * 1000000;
+  struct timespec ts = {0};
+  timespec_add_ticks(&ts, interval_ms);
   nanosleep(&ts, NULL);
 }
+
+/* Platform sleep until function which sleeps until the
+ * monotonic clock reaches the deadline.  The sleep is
+ * reported as early if it was interrupted by a signal.
+ */
+sched_port_wake_t sched_port_sleep_until(sched_time_t deadline_ms) {
+  int32_t remaining_ms = (int32_t)(deadline_ms - sched_port_ticks());
+  if (remaining_ms <= 0) {
+    return SCHED_PORT_WAKE_DEADLINE;
+  }
+
+  // Convert the deadline to an absolute monotonic clock time.
+  struct timespec ts;
+  int ret = clock_gettime(CLOCK_MONOTONIC, &ts);
+  assert(ret == 0);
+  timespec_add_ticks(&ts, (uint32_t)remaining_ms);
+
+  if (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+    return SCHED_PORT_WAKE_EARLY;
+  }
+  return SCHED_PORT_WAKE_DEADLINE;
+}
@@ -0,0 +1,114 @@
+
+/*
+ * POSIX Simulated Time Scheduler Support Functions
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "sched_port_sim.h"
+
+// The simulated time. (nS)
+static uint64_t sim_ns = 0;
+
+// Count of the scheduler sleeps.
+static uint32_t sim_sleep_cnt = 0;
+
+// Is the scheduler locked?  The simulation is single threaded.
+static bool sim_locked = false;
+
+// The pending simulated interrupt's time (nS) and handler, NULL for none.
+static uint64_t sim_irq_ns = 0;
+static void (*sim_irq_handler)(void) = NULL;
+
+void sched_sim_set_ns(uint64_t time_ns) {
+  sim_ns = time_ns;
+}
+
+void sched_sim_advance_ns(uint64_t interval_ns) {
+  sim_ns += interval_ns;
+}
+
+uint64_t sched_sim_ns(void) {
+  return sim_ns;
+}
+
+uint64_t sched_sim_ticks_ns(uint64_t time_ticks) {
+  // Round up so the nS time is inside the tick.
+  return ((time_ticks * 1000000000) + SCHED_TICK_HZ - 1) / SCHED_TICK_HZ;
+}
+
+uint32_t sched_sim_sleep_cnt(void) {
+  return sim_sleep_cnt;
+}
+
+void sched_sim_irq_set(uint64_t time_ns, void (*p_handler)(void)) {
+  sim_irq_ns = time_ns;
+  sim_irq_handler = p_handler;
+}
+
+void sched_port_lock(void) {
+  // The scheduler never nests its critical sections.
+  assert(!sim_locked);
+  sim_locked = true;
+}
+
+void sched_port_free(void) {
+  assert(sim_locked);
+  sim_locked = false;
+}
+
+uint32_t sched_port_ms(void) {
+  return (uint32_t)(sim_ns / 1000000);
+}
+
+// Function for getting the simulated time in ticks without limiting it.
+static uint64_t sim_ticks(void) {
+  return (sim_ns * SCHED_TICK_HZ) / 1000000000;
+}
+
+sched_time_t sched_port_ticks(void) {
+  return (sched_time_t)sim_ticks();
+}
+
+/* Platform sleep function which advances the simulated time
+ * by the supplied interval.
+ */
+void sched_port_sleep(uint32_t interval_ms) {
+  sim_sleep_cnt++;
+  sim_ns += sched_sim_ticks_ns(interval_ms);
+}
+
+/* Platform sleep until function which advances the simulated
+ * time to the deadline.  The simulated sleep is only woken
+ * early by a simulated interrupt.
+ */
+sched_port_wake_t sched_port_sleep_until(sched_time_t deadline_ms) {
+  sim_sleep_cnt++;
+
+#if (SCHED_TIME_64_EN != 0)
+  int64_t remaining_ticks = (int64_t)(deadline_ms - sched_port_ticks());
+#else
+  int32_t remaining_ticks = (int32_t)(deadline_ms - sched_port_ticks());
+#endif
+  uint64_t deadline_ns = sim_ns;
+  if (remaining_ticks > 0) {
+    // The start of the deadline's tick.
+    deadline_ns = sched_sim_ticks_ns(sim_ticks() + (uint64_t)remaining_ticks);
+  }
+
+  if ((sim_irq_handler != NULL) && (sim_irq_ns < deadline_ns)) {
+    // Wake at the interrupt, the handler runs outside of the scheduler lock.
+    void (*p_handler)(void) = sim_irq_handler;
+    sim_irq_handler = NULL;
+    if (sim_irq_ns > sim_ns) {
+      sim_ns = sim_irq_ns;
+    }
+    p_handler();
+    return SCHED_PORT_WAKE_EARLY;
+  }
+
+  sim_ns = deadline_ns;
+  return SCHED_PORT_WAKE_DEADLINE;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file sched_port_sim.h
+ * @brief Simulated time POSIX platform support for the scheduler.
+ *
+ * The simulated port replaces sched_port.c for deterministic tests and
+ * benchmarks.  The scheduler's clock is a virtual clock which only moves
+ * when the scheduler sleeps or when the application advances it, so a
+ * simulated day runs in well under a second of wall clock time.  The port is
+ * single threaded, the scheduler lock is only checked for nesting.
+ */
+
+#ifndef SCHED_PORT_SIM_H__
+#define SCHED_PORT_SIM_H__
+
+#include <stdint.h>
+#include "sched_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Function for setting the simulated time in nS, for example to start a
+ * test just before the tick counter rolls over.
+ */
+void sched_sim_set_ns(uint64_t time_ns);
+
+/*
+ * Function for advancing the simulated time by an interval in nS, for
+ * example to simulate a task handler's execution time.
+ */
+void sched_sim_advance_ns(uint64_t interval_ns);
+
+/*
+ * Function for getting the simulated time in nS.
+ */
+uint64_t sched_sim_ns(void);
+
+/*
+ * Function for converting a time in ticks to nS, rounded up to the first nS
+ * of the tick.
+ */
+uint64_t sched_sim_ticks_ns(uint64_t time_ticks);
+
+/*
+ * Function for getting the number of times the scheduler has slept.
+ */
+uint32_t sched_sim_sleep_cnt(void);
+
+/*
+ * Function for scheduling a simulated interrupt at a time in nS.  A sleep
+ * which reaches the interrupt time stops there, calls the interrupt handler
+ * and reports an early wake up.  A single interrupt is pending at a time, the
+ * handler can schedule the next one.  A NULL handler cancels the interrupt.
+ */
+void sched_sim_irq_set(uint64_t time_ns, void (*p_handler)(void));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_PORT_SIM_H__
@@ -111,12 +111,73 @@ static bool test_data_add(sched_task_t * const p_task)
   return bytes_added == sizeof(dummy_data);
 }
 
+/**
+ * Function for testing if data can be reserved and committed in a task's
+ * buffer.
+ *
+ * @param[in] p_task  Pointer to the task to test.
+ *
+ * @return            True if data could be reserved and committed else false.
+ *
+ */
+static bool test_data_reserve(sched_task_t * const p_task)
+{
+  assert(p_task != NULL);
+
+  // Attempt to reserve space for a single byte.
+  uint8_t *p_buff = sched_task_data_reserve(p_task, 1);
+  if (p_buff == NULL)
+  {
+    // Committing without a reservation must also fail.
+    return sched_task_data_commit(p_task, 1) != 0;
+  }
+
+  // The reservation should point to the task's buffer.
+#if (SCHED_TASK_COMPACT_EN != 0)
+  const uint8_t *p_task_data = p_task->p_buff->p_data;
+  const uint8_t *p_data_size = &p_task->p_buff->data_size;
+#else
+  const uint8_t *p_task_data = p_task->p_data;
+  const uint8_t *p_data_size = &p_task->data_size;
+#endif
+  if (p_buff != p_task_data)
+  {
+    printf("Fail: Reserved Buffer Address\n");
+    return false;
+  }
+
+  // Write the data and commit it.
+  p_buff[0] = 0xFF;
+  return (sched_task_data_commit(p_task, 1) == 1) && (*p_data_size == 1);
+}
+
 // Task handler for testing purposes.
 static void test_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
 {
   // Empty
 }
 
+// Local task data structure and buffer for performing tests on.
+static SCHED_TASK_SECTION sched_task_t task_copy;
+static uint8_t task_copy_buff[UINT8_MAX];
+#if (SCHED_TASK_COMPACT_EN != 0)
+static sched_task_buff_t task_copy_rec;
+#endif
+
+/**
+ * Function for removing the local copy of a task from the scheduler's que.
+ *
+ * A copy which was started by a test may have been added to the que.  The
+ * copy must be stopped before it is overwritten or it remains in the que.
+ */
+static void task_local_copy_release(void)
+{
+  if (task_copy.state == SCHED_TASK_ACTIVE)
+  {
+    sched_task_stop(&task_copy);
+  }
+}
+
 /**
  * Function for creating a local copy of a task.
  *
@@ -127,17 +188,27 @@ static void test_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_s
  */
 static sched_task_t *task_local_copy(const sched_task_t * const p_task)
 {
-
-  // Create a local data structure and buffer.
-  static sched_task_t task_copy;
-  static uint8_t task_copy_buff[UINT8_MAX];
+  // Release the previous copy before overwriting it.
+  task_local_copy_release();
 
   // Copy the task and task data.
   memcpy(&task_copy, p_task, sizeof(sched_task_t));
+#if (SCHED_TASK_COMPACT_EN != 0)
+  if (p_task->p_buff != NULL)
+  {
+    task_copy_rec = *p_task->p_buff;
+    memcpy(task_copy_buff, task_copy_rec.p_data, task_copy_rec.buff_size);
+
+    // Update the local task data record to the local buffer.
+    task_copy_rec.p_data = task_copy_buff;
+    task_copy.p_buff = &task_copy_rec;
+  }
+#else
   memcpy(task_copy_buff, p_task->p_data, p_task->buff_size);
 
   // Update the local task data pointer to the local buffer.
   task_copy.p_data = task_copy_buff;
+#endif
 
   return &task_copy;
 }
@@ -206,7 +277,7 @@ bool task_access_test(const sched_task_t * const p_task)
   }
 
   // Attempt to add data to the task if it has a buffer.
-  if (p_task_copy->buff_size != 0)
+  if (sched_task_buffered(p_task_copy))
   {
     p_task_copy = task_local_copy(p_task);
     bool data_add_result = test_data_add(p_task_copy);
@@ -215,7 +286,17 @@ bool task_access_test(const sched_task_t * const p_task)
       printf("Fail: Data Add Test\n");
       test_pass = false;
     }
+
+    p_task_copy = task_local_copy(p_task);
+    bool data_reserve_result = test_data_reserve(p_task_copy);
+    if (data_reserve_result != p_task_access->data)
+    {
+      printf("Fail: Data Reserve Test\n");
+      test_pass = false;
+    }
   }
 
+  task_local_copy_release();
+
   return test_pass;
 }
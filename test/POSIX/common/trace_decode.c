@@ -0,0 +1,106 @@
+//
+//  trace_decode.c
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "trace_decode.h"
+
+// Function for writing a single timeline event.
+static void trace_json_event(FILE * p_out, uint32_t * p_json_cnt, const char * p_name,
+                             const char * p_phase, double time_us, uint8_t instance,
+                             uint32_t task_id) {
+  fprintf(p_out, "%s\n  {\"name\": \"%s\", \"ph\": \"%s\", \"ts\": %.1f, \"pid\": 0, \"tid\": %u",
+          (*p_json_cnt == 0) ? "" : ",", p_name, p_phase, time_us, instance);
+
+  if (p_phase[0] == 'i') {
+    // Instant events are drawn on their thread.
+    fprintf(p_out, ", \"s\": \"t\"");
+  }
+  if (task_id != 0) {
+    fprintf(p_out, ", \"args\": {\"task\": %u}", task_id);
+  }
+  fprintf(p_out, "}");
+
+  (*p_json_cnt)++;
+}
+
+uint32_t trace_decode_json(FILE * p_out, const sched_trace_t * p_events,
+                           uint32_t event_cnt, uint32_t tick_hz) {
+  assert(p_out != NULL);
+  assert((p_events != NULL) || (event_cnt == 0));
+  assert(tick_hz > 0);
+
+  uint32_t json_cnt = 0;
+  char name[32];
+
+  // Event times are relative to the first event and may wrap around.
+  int64_t time_ticks = 0;
+
+  fprintf(p_out, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+
+  for (uint32_t index = 0; index < event_cnt; index++) {
+    const sched_trace_t * p_event = &p_events[index];
+
+    if (index > 0) {
+      const sched_trace_t * p_prev = &p_events[index - 1];
+      time_ticks += (int32_t)(p_event->time_ms - p_prev->time_ms);
+
+      // Note any events which were overwritten before they were read.
+      uint16_t lost_cnt = (uint16_t)(p_event->seq - p_prev->seq - 1);
+      if (lost_cnt > 0) {
+        snprintf(name, sizeof(name), "lost %u", lost_cnt);
+        trace_json_event(p_out, &json_cnt, name, "i",
+                         (double)time_ticks * 1e6 / tick_hz, p_event->instance, 0);
+      }
+    }
+
+    double time_us = (double)time_ticks * 1e6 / tick_hz;
+    snprintf(name, sizeof(name), "task %u", p_event->task_id);
+
+    switch (p_event->event) {
+    case SCHED_TRACE_TASK_START:
+      trace_json_event(p_out, &json_cnt, "start", "i", time_us, p_event->instance,
+                       p_event->task_id);
+      break;
+
+    case SCHED_TRACE_TASK_STOP:
+      trace_json_event(p_out, &json_cnt, "stop", "i", time_us, p_event->instance,
+                       p_event->task_id);
+      break;
+
+    case SCHED_TRACE_TASK_EXPIRE:
+      trace_json_event(p_out, &json_cnt, "expire", "i", time_us, p_event->instance,
+                       p_event->task_id);
+      break;
+
+    case SCHED_TRACE_HANDLER_ENTER:
+      trace_json_event(p_out, &json_cnt, name, "B", time_us, p_event->instance,
+                       p_event->task_id);
+      break;
+
+    case SCHED_TRACE_HANDLER_EXIT:
+      trace_json_event(p_out, &json_cnt, name, "E", time_us, p_event->instance,
+                       p_event->task_id);
+      break;
+
+    case SCHED_TRACE_SLEEP_ENTER:
+      trace_json_event(p_out, &json_cnt, "sleep", "B", time_us, p_event->instance, 0);
+      break;
+
+    case SCHED_TRACE_WAKE:
+      trace_json_event(p_out, &json_cnt, "sleep", "E", time_us, p_event->instance, 0);
+      break;
+
+    default:
+      snprintf(name, sizeof(name), "unknown %u", p_event->event);
+      trace_json_event(p_out, &json_cnt, name, "i", time_us, p_event->instance, 0);
+      break;
+    }
+  }
+
+  fprintf(p_out, "\n]}\n");
+
+  return json_cnt;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file trace_decode.h
+ * @brief Module for decoding a dump of scheduler trace events into a Chrome
+ * trace JSON timeline.
+ */
+
+#ifndef TRACE_DECODE_H__
+#define TRACE_DECODE_H__
+
+#include <stdio.h>
+#include <stdint.h>
+#include "scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Function for writing a Chrome trace JSON timeline of a set of trace events.
+ *
+ * Handler calls and sleeps become duration events on a thread per scheduler
+ * instance.  Task starts, stops and expirations become instant events.  Gaps
+ * in the event sequence numbers become "lost" instant events.  The tick_hz
+ * rate converts the event times to uS.
+ *
+ * Returns the number of timeline events written.
+ */
+uint32_t trace_decode_json(FILE * p_out, const sched_trace_t * p_events,
+                           uint32_t event_cnt, uint32_t tick_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TRACE_DECODE_H__
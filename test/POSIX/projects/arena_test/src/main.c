@@ -0,0 +1,451 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Arena Pool Test
+ *
+ * The program tests the scheduler's arena task pools.
+ *
+ * The arena reservation is first checked directly by storing data in a few
+ * tasks, returning some of them to the pool and reusing their space.  Tasks
+ * are then repeatedly allocated from the pool with randomly sized data, most
+ * of which is small with an occasional large payload.  The test verifies
+ * that:
+ *
+ *  - Only the space for the data is reserved from the arena and the space is
+ *    returned when the task stops.
+ *  - The data stored in each task is intact when its handler is called.
+ *  - A data reservation which doesn't fit in the arena fails without storing
+ *    any data.
+ *  - Data written directly into reserved arena space is committed.
+ *  - More tasks are in flight at once than would fit in a fixed buffer pool
+ *    of the same size.
+ *  - All of the tasks and arena space are free once the test completes.
+ *  - Tasks are returned to their own pools until the pool table is full,
+ *    after which no tasks can be allocated from a new pool.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The number of tasks in the pool.
+#define TASK_COUNT (128)
+
+// The size of the pool's data arena. (bytes)
+#define ARENA_SIZE (1024)
+
+// The maximum data size, a fixed buffer pool would need this for every task.
+#define DATA_SIZE_MAX (200)
+
+// The maximum small data size, 9 out of 10 tasks store small data. (bytes)
+#define DATA_SMALL_MAX (16)
+
+// The maximum random task interval (mS)
+#define INTERVAL_MAX_MS (50)
+
+// The number of tasks to start before the test completes.
+#define TASK_START_CNT (3000)
+
+#if (ARENA_SIZE % SCHED_TASK_ARENA_BLOCK_SIZE) != 0
+#error "The arena size must be a whole number of blocks"
+#endif
+
+// The arena pool.
+SCHED_TASK_ARENA_POOL_DEF(arena_pool, ARENA_SIZE, TASK_COUNT);
+
+// Single task pools for filling the pool table, the arena pool uses the first entry.
+static uint8_t table_pool_buff[SCHED_TASK_POOL_MAX][1];
+static SCHED_TASK_SECTION sched_task_t table_pool_tasks[SCHED_TASK_POOL_MAX][1];
+static uint32_t table_pool_free[SCHED_TASK_POOL_MAX][1];
+static sched_task_pool_t table_pools[SCHED_TASK_POOL_MAX];
+#if (SCHED_TASK_COMPACT_EN != 0)
+static sched_task_buff_t table_pool_recs[SCHED_TASK_POOL_MAX][1];
+#endif
+
+// Task for allocating and starting the pool tasks.
+SCHED_TASK_DEF(starter_task);
+
+// The expected data size of each of the pool's tasks.
+static uint8_t task_data_size[TASK_COUNT];
+
+// The data pattern seed of each of the pool's tasks.
+static uint8_t task_data_seed[TASK_COUNT];
+
+// Count of the number of pool tasks started.
+static uint32_t tasks_started = 0;
+
+// Count of the number of data reservations which didn't fit in the arena.
+static uint32_t reserve_fail_cnt = 0;
+
+// The maximum number of pool tasks allocated at the same time.
+static uint8_t allocated_max = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for filling a data buffer with a pattern generated from a seed.
+static void pattern_fill(uint8_t *p_data, uint8_t size, uint8_t seed)
+{
+  for (uint32_t index = 0; index < size; index++)
+  {
+    p_data[index] = (uint8_t)(seed + (index * 31));
+  }
+}
+
+// Function for checking a pattern filled data buffer.
+static bool pattern_check(const uint8_t *p_data, uint8_t size, uint8_t seed)
+{
+  for (uint32_t index = 0; index < size; index++)
+  {
+    if (p_data[index] != (uint8_t)(seed + (index * 31)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Function for getting a pool task's data pointer.
+static uint8_t *task_data_ptr(const sched_task_t *p_task)
+{
+#if (SCHED_TASK_COMPACT_EN != 0)
+  return p_task->p_buff->p_data;
+#else
+  return p_task->p_data;
+#endif
+}
+
+// Function for getting a task's index in the pool.
+static uint32_t pool_index(const sched_task_t *p_task)
+{
+  uint32_t index = (uint32_t)(p_task - arena_pool_TASKS);
+  assert(index < TASK_COUNT);
+  return index;
+}
+
+// Function for storing pattern filled data of the specified size in a task.
+static uint8_t pool_task_data(sched_task_t *p_task, uint8_t size)
+{
+  uint8_t data[DATA_SIZE_MAX];
+  uint8_t seed = (uint8_t)rand();
+  pattern_fill(data, size, seed);
+
+  uint8_t stored = sched_task_data(p_task, data, size);
+
+  uint32_t index = pool_index(p_task);
+  task_data_size[index] = stored;
+  task_data_seed[index] = seed;
+
+  return stored;
+}
+
+// Pool Task Handler
+static void pool_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = pool_index(p_task);
+
+  if (data_size != task_data_size[index])
+  {
+    log_error("Error: Task %u data size %u, expected %u.\n", index, data_size,
+              task_data_size[index]);
+    test_pass_set(false);
+  }
+  else if ((data_size > 0) && !pattern_check(p_data, data_size, task_data_seed[index]))
+  {
+    log_error("Error: Task %u data is corrupt.\n", index);
+    test_pass_set(false);
+  }
+
+  /* Stop the scheduler once all of the tasks have been started and the other
+   * pool tasks have stopped.  The current task is returned to the pool after
+   * its handler returns so it is still allocated here.
+   */
+  if ((tasks_started >= TASK_START_CNT) && (sched_pool_allocated(&arena_pool) == 1))
+  {
+    sched_stop();
+  }
+}
+
+// Task handler for allocating and starting the pool tasks.
+static void starter_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // Start a few tasks per call so the pool and arena fill up.
+  for (uint32_t cnt = 0; cnt < 4; cnt++)
+  {
+    sched_task_t *p_pool_task = sched_task_alloc(&arena_pool);
+    if (p_pool_task == NULL)
+    {
+      break;
+    }
+
+    bool success = sched_task_config(p_pool_task, pool_task_handler,
+                                     rand() % (INTERVAL_MAX_MS + 1), false);
+    assert(success);
+
+    // Most tasks store small data with the occasional large data.
+    uint8_t size = ((rand() % 10) == 0) ? (rand() % DATA_SIZE_MAX) + 1 :
+                                          (rand() % DATA_SMALL_MAX) + 1;
+
+    // Tasks whose data doesn't fit in the arena are started without data.
+    if (pool_task_data(p_pool_task, size) != size)
+    {
+      reserve_fail_cnt++;
+    }
+
+    success = sched_task_start(p_pool_task);
+    assert(success);
+    tasks_started++;
+
+    uint8_t allocated = sched_pool_allocated(&arena_pool);
+    allocated_max = SCHED_MAX(allocated_max, allocated);
+    if ((allocated + sched_pool_free(&arena_pool)) != TASK_COUNT)
+    {
+      log_error("Error: Allocated %u + Free %u != Total Tasks %u.\n", allocated,
+                sched_pool_free(&arena_pool), TASK_COUNT);
+      test_pass_set(false);
+    }
+
+    if (tasks_started >= TASK_START_CNT)
+    {
+      sched_task_stop(p_task);
+      break;
+    }
+  }
+}
+
+// Function for checking the arena's free space.
+static void arena_free_check(uint32_t expected, const char *p_step)
+{
+  uint32_t arena_free = sched_pool_arena_free(&arena_pool);
+  if (arena_free != expected)
+  {
+    log_error("Error: %s arena free %u, expected %u.\n", p_step, arena_free, expected);
+    test_pass_set(false);
+  }
+}
+
+// Function for directly checking the arena reservation.
+static void arena_reserve_test(void)
+{
+  const uint32_t block = SCHED_TASK_ARENA_BLOCK_SIZE;
+  sched_task_t *p_tasks[3];
+
+  arena_free_check(ARENA_SIZE, "Initial");
+
+  // Store data which needs 1, 2 & 1 blocks.
+  const uint8_t sizes[3] = {block, block + 1, 1};
+  uint32_t reserved = 0;
+  for (uint32_t index = 0; index < 3; index++)
+  {
+    p_tasks[index] = sched_task_alloc(&arena_pool);
+    assert(p_tasks[index] != NULL);
+    bool success = sched_task_config(p_tasks[index], pool_task_handler, 0, false);
+    assert(success);
+    if (pool_task_data(p_tasks[index], sizes[index]) != sizes[index])
+    {
+      log_error("Error: Task data %u could not be stored.\n", index);
+      test_pass_set(false);
+    }
+    reserved += ((sizes[index] + block - 1) / block) * block;
+  }
+  arena_free_check(ARENA_SIZE - reserved, "Reserved");
+
+  // Replacing a task's data returns its previous space first.
+  pool_task_data(p_tasks[2], 2);
+  arena_free_check(ARENA_SIZE - reserved, "Replaced");
+
+  // Data can be written directly into the reserved arena space.
+  uint8_t *p_buff = sched_task_data_reserve(p_tasks[2], 3);
+  assert(p_buff != NULL);
+  pattern_fill(p_buff, 3, task_data_seed[2]);
+  task_data_size[2] = sched_task_data_commit(p_tasks[2], 3);
+  if ((task_data_size[2] != 3) || (sched_task_data_commit(p_tasks[2], 4) != 3))
+  {
+    log_error("Error: Reserved data was not committed.\n");
+    test_pass_set(false);
+  }
+  arena_free_check(ARENA_SIZE - reserved, "Committed");
+
+  // The space of a stopped task is returned to the arena and reused.
+  uint8_t *p_gap = task_data_ptr(p_tasks[1]);
+  sched_task_start(p_tasks[1]);
+  sched_task_stop(p_tasks[1]);
+  reserved -= 2 * block;
+  arena_free_check(ARENA_SIZE - reserved, "Stopped");
+
+  p_tasks[1] = sched_task_alloc(&arena_pool);
+  assert(p_tasks[1] != NULL);
+  sched_task_config(p_tasks[1], pool_task_handler, 0, false);
+  pool_task_data(p_tasks[1], 2 * block);
+  reserved += 2 * block;
+  if (task_data_ptr(p_tasks[1]) != p_gap)
+  {
+    log_error("Error: The free arena space was not reused.\n");
+    test_pass_set(false);
+  }
+
+  // Data larger than the remaining space isn't stored.
+  sched_task_t *p_big = sched_task_alloc(&arena_pool);
+  assert(p_big != NULL);
+  sched_task_config(p_big, pool_task_handler, 0, false);
+  while (sched_pool_arena_free(&arena_pool) >= DATA_SIZE_MAX)
+  {
+    uint8_t stored = pool_task_data(p_big, DATA_SIZE_MAX);
+    assert(stored == DATA_SIZE_MAX);
+    sched_task_start(p_big);
+    reserved += ((DATA_SIZE_MAX + block - 1) / block) * block;
+    p_big = sched_task_alloc(&arena_pool);
+    assert(p_big != NULL);
+    sched_task_config(p_big, pool_task_handler, 0, false);
+  }
+  if (pool_task_data(p_big, DATA_SIZE_MAX) != 0)
+  {
+    log_error("Error: Data larger than the free arena space was stored.\n");
+    test_pass_set(false);
+  }
+  arena_free_check(ARENA_SIZE - reserved, "Full");
+
+  // Return all of the tasks to the pool, only active tasks are returned.
+  sched_task_start(p_big);
+  for (uint32_t index = 0; index < 3; index++)
+  {
+    sched_task_start(p_tasks[index]);
+  }
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    sched_task_stop(&arena_pool_TASKS[index]);
+  }
+  arena_free_check(ARENA_SIZE, "Released");
+  if (sched_pool_allocated(&arena_pool) != 0)
+  {
+    log_error("Error: %u tasks are still allocated.\n", sched_pool_allocated(&arena_pool));
+    test_pass_set(false);
+  }
+}
+
+// Function for checking that tasks are returned to their own pool until the pool table is full.
+static void pool_table_test(void)
+{
+  for (uint32_t index = 0; index < SCHED_TASK_POOL_MAX; index++)
+  {
+    table_pools[index] = (sched_task_pool_t){.p_data = table_pool_buff[index],
+                                             .p_tasks = table_pool_tasks[index],
+                                             .p_free = table_pool_free[index],
+                                             .p_arena_free = NULL,
+                                             .arena_blocks = 0,
+                                             .buff_size = 1,
+                                             .task_cnt = 1,
+                                             .initialized = false};
+#if (SCHED_TASK_COMPACT_EN != 0)
+    table_pools[index].p_buffs = table_pool_recs[index];
+#endif
+  }
+
+  // The arena pool has been registered, so the last pool doesn't fit in the table.
+  for (uint32_t index = 0; index < SCHED_TASK_POOL_MAX; index++)
+  {
+    sched_task_t *p_task = sched_task_alloc(&table_pools[index]);
+    if (index == (SCHED_TASK_POOL_MAX - 1))
+    {
+      if (p_task != NULL)
+      {
+        log_error("Error: A task was allocated from a pool beyond the pool table.\n");
+        test_pass_set(false);
+      }
+      break;
+    }
+
+    assert(p_task == &table_pool_tasks[index][0]);
+    bool success = sched_task_config(p_task, pool_task_handler, 0, false);
+    success = success && sched_task_start(p_task);
+    assert(success);
+    sched_task_stop(p_task);
+    if ((sched_pool_free(&table_pools[index]) != 1) || (sched_pool_allocated(&arena_pool) != 0))
+    {
+      log_error("Error: Table pool %u task was not returned to its pool.\n", index);
+      test_pass_set(false);
+    }
+  }
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Arena Pool Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Seed the random number generator.
+  srand((unsigned int)time(NULL));
+
+  arena_reserve_test();
+  pool_table_test();
+
+  // Configure and start the pool starter task.
+  bool success = sched_task_config(&starter_task, starter_handler, 1, true);
+  assert(success);
+  success = sched_task_start(&starter_task);
+  assert(success);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  log_info("Tasks Started: %u, Reserve Fails: %u, Max Allocated: %u\n",
+           tasks_started, reserve_fail_cnt, allocated_max);
+
+  arena_free_check(ARENA_SIZE, "Final");
+
+  // A fixed buffer pool of the same size would fit ARENA_SIZE / DATA_SIZE_MAX tasks.
+  if (allocated_max <= (4 * (ARENA_SIZE / DATA_SIZE_MAX)))
+  {
+    log_error("Error: Only %u tasks were in flight.\n", allocated_max);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Arena Pool Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Arena Pool Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file hooks.h
+ * @author Ben Wirz
+ * @brief Scheduler hook functions for the task budget test.
+ *
+ * The header is included ahead of every source file by the project's
+ * makefile, which maps the scheduler's budget overrun and watchdog hooks to
+ * these functions.
+ */
+
+#ifndef HOOKS_H__
+#define HOOKS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct _sched_task;
+
+/**
+ * @brief Function called by the SCHED_HOOK_BUDGET_OVERRUN() hook.
+ *
+ * @param[in] p_task   Pointer to the task.
+ * @param[in] exec_ms  The handler's execution time. (ticks)
+ */
+void budget_overrun_hook(struct _sched_task *p_task, uint64_t exec_ms);
+
+/// @brief Function called by the SCHED_HOOK_WATCHDOG_KICK() hook.
+void watchdog_kick_hook(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOOKS_H__
@@ -0,0 +1,298 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Budget Test
+ *
+ * The program tests task execution budgets, built with SCHED_TASK_BUDGET_EN
+ * enabled, on the simulated time port.  The task handlers simulate their
+ * execution time by advancing the simulated time and the makefile maps the
+ * budget overrun and watchdog hooks to functions in the program.  The test
+ * verifies that:
+ *
+ *  - Only the handler calls which run longer than their task's budget are
+ *    counted as overruns and reported to the overrun hook.
+ *  - A slow handler of a task without a budget isn't an overrun.
+ *  - The watchdog is refreshed by every loop pass without an overrun, but not
+ *    by a pass with an overrun, so a task which overruns on every call
+ *    starves the watchdog.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The interval of the fast and hung tasks. (ticks)
+#define TASK_TICKS (10)
+
+// The execution budget of the fast and hung tasks. (ticks)
+#define BUDGET_TICKS (2)
+
+// The normal handler execution time. (ticks)
+#define EXEC_TICKS (1)
+
+// The handler execution time of an overrun. (ticks)
+#define OVERRUN_TICKS (5)
+
+// The fast task's handler calls which overrun the budget.
+#define OVERRUN_CALL_A (3)
+#define OVERRUN_CALL_B (7)
+
+// The time and execution time of the slow task without a budget. (ticks)
+#define SLOW_TICKS (155)
+#define SLOW_EXEC_TICKS (20)
+
+// The time at which the fast task is replaced by the hung task. (ticks)
+#define HUNG_TICKS (302)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (405)
+
+// The period of the simulated watchdog. (ticks)
+#define WATCHDOG_TICKS (30)
+
+// The expected budget overruns of the hung task, one for each call.
+#define HUNG_OVERRUNS_EXPECTED ((STOP_TICKS - HUNG_TICKS) / TASK_TICKS)
+
+// The tasks.
+SCHED_TASK_DEF(fast_task);
+SCHED_TASK_DEF(slow_task);
+SCHED_TASK_DEF(hung_task);
+SCHED_TASK_DEF(phase_task);
+SCHED_TASK_DEF(stop_task);
+
+// The number of fast task handler calls.
+static uint32_t fast_calls = 0;
+
+// The number of overruns reported to the hook.
+static uint32_t hook_overruns = 0;
+
+// The time the last overrunning handler returned. (ticks)
+static sched_time_t overrun_end_ticks = 0;
+
+// The number of watchdog refreshes.
+static uint32_t kick_cnt = 0;
+
+// The time of the last watchdog refresh. (ticks)
+static sched_time_t kick_ticks = 0;
+
+// Has the stop task run?
+static bool stopped = false;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for simulating a handler's execution time.
+static void exec_ticks(sched_time_t ticks)
+{
+  sched_sim_advance_ns(sched_sim_ticks_ns(ticks));
+}
+
+void budget_overrun_hook(struct _sched_task *p_task, uint64_t exec_ms)
+{
+  log_info("Budget Overrun at %u Ticks: %u Ticks\n", (uint32_t)sched_port_ticks(),
+           (uint32_t)exec_ms);
+
+  if ((p_task == &slow_task) || (exec_ms != OVERRUN_TICKS))
+  {
+    log_error("Error: An overrun of %u ticks was reported.\n", (uint32_t)exec_ms);
+    test_pass_set(false);
+  }
+
+  hook_overruns++;
+  overrun_end_ticks = sched_port_ticks();
+}
+
+void watchdog_kick_hook(void)
+{
+  /* The pass which stops the scheduler refreshes the watchdog unless it also
+   * ran an overrunning handler, which depends on the order of the task list.
+   */
+  if (stopped)
+  {
+    return;
+  }
+
+  sched_time_t now_ticks = sched_port_ticks();
+
+  // The pass which ran the overrunning handler doesn't refresh the watchdog.
+  if ((hook_overruns > 0) && (now_ticks == overrun_end_ticks))
+  {
+    log_error("Error: The watchdog was refreshed after an overrun at %u ticks.\n",
+              (uint32_t)now_ticks);
+    test_pass_set(false);
+  }
+
+  if ((now_ticks > HUNG_TICKS) && (now_ticks < STOP_TICKS))
+  {
+    log_error("Error: The watchdog was refreshed at %u ticks while the hung task ran.\n",
+              (uint32_t)now_ticks);
+    test_pass_set(false);
+  }
+
+  if (now_ticks - kick_ticks > WATCHDOG_TICKS)
+  {
+    log_error("Error: The watchdog expired before the refresh at %u ticks.\n",
+              (uint32_t)now_ticks);
+    test_pass_set(false);
+  }
+
+  kick_cnt++;
+  kick_ticks = now_ticks;
+}
+
+// Fast Task Handler, overruns its budget on two of its calls.
+static void fast_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  fast_calls++;
+  bool overrun = (fast_calls == OVERRUN_CALL_A) || (fast_calls == OVERRUN_CALL_B);
+  exec_ticks(overrun ? OVERRUN_TICKS : EXEC_TICKS);
+}
+
+// Slow Task Handler, the task has no budget.
+static void slow_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  exec_ticks(SLOW_EXEC_TICKS);
+}
+
+// Hung Task Handler, overruns its budget on every call.
+static void hung_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  exec_ticks(OVERRUN_TICKS);
+}
+
+// Phase Task Handler, replaces the fast task with the hung task.
+static void phase_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if (sched_task_budget_overruns(&fast_task) != 2)
+  {
+    log_error("Error: The fast task overran its budget %u times.\n",
+              sched_task_budget_overruns(&fast_task));
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_stop(&fast_task);
+  success = success && sched_task_start(&hung_task);
+  if (!success)
+  {
+    log_error("Error: The hung task could not be started.\n");
+    test_pass_set(false);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // The watchdog hasn't been refreshed since the hung task started.
+  if ((kick_ticks > HUNG_TICKS) || (sched_port_ticks() - kick_ticks <= WATCHDOG_TICKS))
+  {
+    log_error("Error: The hung task didn't starve the watchdog.\n");
+    test_pass_set(false);
+  }
+
+  if (sched_task_budget_overruns(&hung_task) != HUNG_OVERRUNS_EXPECTED)
+  {
+    log_error("Error: The hung task overran its budget %u times.\n",
+              sched_task_budget_overruns(&hung_task));
+    test_pass_set(false);
+  }
+
+  stopped = true;
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Task Budget Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // A task must be configured before its budget can be set.
+  if (sched_task_budget(&fast_task, BUDGET_TICKS))
+  {
+    log_error("Error: The budget of an unconfigured task was set.\n");
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_config(&fast_task, fast_task_handler, TASK_TICKS, true);
+  success = success && sched_task_budget(&fast_task, BUDGET_TICKS);
+  success = success && sched_task_start(&fast_task);
+
+  success = success && sched_task_config(&slow_task, slow_task_handler, SLOW_TICKS, false);
+  success = success && sched_task_start(&slow_task);
+
+  success = success && sched_task_config(&hung_task, hung_task_handler, TASK_TICKS, true);
+  success = success && sched_task_budget(&hung_task, BUDGET_TICKS);
+
+  success = success && sched_task_config(&phase_task, phase_task_handler, HUNG_TICKS, false);
+  success = success && sched_task_start(&phase_task);
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Overruns: %u, Watchdog Refreshes: %u\n", hook_overruns, kick_cnt);
+
+  if ((hook_overruns != 2 + HUNG_OVERRUNS_EXPECTED) || (kick_cnt == 0))
+  {
+    log_error("Error: %u overruns were reported with %u watchdog refreshes.\n", hook_overruns,
+              kick_cnt);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Task Budget Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Task Budget Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,238 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Slack Coalescing Test
+ *
+ * The program tests the scheduler's task slack support.
+ *
+ * A set of repeating tasks with unrelated intervals is run for one hour of
+ * simulated time, first without slack and then with a slack time of a fifth
+ * of each task's interval.  The simulated platform support counts the number
+ * of times the scheduler sleeps.  The test verifies that:
+ *
+ *  - No task handler is called before its task expires.
+ *  - No task handler is called later than its slack time after the task
+ *    expires.
+ *  - Assigning slack to the tasks reduces the number of wake ups by at least
+ *    a quarter.
+ *
+ * The simulated time starts shortly before the mS time rolls over so the
+ * rollover occurs during each test pass.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The simulated test duration (mS)
+#define TEST_DURATION_MS (60 * 60 * 1000)
+
+// The simulated time at the start of each test pass (mS)
+#define TEST_START_MS (UINT32_MAX - (TEST_DURATION_MS / 2))
+
+// The slack time of each task as a fraction of its interval.
+#define SLACK_DIVISOR (5)
+
+// The repeating task intervals (mS)
+static const uint32_t task_intervals_ms[] =
+{
+  1000, 1130, 1570, 2310, 4470, 9990, 30230, 59870
+};
+
+// The number of repeating test tasks.
+#define TASK_COUNT (sizeof(task_intervals_ms) / sizeof(task_intervals_ms[0]))
+
+// The repeating test tasks.
+static SCHED_TASK_SECTION sched_task_t test_tasks[TASK_COUNT];
+
+// The time each test task is next expected to expire (mS)
+static sched_time_t task_expire_ms[TASK_COUNT];
+
+// The slack of each test task. (mS)
+static uint32_t task_slack_ms[TASK_COUNT];
+
+// The test completion task.
+SCHED_TASK_DEF(stop_task);
+
+// The simulated time (mS)
+static sched_time_t sim_time_ms = 0;
+
+// Count of the number of times the scheduler slept.
+static uint32_t sim_wake_cnt = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+/* Simulated Platform Support Functions
+ *
+ * The test is single threaded so exclusive access is not required.  Sleeping
+ * advances the simulated time by the entire sleep interval.
+ */
+void sched_port_lock(void)
+{
+}
+
+void sched_port_free(void)
+{
+}
+
+uint32_t sched_port_ms(void)
+{
+  return (uint32_t)sim_time_ms;
+}
+
+sched_time_t sched_port_ticks(void)
+{
+  return sim_time_ms;
+}
+
+void sched_port_sleep(uint32_t interval_ms)
+{
+  sim_time_ms += interval_ms;
+  sim_wake_cnt++;
+}
+
+// Function for storing a test task's next expiration time.
+static void test_task_expire_set(uint32_t index)
+{
+  task_expire_ms[index] = test_tasks[index].start_ms + test_tasks[index].interval_ms;
+}
+
+// Test Task Handler
+static void test_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = (uint32_t)(p_task - test_tasks);
+  assert(index < TASK_COUNT);
+
+  // The simulated time doesn't advance during the handler call.
+  int32_t late_ms = (int32_t)(sim_time_ms - task_expire_ms[index]);
+  uint32_t slack_ms = task_slack_ms[index];
+
+  if (late_ms < 0)
+  {
+    log_error("Error: Task %u called %d mS early.\n", index, -late_ms);
+    test_pass_set(false);
+  }
+  else if ((uint32_t)late_ms > slack_ms)
+  {
+    log_error("Error: Task %u called %d mS late with %u mS of slack.\n", index,
+              late_ms, slack_ms);
+    test_pass_set(false);
+  }
+
+  // The task has been re-armed before the handler call.
+  test_task_expire_set(index);
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    sched_task_stop(&test_tasks[index]);
+  }
+  sched_stop();
+}
+
+/* Function for running the test tasks for the test duration.
+ * Returns the number of scheduler wake ups.
+ */
+static uint32_t test_run(bool slack)
+{
+  sim_time_ms = TEST_START_MS;
+  sim_wake_cnt = 0;
+
+  // Initialize the Scheduler
+  sched_init();
+
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    task_slack_ms[index] = slack ? (task_intervals_ms[index] / SLACK_DIVISOR) : 0;
+
+    bool success = sched_task_config(&test_tasks[index], test_task_handler,
+                                     task_intervals_ms[index], true);
+    success = success && sched_task_slack(&test_tasks[index], task_slack_ms[index]);
+    success = success && sched_task_start(&test_tasks[index]);
+    if (!success)
+    {
+      log_error("Error: Task %u could not be started.\n", index);
+      test_pass_set(false);
+    }
+    test_task_expire_set(index);
+  }
+
+  sched_task_config(&stop_task, stop_task_handler, TEST_DURATION_MS, false);
+  sched_task_start(&stop_task);
+
+  // Start the Scheduler (Returns after the test duration)
+  sched_start();
+
+  return sim_wake_cnt;
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Slack Coalescing Test Started ***\n\n");
+
+  // The slack time can't be set for an unconfigured task.
+  if (sched_task_slack(NULL, 0) || sched_task_slack(&stop_task, 0))
+  {
+    log_error("Error: Invalid slack change accepted.\n");
+    test_pass_set(false);
+  }
+
+  uint32_t wake_cnt = test_run(false);
+  uint32_t coalesced_wake_cnt = test_run(true);
+
+  log_info("Wake Ups per Hour: %u, Coalesced: %u\n", wake_cnt, coalesced_wake_cnt);
+
+  if ((coalesced_wake_cnt * 4) > (wake_cnt * 3))
+  {
+    log_error("Error: Slack didn't reduce the wake ups, %u vs %u.\n",
+              coalesced_wake_cnt, wake_cnt);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Slack Coalescing Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Slack Coalescing Test: FAIL\n");
+    return 1;
+  }
+}
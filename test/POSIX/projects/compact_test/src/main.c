@@ -0,0 +1,301 @@
+/**
+ *  main.c
+ *
+ *  POSIX Compact Task Layout Test
+ *
+ * The program tests the compact task layout, built with SCHED_TASK_COMPACT_EN
+ * enabled, on the simulated time port.  Tasks defined with each of the task
+ * definition macros, an array of tasks with the task section attribute and
+ * tasks allocated from a buffered and an arena task pool, defined in two
+ * modules, share the task que.  The test verifies that:
+ *
+ *  - A task outside of the task section, or a pool of such tasks, is rejected.
+ *  - Each repeating task is called the exact number of times, including the
+ *    tasks stopped part way through the test.
+ *  - The buffered and pool tasks are called once with their data and the pool
+ *    tasks are returned to their pools.
+ *  - Unbuffered tasks don't store data and are called without data.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+#include "tasks.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The interval of the first array task, each following task is one step longer. (ticks)
+#define ARRAY_INTERVAL_STEP (10)
+
+// The time at which the even array tasks are stopped. (ticks)
+#define MIDDLE_TICKS (505)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (1005)
+
+// The delay of the buffered task. (ticks)
+#define BUFF_TICKS (250)
+
+// The delay of the first pool task, each following task is one tick longer. (ticks)
+#define POOL_TICKS (100)
+
+// The data stored in the buffered task.
+static const uint8_t BUFF_DATA[TASK_BUFF_SIZE] = "compact";
+
+// The task which stops the even array tasks part way through the test.
+SCHED_TASK_DEF(middle_task);
+
+// The task which stops the test.
+SCHED_TASK_DEF(stop_task);
+
+// A task defined outside of the task section which can't be configured.
+static sched_task_t outside_task;
+
+// A task pool with tasks outside of the task section which can't allocate tasks.
+static uint8_t outside_pool_buff[TASK_BUFF_SIZE];
+static sched_task_t outside_pool_tasks[1];
+static uint32_t outside_pool_free[1];
+static sched_task_pool_t outside_pool = {
+    .p_data = outside_pool_buff,
+    .p_tasks = outside_pool_tasks,
+    .p_free = outside_pool_free,
+    .p_arena_free = NULL,
+    .arena_blocks = 0,
+    .buff_size = TASK_BUFF_SIZE,
+    .task_cnt = 1,
+    .initialized = false};
+
+// The number of handler calls of each array task.
+static uint32_t array_calls[ARRAY_TASK_COUNT];
+
+// The number of handler calls of the buffered task.
+static uint32_t buff_calls = 0;
+
+// The number of handler calls of the pool tasks.
+static uint32_t pool_calls = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Array Task Handler
+static void array_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = (uint32_t)(p_task - array_task_get(0));
+  assert(index < ARRAY_TASK_COUNT);
+  array_calls[index]++;
+}
+
+// Buffered Task Handler
+static void buff_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  buff_calls++;
+
+  if ((data_size != sizeof(BUFF_DATA)) || (memcmp(p_data, BUFF_DATA, sizeof(BUFF_DATA)) != 0))
+  {
+    log_error("Error: The buffered task's data is corrupt.\n");
+    test_pass_set(false);
+  }
+}
+
+// Pool Task Handler, the data is the task's delay.
+static void pool_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  pool_calls++;
+
+  sched_time_t delay_ticks;
+  if ((data_size != sizeof(delay_ticks)) || (p_data == NULL))
+  {
+    log_error("Error: A pool task's data size is %u.\n", data_size);
+    test_pass_set(false);
+    return;
+  }
+
+  memcpy(&delay_ticks, p_data, sizeof(delay_ticks));
+  if (sched_port_ticks() != delay_ticks)
+  {
+    log_error("Error: A pool task with a %u tick delay was called at %u ticks.\n",
+              (uint32_t)delay_ticks, (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+}
+
+// Middle Task Handler, stops the even array tasks.
+static void middle_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if ((p_data != NULL) || (data_size != 0))
+  {
+    log_error("Error: An unbuffered task was called with data.\n");
+    test_pass_set(false);
+  }
+
+  for (uint32_t index = 0; index < ARRAY_TASK_COUNT; index += 2)
+  {
+    bool success = sched_task_stop(array_task_get(index));
+    assert(success);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // Every pool task has been called and returned to its pool.
+  if ((sched_pool_free(msg_pool_get()) != POOL_TASK_COUNT) ||
+      (sched_pool_free(arena_pool_get()) != POOL_TASK_COUNT) ||
+      (sched_pool_arena_free(arena_pool_get()) != ARENA_SIZE))
+  {
+    log_error("Error: The pool tasks were not returned to their pools.\n");
+    test_pass_set(false);
+  }
+
+  sched_stop();
+}
+
+/* Function for allocating, configuring and starting every task of a pool.
+ * Each task stores its delay as its data.
+ */
+static bool pool_tasks_start(sched_task_pool_t *p_pool, sched_time_t delay_ticks)
+{
+  for (uint32_t index = 0; index < POOL_TASK_COUNT; index++)
+  {
+    sched_task_t *p_task = sched_task_alloc(p_pool);
+    if (p_task == NULL)
+    {
+      return false;
+    }
+
+    bool success = sched_task_config(p_task, pool_task_handler, delay_ticks, false);
+    success = success && (sched_task_data(p_task, &delay_ticks, sizeof(delay_ticks)) ==
+                          sizeof(delay_ticks));
+    success = success && sched_task_start(p_task);
+    if (!success)
+    {
+      return false;
+    }
+    delay_ticks++;
+  }
+
+  // The pool is empty.
+  return sched_task_alloc(p_pool) == NULL;
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Compact Task Layout Test Started ***\n\n");
+  log_info("Task Size: %u bytes\n", (uint32_t)sizeof(sched_task_t));
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Tasks and pool tasks outside of the task section are rejected.
+  if (sched_task_config(&outside_task, array_task_handler, 1, false))
+  {
+    log_error("Error: A task outside of the task section was configured.\n");
+    test_pass_set(false);
+  }
+  if (sched_task_alloc(&outside_pool) != NULL)
+  {
+    log_error("Error: A task was allocated from outside of the task section.\n");
+    test_pass_set(false);
+  }
+
+  bool success = true;
+  for (uint32_t index = 0; index < ARRAY_TASK_COUNT; index++)
+  {
+    sched_time_t interval_ticks = (index + 1) * ARRAY_INTERVAL_STEP;
+    success = success && sched_task_config(array_task_get(index), array_task_handler,
+                                           interval_ticks, true);
+    success = success && sched_task_start(array_task_get(index));
+  }
+
+  success = success && sched_task_config(buff_task_get(), buff_task_handler, BUFF_TICKS, false);
+  success = success && (sched_task_data(buff_task_get(), BUFF_DATA, sizeof(BUFF_DATA)) ==
+                        sizeof(BUFF_DATA));
+  success = success && sched_task_start(buff_task_get());
+
+  success = success && pool_tasks_start(msg_pool_get(), POOL_TICKS);
+  success = success && pool_tasks_start(arena_pool_get(), POOL_TICKS + POOL_TASK_COUNT);
+
+  success = success && sched_task_config(&middle_task, middle_task_handler, MIDDLE_TICKS, false);
+  success = success && (sched_task_data(&middle_task, BUFF_DATA, sizeof(BUFF_DATA)) == 0);
+  success = success && sched_task_start(&middle_task);
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  for (uint32_t index = 0; index < ARRAY_TASK_COUNT; index++)
+  {
+    sched_time_t interval_ticks = (index + 1) * ARRAY_INTERVAL_STEP;
+    uint32_t expected = (index % 2 == 0) ? (MIDDLE_TICKS / interval_ticks)
+                                         : (STOP_TICKS / interval_ticks);
+
+    log_info("Array Task %u Calls: %u\n", index, array_calls[index]);
+    if (array_calls[index] != expected)
+    {
+      log_error("Error: Array task %u was called %u times, expected %u.\n", index,
+                array_calls[index], expected);
+      test_pass_set(false);
+    }
+  }
+
+  if ((buff_calls != 1) || (pool_calls != 2 * POOL_TASK_COUNT))
+  {
+    log_error("Error: The buffered task was called %u times and the pool tasks %u times.\n",
+              buff_calls, pool_calls);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Compact Task Layout Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Compact Task Layout Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,42 @@
+/**
+ * @file tasks.c
+ * @author Ben Wirz
+ * @brief Tasks defined in a separate module for the compact task layout test.
+ *
+ * The tasks are placed in the task section from a different module than the
+ * tasks defined in main.c so the test covers tasks linked across modules.
+ */
+
+#include "tasks.h"
+
+// An array of tasks defined directly with the task section attribute.
+static SCHED_TASK_SECTION sched_task_t array_tasks[ARRAY_TASK_COUNT];
+
+// A buffered task.
+SCHED_TASK_BUFF_DEF(buff_task, TASK_BUFF_SIZE);
+
+// A task pool with a buffer for each task.
+SCHED_TASK_POOL_DEF(msg_pool, TASK_BUFF_SIZE, POOL_TASK_COUNT);
+
+// A task pool with a shared data arena.
+SCHED_TASK_ARENA_POOL_DEF(arena_pool, ARENA_SIZE, POOL_TASK_COUNT);
+
+sched_task_t *array_task_get(uint32_t index)
+{
+  return (index < ARRAY_TASK_COUNT) ? &array_tasks[index] : NULL;
+}
+
+sched_task_t *buff_task_get(void)
+{
+  return &buff_task;
+}
+
+sched_task_pool_t *msg_pool_get(void)
+{
+  return &msg_pool;
+}
+
+sched_task_pool_t *arena_pool_get(void)
+{
+  return &arena_pool;
+}
@@ -0,0 +1,49 @@
+/**
+ * @file tasks.h
+ * @author Ben Wirz
+ * @brief Tasks defined in a separate module for the compact task layout test.
+ */
+
+#ifndef TASKS_H__
+#define TASKS_H__
+
+#include "scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The number of tasks in the array of tasks.
+#define ARRAY_TASK_COUNT (8)
+
+// The buffer size of the buffered task and the message pool tasks. (bytes)
+#define TASK_BUFF_SIZE (8)
+
+// The number of tasks in each task pool.
+#define POOL_TASK_COUNT (4)
+
+// The size of the arena pool's data arena, a block for each task. (bytes)
+#define ARENA_SIZE (SCHED_TASK_ARENA_BLOCK_SIZE * POOL_TASK_COUNT)
+
+/**
+ * @brief Function for getting a task from the array of tasks.
+ *
+ * @param[in] index  The task's index, less than ARRAY_TASK_COUNT.
+ * @return Pointer to the task.
+ */
+sched_task_t *array_task_get(uint32_t index);
+
+/// @brief Function for getting the buffered task.
+sched_task_t *buff_task_get(void);
+
+/// @brief Function for getting the message task pool.
+sched_task_pool_t *msg_pool_get(void);
+
+/// @brief Function for getting the arena task pool.
+sched_task_pool_t *arena_pool_get(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TASKS_H__
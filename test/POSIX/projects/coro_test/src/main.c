@@ -0,0 +1,367 @@
+/**
+ *  main.c
+ *
+ *  POSIX Coroutine Task Test
+ *
+ * The program tests coroutine tasks, built with SCHED_EVENT_EN enabled, on
+ * the simulated time port.  A flash erase coroutine erases a number of
+ * sectors, polling for each erase to finish, and a radio join coroutine
+ * waits for replies signaled by simulated interrupts.  A repeating task runs
+ * alongside the coroutines.  The test verifies that:
+ *
+ *  - Each coroutine step runs at the expected time and the setup code at the
+ *    top of the coroutine only runs once per coroutine run.
+ *  - A signal made while the coroutine isn't waiting for it resumes the
+ *    coroutine as soon as it waits for the event.
+ *  - A coroutine task stops at the end of its coroutine and starting it again
+ *    runs the coroutine from the beginning.
+ *  - The repeating task is called on time while the coroutines are yielding.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_coroutine.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The number of flash sectors to erase.
+#define SECTOR_CNT (3)
+
+// The time a sector erase takes. (ticks)
+#define ERASE_TICKS (12)
+
+// The interval between the erase done checks. (ticks)
+#define ERASE_POLL_TICKS (5)
+
+// The delay before the erase coroutine is called. (ticks)
+#define ERASE_START_TICKS (10)
+
+// The time at which the erase coroutine is run again. (ticks)
+#define ERASE_RESTART_TICKS (300)
+
+// The delay before the join coroutine is called. (ticks)
+#define JOIN_START_TICKS (100)
+
+// The time the join coroutine waits between its replies. (ticks)
+#define JOIN_WAIT_TICKS (50)
+
+// The interval of the repeating task. (ticks)
+#define REPEAT_TICKS (10)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (405)
+
+// The times of the simulated interrupts which signal the join replies, the
+// second reply arrives while the coroutine yields. (ticks)
+static const sched_time_t irq_ticks[] = {137, 150};
+
+#define IRQ_CNT (sizeof(irq_ticks) / sizeof(irq_ticks[0]))
+
+// The coroutine steps.
+typedef enum
+{
+  STEP_ERASE_SETUP,
+  STEP_ERASE_START,
+  STEP_ERASE_DONE,
+  STEP_ERASE_END,
+  STEP_JOIN_SETUP,
+  STEP_JOIN_ACCEPT,
+  STEP_JOIN_KEY,
+  STEP_JOIN_END,
+} step_t;
+
+// A coroutine step and the time it ran.
+typedef struct
+{
+  step_t step;
+  sched_time_t time_ticks;
+} step_log_t;
+
+// The expected coroutine steps.
+static const step_log_t steps_expected[] = {
+    {STEP_ERASE_SETUP, 10},
+    {STEP_ERASE_START, 10},
+    {STEP_ERASE_DONE, 25},
+    {STEP_ERASE_START, 25},
+    {STEP_ERASE_DONE, 40},
+    {STEP_ERASE_START, 40},
+    {STEP_ERASE_DONE, 55},
+    {STEP_ERASE_END, 55},
+    {STEP_JOIN_SETUP, 100},
+    {STEP_JOIN_ACCEPT, 137},
+    {STEP_JOIN_KEY, 137 + JOIN_WAIT_TICKS},
+    {STEP_JOIN_END, 137 + JOIN_WAIT_TICKS},
+    {STEP_ERASE_SETUP, 310},
+    {STEP_ERASE_START, 310},
+    {STEP_ERASE_DONE, 325},
+    {STEP_ERASE_START, 325},
+    {STEP_ERASE_DONE, 340},
+    {STEP_ERASE_START, 340},
+    {STEP_ERASE_DONE, 355},
+    {STEP_ERASE_END, 355},
+};
+
+#define STEP_CNT (sizeof(steps_expected) / sizeof(steps_expected[0]))
+
+// The join reply event.
+SCHED_EVENT_DEF(reply_event, 1);
+
+// The coroutine tasks.
+SCHED_TASK_DEF(erase_task);
+SCHED_TASK_DEF(join_task);
+
+// The timed tasks.
+SCHED_TASK_DEF(repeat_task);
+SCHED_TASK_DEF(restart_task);
+SCHED_TASK_DEF(stop_task);
+
+// The coroutine states.
+static sched_coro_t erase_coro;
+static sched_coro_t join_coro;
+
+// The erase coroutine's sector, kept across the yield points.
+static uint32_t erase_sector = 0;
+
+// The time the current sector erase finishes. (ticks)
+static sched_time_t erase_done_ticks = 0;
+
+// The index of the next interrupt.
+static uint32_t irq_index = 0;
+
+// The number of coroutine steps.
+static uint32_t step_cnt = 0;
+
+// The number of repeating task calls.
+static uint32_t repeat_calls = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for checking a coroutine step against the expected steps.
+static void step_check(step_t step)
+{
+  log_info("Step %u at %u Ticks\n", step, (uint32_t)sched_port_ticks());
+
+  if ((step_cnt >= STEP_CNT) ||
+      (steps_expected[step_cnt].step != step) ||
+      (steps_expected[step_cnt].time_ticks != sched_port_ticks()))
+  {
+    log_error("Error: Step %u ran at %u ticks.\n", step, (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+  step_cnt++;
+}
+
+// Function for scheduling the next simulated interrupt.
+static void irq_next(void);
+
+// Simulated Interrupt Handler, signals a join reply.
+static void irq_handler(void)
+{
+  irq_index++;
+  if (!sched_event_signal(&reply_event))
+  {
+    log_error("Error: A join reply was lost.\n");
+    test_pass_set(false);
+  }
+  irq_next();
+}
+
+static void irq_next(void)
+{
+  if (irq_index < IRQ_CNT)
+  {
+    sched_sim_irq_set(sched_sim_ticks_ns(irq_ticks[irq_index]), irq_handler);
+  }
+}
+
+// Function for starting a simulated sector erase.
+static void erase_start(void)
+{
+  step_check(STEP_ERASE_START);
+  erase_done_ticks = sched_port_ticks() + ERASE_TICKS;
+}
+
+// Function for checking if the simulated sector erase is done.
+static bool erase_done(void)
+{
+  return sched_port_ticks() >= erase_done_ticks;
+}
+
+// Erase Task Handler, erases the sectors one at a time.
+static void erase_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  SCHED_CORO_BEGIN(&erase_coro, p_task);
+
+  step_check(STEP_ERASE_SETUP);
+
+  for (erase_sector = 0; erase_sector < SECTOR_CNT; erase_sector++)
+  {
+    erase_start();
+    SCHED_CORO_YIELD_UNTIL(erase_done(), ERASE_POLL_TICKS);
+    step_check(STEP_ERASE_DONE);
+  }
+
+  // Give the other tasks a turn before finishing.
+  SCHED_CORO_YIELD();
+  step_check(STEP_ERASE_END);
+
+  SCHED_CORO_END();
+}
+
+// Join Task Handler, waits for the join replies.
+static void join_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  SCHED_CORO_BEGIN(&join_coro, p_task);
+
+  step_check(STEP_JOIN_SETUP);
+  SCHED_CORO_WAIT_EVENT(&reply_event);
+
+  step_check(STEP_JOIN_ACCEPT);
+  SCHED_CORO_YIELD_MS(JOIN_WAIT_TICKS);
+
+  // The second reply was signaled while the coroutine yielded.
+  step_check(STEP_JOIN_KEY);
+  SCHED_CORO_WAIT_EVENT(&reply_event);
+
+  step_check(STEP_JOIN_END);
+
+  SCHED_CORO_END();
+}
+
+// Repeating Task Handler
+static void repeat_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  repeat_calls++;
+  if (sched_port_ticks() != repeat_calls * REPEAT_TICKS)
+  {
+    log_error("Error: The repeating task was called at %u ticks.\n",
+              (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+}
+
+// Restart Task Handler, runs the finished erase coroutine again.
+static void restart_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if ((sched_task_state(&erase_task) != SCHED_TASK_STOPPED) || sched_coro_running(&erase_coro))
+  {
+    log_error("Error: The erase task didn't stop at the end of its coroutine.\n");
+    test_pass_set(false);
+  }
+
+  if (!sched_task_update(&erase_task, ERASE_START_TICKS))
+  {
+    log_error("Error: The erase task could not be started again.\n");
+    test_pass_set(false);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // Both coroutines finished and their tasks stopped.
+  if ((sched_task_state(&erase_task) != SCHED_TASK_STOPPED) ||
+      (sched_task_state(&join_task) != SCHED_TASK_STOPPED) ||
+      sched_coro_running(&erase_coro) || sched_coro_running(&join_coro))
+  {
+    log_error("Error: The coroutine tasks didn't stop.\n");
+    test_pass_set(false);
+  }
+
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Coroutine Task Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = sched_task_config(&erase_task, erase_task_handler, ERASE_START_TICKS, false);
+  success = success && sched_task_start(&erase_task);
+  success = success && sched_task_config(&join_task, join_task_handler, JOIN_START_TICKS, false);
+  success = success && sched_task_start(&join_task);
+
+  success = success && sched_task_config(&repeat_task, repeat_task_handler, REPEAT_TICKS, true);
+  success = success && sched_task_start(&repeat_task);
+  success = success && sched_task_config(&restart_task, restart_task_handler,
+                                         ERASE_RESTART_TICKS, false);
+  success = success && sched_task_start(&restart_task);
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    irq_next();
+
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Steps: %u, Repeating Task Calls: %u\n", step_cnt, repeat_calls);
+
+  if ((step_cnt != STEP_CNT) || (irq_index != IRQ_CNT))
+  {
+    log_error("Error: %u of %u coroutine steps ran.\n", step_cnt, (uint32_t)STEP_CNT);
+    test_pass_set(false);
+  }
+
+  if (repeat_calls != STOP_TICKS / REPEAT_TICKS)
+  {
+    log_error("Error: The repeating task was called %u times.\n", repeat_calls);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Coroutine Task Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Coroutine Task Test: FAIL\n");
+    return 1;
+  }
+}
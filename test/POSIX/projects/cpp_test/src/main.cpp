@@ -0,0 +1,271 @@
+/**
+ *  main.cpp
+ *
+ *  POSIX C++ Wrapper Test
+ *
+ * The program tests the header only C++ wrapper on the simulated time port.
+ * A repeating task with a lambda handler updates its payload on every call,
+ * a task with a member function handler has a payload with a constructor and
+ * a pool of single shot tasks with a function handler is allocated, each
+ * task with its own payload.  The test verifies that:
+ *
+ *  - Payloads are constructed in place and passed to their handlers by
+ *    reference, changes to a repeating task's payload are kept.
+ *  - Lambda, member function and function handlers are called on time.
+ *  - A started task's payload can't be replaced and a started task can't be
+ *    configured.
+ *  - The pool's tasks are returned to the pool when they stop.
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include "scheduler.hpp"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The interval of the sample task. (ticks)
+#define SAMPLE_TICKS (10)
+
+// The interval of the filter task. (ticks)
+#define FILTER_TICKS (25)
+
+// The delay of the first message task, each task is delayed by an additional interval. (ticks)
+#define MSG_TICKS (15)
+
+// The number of tasks in the message pool.
+#define MSG_CNT (4)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (105)
+
+// The expected task calls.
+#define SAMPLE_CALLS_EXPECTED (STOP_TICKS / SAMPLE_TICKS)
+#define FILTER_CALLS_EXPECTED (STOP_TICKS / FILTER_TICKS)
+
+// The sample task's payload, an aggregate.
+struct sample_t
+{
+  uint8_t channel;
+  uint16_t value;
+};
+
+// The filter task's payload, a type with a constructor.
+class reading_t
+{
+public:
+  reading_t(uint16_t offset, uint16_t scale) : offset_(offset), scale_(scale) {}
+  uint16_t apply(uint16_t raw) const { return (uint16_t)(raw * scale_ + offset_); }
+
+private:
+  uint16_t offset_;
+  uint16_t scale_;
+};
+
+// The message tasks' payload.
+struct msg_t
+{
+  uint8_t index;
+  sched_time_t due_ticks;
+};
+
+// The filter, whose member function is the filter task's handler.
+class filter_t
+{
+public:
+  void on_reading(sched::task_ref<reading_t> task, reading_t &reading);
+  uint32_t calls = 0;
+};
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// The tasks.
+static SCHED_TASK_SECTION sched::task<sample_t> sample_task;
+static SCHED_TASK_SECTION sched::task<reading_t> filter_task;
+static SCHED_TASK_SECTION sched::task<uint8_t> stop_task;
+
+#if (SCHED_TASK_POOL_EN != 0) && (SCHED_TASK_COMPACT_EN == 0)
+static sched::task_pool<msg_t, MSG_CNT> msg_pool;
+#endif
+
+static filter_t filter;
+
+// The number of task calls.
+static uint32_t sample_calls = 0;
+static uint32_t msg_calls = 0;
+
+// Function for checking that a task is called on time.
+static void on_time_check(sched_time_t expected_ticks)
+{
+  if (sched_port_ticks() != expected_ticks)
+  {
+    log_error("Error: A task was called at %u ticks rather than %u ticks.\n",
+              (uint32_t)sched_port_ticks(), (uint32_t)expected_ticks);
+    test_pass_set(false);
+  }
+}
+
+// Filter Task Handler
+void filter_t::on_reading(sched::task_ref<reading_t> task, reading_t &reading)
+{
+  calls++;
+  on_time_check(calls * FILTER_TICKS);
+
+  if ((this != &filter) || (task.get() != filter_task.get()) || (reading.apply(3) != 11))
+  {
+    log_error("Error: The filter task was called with the wrong object or payload.\n");
+    test_pass_set(false);
+  }
+}
+
+// Message Task Handler
+static void msg_handler(sched::task_ref<msg_t> task, msg_t &msg)
+{
+  msg_calls++;
+  on_time_check(msg.due_ticks);
+
+  if ((msg.index >= MSG_CNT) || (msg.due_ticks != (sched_time_t)((msg.index + 1) * MSG_TICKS)))
+  {
+    log_error("Error: Message task %u was called with the wrong payload.\n", msg.index);
+    test_pass_set(false);
+  }
+}
+
+// Function for configuring and starting the message tasks.
+static bool msg_start(void)
+{
+#if (SCHED_TASK_POOL_EN != 0) && (SCHED_TASK_COMPACT_EN == 0)
+  for (uint8_t index = 0; index < MSG_CNT; index++)
+  {
+    sched::task_ref<msg_t> task = msg_pool.alloc();
+    sched_time_t due_ticks = (index + 1) * MSG_TICKS;
+    if (!task || !task.config(msg_handler, due_ticks, false) ||
+        (task.emplace(index, due_ticks) == nullptr) || !task.start())
+    {
+      return false;
+    }
+  }
+
+  // The pool is exhausted.
+  return !msg_pool.alloc() && (msg_pool.free() == 0);
+#else
+  return true;
+#endif
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler C++ Wrapper Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  uint32_t *p_sample_calls = &sample_calls;
+  bool success = sample_task.config(
+      [p_sample_calls](sched::task_ref<sample_t> task, sample_t &sample)
+      {
+        (*p_sample_calls)++;
+        on_time_check(*p_sample_calls * SAMPLE_TICKS);
+
+        // The payload's value is kept between calls.
+        if ((sample.channel != 2) || (sample.value != 100 + *p_sample_calls - 1))
+        {
+          log_error("Error: The sample task was called with value %u.\n", sample.value);
+          test_pass_set(false);
+        }
+        sample.value++;
+      },
+      SAMPLE_TICKS, true);
+  success = success && (sample_task.emplace(uint8_t(2), uint16_t(100)) != nullptr);
+  success = success && sample_task.start();
+
+  // A started task's payload can't be replaced and the task can't be configured.
+  if (success && ((sample_task.emplace(uint8_t(3), uint16_t(0)) != nullptr) ||
+                  sample_task.config([](sched::task_ref<sample_t>, sample_t &) {}, SAMPLE_TICKS,
+                                     true)))
+  {
+    log_error("Error: The started task was changed.\n");
+    test_pass_set(false);
+  }
+
+  success = success && filter_task.config(filter, &filter_t::on_reading, FILTER_TICKS, true);
+  success = success && (filter_task.emplace(uint16_t(5), uint16_t(2)) != nullptr);
+  success = success && filter_task.start();
+
+  success = success && msg_start();
+
+  success = success && stop_task.config([](sched::task_ref<uint8_t> task, uint8_t &unused)
+                                        { sched_stop(); },
+                                        STOP_TICKS, false);
+  success = success && stop_task.start();
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    // Start the Scheduler (Returns after the Stop Task)
+    sched_start();
+  }
+
+  log_info("Sample Calls: %u, Filter Calls: %u, Message Calls: %u\n", sample_calls, filter.calls,
+           msg_calls);
+
+  if ((sample_calls != SAMPLE_CALLS_EXPECTED) || (filter.calls != FILTER_CALLS_EXPECTED))
+  {
+    log_error("Error: %u sample and %u filter task calls.\n", sample_calls, filter.calls);
+    test_pass_set(false);
+  }
+
+#if (SCHED_TASK_POOL_EN != 0) && (SCHED_TASK_COMPACT_EN == 0)
+  // Every message task was called and returned to the pool.
+  if ((msg_calls != MSG_CNT) || (msg_pool.free() != MSG_CNT))
+  {
+    log_error("Error: %u message task calls, %u free tasks.\n", msg_calls, msg_pool.free());
+    test_pass_set(false);
+  }
+#endif
+
+  if (test_pass)
+  {
+    log_info("Scheduler C++ Wrapper Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler C++ Wrapper Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,381 @@
+/**
+ *  main.c
+ *
+ *  POSIX Event Triggered Task Test
+ *
+ * The program tests event triggered tasks, built with SCHED_EVENT_EN enabled,
+ * on the simulated time port.  A table of simulated interrupts signals a
+ * binary event, a counting event and an event shared by two worker tasks.
+ * The test verifies that:
+ *
+ *  - A signaled task's handler is called on the tick of the signal, or after
+ *    its interval, and waits for the event again once it returns.
+ *  - Signals made while the bound tasks are busy are counted up to the
+ *    event's count limit and the excess signals are reported as lost.
+ *  - Each signal of a shared event starts one worker, in the order the
+ *    workers started waiting.
+ *  - A waiting task can be stopped and a pending signal starts the task when
+ *    it is started again.
+ *  - The scheduler only wakes up for the interrupts and the timed tasks,
+ *    the waiting tasks never wake it.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The count limit of the counting event. (signals)
+#define BURST_COUNT_MAX (8)
+
+// The number of worker tasks sharing the work event.
+#define WORKER_CNT (2)
+
+// The worker tasks' interval after their signal. (ticks)
+#define WORKER_TICKS (5)
+
+// The time at which the receive task is stopped while waiting. (ticks)
+#define STOP_RX_TICKS (550)
+
+// The time at which the stopped receive task is started again. (ticks)
+#define START_RX_TICKS (700)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (1000)
+
+// The number of timed wake ups, the worker deadlines at 505 and 510 ticks and
+// the stop receive, start receive and stop tasks.
+#define TIMED_WAKE_CNT (5)
+
+// A simulated interrupt which signals an event a number of times.
+typedef struct
+{
+  sched_time_t time_ticks;
+  sched_event_t *p_event;
+  uint32_t signal_cnt;
+} irq_t;
+
+// A binary event.
+SCHED_EVENT_DEF(rx_event, 1);
+
+// A counting event.
+SCHED_EVENT_DEF(burst_event, BURST_COUNT_MAX);
+
+// An event shared by the worker tasks.
+SCHED_EVENT_DEF(work_event, 4);
+
+// The interrupt table, the receive task is stopped while its 600 tick signal
+// is made so the signal stays pending.
+static const irq_t irqs[] = {
+    {100, &rx_event, 1},
+    {200, &rx_event, 3},
+    {300, &burst_event, 5},
+    {400, &burst_event, 10},
+    {500, &work_event, 3},
+    {600, &rx_event, 1},
+};
+
+#define IRQ_CNT (sizeof(irqs) / sizeof(irqs[0]))
+
+// The expected number of handler calls and lost signals of each event.
+#define RX_CALLS_EXPECTED (1 + 2 + 1)
+#define RX_LOST_EXPECTED (1)
+#define BURST_CALLS_EXPECTED (5 + 1 + BURST_COUNT_MAX)
+#define BURST_LOST_EXPECTED (1)
+#define WORK_CALLS_EXPECTED (3)
+
+// The expected worker handler calls, the first worker takes the pending
+// signal once its first handler returns.
+static const struct
+{
+  uint32_t worker;
+  sched_time_t time_ticks;
+} work_expected[WORK_CALLS_EXPECTED] = {
+    {0, 500 + WORKER_TICKS},
+    {1, 500 + WORKER_TICKS},
+    {0, 500 + (2 * WORKER_TICKS)},
+};
+
+// The event triggered tasks.
+SCHED_TASK_DEF(rx_task);
+SCHED_TASK_DEF(burst_task);
+static SCHED_TASK_SECTION sched_task_t worker_tasks[WORKER_CNT];
+
+// The timed tasks.
+SCHED_TASK_DEF(stop_rx_task);
+SCHED_TASK_DEF(start_rx_task);
+SCHED_TASK_DEF(stop_task);
+
+// The index of the next interrupt.
+static uint32_t irq_index = 0;
+
+// The number of lost signals of each event.
+static uint32_t rx_lost = 0;
+static uint32_t burst_lost = 0;
+
+// The number of handler calls of each task.
+static uint32_t rx_calls = 0;
+static uint32_t burst_calls = 0;
+static uint32_t work_calls = 0;
+
+// The time of the last interrupt. (ticks)
+static sched_time_t irq_ticks = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for scheduling the next simulated interrupt.
+static void irq_next(void);
+
+// Simulated Interrupt Handler, signals the interrupt's event.
+static void irq_handler(void)
+{
+  const irq_t *p_irq = &irqs[irq_index++];
+  irq_ticks = sched_port_ticks();
+
+  for (uint32_t signal = 0; signal < p_irq->signal_cnt; signal++)
+  {
+    if (!sched_event_signal(p_irq->p_event))
+    {
+      if (p_irq->p_event == &rx_event)
+      {
+        rx_lost++;
+      }
+      else if (p_irq->p_event == &burst_event)
+      {
+        burst_lost++;
+      }
+      else
+      {
+        log_error("Error: A work event signal was lost.\n");
+        test_pass_set(false);
+      }
+    }
+  }
+
+  irq_next();
+}
+
+static void irq_next(void)
+{
+  if (irq_index < IRQ_CNT)
+  {
+    sched_sim_irq_set(sched_sim_ticks_ns(irqs[irq_index].time_ticks), irq_handler);
+  }
+}
+
+// Function for checking that a handler is called on the tick of its signal.
+static void signal_time_check(const char *p_name)
+{
+  if (sched_port_ticks() != irq_ticks)
+  {
+    log_error("Error: The %s task was called at %u ticks, signaled at %u ticks.\n",
+              p_name, (uint32_t)sched_port_ticks(), (uint32_t)irq_ticks);
+    test_pass_set(false);
+  }
+}
+
+// Receive Task Handler
+static void rx_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  rx_calls++;
+  signal_time_check("receive");
+}
+
+// Burst Task Handler
+static void burst_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  burst_calls++;
+  signal_time_check("burst");
+}
+
+// Worker Task Handler
+static void worker_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t worker = (uint32_t)(p_task - worker_tasks);
+  assert(worker < WORKER_CNT);
+
+  if ((work_calls >= WORK_CALLS_EXPECTED) ||
+      (work_expected[work_calls].worker != worker) ||
+      (work_expected[work_calls].time_ticks != sched_port_ticks()))
+  {
+    log_error("Error: Worker %u was called at %u ticks.\n", worker,
+              (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+  work_calls++;
+}
+
+// Stop Receive Task Handler, stops the waiting receive task.
+static void stop_rx_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if (sched_task_state(&rx_task) != SCHED_TASK_WAITING)
+  {
+    log_error("Error: The receive task isn't waiting.\n");
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_stop(&rx_task);
+  if (!success || (sched_task_state(&rx_task) != SCHED_TASK_STOPPED))
+  {
+    log_error("Error: The waiting receive task could not be stopped.\n");
+    test_pass_set(false);
+  }
+}
+
+// Start Receive Task Handler, the pending signal starts the receive task.
+static void start_rx_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if (sched_event_count(&rx_event) != 1)
+  {
+    log_error("Error: The receive event has %u pending signals.\n",
+              sched_event_count(&rx_event));
+    test_pass_set(false);
+  }
+
+  // The signal is taken so the handler is called on this tick.
+  irq_ticks = sched_port_ticks();
+  bool success = sched_task_start(&rx_task);
+  if (!success || (sched_event_count(&rx_event) != 0) ||
+      (sched_task_state(&rx_task) != SCHED_TASK_ACTIVE))
+  {
+    log_error("Error: The receive task didn't take the pending signal.\n");
+    test_pass_set(false);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Event Triggered Task Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = sched_task_config(&rx_task, rx_task_handler, 0, false);
+  success = success && sched_task_event(&rx_task, &rx_event);
+  success = success && sched_task_start(&rx_task);
+
+  success = success && sched_task_config(&burst_task, burst_task_handler, 0, false);
+  success = success && sched_task_event(&burst_task, &burst_event);
+  success = success && sched_task_start(&burst_task);
+
+  for (uint32_t worker = 0; worker < WORKER_CNT; worker++)
+  {
+    success = success && sched_task_config(&worker_tasks[worker], worker_task_handler,
+                                           WORKER_TICKS, false);
+    success = success && sched_task_event(&worker_tasks[worker], &work_event);
+    success = success && sched_task_start(&worker_tasks[worker]);
+  }
+
+  // A task can only be bound to an event while it is stopped.
+  if (sched_task_event(&rx_task, &burst_event))
+  {
+    log_error("Error: A waiting task was bound to a different event.\n");
+    test_pass_set(false);
+  }
+
+  success = success && sched_task_config(&stop_rx_task, stop_rx_task_handler, STOP_RX_TICKS, false);
+  success = success && sched_task_start(&stop_rx_task);
+  success = success && sched_task_config(&start_rx_task, start_rx_task_handler, START_RX_TICKS, false);
+  success = success && sched_task_start(&start_rx_task);
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    irq_next();
+
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Receive Calls: %u, Lost: %u\n", rx_calls, rx_lost);
+  log_info("Burst Calls: %u, Lost: %u\n", burst_calls, burst_lost);
+  log_info("Work Calls: %u\n", work_calls);
+  log_info("Sleeps: %u\n", sched_sim_sleep_cnt());
+
+  if ((rx_calls != RX_CALLS_EXPECTED) || (rx_lost != RX_LOST_EXPECTED))
+  {
+    log_error("Error: The receive task was called %u times with %u lost signals.\n",
+              rx_calls, rx_lost);
+    test_pass_set(false);
+  }
+
+  if ((burst_calls != BURST_CALLS_EXPECTED) || (burst_lost != BURST_LOST_EXPECTED))
+  {
+    log_error("Error: The burst task was called %u times with %u lost signals.\n",
+              burst_calls, burst_lost);
+    test_pass_set(false);
+  }
+
+  if (work_calls != WORK_CALLS_EXPECTED)
+  {
+    log_error("Error: The workers were called %u times.\n", work_calls);
+    test_pass_set(false);
+  }
+
+  // Each interrupt and each timed task wakes the scheduler once.
+  if ((irq_index != IRQ_CNT) || (sched_sim_sleep_cnt() != IRQ_CNT + TIMED_WAKE_CNT))
+  {
+    log_error("Error: The scheduler slept %u times for %u interrupts.\n",
+              sched_sim_sleep_cnt(), irq_index);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Event Triggered Task Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Event Triggered Task Test: FAIL\n");
+    return 1;
+  }
+}
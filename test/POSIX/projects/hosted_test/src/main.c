@@ -0,0 +1,301 @@
+/**
+ *  main.c
+ *
+ *  POSIX Hosted Port Test
+ *
+ * The program tests the hosted Linux port, which sleeps on an epoll
+ * instance, in real time.  The scheduler is initialized by the main thread
+ * and runs in a second thread with a slow repeating task, so it sleeps for
+ * long periods.  The main thread starts a task from outside of the scheduler
+ * a number of times, then writes a number of messages to a pipe whose read
+ * end starts a task, and finally stops the scheduler.  The test verifies
+ * that:
+ *
+ *  - A task started by another thread, including the thread which
+ *    initialized the scheduler, wakes the sleeping scheduler immediately,
+ *    rather than at its next deadline.
+ *  - A ready file descriptor starts its task, which reads every message, and
+ *    the task's handler gets the reported events.
+ *  - The scheduler can be stopped by another thread.
+ *  - The repeating task is never called before its deadline.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include "scheduler.h"
+#include "sched_port_posix.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The interval of the slow task, longer than the longest latency. (mS)
+#define SLOW_MS (250)
+
+// The time after which the test is stopped if the main thread doesn't stop it. (mS)
+#define TIMEOUT_MS (20000)
+
+// The number of times the main thread starts the remote task.
+#define REMOTE_CNT (50)
+
+// The number of messages the main thread writes to the pipe.
+#define MSG_CNT (50)
+
+// The time the main thread waits before each start or message. (uS)
+#define GAP_US (2000)
+
+// The longest time from a start or message to the handler call, shorter than SLOW_MS. (mS)
+#define LATENCY_MS_MAX (100)
+
+// The tasks.
+SCHED_TASK_DEF(slow_task);
+SCHED_TASK_DEF(remote_task);
+SCHED_TASK_DEF(pipe_task);
+SCHED_TASK_DEF(timeout_task);
+
+// The pipe, read by the pipe task.
+static int pipe_fds[2];
+
+// The time of the last start or message. (nS)
+static atomic_uint_fast64_t sent_ns;
+
+// The number of remote task calls and messages read.
+static atomic_uint remote_calls;
+static atomic_uint msg_reads;
+
+// The longest time from a start or message to the handler call. (nS)
+static uint64_t latency_ns_max = 0;
+
+// The time the slow task was started and the number of its calls.
+static sched_time_t slow_start_ms = 0;
+static uint32_t slow_calls = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for getting the monotonic clock time in nS.
+static uint64_t time_ns(void)
+{
+  struct timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return ((uint64_t)time.tv_sec * 1000000000) + (uint64_t)time.tv_nsec;
+}
+
+// Function for recording the time from the last start or message to a handler call.
+static void latency_record(void)
+{
+  uint64_t latency_ns = time_ns() - atomic_load(&sent_ns);
+  latency_ns_max = (latency_ns > latency_ns_max) ? latency_ns : latency_ns_max;
+}
+
+// Slow Task Handler
+static void slow_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  slow_calls++;
+  if ((int32_t)(sched_port_ticks() - (slow_start_ms + (slow_calls * SLOW_MS))) < 0)
+  {
+    log_error("Error: The slow task was called early.\n");
+    test_pass_set(false);
+  }
+}
+
+// Remote Task Handler, the task is started by the main thread.
+static void remote_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  latency_record();
+  atomic_fetch_add(&remote_calls, 1);
+}
+
+// Pipe Task Handler, the task is started when the pipe is readable.
+static void pipe_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  latency_record();
+
+  if ((sched_port_fd_events(pipe_fds[0]) & EPOLLIN) == 0)
+  {
+    log_error("Error: The pipe task was started without a read event.\n");
+    test_pass_set(false);
+  }
+
+  // Read every waiting message, the pipe is non-blocking.
+  uint8_t msgs[MSG_CNT];
+  ssize_t read_cnt;
+  while ((read_cnt = read(pipe_fds[0], msgs, sizeof(msgs))) > 0)
+  {
+    atomic_fetch_add(&msg_reads, (unsigned int)read_cnt);
+  }
+}
+
+// Timeout Task Handler
+static void timeout_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  log_error("Error: The test timed out.\n");
+  test_pass_set(false);
+  sched_stop();
+}
+
+// Function for waiting until a counter reaches a count, false on timeout.
+static bool count_wait(atomic_uint *p_count, unsigned int count)
+{
+  for (uint32_t wait_ms = 0; wait_ms < LATENCY_MS_MAX * 10; wait_ms++)
+  {
+    if (atomic_load(p_count) >= count)
+    {
+      return true;
+    }
+    usleep(1000);
+  }
+  return false;
+}
+
+// The scheduler's thread.
+static void *sched_thread(void *p_arg)
+{
+  // Start the Scheduler (Returns once the main thread stops it)
+  sched_start();
+  return NULL;
+}
+
+// Function for starting the remote task, writing the messages and stopping the scheduler.
+static void remote_run(void)
+{
+  bool success = true;
+
+  for (unsigned int index = 0; success && (index < REMOTE_CNT); index++)
+  {
+    usleep(GAP_US);
+    atomic_store(&sent_ns, time_ns());
+    success = sched_task_start(&remote_task) && count_wait(&remote_calls, index + 1);
+  }
+
+  for (unsigned int index = 0; success && (index < MSG_CNT); index++)
+  {
+    usleep(GAP_US);
+    uint8_t msg = (uint8_t)index;
+    atomic_store(&sent_ns, time_ns());
+    success = (write(pipe_fds[1], &msg, sizeof(msg)) == sizeof(msg)) &&
+              count_wait(&msg_reads, index + 1);
+  }
+
+  if (!success)
+  {
+    log_error("Error: The main thread's tasks weren't called.\n");
+    test_pass_set(false);
+  }
+
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Hosted Port Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = (pipe(pipe_fds) == 0) && (fcntl(pipe_fds[0], F_SETFL, O_NONBLOCK) == 0);
+
+  success = success && sched_task_config(&slow_task, slow_task_handler, SLOW_MS, true);
+  slow_start_ms = sched_port_ticks();
+  success = success && sched_task_start(&slow_task);
+
+  success = success && sched_task_config(&remote_task, remote_task_handler, 0, false);
+
+  success = success && sched_task_config(&pipe_task, pipe_task_handler, 0, false);
+  success = success && sched_port_fd_add(pipe_fds[0], EPOLLIN, &pipe_task);
+
+  // A file descriptor can only be added once.
+  if (success && sched_port_fd_add(pipe_fds[0], EPOLLIN, &pipe_task))
+  {
+    log_error("Error: The pipe was added twice.\n");
+    test_pass_set(false);
+  }
+
+  success = success && sched_task_config(&timeout_task, timeout_task_handler, TIMEOUT_MS, false);
+  success = success && sched_task_start(&timeout_task);
+
+  pthread_t thread;
+  success = success && (pthread_create(&thread, NULL, sched_thread, NULL) == 0);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    // The main thread, which initialized the scheduler, acts from outside of it.
+    remote_run();
+    pthread_join(thread, NULL);
+  }
+
+  if (!sched_port_fd_remove(pipe_fds[0]) || sched_port_fd_remove(pipe_fds[0]))
+  {
+    log_error("Error: The pipe could not be removed.\n");
+    test_pass_set(false);
+  }
+
+  log_info("Remote Calls: %u, Messages: %u, Max Latency: %u uS\n", atomic_load(&remote_calls),
+           atomic_load(&msg_reads), (uint32_t)(latency_ns_max / 1000));
+
+  if ((atomic_load(&remote_calls) != REMOTE_CNT) || (atomic_load(&msg_reads) != MSG_CNT) ||
+      (slow_calls == 0))
+  {
+    log_error("Error: %u remote calls, %u messages and %u slow calls.\n",
+              atomic_load(&remote_calls), atomic_load(&msg_reads), slow_calls);
+    test_pass_set(false);
+  }
+
+  if (latency_ns_max > (uint64_t)LATENCY_MS_MAX * 1000000)
+  {
+    log_error("Error: A handler was called %u uS late.\n", (uint32_t)(latency_ns_max / 1000));
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Hosted Port Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Hosted Port Test: FAIL\n");
+    return 1;
+  }
+}
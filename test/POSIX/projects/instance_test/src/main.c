@@ -0,0 +1,335 @@
+/**
+ *  main.c
+ *
+ *  POSIX Scheduler Instance Test
+ *
+ * The program tests two scheduler instances run by two threads.
+ *
+ * The default instance is kept busy by a pinned task with a long running
+ * handler alongside a set of short unpinned work tasks.  The second instance
+ * only runs a single pinned task of its own so it is idle most of the time
+ * and steals the expired work tasks from the busy default instance.  The test
+ * verifies that:
+ *
+ *  - Tasks can only be moved to an initialized instance while they are
+ *    outside of their handlers.
+ *  - Every handler is called by the instance whose que stores its task and
+ *    no task's handler is called by both instances at the same time.
+ *  - Pinned tasks are never stolen.
+ *  - The idle instance steals work tasks from the busy instance.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+#if (SCHED_INSTANCE_CNT != 2)
+#error "The instance test must be built with a SCHED_INSTANCE_CNT of 2"
+#endif
+
+// The second scheduler instance run by the test thread.
+#define INSTANCE_WORKER (1)
+
+// The number of unpinned work tasks.
+#define WORK_TASK_COUNT (8)
+
+// The work task interval (mS)
+#define WORK_INTERVAL_MS (4)
+
+// The work task handler execution time (uS)
+#define WORK_HANDLER_US (100)
+
+// The busy task interval (mS)
+#define BUSY_INTERVAL_MS (20)
+
+// The busy task handler execution time (mS)
+#define BUSY_HANDLER_MS (10)
+
+// The worker instance's pinned task interval (mS)
+#define PINNED_INTERVAL_MS (3)
+
+// The test duration (mS)
+#define TEST_DURATION_MS (1000)
+
+/*
+ * Data structure for tracking each of the test tasks.
+ */
+typedef struct
+{
+  volatile bool executing;                    // Is the task's handler executing?
+  uint32_t handler_cnt[SCHED_INSTANCE_CNT];   // Handler calls by each instance.
+} test_task_data_t;
+
+// The unpinned work tasks, initially in the default instance.
+static SCHED_TASK_SECTION sched_task_t work_tasks[WORK_TASK_COUNT];
+static test_task_data_t work_data[WORK_TASK_COUNT];
+
+// The pinned busy task in the default instance.
+SCHED_TASK_DEF(busy_task);
+static test_task_data_t busy_data;
+
+// The pinned task in the worker instance.
+SCHED_TASK_DEF(pinned_task);
+static test_task_data_t pinned_data;
+
+// The test completion task.
+SCHED_TASK_DEF(stop_task);
+
+// The instance run by the current thread.
+static __thread sched_instance_t thread_instance = SCHED_INSTANCE_DEFAULT;
+
+// Test Result
+static volatile bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for busy waiting to simulate a handler's execution time.
+static void busy_wait_us(uint32_t wait_us)
+{
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  do
+  {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+  } while ((((now.tv_sec - start.tv_sec) * 1000000) + ((now.tv_nsec - start.tv_nsec) / 1000)) <
+           wait_us);
+}
+
+/* Function for checking a handler call at handler entry.  The handler must be
+ * called by the instance storing its task and must not already be executing.
+ */
+static void test_handler_enter(sched_task_t *p_task, test_task_data_t *p_data)
+{
+  if (__atomic_exchange_n(&p_data->executing, true, __ATOMIC_SEQ_CST))
+  {
+    log_error("Error: A task handler was called by both instances.\n");
+    test_pass_set(false);
+  }
+
+  if (sched_task_instance(p_task) != thread_instance)
+  {
+    log_error("Error: Instance %u called a task of instance %u.\n", thread_instance,
+              sched_task_instance(p_task));
+    test_pass_set(false);
+  }
+
+  p_data->handler_cnt[thread_instance]++;
+}
+
+// Function for checking a handler call at handler exit.
+static void test_handler_exit(test_task_data_t *p_data)
+{
+  __atomic_store_n(&p_data->executing, false, __ATOMIC_SEQ_CST);
+}
+
+// Work Task Handler
+static void work_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = (uint32_t)(p_task - work_tasks);
+  assert(index < WORK_TASK_COUNT);
+
+  test_handler_enter(p_task, &work_data[index]);
+  busy_wait_us(WORK_HANDLER_US);
+  test_handler_exit(&work_data[index]);
+}
+
+// Busy Task Handler
+static void busy_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  test_handler_enter(p_task, &busy_data);
+
+  // A task can't be moved while its handler is executing.
+  if (sched_task_move(p_task, INSTANCE_WORKER))
+  {
+    log_error("Error: An executing task was moved.\n");
+    test_pass_set(false);
+  }
+
+  busy_wait_us(BUSY_HANDLER_MS * 1000);
+  test_handler_exit(&busy_data);
+}
+
+// Pinned Worker Instance Task Handler
+static void pinned_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  test_handler_enter(p_task, &pinned_data);
+  test_handler_exit(&pinned_data);
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // Stop both instances, the test results are checked once both have stopped.
+  sched_instance_stop(INSTANCE_WORKER);
+  sched_stop();
+}
+
+// Worker Instance Thread
+static void *worker_thread(void *p_arg)
+{
+  thread_instance = INSTANCE_WORKER;
+
+  // Start the Worker Instance (Returns after Tests)
+  sched_instance_start(INSTANCE_WORKER);
+  return NULL;
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Instance Test Started ***\n\n");
+
+  // Initialize the Default Instance
+  sched_init();
+
+  // An unconfigured task can't be moved or pinned.
+  if (sched_task_move(&pinned_task, INSTANCE_WORKER) || sched_task_affinity(&pinned_task, true) ||
+      sched_task_move(NULL, INSTANCE_WORKER) || sched_task_affinity(NULL, true))
+  {
+    log_error("Error: An unconfigured or NULL task was moved or pinned.\n");
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_config(&pinned_task, pinned_task_handler, PINNED_INTERVAL_MS, true);
+  assert(success);
+
+  // A task can't be moved to an invalid or uninitialized instance.
+  if (sched_task_move(&pinned_task, SCHED_INSTANCE_CNT) ||
+      sched_task_move(&pinned_task, INSTANCE_WORKER))
+  {
+    log_error("Error: A task was moved to an invalid or uninitialized instance.\n");
+    test_pass_set(false);
+  }
+
+  // Initialize the Worker Instance
+  sched_instance_init(INSTANCE_WORKER);
+
+  // Move the pinned task to the worker instance, back and then over again.
+  success = sched_task_move(&pinned_task, INSTANCE_WORKER);
+  success = success && sched_task_move(&pinned_task, SCHED_INSTANCE_DEFAULT);
+  success = success && (sched_task_instance(&pinned_task) == SCHED_INSTANCE_DEFAULT);
+  success = success && sched_task_move(&pinned_task, INSTANCE_WORKER);
+  success = success && (sched_task_instance(&pinned_task) == INSTANCE_WORKER);
+  success = success && sched_task_affinity(&pinned_task, true);
+  success = success && sched_task_start(&pinned_task);
+  if (!success)
+  {
+    log_error("Error: The pinned task could not be moved to the worker instance.\n");
+    test_pass_set(false);
+  }
+
+  // Configure and start the unpinned work tasks in the default instance.
+  for (uint32_t index = 0; index < WORK_TASK_COUNT; index++)
+  {
+    success = sched_task_config(&work_tasks[index], work_task_handler, WORK_INTERVAL_MS, true);
+    success = success && sched_task_start(&work_tasks[index]);
+    if (!success)
+    {
+      log_error("Error: Work task %u could not be started.\n", index);
+      test_pass_set(false);
+    }
+  }
+
+  // Configure and start the pinned busy task in the default instance.
+  success = sched_task_config(&busy_task, busy_task_handler, BUSY_INTERVAL_MS, true);
+  success = success && sched_task_affinity(&busy_task, true);
+  success = success && sched_task_start(&busy_task);
+  assert(success);
+
+  // Configure and start the test completion task in the default instance.
+  success = sched_task_config(&stop_task, stop_task_handler, TEST_DURATION_MS, false);
+  success = success && sched_task_affinity(&stop_task, true);
+  success = success && sched_task_start(&stop_task);
+  assert(success);
+
+  // Start the worker instance's thread.
+  pthread_t thread;
+  int ret = pthread_create(&thread, NULL, worker_thread, NULL);
+  assert(ret == 0);
+
+  // Start the Default Instance (Returns after Tests)
+  sched_start();
+
+  ret = pthread_join(thread, NULL);
+  assert(ret == 0);
+
+  // Count the work task handler calls made by each instance.
+  uint32_t work_cnt[SCHED_INSTANCE_CNT] = {0};
+  for (uint32_t index = 0; index < WORK_TASK_COUNT; index++)
+  {
+    for (uint32_t instance = 0; instance < SCHED_INSTANCE_CNT; instance++)
+    {
+      work_cnt[instance] += work_data[index].handler_cnt[instance];
+    }
+  }
+
+  log_info("Work Calls: %u Default, %u Worker, Busy Calls: %u, Pinned Calls: %u\n",
+           work_cnt[SCHED_INSTANCE_DEFAULT], work_cnt[INSTANCE_WORKER],
+           busy_data.handler_cnt[SCHED_INSTANCE_DEFAULT],
+           pinned_data.handler_cnt[INSTANCE_WORKER]);
+
+  if ((busy_data.handler_cnt[INSTANCE_WORKER] != 0) ||
+      (pinned_data.handler_cnt[SCHED_INSTANCE_DEFAULT] != 0))
+  {
+    log_error("Error: A pinned task was stolen.\n");
+    test_pass_set(false);
+  }
+
+  if ((busy_data.handler_cnt[SCHED_INSTANCE_DEFAULT] == 0) ||
+      (pinned_data.handler_cnt[INSTANCE_WORKER] == 0))
+  {
+    log_error("Error: A pinned task was not called.\n");
+    test_pass_set(false);
+  }
+
+  if (work_cnt[INSTANCE_WORKER] == 0)
+  {
+    log_error("Error: No work tasks were stolen by the idle instance.\n");
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Instance Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Instance Test: FAIL\n");
+    return 1;
+  }
+}
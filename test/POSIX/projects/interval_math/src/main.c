@@ -53,27 +53,31 @@ const bool DEBUG = false;
  */
 
 static bool task_check(sched_task_t *p_task,
-                       uint32_t now_ms,
-                       uint32_t remaining_ms,
-                       uint32_t elapsed_ms,
+                       sched_time_t now_ms,
+                       sched_time_t remaining_ms,
+                       sched_time_t elapsed_ms,
                        bool expired)
 {
   bool test_result = true;
-  uint32_t remaining_calc = task_time_remaining_ms(p_task, now_ms);
-  uint32_t elapsed_calc = task_time_elapsed_ms(p_task, now_ms);
+  sched_time_t remaining_calc = task_time_remaining_ms(p_task, now_ms);
+  sched_time_t elapsed_calc = task_time_elapsed_ms(p_task, now_ms);
   bool expired_calc = task_time_expired(p_task, now_ms);
 
-  log_info("Start: %u mS, Interval: %u mS\n", p_task->start_ms, p_task->interval_ms);
-  log_info("Now: %u mS, Elapsed: %u mS, Remaining: %u mS\n", now_ms, elapsed_ms, remaining_ms);
+  log_info("Start: %llu mS, Interval: %llu mS\n", (unsigned long long)p_task->start_ms,
+           (unsigned long long)p_task->interval_ms);
+  log_info("Now: %llu mS, Elapsed: %llu mS, Remaining: %llu mS\n", (unsigned long long)now_ms,
+           (unsigned long long)elapsed_ms, (unsigned long long)remaining_ms);
 
   if (remaining_calc != remaining_ms) {
     test_result = false;
-    log_error("Remaining: %u mS does not match check: %u mS.\n", remaining_calc, remaining_ms);
+    log_error("Remaining: %llu mS does not match check: %llu mS.\n",
+              (unsigned long long)remaining_calc, (unsigned long long)remaining_ms);
   }
 
   if (elapsed_calc != elapsed_ms) {
     test_result = false;
-    log_error("Elapsed: %u mS does not match check: %u mS.\n", elapsed_calc, elapsed_ms);
+    log_error("Elapsed: %llu mS does not match check: %llu mS.\n",
+              (unsigned long long)elapsed_calc, (unsigned long long)elapsed_ms);
   }
 
   if (expired_calc != expired) {
@@ -116,10 +120,10 @@ static bool unexpired_roll_test() {
   log_info("\n* Unexpired Task with Timer Roll.\n");
   test_task.interval_ms = 1000;
   // Start time = 100 mS before timer roll
-  test_task.start_ms = UINT32_MAX - 100;
+  test_task.start_ms = SCHED_TIME_MAX - 100;
   // Now Time = 100 mS after roll.
   // Elapsed should be 200 mS, remaining should be 800 mS
-  return task_check(&test_task, UINT32_MAX + 100, 800, 200, false);
+  return task_check(&test_task, (sched_time_t)(SCHED_TIME_MAX + 100), 800, 200, false);
 }
 
 // Expired Task with Timer Roll
@@ -128,10 +132,10 @@ static bool expired_roll_test() {
   log_info("\n* Expired Task with Timer Roll.\n");
   test_task.interval_ms = 1000;
   // Start time = 20000 mS before timer roll
-  test_task.start_ms = UINT32_MAX - 2000;
+  test_task.start_ms = SCHED_TIME_MAX - 2000;
   // Now Time = 100 mS after roll.
   // The elapsed times should be 2100 mS, remaining time should be 0 mS
-  return task_check(&test_task, UINT32_MAX + 100, 0, 2100, true);
+  return task_check(&test_task, (sched_time_t)(SCHED_TIME_MAX + 100), 0, 2100, true);
 }
 
 int main() {
@@ -0,0 +1,325 @@
+/**
+ *  main.c
+ *
+ *  POSIX Message Task Test
+ *
+ * The program tests message tasks, built with SCHED_TASK_MSG_EN enabled, on
+ * the simulated time port.  Simulated interrupts post bursts of frames of
+ * varying sizes to a message task which collects them for a short interval
+ * before its handler reads them.  The test verifies that:
+ *
+ *  - Each burst results in a single handler call, after the task's interval,
+ *    which reads every frame of the burst in order.
+ *  - Frames posted to a full FIFO are rejected and oversized frames are
+ *    truncated to the message size.
+ *  - A frame posted from the task's own handler calls the handler again.
+ *  - Configuring the task discards its pending messages and frames can't be
+ *    posted to a task without a message FIFO.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The maximum frame size. (bytes)
+#define FRAME_SIZE (16)
+
+// The depth of the frame FIFO. (frames)
+#define FRAME_CNT (64)
+
+// The time the task collects frames before its handler is called. (ticks)
+#define COLLECT_TICKS (2)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (1000)
+
+// A simulated interrupt which posts a burst of frames.
+typedef struct
+{
+  sched_time_t time_ticks;
+  uint32_t frame_cnt;
+} irq_t;
+
+// The interrupt table, the second burst overflows the FIFO.
+static const irq_t irqs[] = {
+    {100, 50},
+    {200, FRAME_CNT + 6},
+    {300, 1},
+};
+
+#define IRQ_CNT (sizeof(irqs) / sizeof(irqs[0]))
+
+// The expected handler calls, the handler posts a frame to itself at 302.
+static const struct
+{
+  sched_time_t time_ticks;
+  uint32_t frame_cnt;
+} calls_expected[] = {
+    {100 + COLLECT_TICKS, 50},
+    {200 + COLLECT_TICKS, FRAME_CNT},
+    {300 + COLLECT_TICKS, 1},
+    {300 + (2 * COLLECT_TICKS), 1},
+};
+
+#define CALL_CNT (sizeof(calls_expected) / sizeof(calls_expected[0]))
+
+// The time of the handler call which posts a frame to its own task. (ticks)
+#define SELF_POST_TICKS (300 + COLLECT_TICKS)
+
+// The number of frames rejected since the FIFO was full.
+#define REJECT_EXPECTED (6)
+
+// The message task.
+SCHED_TASK_MSG_DEF(frame_task, FRAME_SIZE, FRAME_CNT);
+
+// A task without a message FIFO.
+SCHED_TASK_DEF(plain_task);
+
+// The task which stops the test.
+SCHED_TASK_DEF(stop_task);
+
+// The index of the next interrupt.
+static uint32_t irq_index = 0;
+
+// The sequence number of the next frame to post and to read.
+static uint8_t post_seq = 0;
+static uint8_t read_seq = 0;
+
+// The number of rejected frames.
+static uint32_t reject_cnt = 0;
+
+// The number of handler calls.
+static uint32_t call_cnt = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for getting the size of a frame from its sequence number.
+static uint8_t frame_size(uint8_t seq)
+{
+  return (uint8_t)(1 + (seq % FRAME_SIZE));
+}
+
+// Function for posting the next frame, returns true if it was accepted.
+static bool frame_post(void)
+{
+  uint8_t frame[FRAME_SIZE];
+  uint8_t size = frame_size(post_seq);
+  for (uint8_t index = 0; index < size; index++)
+  {
+    frame[index] = (uint8_t)(post_seq ^ index);
+  }
+
+  uint8_t posted = sched_task_msg_post(&frame_task, frame, size);
+  if (posted == 0)
+  {
+    return false;
+  }
+
+  assert(posted == size);
+  post_seq++;
+  return true;
+}
+
+// Function for checking a frame which was read.
+static bool frame_check(const uint8_t *p_frame, uint8_t size)
+{
+  if (size != frame_size(read_seq))
+  {
+    return false;
+  }
+  for (uint8_t index = 0; index < size; index++)
+  {
+    if (p_frame[index] != (uint8_t)(read_seq ^ index))
+    {
+      return false;
+    }
+  }
+  read_seq++;
+  return true;
+}
+
+// Function for scheduling the next simulated interrupt.
+static void irq_next(void);
+
+// Simulated Interrupt Handler, posts a burst of frames.
+static void irq_handler(void)
+{
+  const irq_t *p_irq = &irqs[irq_index++];
+
+  for (uint32_t frame = 0; frame < p_irq->frame_cnt; frame++)
+  {
+    if (!frame_post())
+    {
+      reject_cnt++;
+    }
+  }
+
+  irq_next();
+}
+
+static void irq_next(void)
+{
+  if (irq_index < IRQ_CNT)
+  {
+    sched_sim_irq_set(sched_sim_ticks_ns(irqs[irq_index].time_ticks), irq_handler);
+  }
+}
+
+// Frame Task Handler, reads every pending frame.
+static void frame_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint8_t frame[FRAME_SIZE];
+  uint8_t size;
+  uint32_t frame_cnt = 0;
+
+  while ((size = sched_task_msg_read(p_task, frame, sizeof(frame))) > 0)
+  {
+    if (!frame_check(frame, size))
+    {
+      log_error("Error: Frame %u is corrupt or out of order.\n", read_seq);
+      test_pass_set(false);
+    }
+    frame_cnt++;
+  }
+
+  log_info("Frame Task Call at %u Ticks: %u Frames\n", (uint32_t)sched_port_ticks(), frame_cnt);
+
+  if ((call_cnt >= CALL_CNT) ||
+      (calls_expected[call_cnt].time_ticks != sched_port_ticks()) ||
+      (calls_expected[call_cnt].frame_cnt != frame_cnt))
+  {
+    log_error("Error: The frame task read %u frames at %u ticks.\n", frame_cnt,
+              (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+  call_cnt++;
+
+  // A frame posted from the handler calls the handler again.
+  if (sched_port_ticks() == SELF_POST_TICKS)
+  {
+    if (!frame_post())
+    {
+      log_error("Error: The handler could not post a frame.\n");
+      test_pass_set(false);
+    }
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Message Task Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = sched_task_config(&frame_task, frame_task_handler, COLLECT_TICKS, false);
+  success = success && sched_task_config(&plain_task, frame_task_handler, 1, false);
+
+  // An oversized frame is truncated to the message size.
+  uint8_t big_frame[FRAME_SIZE + 4] = {0};
+  uint8_t read_frame[FRAME_SIZE + 4];
+  if ((sched_task_msg_post(&frame_task, big_frame, sizeof(big_frame)) != FRAME_SIZE) ||
+      (sched_task_msg_pending(&frame_task) != 1) ||
+      (sched_task_msg_read(&frame_task, read_frame, sizeof(read_frame)) != FRAME_SIZE))
+  {
+    log_error("Error: The oversized frame wasn't truncated.\n");
+    test_pass_set(false);
+  }
+
+  // Configuring the task stops it and discards the pending messages.
+  frame_post();
+  post_seq = 0;
+  success = success && sched_task_stop(&frame_task);
+  success = success && sched_task_config(&frame_task, frame_task_handler, COLLECT_TICKS, false);
+  if (sched_task_msg_pending(&frame_task) != 0)
+  {
+    log_error("Error: Configuring the task didn't discard its messages.\n");
+    test_pass_set(false);
+  }
+
+  // A task without a message FIFO doesn't accept messages.
+  if (sched_task_msg_post(&plain_task, big_frame, 1) != 0)
+  {
+    log_error("Error: A message was posted to a task without a FIFO.\n");
+    test_pass_set(false);
+  }
+
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    irq_next();
+
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Handler Calls: %u, Frames: %u, Rejected: %u\n", call_cnt, read_seq, reject_cnt);
+
+  if ((call_cnt != CALL_CNT) || (read_seq != post_seq) || (reject_cnt != REJECT_EXPECTED))
+  {
+    log_error("Error: %u handler calls read %u of %u frames with %u rejected.\n", call_cnt,
+              read_seq, post_seq, reject_cnt);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Message Task Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Message Task Test: FAIL\n");
+    return 1;
+  }
+}
@@ -103,9 +103,10 @@ static void pool_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_s
     sched_task_stop(p_task);
 
     /* Stop the scheduler after the starter task has been stopped and after 
-     * all of the pool tasks have been stopped.
+     * all of the pool tasks have been stopped.  The stop of the current task
+     * completes after its handler returns so it is still allocated here.
      */
-    if(sched_pool_allocated(&task_pool) == 0) {
+    if(sched_pool_allocated(&task_pool) == 1) {
         log_info("Test complete, stopping the scheduler.\n");
         sched_stop();
       }
@@ -0,0 +1,343 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Post Que Test
+ *
+ * The program tests starting and stopping tasks from an interrupt context
+ * with the task post que.
+ *
+ * A periodic SIGALRM signal stands in for a hardware interrupt.  The signal
+ * handler posts interval updates for a set of non-repeating tasks and later
+ * posts a stop for a repeating task, without taking the scheduler lock.  The
+ * test verifies that:
+ *
+ *  - Every accepted post is applied and each posted task's handler is called
+ *    exactly once per post.
+ *  - No posted task handler is called before its interval has expired.
+ *  - The posted stop stops the repeating task.
+ *  - Posts are rejected rather than lost when the post que is full.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <sys/time.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+#if (SCHED_TASK_POST_SIZE == 0)
+#error "The post test must be built with the task post que enabled"
+#endif
+
+// The number of posted test tasks.
+#define TASK_COUNT (8)
+
+// The signal period. (uS)
+#define SIGNAL_PERIOD_US (500)
+
+// The maximum random posted task interval. (mS)
+#define INTERVAL_MAX_MS (5)
+
+// The number of posts made before the signal handler stops posting.
+#define POST_CNT (2000)
+
+// The signal count at which the repeating task's stop is posted.
+#define STOP_SIGNAL_CNT (200)
+
+// The maximum test run time. (mS)
+#define TEST_TIMEOUT_MS (10000)
+
+/*
+ * Data structure for tracking each of the posted test tasks.
+ */
+typedef struct
+{
+  volatile sig_atomic_t pending;  // Has a post been made which hasn't executed?
+  volatile uint32_t post_ms;      // The time the last post was made.
+  volatile uint32_t interval_ms;  // The last posted interval.
+  uint32_t handler_cnt;           // Count of the number of handler calls.
+} test_task_data_t;
+
+// The posted test tasks.
+static SCHED_TASK_SECTION sched_task_t test_tasks[TASK_COUNT];
+
+// The test data for each task.
+static test_task_data_t test_data[TASK_COUNT];
+
+// The repeating task which is stopped by a post.
+SCHED_TASK_DEF(repeat_task);
+
+// The test completion check task.
+SCHED_TASK_DEF(check_task);
+
+// Count of the signal handler calls.
+static volatile uint32_t signal_cnt = 0;
+
+// Count of the accepted and rejected posts.
+static volatile uint32_t post_cnt = 0;
+static volatile uint32_t post_full_cnt = 0;
+
+// Has the repeating task's stop been posted?
+static volatile sig_atomic_t stop_posted = false;
+
+// Count of the repeating task handler calls after its stop was applied.
+static uint32_t repeat_late_cnt = 0;
+
+// The time the test started. (mS)
+static uint32_t test_start_ms = 0;
+
+// Random number state for the signal handler, rand() isn't signal safe.
+static uint32_t signal_rand_state = 1;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Signal safe pseudo random number generator.
+static uint32_t signal_rand(void)
+{
+  signal_rand_state = (signal_rand_state * 1103515245) + 12345;
+  return signal_rand_state >> 16;
+}
+
+/* Signal handler which stands in for an interrupt.  Tasks are only started
+ * and stopped with posts since the scheduler lock may already be held by the
+ * interrupted main context.
+ */
+static void signal_handler(int signal)
+{
+  signal_cnt++;
+
+  if (signal_cnt == STOP_SIGNAL_CNT)
+  {
+    if (sched_task_post_stop(&repeat_task))
+    {
+      stop_posted = true;
+    }
+  }
+
+  if (post_cnt >= POST_CNT)
+  {
+    return;
+  }
+
+  // Post a few tasks at a time so the post que fills up occasionally.
+  for (uint32_t cnt = 0; cnt < 3; cnt++)
+  {
+    uint32_t index = signal_rand() % TASK_COUNT;
+    test_task_data_t *p_data = &test_data[index];
+    if (p_data->pending)
+    {
+      continue;
+    }
+
+    uint32_t interval_ms = signal_rand() % (INTERVAL_MAX_MS + 1);
+    p_data->interval_ms = interval_ms;
+    p_data->post_ms = sched_port_ms();
+
+    if (sched_task_post_update(&test_tasks[index], interval_ms))
+    {
+      p_data->pending = true;
+      post_cnt++;
+    }
+    else
+    {
+      post_full_cnt++;
+    }
+  }
+}
+
+// Posted Test Task Handler
+static void test_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t now_ms = sched_port_ms();
+  uint32_t index = (uint32_t)(p_task - test_tasks);
+  assert(index < TASK_COUNT);
+  test_task_data_t *p_test_data = &test_data[index];
+
+  if (!p_test_data->pending)
+  {
+    log_error("Error: Task %u was called without a post.\n", index);
+    test_pass_set(false);
+  }
+
+  uint32_t elapsed_ms = now_ms - p_test_data->post_ms;
+  if (elapsed_ms < p_test_data->interval_ms)
+  {
+    log_error("Error: Task %u called %u mS early.\n", index,
+              p_test_data->interval_ms - elapsed_ms);
+    test_pass_set(false);
+  }
+
+  p_test_data->handler_cnt++;
+  p_test_data->pending = false;
+}
+
+// Repeating Task Handler
+static void repeat_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // The posted stop is applied before the task que is executed again.
+  if (stop_posted)
+  {
+    repeat_late_cnt++;
+  }
+}
+
+// Test Completion Check Task Handler
+static void check_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t handler_cnt = 0;
+  bool pending = false;
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    handler_cnt += test_data[index].handler_cnt;
+    pending = pending || test_data[index].pending;
+  }
+
+  bool timeout = (sched_port_ms() - test_start_ms) > TEST_TIMEOUT_MS;
+  if (((post_cnt >= POST_CNT) && !pending && stop_posted) || timeout)
+  {
+    // Stop the signal before checking the results.
+    struct itimerval timer = {0};
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    log_info("Signals: %u, Posts: %u, Full: %u, Handler Calls: %u\n", signal_cnt,
+             post_cnt, post_full_cnt, handler_cnt);
+
+    if (timeout)
+    {
+      log_error("Error: Test timed out after %u posts.\n", post_cnt);
+      test_pass_set(false);
+    }
+
+    if (handler_cnt != post_cnt)
+    {
+      log_error("Error: %u handler calls for %u posts.\n", handler_cnt, post_cnt);
+      test_pass_set(false);
+    }
+
+    // A call may already be executing when the stop is posted.
+    if ((sched_task_state(&repeat_task) != SCHED_TASK_STOPPED) || (repeat_late_cnt > 1))
+    {
+      log_error("Error: The posted stop didn't stop the repeating task.\n");
+      test_pass_set(false);
+    }
+
+    sched_task_stop(p_task);
+    sched_stop();
+  }
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Post Que Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Posts aren't accepted for NULL tasks.
+  if (sched_task_post_start(NULL) || sched_task_post_stop(NULL) ||
+      sched_task_post_update(NULL, 0))
+  {
+    log_error("Error: A NULL task post was accepted.\n");
+    test_pass_set(false);
+  }
+
+  // Configure the posted tasks, they are only started by posts.
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    bool success = sched_task_config(&test_tasks[index], test_task_handler, 0, false);
+    assert(success);
+  }
+
+  // Start the repeating task which will be stopped by a post.
+  bool success = sched_task_config(&repeat_task, repeat_task_handler, 1, true);
+  success = success && sched_task_start(&repeat_task);
+  assert(success);
+
+  // Start the completion check task.
+  success = sched_task_config(&check_task, check_task_handler, 10, true);
+  success = success && sched_task_start(&check_task);
+  assert(success);
+
+  /* Fill the post que, the posts are applied once the scheduler starts.
+   * Restarting the completion check task is harmless.
+   */
+  for (uint32_t cnt = 0; cnt < SCHED_TASK_POST_SIZE; cnt++)
+  {
+    if (!sched_task_post_start(&check_task))
+    {
+      log_error("Error: Post %u was rejected.\n", cnt);
+      test_pass_set(false);
+    }
+  }
+  if (sched_task_post_start(&check_task))
+  {
+    log_error("Error: A post was accepted by a full post que.\n");
+    test_pass_set(false);
+  }
+
+  // Start the periodic signal.
+  struct sigaction action = {0};
+  action.sa_handler = signal_handler;
+  action.sa_flags = SA_RESTART;
+  sigemptyset(&action.sa_mask);
+  int ret = sigaction(SIGALRM, &action, NULL);
+  assert(ret == 0);
+
+  struct itimerval timer = {
+      .it_interval = {.tv_sec = 0, .tv_usec = SIGNAL_PERIOD_US},
+      .it_value = {.tv_sec = 0, .tv_usec = SIGNAL_PERIOD_US},
+  };
+  test_start_ms = sched_port_ms();
+  ret = setitimer(ITIMER_REAL, &timer, NULL);
+  assert(ret == 0);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  if (test_pass)
+  {
+    log_info("Scheduler Post Que Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Post Que Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,296 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Power Mode Test
+ *
+ * The program tests task power modes, built with SCHED_TASK_POWER_EN
+ * enabled, on the simulated time port.  The program implements the run mode
+ * and sleep mode port functions, recording the modes the scheduler requests.
+ * A repeating task requires a fast run mode, a second repeating task runs in
+ * the low run mode and two single shot tasks restrict the depth of the sleep
+ * while they are started.  The test verifies that:
+ *
+ *  - Each handler is called in its task's run mode and the run mode is only
+ *    switched when it changes.
+ *  - The scheduler returns to the low run mode before sleeping and once it
+ *    stops.
+ *  - Each sleep is limited to the deepest sleep mode allowed by all of the
+ *    started tasks.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The simulated run modes.
+#define RUN_MODE_LOW (SCHED_RUN_MODE_LOW)
+#define RUN_MODE_FAST (1)
+
+// The simulated sleep modes.
+#define SLEEP_MODE_NONE (0)
+#define SLEEP_MODE_LIGHT (1)
+#define SLEEP_MODE_DEEP (2)
+
+// The interval of the low run mode task. (ticks)
+#define LOW_TICKS (10)
+
+// The interval of the fast run mode task. (ticks)
+#define FAST_TICKS (25)
+
+// The delay of the task which limits the sleep to the light mode. (ticks)
+#define LIGHT_TICKS (200)
+
+// The delay of the task which prevents sleeping, started by the light task. (ticks)
+#define NONE_TICKS (50)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (305)
+
+// The expected number of fast task calls.
+#define FAST_CALLS_EXPECTED (STOP_TICKS / FAST_TICKS)
+
+// The tasks.
+SCHED_TASK_DEF(low_task);
+SCHED_TASK_DEF(fast_task);
+SCHED_TASK_DEF(light_task);
+SCHED_TASK_DEF(none_task);
+SCHED_TASK_DEF(stop_task);
+
+// The current simulated run mode.
+static uint8_t run_mode = RUN_MODE_LOW;
+
+// The number of run mode switches.
+static uint32_t run_switch_cnt = 0;
+
+// The number of sleeps limited to each sleep mode.
+static uint32_t sleep_none_cnt = 0;
+static uint32_t sleep_light_cnt = 0;
+static uint32_t sleep_deep_cnt = 0;
+
+// The number of fast task calls.
+static uint32_t fast_calls = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Simulated run mode switch.
+void sched_port_run_mode(uint8_t mode)
+{
+  if (mode == run_mode)
+  {
+    log_error("Error: The run mode was switched to the current mode %u.\n", mode);
+    test_pass_set(false);
+  }
+
+  run_mode = mode;
+  run_switch_cnt++;
+}
+
+// Simulated sleep mode limit, checked against the started tasks.
+void sched_port_sleep_mode(uint8_t sleep_mode)
+{
+  sched_time_t now_ticks = sched_port_ticks();
+  log_info("Sleep Mode at %u Ticks: %u\n", (uint32_t)now_ticks, sleep_mode);
+
+  // The fast task is always started and allows the deep sleep mode.
+  uint8_t expected = SLEEP_MODE_DEEP;
+  if (now_ticks < LIGHT_TICKS)
+  {
+    expected = SLEEP_MODE_LIGHT;
+  }
+  else if (now_ticks < LIGHT_TICKS + NONE_TICKS)
+  {
+    expected = SLEEP_MODE_NONE;
+  }
+
+  if ((sleep_mode != expected) || (run_mode != RUN_MODE_LOW))
+  {
+    log_error("Error: Sleep mode %u in run mode %u at %u ticks.\n", sleep_mode, run_mode,
+              (uint32_t)now_ticks);
+    test_pass_set(false);
+  }
+
+  switch (sleep_mode)
+  {
+    case SLEEP_MODE_NONE:
+      sleep_none_cnt++;
+      break;
+    case SLEEP_MODE_LIGHT:
+      sleep_light_cnt++;
+      break;
+    case SLEEP_MODE_DEEP:
+      sleep_deep_cnt++;
+      break;
+    default:
+      break;
+  }
+}
+
+// Function for checking that a handler is called in the expected run mode.
+static void run_mode_check(uint8_t expected)
+{
+  if (run_mode != expected)
+  {
+    log_error("Error: A handler was called in run mode %u at %u ticks.\n", run_mode,
+              (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+}
+
+// Low Run Mode Task Handler
+static void low_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  run_mode_check(RUN_MODE_LOW);
+}
+
+// Fast Run Mode Task Handler
+static void fast_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  fast_calls++;
+  run_mode_check(RUN_MODE_FAST);
+}
+
+// Light Sleep Task Handler, starts the task which prevents sleeping.
+static void light_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  run_mode_check(RUN_MODE_LOW);
+
+  if (!sched_task_start(&none_task))
+  {
+    log_error("Error: The no sleep task could not be started.\n");
+    test_pass_set(false);
+  }
+}
+
+// No Sleep Task Handler
+static void none_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  run_mode_check(RUN_MODE_LOW);
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Task Power Mode Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // A task must be configured before its power modes can be set.
+  if (sched_task_power(&fast_task, RUN_MODE_FAST, SLEEP_MODE_DEEP))
+  {
+    log_error("Error: The power modes of an unconfigured task were set.\n");
+    test_pass_set(false);
+  }
+
+  // A started task stops limiting the sleep once its sleep mode is changed.
+  bool success = sched_task_config(&low_task, low_task_handler, LOW_TICKS, true);
+  success = success && sched_task_power(&low_task, RUN_MODE_LOW, SLEEP_MODE_NONE);
+  success = success && sched_task_start(&low_task);
+  success = success && sched_task_power(&low_task, RUN_MODE_LOW, SCHED_SLEEP_MODE_ANY);
+
+  success = success && sched_task_config(&fast_task, fast_task_handler, FAST_TICKS, true);
+  success = success && sched_task_power(&fast_task, RUN_MODE_FAST, SLEEP_MODE_DEEP);
+  success = success && sched_task_start(&fast_task);
+
+  success = success && sched_task_config(&light_task, light_task_handler, LIGHT_TICKS, false);
+  success = success && sched_task_power(&light_task, RUN_MODE_LOW, SLEEP_MODE_LIGHT);
+  success = success && sched_task_start(&light_task);
+
+  // The task only limits the sleep while it is started.
+  success = success && sched_task_config(&none_task, none_task_handler, NONE_TICKS, false);
+  success = success && sched_task_power(&none_task, RUN_MODE_LOW, SLEEP_MODE_NONE);
+  success = success && sched_task_start(&none_task);
+  success = success && sched_task_stop(&none_task);
+
+  // Sleep modes past the counted range can't be set.
+  if (sched_task_power(&none_task, RUN_MODE_LOW, SCHED_SLEEP_MODE_CNT))
+  {
+    log_error("Error: A sleep mode outside of the counted range was set.\n");
+    test_pass_set(false);
+  }
+
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Run Mode Switches: %u, Sleeps None: %u, Light: %u, Deep: %u\n", run_switch_cnt,
+           sleep_none_cnt, sleep_light_cnt, sleep_deep_cnt);
+
+  // Each fast task call switches to the fast run mode and back.
+  if ((fast_calls != FAST_CALLS_EXPECTED) || (run_switch_cnt != 2 * FAST_CALLS_EXPECTED) ||
+      (run_mode != RUN_MODE_LOW))
+  {
+    log_error("Error: %u fast task calls with %u run mode switches, ending in run mode %u.\n",
+              fast_calls, run_switch_cnt, run_mode);
+    test_pass_set(false);
+  }
+
+  if ((sleep_none_cnt == 0) || (sleep_light_cnt == 0) || (sleep_deep_cnt == 0))
+  {
+    log_error("Error: The sleeps weren't limited by each of the sleep modes.\n");
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Task Power Mode Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Task Power Mode Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,399 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Priority Test
+ *
+ * The program tests the dispatch order and dispatch latency of tasks with
+ * different priority levels.
+ *
+ * The first part of the test repeatedly expires a set of tasks with random
+ * priorities at the same time and verifies that:
+ *
+ *  - Tasks can only be given a valid priority once they are configured.
+ *  - Expired tasks are called in order of priority, highest first.
+ *  - Every expired task is called exactly once.
+ *
+ * The second part of the test runs a load of repeating tasks, one per
+ * priority level, with handler execution times which get shorter as the
+ * priority increases.  The worst case dispatch latency of each level is
+ * measured and the latency of the highest level is verified to be bounded by
+ * the longest handler execution time, allowing for a few calls delayed by the
+ * host preempting the test.
+ *
+ * The dispatch latency is measured from a task's expiration if a handler was
+ * executing at the time, otherwise from the start of the first handler call
+ * after the expiration.  The time the host takes to wake the sleeping
+ * scheduler is therefore excluded since it depends on the host's sleep
+ * accuracy rather than on the scheduler.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+#if (SCHED_TASK_PRIORITY_LEVELS != 4)
+#error "The priority test must be built with a SCHED_TASK_PRIORITY_LEVELS of 4"
+#endif
+
+// The number of order test tasks.
+#define ORDER_TASK_COUNT (16)
+
+// The number of times the order test tasks are expired together.
+#define ORDER_ROUNDS (100)
+
+// The order test setup task interval (mS)
+#define SETUP_INTERVAL_MS (2)
+
+// The latency test duration (mS)
+#define LATENCY_DURATION_MS (1000)
+
+/* The allowed dispatch latency of the highest priority level over the longest
+ * handler execution time. (uS)
+ */
+#define LATENCY_MARGIN_US (2000)
+
+/* The percentage of the highest priority level's calls which may exceed the
+ * latency bound since the host may preempt the test.
+ */
+#define LATENCY_EXCEED_PCT (1)
+
+/*
+ * Data structure for defining the load task of a priority level.
+ */
+typedef struct
+{
+  sched_time_t interval_ms;   // The task interval.
+  uint32_t handler_us;        // The handler execution time.
+} load_task_def_t;
+
+// The load task of each priority level, lowest first.
+static const load_task_def_t load_defs[SCHED_TASK_PRIORITY_LEVELS] = {
+    {.interval_ms = 10, .handler_us = 3000},
+    {.interval_ms = 4, .handler_us = 300},
+    {.interval_ms = 3, .handler_us = 200},
+    {.interval_ms = 2, .handler_us = 50},
+};
+
+/*
+ * Data structure for tracking each of the load tasks.
+ */
+typedef struct
+{
+  uint32_t armed_ms;          // The time the task was last armed.
+  uint64_t expire_us;         // The time the task expires.
+  uint64_t wait_start_us;     // The time the dispatch latency started, 0 if not yet.
+  uint64_t latency_max_us;    // The maximum dispatch latency.
+  uint32_t exceed_cnt;        // Count of the calls exceeding the latency bound.
+  uint32_t handler_cnt;       // Count of the number of handler calls.
+} load_task_data_t;
+
+// The order test tasks.
+static SCHED_TASK_SECTION sched_task_t order_tasks[ORDER_TASK_COUNT];
+
+// The order test setup task.
+SCHED_TASK_DEF(setup_task);
+
+// The latency test load tasks, one per priority level.
+static SCHED_TASK_SECTION sched_task_t load_tasks[SCHED_TASK_PRIORITY_LEVELS];
+static load_task_data_t load_data[SCHED_TASK_PRIORITY_LEVELS];
+
+// The test completion task.
+SCHED_TASK_DEF(stop_task);
+
+// The priority of each order test task in the current round.
+static uint8_t order_priority[ORDER_TASK_COUNT];
+
+// The priority of the last order test task called in the current round.
+static uint8_t order_last_priority = 0;
+
+// Count of the order test handler calls in the current round.
+static uint32_t order_call_cnt = 0;
+
+// Count of the completed order test rounds.
+static uint32_t order_round_cnt = 0;
+
+// The time the last load task handler call returned. (uS)
+static uint64_t load_exit_us = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for busy waiting to simulate a handler's execution time.
+static void busy_wait_us(uint32_t wait_us)
+{
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  do
+  {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+  } while ((((now.tv_sec - start.tv_sec) * 1000000) + ((now.tv_nsec - start.tv_nsec) / 1000)) <
+           wait_us);
+}
+
+// Function for getting the monotonic time in uS.
+static uint64_t time_us(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+// Function for arming a load task and recording the time it was armed.
+static void load_task_arm(uint32_t level)
+{
+  load_task_data_t *p_load_data = &load_data[level];
+  p_load_data->armed_ms = sched_port_ms();
+  p_load_data->expire_us = time_us() + (load_defs[level].interval_ms * 1000);
+  p_load_data->wait_start_us = 0;
+  bool success = sched_task_update(&load_tasks[level], load_defs[level].interval_ms);
+  assert(success);
+}
+
+/* Function for starting the dispatch latency of the expired load tasks at the
+ * start of a handler call.  The latency starts at the expiration if the
+ * previous handler call was still executing, else the scheduler was asleep
+ * and the latency starts now.
+ */
+static void load_wait_start(uint64_t now_us)
+{
+  for (uint32_t level = 0; level < SCHED_TASK_PRIORITY_LEVELS; level++)
+  {
+    load_task_data_t *p_load_data = &load_data[level];
+    if ((p_load_data->wait_start_us == 0) && (p_load_data->expire_us <= now_us))
+    {
+      p_load_data->wait_start_us =
+          (load_exit_us > p_load_data->expire_us) ? p_load_data->expire_us : now_us;
+    }
+  }
+}
+
+// Order Test Task Handler
+static void order_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = (uint32_t)(p_task - order_tasks);
+  assert(index < ORDER_TASK_COUNT);
+
+  if (order_priority[index] > order_last_priority)
+  {
+    log_error("Error: Round %u called priority %u after priority %u.\n", order_round_cnt,
+              order_priority[index], order_last_priority);
+    test_pass_set(false);
+  }
+
+  order_last_priority = order_priority[index];
+  order_call_cnt++;
+}
+
+// The dispatch latency bound of the highest priority level. (uS)
+static uint32_t latency_bound_us = 0;
+
+// Load Task Handler
+static void load_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t now_ms = sched_port_ms();
+  uint64_t now_us = time_us();
+  uint32_t level = (uint32_t)(p_task - load_tasks);
+  assert(level < SCHED_TASK_PRIORITY_LEVELS);
+  load_task_data_t *p_load_data = &load_data[level];
+
+  uint32_t elapsed_ms = now_ms - p_load_data->armed_ms;
+  if (elapsed_ms < load_defs[level].interval_ms)
+  {
+    log_error("Error: Level %u called %u mS early.\n", level,
+              (uint32_t)(load_defs[level].interval_ms - elapsed_ms));
+    test_pass_set(false);
+  }
+
+  // The tick resolution may call the task slightly before its uS expiration.
+  load_wait_start(now_us);
+  if (p_load_data->wait_start_us != 0)
+  {
+    uint64_t latency_us = now_us - p_load_data->wait_start_us;
+    p_load_data->latency_max_us = SCHED_MAX(p_load_data->latency_max_us, latency_us);
+    if (latency_us > latency_bound_us)
+    {
+      p_load_data->exceed_cnt++;
+    }
+  }
+
+  p_load_data->handler_cnt++;
+  busy_wait_us(load_defs[level].handler_us);
+
+  // Re-arm the task once the handler's work is done.
+  load_task_arm(level);
+  load_exit_us = time_us();
+}
+
+// Order Test Setup Task Handler
+static void setup_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if (order_call_cnt != ((order_round_cnt == 0) ? 0 : ORDER_TASK_COUNT))
+  {
+    log_error("Error: Round %u made %u calls.\n", order_round_cnt, order_call_cnt);
+    test_pass_set(false);
+  }
+
+  if (order_round_cnt == ORDER_ROUNDS)
+  {
+    // Start the latency test.
+    sched_task_stop(p_task);
+    for (uint32_t level = 0; level < SCHED_TASK_PRIORITY_LEVELS; level++)
+    {
+      load_task_arm(level);
+    }
+    bool success = sched_task_start(&stop_task);
+    assert(success);
+    return;
+  }
+
+  // Expire every order task at once with a random priority.
+  for (uint32_t index = 0; index < ORDER_TASK_COUNT; index++)
+  {
+    order_priority[index] = rand() % SCHED_TASK_PRIORITY_LEVELS;
+    bool success = sched_task_priority(&order_tasks[index], order_priority[index]);
+    success = success && sched_task_update(&order_tasks[index], 0);
+    assert(success);
+  }
+
+  order_last_priority = SCHED_TASK_PRIORITY_LEVELS - 1;
+  order_call_cnt = 0;
+  order_round_cnt++;
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  for (uint32_t level = 0; level < SCHED_TASK_PRIORITY_LEVELS; level++)
+  {
+    sched_task_stop(&load_tasks[level]);
+
+    log_info("Level %u: %u Calls, Max Latency: %u uS, Over %u uS: %u Calls\n", level,
+             load_data[level].handler_cnt, (uint32_t)load_data[level].latency_max_us,
+             latency_bound_us, load_data[level].exceed_cnt);
+
+    if (load_data[level].handler_cnt == 0)
+    {
+      log_error("Error: Level %u was never called.\n", level);
+      test_pass_set(false);
+    }
+  }
+
+  // A task of the highest priority waits at most for the handler executing when it expires.
+  load_task_data_t *p_top_data = &load_data[SCHED_TASK_PRIORITY_LEVELS - 1];
+  if ((p_top_data->exceed_cnt * 100) > (p_top_data->handler_cnt * LATENCY_EXCEED_PCT))
+  {
+    log_error("Error: %u of %u highest priority calls exceeded %u uS.\n",
+              p_top_data->exceed_cnt, p_top_data->handler_cnt, latency_bound_us);
+    test_pass_set(false);
+  }
+
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Task Priority Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Priorities can only be set for configured tasks.
+  if (sched_task_priority(NULL, 0) || sched_task_priority(&setup_task, 0))
+  {
+    log_error("Error: A priority was set for an unconfigured or NULL task.\n");
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_config(&setup_task, setup_task_handler, SETUP_INTERVAL_MS, true);
+  assert(success);
+
+  // The priority must be valid.
+  if (sched_task_priority(&setup_task, SCHED_TASK_PRIORITY_LEVELS) ||
+      !sched_task_priority(&setup_task, SCHED_TASK_PRIORITY_LEVELS - 1) ||
+      !sched_task_priority(&setup_task, 0))
+  {
+    log_error("Error: The priority range was not checked.\n");
+    test_pass_set(false);
+  }
+
+  success = sched_task_start(&setup_task);
+  assert(success);
+
+  // Configure the order test tasks, they are started by the setup task.
+  for (uint32_t index = 0; index < ORDER_TASK_COUNT; index++)
+  {
+    success = sched_task_config(&order_tasks[index], order_task_handler, 0, false);
+    assert(success);
+  }
+
+  // Configure the load tasks, they are started once the order test completes.
+  for (uint32_t level = 0; level < SCHED_TASK_PRIORITY_LEVELS; level++)
+  {
+    latency_bound_us = SCHED_MAX(latency_bound_us, load_defs[level].handler_us + LATENCY_MARGIN_US);
+
+    success = sched_task_config(&load_tasks[level], load_task_handler,
+                                load_defs[level].interval_ms, false);
+    success = success && sched_task_priority(&load_tasks[level], level);
+    assert(success);
+  }
+
+  // Configure the test completion task with the lowest priority.
+  success = sched_task_config(&stop_task, stop_task_handler, LATENCY_DURATION_MS, false);
+  assert(success);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  if (order_round_cnt != ORDER_ROUNDS)
+  {
+    log_error("Error: %u of %u order rounds completed.\n", order_round_cnt, ORDER_ROUNDS);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Task Priority Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Task Priority Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,339 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task List Pruning Test
+ *
+ * The program tests the unlinking of stopped tasks from the scheduler's task
+ * list on the simulated time port.  An array of single shot tasks, tasks
+ * allocated from a pool over and over and a task stopped from a simulated
+ * interrupt are all stopped part way through the test.  The test verifies
+ * that:
+ *
+ *  - Stopped single shot tasks, pool tasks returned to their pool and tasks
+ *    stopped from an interrupt are unlinked so the task list only holds the
+ *    started tasks.
+ *  - A task stopped and started again before it is unlinked stays linked
+ *    once and an unlinked task is linked again when it is started.
+ *  - Every task is called the expected number of times and the tasks are
+ *    stopped, keeping their configuration, once the scheduler stops.
+ *  - A task can't be started while the scheduler is stopped, but is linked
+ *    when started after the scheduler is initialized again.
+ *  - Tasks sharing a que position when the scheduler is stopped can be
+ *    started again after other tasks take their place in the que.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The number of single shot tasks, each task's delay is its index plus one.
+#define SHOT_TASK_CNT (64)
+
+// The number of tasks in the task pool.
+#define POOL_TASK_CNT (8)
+
+// The interval of the task which allocates the pool tasks. (ticks)
+#define CHURN_TICKS (10)
+
+// The delay of the pool tasks. (ticks)
+#define POOL_TICKS (3)
+
+// The delay of the long task, which is stopped before it expires. (ticks)
+#define LONG_TICKS (1000)
+
+// The time of the simulated interrupt which stops the long task. (ticks)
+#define IRQ_TICKS (150)
+
+// The time of the first list check and the interval to the following checks,
+// the checks fall between the pool task calls. (ticks)
+#define CHECK_TICKS (105)
+#define CHECK_STEP_TICKS (104)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (355)
+
+// The expected churn task calls, 20 calls before it is restarted by the
+// second check at 209 ticks and 14 calls from 219 to 349 ticks.
+#define CHURN_CALLS_EXPECTED (34)
+
+// The expected pool task calls, no tasks are allocated with pools disabled.
+#if (SCHED_TASK_POOL_EN != 0)
+#define POOL_CALLS_EXPECTED (CHURN_CALLS_EXPECTED * POOL_TASK_CNT)
+#else
+#define POOL_CALLS_EXPECTED (0)
+#endif
+
+// The expected number of linked tasks at each check.
+static const uint32_t linked_expected[] = {
+    4, // The check, stop, churn and long tasks.
+    3, // The long task was stopped by the interrupt.
+    3, // The restarted churn task is linked once.
+};
+
+#define CHECK_CNT (sizeof(linked_expected) / sizeof(linked_expected[0]))
+
+// The single shot tasks.
+static SCHED_TASK_SECTION sched_task_t shot_tasks[SHOT_TASK_CNT];
+
+// The task pool.
+SCHED_TASK_POOL_DEF(churn_pool, sizeof(uint32_t), POOL_TASK_CNT);
+
+// The timed tasks.
+SCHED_TASK_DEF(churn_task);
+SCHED_TASK_DEF(long_task);
+SCHED_TASK_DEF(check_task);
+SCHED_TASK_DEF(stop_task);
+
+// The number of handler calls of each single shot task.
+static uint32_t shot_calls[SHOT_TASK_CNT];
+
+// The number of handler calls of the churn task and the pool tasks.
+static uint32_t churn_calls = 0;
+static uint32_t pool_calls = 0;
+
+// The number of list checks.
+static uint32_t check_cnt = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Simulated Interrupt Handler, stops the long task.
+static void irq_handler(void)
+{
+  if (!sched_task_stop(&long_task))
+  {
+    log_error("Error: The long task could not be stopped from the interrupt.\n");
+    test_pass_set(false);
+  }
+}
+
+// Single Shot Task Handler
+static void shot_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = (uint32_t)(p_task - shot_tasks);
+  assert(index < SHOT_TASK_CNT);
+  shot_calls[index]++;
+}
+
+// Pool Task Handler
+static void pool_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  pool_calls++;
+}
+
+// Churn Task Handler, allocates and starts every pool task.
+static void churn_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  churn_calls++;
+
+  sched_task_t *p_pool_task;
+  while ((p_pool_task = sched_task_alloc(&churn_pool)) != NULL)
+  {
+    bool success = sched_task_config(p_pool_task, pool_task_handler, POOL_TICKS, false);
+    success = success && sched_task_start(p_pool_task);
+    if (!success)
+    {
+      log_error("Error: A pool task could not be started.\n");
+      test_pass_set(false);
+    }
+  }
+}
+
+// Long Task Handler, the task is stopped before it expires.
+static void long_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  log_error("Error: The long task was called.\n");
+  test_pass_set(false);
+}
+
+// Check Task Handler, checks the number of linked tasks.
+static void check_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t linked = sched_task_cnt();
+  log_info("Linked Tasks at %u Ticks: %u\n", (uint32_t)sched_port_ticks(), linked);
+
+  if ((check_cnt >= CHECK_CNT) || (linked != linked_expected[check_cnt]))
+  {
+    log_error("Error: %u tasks were linked at %u ticks.\n", linked,
+              (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+  check_cnt++;
+
+  bool success = true;
+  if (check_cnt == 2)
+  {
+    // Restart the churn task before it is unlinked.
+    success = success && sched_task_stop(&churn_task);
+    success = success && sched_task_start(&churn_task);
+
+    // Start an unlinked single shot task again.
+    success = success && sched_task_update(&shot_tasks[0], 1);
+  }
+
+  success = success && sched_task_update(p_task, CHECK_STEP_TICKS);
+  if (!success)
+  {
+    log_error("Error: The tasks could not be restarted.\n");
+    test_pass_set(false);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Task List Pruning Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = true;
+  for (uint32_t index = 0; index < SHOT_TASK_CNT; index++)
+  {
+    success = success && sched_task_config(&shot_tasks[index], shot_task_handler, index + 1, false);
+    success = success && sched_task_start(&shot_tasks[index]);
+  }
+
+  // Configured tasks are only linked once they are started.
+  success = success && sched_task_config(&churn_task, churn_task_handler, CHURN_TICKS, true);
+  success = success && sched_task_config(&long_task, long_task_handler, LONG_TICKS, false);
+  success = success && sched_task_config(&check_task, check_task_handler, CHECK_TICKS, false);
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  if (sched_task_cnt() != SHOT_TASK_CNT)
+  {
+    log_error("Error: %u tasks were linked before the tasks started.\n", sched_task_cnt());
+    test_pass_set(false);
+  }
+
+  success = success && sched_task_start(&churn_task);
+  success = success && sched_task_start(&long_task);
+  success = success && sched_task_start(&check_task);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    sched_sim_irq_set(sched_sim_ticks_ns(IRQ_TICKS), irq_handler);
+
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Checks: %u, Churn Calls: %u, Pool Calls: %u\n", check_cnt, churn_calls, pool_calls);
+
+  for (uint32_t index = 0; index < SHOT_TASK_CNT; index++)
+  {
+    uint32_t expected = (index == 0) ? 2 : 1;
+    if (shot_calls[index] != expected)
+    {
+      log_error("Error: Single shot task %u was called %u times.\n", index, shot_calls[index]);
+      test_pass_set(false);
+    }
+  }
+
+  if ((check_cnt != CHECK_CNT) || (churn_calls != CHURN_CALLS_EXPECTED) ||
+      (pool_calls != POOL_CALLS_EXPECTED))
+  {
+    log_error("Error: %u checks, %u churn calls and %u pool calls.\n", check_cnt, churn_calls,
+              pool_calls);
+    test_pass_set(false);
+  }
+
+  // The stopped scheduler stops its tasks which keep their configuration.
+  if ((sched_task_state(&churn_task) != SCHED_TASK_STOPPED) ||
+      (sched_task_state(&long_task) != SCHED_TASK_STOPPED) || (sched_task_cnt() != 0))
+  {
+    log_error("Error: The tasks weren't stopped with the scheduler.\n");
+    test_pass_set(false);
+  }
+
+  // A task can't be started while the scheduler is stopped.
+  if (sched_task_start(&long_task) || (sched_task_state(&long_task) != SCHED_TASK_STOPPED))
+  {
+    log_error("Error: A task was started while the scheduler was stopped.\n");
+    test_pass_set(false);
+  }
+
+  // The task is linked and run once the scheduler is initialized again.
+  sched_init();
+  if (!sched_task_start(&long_task) || (sched_task_cnt() != 1))
+  {
+    log_error("Error: The task couldn't be started after the scheduler was initialized.\n");
+    test_pass_set(false);
+  }
+
+  // Tasks with the same delay are stored together in the que when the scheduler stops.
+  success = sched_task_config(&shot_tasks[0], shot_task_handler, LONG_TICKS, false);
+  success = success && sched_task_config(&shot_tasks[1], shot_task_handler, LONG_TICKS, false);
+  success = success && sched_task_start(&shot_tasks[0]);
+  success = success && sched_task_start(&shot_tasks[1]);
+  sched_stop();
+  sched_start();
+
+  // A task started after the scheduler is initialized again takes their place.
+  sched_init();
+  success = success && sched_task_config(&shot_tasks[2], shot_task_handler, LONG_TICKS, false);
+  success = success && sched_task_start(&shot_tasks[2]);
+  success = success && sched_task_start(&shot_tasks[1]);
+  if (!success || (sched_task_cnt() != 2))
+  {
+    log_error("Error: A task couldn't be started again after the scheduler was stopped.\n");
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Task List Pruning Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Task List Pruning Test: FAIL\n");
+    return 1;
+  }
+}
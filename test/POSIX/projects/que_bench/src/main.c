@@ -0,0 +1,134 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Que Benchmark
+ *
+ * The program measures the processor time used by the scheduler's task que
+ * engine for an application with a large number of long interval tasks.
+ *
+ *  - A small number of fast repeating tasks are run with short intervals,
+ *    similar to sensor polling tasks.
+ *  - A large number of repeating tasks are run with long intervals ranging
+ *    from one minute to one day, similar to housekeeping tasks.
+ *  - Each fast task handler call restarts one of the long interval tasks.
+ *
+ * The processor time is measured over a fixed run time and reported per
+ * fast task handler call.  The benchmark is intended to be built and run
+ * with each of the que engine build configurations with the "bench" target
+ * of the POSIX test makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// The number of fast tasks.
+#define FAST_TASK_COUNT (10)
+
+// The fast task interval. (mS)
+#define FAST_INTERVAL_MS (10)
+
+// The number of long interval tasks.
+#define LONG_TASK_COUNT (10000)
+
+// The long task interval range. (mS)
+#define LONG_INTERVAL_MIN_MS (1000 * 60)
+#define LONG_INTERVAL_MAX_MS (1000 * 60 * 60 * 24)
+
+// The benchmark run time. (mS)
+#define RUN_TIME_MS (5000)
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+#define ENGINE_NAME "List"
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+#define ENGINE_NAME "Heap"
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+#define ENGINE_NAME "Wheel"
+#endif
+
+// The benchmark tasks.
+static SCHED_TASK_SECTION sched_task_t fast_tasks[FAST_TASK_COUNT];
+static SCHED_TASK_SECTION sched_task_t long_tasks[LONG_TASK_COUNT];
+
+// Count of the fast task handler calls.
+static uint32_t fast_calls = 0;
+
+// The benchmark start time. (mS)
+static uint32_t bench_start_ms;
+
+// Function for generating a random long task interval.
+static uint32_t long_interval_ms(void)
+{
+  return LONG_INTERVAL_MIN_MS + (rand() % (LONG_INTERVAL_MAX_MS - LONG_INTERVAL_MIN_MS));
+}
+
+// Fast Task Handler
+static void fast_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  fast_calls++;
+
+  if ((sched_port_ms() - bench_start_ms) >= RUN_TIME_MS)
+  {
+    // Stop the scheduler once the run time has elapsed.
+    sched_stop();
+    return;
+  }
+
+  // Restart one of the long interval tasks with a new interval.
+  sched_task_update(&long_tasks[rand() % LONG_TASK_COUNT], long_interval_ms());
+}
+
+// Long Task Handler
+static void long_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // Empty
+}
+
+int main(void)
+{
+  // Initialize the Scheduler
+  sched_init();
+
+  // Use a fixed seed so every engine runs the same task intervals.
+  srand(1);
+
+  for (uint32_t index = 0; index < LONG_TASK_COUNT; index++)
+  {
+    bool success = sched_task_config(&long_tasks[index], long_task_handler,
+                                     long_interval_ms(), true);
+    success = success && sched_task_start(&long_tasks[index]);
+    if (!success)
+    {
+      printf("Error: Long task %u could not be started.\n", index);
+      return 1;
+    }
+  }
+
+  for (uint32_t index = 0; index < FAST_TASK_COUNT; index++)
+  {
+    bool success = sched_task_config(&fast_tasks[index], fast_task_handler,
+                                     FAST_INTERVAL_MS, true);
+    success = success && sched_task_start(&fast_tasks[index]);
+    if (!success)
+    {
+      printf("Error: Fast task %u could not be started.\n", index);
+      return 1;
+    }
+  }
+
+  // Start the Scheduler (Returns after the run time)
+  bench_start_ms = sched_port_ms();
+  clock_t cpu_start = clock();
+  sched_start();
+  clock_t cpu_end = clock();
+
+  double cpu_us = (double)(cpu_end - cpu_start) * 1e6 / CLOCKS_PER_SEC;
+  printf("%-6s Que Engine: %u Tasks, %u Handler Calls, %.0f uS CPU Time, %.2f uS / Call\n",
+         ENGINE_NAME, FAST_TASK_COUNT + LONG_TASK_COUNT, fast_calls, cpu_us,
+         (fast_calls > 0) ? cpu_us / fast_calls : 0.0);
+
+  return 0;
+}
@@ -0,0 +1,248 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Que Test
+ *
+ * The program tests the scheduler's task que engine.
+ *
+ * A large number of tasks are started with random intervals.  Each task
+ * restarts itself with a new random interval during its handler call while
+ * also randomly stopping and restarting the other tasks.  The test verifies
+ * that:
+ *
+ *  - No task handler is called before its interval has expired.
+ *  - No task handler is called excessively late.
+ *  - The handler of a stopped task is never called.
+ *  - A task with the maximum interval, SCHED_MS_MAX, doesn't hold up the
+ *    other tasks and is never called.
+ *
+ * The test is intended to be run with each of the que engine build
+ * configurations.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The number of test tasks.
+#define TASK_COUNT (100)
+
+// The maximum random task interval (mS)
+#define INTERVAL_MAX_MS (250)
+
+// The maximum acceptable handler call lateness (mS)
+#define LATE_LIMIT_MS (50)
+
+// The total number of handler calls before the test completes.
+#define HANDLER_CALL_CNT (2500)
+
+/*
+ * Task data structure for tracking each task's expected expiration.
+ */
+typedef struct
+{
+  uint32_t start_ms;      // The time just before the task was started.
+  uint32_t interval_ms;   // The task's programmed interval.
+  bool active;            // Should the task be active?
+  uint32_t handler_cnt;   // Count of the number of handler calls.
+} test_task_data_t;
+
+/* The test tasks.  Zero initialized tasks are equivalent to tasks declared
+ * with the SCHED_TASK_DEF() macro.
+ */
+static SCHED_TASK_SECTION sched_task_t test_tasks[TASK_COUNT];
+
+// The test data for each task.
+static test_task_data_t test_data[TASK_COUNT];
+
+// A single shot task with the maximum interval, which never expires during the test.
+SCHED_TASK_DEF(max_task);
+
+// Count of all of the handler calls.
+static uint32_t handler_calls = 0;
+
+// The maximum measured handler lateness (mS)
+static uint32_t late_max_ms = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for generating a random task interval.
+static uint32_t random_interval_ms(void)
+{
+  return rand() % (INTERVAL_MAX_MS + 1);
+}
+
+// Function for restarting a test task with a new random interval.
+static void test_task_restart(uint32_t index)
+{
+  test_task_data_t *p_data = &test_data[index];
+  p_data->interval_ms = random_interval_ms();
+  p_data->start_ms = sched_port_ms();
+  p_data->active = true;
+  bool success = sched_task_update(&test_tasks[index], p_data->interval_ms);
+  if (!success)
+  {
+    log_error("Error: Task %u could not be started.\n", index);
+    test_pass_set(false);
+  }
+}
+
+// Function for stopping a test task.
+static void test_task_stop(uint32_t index)
+{
+  test_data[index].active = false;
+  sched_task_stop(&test_tasks[index]);
+}
+
+// Maximum Interval Task Handler
+static void max_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  log_error("Error: The maximum interval task was called.\n");
+  test_pass_set(false);
+}
+
+// Test Task Handler
+static void test_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t now_ms = sched_port_ms();
+  uint32_t index = (uint32_t)(p_task - test_tasks);
+  assert(index < TASK_COUNT);
+  test_task_data_t *p_test_data = &test_data[index];
+
+  if (!p_test_data->active)
+  {
+    log_error("Error: Stopped task %u handler was called.\n", index);
+    test_pass_set(false);
+  }
+
+  uint32_t elapsed_ms = now_ms - p_test_data->start_ms;
+  if (elapsed_ms < p_test_data->interval_ms)
+  {
+    log_error("Error: Task %u called %u mS early.\n", index,
+              p_test_data->interval_ms - elapsed_ms);
+    test_pass_set(false);
+  }
+  else
+  {
+    uint32_t late_ms = elapsed_ms - p_test_data->interval_ms;
+    late_max_ms = SCHED_MAX(late_max_ms, late_ms);
+    if (late_ms > LATE_LIMIT_MS)
+    {
+      log_error("Error: Task %u called %u mS late.\n", index, late_ms);
+      test_pass_set(false);
+    }
+  }
+
+  p_test_data->handler_cnt++;
+  handler_calls++;
+
+  if (handler_calls >= HANDLER_CALL_CNT)
+  {
+    // Stop all of the tasks and the scheduler once the test completes.
+    for (uint32_t i = 0; i < TASK_COUNT; i++)
+    {
+      test_task_stop(i);
+    }
+    sched_task_stop(&max_task);
+    sched_stop();
+    return;
+  }
+
+  // Restart the task with a new interval.
+  test_task_restart(index);
+
+  // Randomly stop or restart one of the other tasks.
+  uint32_t other_index = rand() % TASK_COUNT;
+  if (other_index != index)
+  {
+    if (test_data[other_index].active)
+    {
+      if ((rand() % 8) == 0)
+      {
+        test_task_stop(other_index);
+      }
+    }
+    else
+    {
+      test_task_restart(other_index);
+    }
+  }
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Que Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Seed the random number generator.
+  srand((unsigned int)time(NULL));
+
+  // Start the maximum interval task ahead of the test tasks.
+  bool max_success = sched_task_config(&max_task, max_task_handler, SCHED_MS_MAX, false) &&
+                     sched_task_start(&max_task);
+  assert(max_success);
+
+  // Configure and start the test tasks, half are configured as repeating.
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    bool success = sched_task_config(&test_tasks[index], test_task_handler,
+                                     0, (index % 2) == 0);
+    assert(success);
+    test_task_restart(index);
+  }
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  log_info("Handler Calls: %u, Max Lateness: %u mS\n", handler_calls, late_max_ms);
+
+  if (test_pass)
+  {
+    log_info("Scheduler Que Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Que Test: FAIL\n");
+    return 1;
+  }
+}
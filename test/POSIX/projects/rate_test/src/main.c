@@ -0,0 +1,271 @@
+/**
+ *  main.c
+ *
+ *  POSIX Task Repeat Mode Test
+ *
+ * The program tests the scheduler's repeating task re-arm modes.
+ *
+ * A fast repeating task is started with each of the repeat modes alongside an
+ * overrun task whose handler periodically blocks the scheduler for longer than
+ * the fast task interval.  The test verifies that:
+ *
+ *  - Fixed rate catch up tasks are re-armed exactly one interval after their
+ *    previous expiration and are called once per interval on average.
+ *  - Fixed rate skip tasks are re-armed by whole intervals and skip the
+ *    intervals missed while the scheduler was blocked.
+ *  - Fixed delay tasks are re-armed at least one interval after their previous
+ *    start time.
+ *  - No fixed rate task handler is called before its scheduled expiration.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The fast repeating task interval (mS)
+#define FAST_INTERVAL_MS (10)
+
+// The overrun task interval (mS)
+#define OVERRUN_INTERVAL_MS (100)
+
+// The time the overrun task handler blocks the scheduler (mS)
+#define OVERRUN_BLOCK_MS (35)
+
+// The test duration (mS)
+#define TEST_DURATION_MS (2055)
+
+/* The maximum number of intervals a catch up task may be behind its schedule
+ * when the test completes.
+ */
+#define CATCHUP_LAG_MAX (OVERRUN_BLOCK_MS / FAST_INTERVAL_MS + 1)
+
+/*
+ * Data structure for tracking each of the fast tasks.
+ */
+typedef struct
+{
+  sched_repeat_mode_t mode; // The task's repeat mode.
+  uint32_t first_start_ms;  // The task's start time when it was started.
+  uint32_t last_start_ms;   // The task's start time after the last handler call.
+  uint32_t handler_cnt;     // Count of the number of handler calls.
+} test_task_data_t;
+
+// Fast Task Indices
+enum
+{
+  TASK_CATCHUP = 0,
+  TASK_SKIP,
+  TASK_DELAY,
+  TASK_COUNT
+};
+
+// The fast test tasks.
+static SCHED_TASK_SECTION sched_task_t test_tasks[TASK_COUNT];
+
+// The test data for each fast task.
+static test_task_data_t test_data[TASK_COUNT] =
+{
+  [TASK_CATCHUP] = { .mode = SCHED_REPEAT_FIXED_RATE_CATCHUP },
+  [TASK_SKIP] = { .mode = SCHED_REPEAT_FIXED_RATE_SKIP },
+  [TASK_DELAY] = { .mode = SCHED_REPEAT_FIXED_DELAY },
+};
+
+// The overrun and test completion tasks.
+SCHED_TASK_DEF(overrun_task);
+SCHED_TASK_DEF(stop_task);
+
+// A task which is never configured.
+SCHED_TASK_DEF(unconfig_task);
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Fast Task Handler
+static void fast_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t now_ms = sched_port_ms();
+  uint32_t index = (uint32_t)(p_task - test_tasks);
+  assert(index < TASK_COUNT);
+  test_task_data_t *p_test_data = &test_data[index];
+
+  // The task has been re-armed before the handler call.
+  uint32_t start_ms = p_task->start_ms;
+  uint32_t advance_ms = start_ms - p_test_data->last_start_ms;
+
+  switch (p_test_data->mode)
+  {
+    case SCHED_REPEAT_FIXED_RATE_CATCHUP:
+      if (advance_ms != FAST_INTERVAL_MS)
+      {
+        log_error("Error: Catch up task advanced by %u mS.\n", advance_ms);
+        test_pass_set(false);
+      }
+      break;
+
+    case SCHED_REPEAT_FIXED_RATE_SKIP:
+      if ((advance_ms == 0) || ((advance_ms % FAST_INTERVAL_MS) != 0))
+      {
+        log_error("Error: Skip task advanced by %u mS.\n", advance_ms);
+        test_pass_set(false);
+      }
+      break;
+
+    case SCHED_REPEAT_FIXED_DELAY:
+    default:
+      if (advance_ms < FAST_INTERVAL_MS)
+      {
+        log_error("Error: Delay task advanced by %u mS.\n", advance_ms);
+        test_pass_set(false);
+      }
+      break;
+  }
+
+  // A fixed rate task's new start time is the expiration which was handled.
+  if ((p_test_data->mode != SCHED_REPEAT_FIXED_DELAY) &&
+      ((int32_t)(now_ms - start_ms) < 0))
+  {
+    log_error("Error: Task %u called %u mS early.\n", index, start_ms - now_ms);
+    test_pass_set(false);
+  }
+
+  p_test_data->last_start_ms = start_ms;
+  p_test_data->handler_cnt++;
+}
+
+// Overrun Task Handler, blocks the scheduler.
+static void overrun_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t start_ms = sched_port_ms();
+  while ((sched_port_ms() - start_ms) < OVERRUN_BLOCK_MS)
+  {
+    // Busy Wait
+  }
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t now_ms = sched_port_ms();
+  test_task_data_t *p_catchup = &test_data[TASK_CATCHUP];
+  uint32_t expected_cnt = (now_ms - p_catchup->first_start_ms) / FAST_INTERVAL_MS;
+
+  log_info("Expected: %u, Catch Up: %u, Skip: %u, Delay: %u\n", expected_cnt,
+           test_data[TASK_CATCHUP].handler_cnt, test_data[TASK_SKIP].handler_cnt,
+           test_data[TASK_DELAY].handler_cnt);
+
+  if ((p_catchup->handler_cnt > expected_cnt) ||
+      ((expected_cnt - p_catchup->handler_cnt) > CATCHUP_LAG_MAX))
+  {
+    log_error("Error: Catch up task called %u times, expected %u.\n",
+              p_catchup->handler_cnt, expected_cnt);
+    test_pass_set(false);
+  }
+
+  // The skip and delay tasks lose the intervals blocked by the overrun task.
+  for (uint32_t index = TASK_SKIP; index < TASK_COUNT; index++)
+  {
+    if (test_data[index].handler_cnt >= p_catchup->handler_cnt)
+    {
+      log_error("Error: Task %u called %u times, expected less than %u.\n", index,
+                test_data[index].handler_cnt, p_catchup->handler_cnt);
+      test_pass_set(false);
+    }
+  }
+
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    sched_task_stop(&test_tasks[index]);
+  }
+  sched_task_stop(&overrun_task);
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Repeat Mode Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Invalid repeat mode changes are rejected.
+  if (sched_task_repeat_mode(NULL, SCHED_REPEAT_FIXED_RATE_SKIP) ||
+      sched_task_repeat_mode(&unconfig_task, SCHED_REPEAT_FIXED_RATE_SKIP) ||
+      sched_task_repeat_mode(&test_tasks[0], SCHED_REPEAT_FIXED_RATE_SKIP))
+  {
+    log_error("Error: Invalid repeat mode change accepted.\n");
+    test_pass_set(false);
+  }
+
+  // Configure and start the fast tasks.
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    bool success = sched_task_config(&test_tasks[index], fast_task_handler,
+                                     FAST_INTERVAL_MS, true);
+    success = success && !sched_task_repeat_mode(&test_tasks[index],
+                                                 (sched_repeat_mode_t)(SCHED_REPEAT_FIXED_RATE_CATCHUP + 1));
+    success = success && sched_task_repeat_mode(&test_tasks[index], test_data[index].mode);
+    success = success && sched_task_start(&test_tasks[index]);
+    if (!success)
+    {
+      log_error("Error: Task %u could not be started.\n", index);
+      test_pass_set(false);
+    }
+    test_data[index].first_start_ms = test_tasks[index].start_ms;
+    test_data[index].last_start_ms = test_tasks[index].start_ms;
+  }
+
+  // Configure and start the overrun and test completion tasks.
+  sched_task_config(&overrun_task, overrun_task_handler, OVERRUN_INTERVAL_MS, true);
+  sched_task_start(&overrun_task);
+  sched_task_config(&stop_task, stop_task_handler, TEST_DURATION_MS, false);
+  sched_task_start(&stop_task);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  if (test_pass)
+  {
+    log_info("Scheduler Repeat Mode Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Repeat Mode Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,206 @@
+/**
+ *  main.c
+ *
+ *  POSIX Simulated Time Scheduler Benchmark
+ *
+ * The program measures the scheduler's dispatch cost, wake ups and dispatch
+ * lateness with the simulated time port, so the results are deterministic and
+ * don't depend on the host's sleep accuracy.
+ *
+ *  - The benchmark is run with 10, 100, 1000 and 10000 repeating tasks.
+ *  - The task intervals are spread logarithmically from 100 mS to 10 minutes,
+ *    similar to a mix of sensor polling and housekeeping tasks.
+ *  - Each handler call executes for a fixed simulated time, so tasks which
+ *    expire together are dispatched late.
+ *  - Each run lasts a simulated hour or a fixed number of handler calls,
+ *    whichever is first.
+ *
+ * For each run, the processor time per handler call, the wake ups per
+ * simulated hour and the distribution of the handler calls' lateness from
+ * their expirations are reported.  The benchmark is intended to be built and
+ * run with each of the que engine and task cache build configurations with
+ * the "sim_bench" target of the POSIX test makefile.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// The task counts of the runs.
+static const uint32_t RUN_TASK_COUNTS[] = {10, 100, 1000, 10000};
+#define RUN_CNT (sizeof(RUN_TASK_COUNTS) / sizeof(RUN_TASK_COUNTS[0]))
+
+// The maximum number of tasks.
+#define TASK_COUNT_MAX (10000)
+
+// The task interval range. (mS)
+#define INTERVAL_MIN_MS (100)
+#define INTERVAL_MAX_MS (1000 * 60 * 10)
+
+// The simulated execution time of each handler call. (nS)
+#define HANDLER_NS (20000)
+
+// The number of nS in an hour.
+#define HOUR_NS (3600ULL * 1000000000ULL)
+
+// The maximum simulated run time. (nS)
+#define RUN_TIME_NS (HOUR_NS)
+
+// The maximum number of handler calls in a run.
+#define RUN_CALLS_MAX (200000)
+
+// The number of 1 uS lateness histogram bins, later calls are counted in the last bin.
+#define LATE_BINS (100000)
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_LIST) && (SCHED_TASK_CACHE_EN != 0)
+#define ENGINE_NAME "List+Cache"
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_LIST)
+#define ENGINE_NAME "List"
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+#define ENGINE_NAME "Heap"
+#elif (SCHED_QUE_ENGINE == SCHED_QUE_WHEEL)
+#define ENGINE_NAME "Wheel"
+#endif
+
+// The benchmark tasks.
+static SCHED_TASK_SECTION sched_task_t tasks[TASK_COUNT_MAX];
+
+// The tasks' scheduled expirations. (Ticks)
+static sched_time_t task_expire[TASK_COUNT_MAX];
+
+// The tasks' intervals. (Ticks)
+static sched_time_t task_interval[TASK_COUNT_MAX];
+
+// Count of the handler calls in the run.
+static uint32_t run_calls;
+
+// The run's simulated start time. (nS)
+static uint64_t run_start_ns;
+
+// The lateness histogram of the run and the maximum lateness. (uS)
+static uint32_t late_hist[LATE_BINS];
+static uint64_t late_max_us;
+
+// Function for generating a task interval, spread logarithmically over the range.
+static sched_time_t interval_ticks(void)
+{
+  double ratio = (double)rand() / RAND_MAX;
+  double interval_ms = INTERVAL_MIN_MS * pow((double)INTERVAL_MAX_MS / INTERVAL_MIN_MS, ratio);
+  return (sched_time_t)((interval_ms * SCHED_TICK_HZ) / 1000);
+}
+
+// Function for getting the lateness of the calls at a percentile of the histogram. (uS)
+static uint32_t late_percentile_us(double percentile)
+{
+  uint64_t target = (uint64_t)ceil((run_calls * percentile) / 100.0);
+  uint64_t cnt = 0;
+
+  for (uint32_t bin = 0; bin < LATE_BINS; bin++)
+  {
+    cnt += late_hist[bin];
+    if ((cnt >= target) && (cnt > 0))
+    {
+      return bin;
+    }
+  }
+  return LATE_BINS - 1;
+}
+
+// Task Handler
+static void task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = (uint32_t)(p_task - tasks);
+  uint64_t now_ns = sched_sim_ns();
+
+  // The fixed rate tasks are re-armed from their scheduled expirations.
+  uint64_t late_us = (now_ns - sched_sim_ticks_ns(task_expire[index])) / 1000;
+  task_expire[index] += task_interval[index];
+
+  late_hist[(late_us < LATE_BINS) ? late_us : LATE_BINS - 1]++;
+  if (late_us > late_max_us)
+  {
+    late_max_us = late_us;
+  }
+
+  sched_sim_advance_ns(HANDLER_NS);
+
+  run_calls++;
+  if ((run_calls >= RUN_CALLS_MAX) || ((sched_sim_ns() - run_start_ns) >= RUN_TIME_NS))
+  {
+    sched_stop();
+  }
+}
+
+// Function for running the benchmark with a number of tasks.
+static bool bench_run(uint32_t task_cnt)
+{
+  memset(tasks, 0x00, sizeof(tasks));
+  memset(late_hist, 0x00, sizeof(late_hist));
+  late_max_us = 0;
+  run_calls = 0;
+
+  // Start each run on a tick at the same time.
+  sched_sim_set_ns(sched_sim_ticks_ns(SCHED_TICK_HZ));
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Use a fixed seed so every configuration runs the same task intervals.
+  srand(1);
+
+  for (uint32_t index = 0; index < task_cnt; index++)
+  {
+    task_interval[index] = interval_ticks();
+    task_expire[index] = sched_port_ticks() + task_interval[index];
+
+    bool success = sched_task_config(&tasks[index], task_handler, task_interval[index], true);
+    success = success && sched_task_repeat_mode(&tasks[index], SCHED_REPEAT_FIXED_RATE_CATCHUP);
+    success = success && sched_task_start(&tasks[index]);
+    if (!success)
+    {
+      printf("Error: Task %u could not be started.\n", index);
+      return false;
+    }
+  }
+
+  // Start the Scheduler (Returns after the run)
+  run_start_ns = sched_sim_ns();
+  uint32_t sleep_start_cnt = sched_sim_sleep_cnt();
+  struct timespec cpu_start, cpu_end;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+  sched_start();
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+
+  double cpu_ns = ((double)(cpu_end.tv_sec - cpu_start.tv_sec) * 1e9) +
+                  (double)(cpu_end.tv_nsec - cpu_start.tv_nsec);
+  double run_hours = (double)(sched_sim_ns() - run_start_ns) / HOUR_NS;
+  uint32_t wake_cnt = sched_sim_sleep_cnt() - sleep_start_cnt;
+
+  printf("%-10s %5u Tasks: %6u Calls in %7.1f S, %7.0f nS / Call, %9.0f Wake Ups / Hour, "
+         "Late uS p50/p90/p99/p99.9/Max: %u/%u/%u/%u/%u\n",
+         ENGINE_NAME, task_cnt, run_calls, run_hours * 3600,
+         (run_calls > 0) ? cpu_ns / run_calls : 0.0, (run_hours > 0) ? wake_cnt / run_hours : 0.0,
+         late_percentile_us(50.0), late_percentile_us(90.0), late_percentile_us(99.0),
+         late_percentile_us(99.9), (uint32_t)late_max_us);
+
+  return true;
+}
+
+int main(void)
+{
+  for (uint32_t run = 0; run < RUN_CNT; run++)
+  {
+    if (!bench_run(RUN_TASK_COUNTS[run]))
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
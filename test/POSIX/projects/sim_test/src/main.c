@@ -0,0 +1,197 @@
+/**
+ *  main.c
+ *
+ *  POSIX Simulated Time Test
+ *
+ * The program tests the scheduler over a simulated day with the simulated
+ * time port, which runs the day in well under a second.
+ *
+ * The simulated time starts shortly before the tick timer rolls over.  A
+ * fixed rate task with a 1 second interval, whose handler executes for a
+ * simulated time, runs alongside a fixed delay task with a 1 hour interval
+ * and a single shot task with a 1 day delay.  The test verifies that:
+ *
+ *  - Each task's handler is called the exact number of times for the day,
+ *    including across the tick timer rollover.
+ *  - No handler is called before its expiration or more than a tick after.
+ *  - The scheduler only wakes up to call handlers.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The number of ticks in a second.
+#define SECOND_TICKS ((sched_time_t)SCHED_TICK_HZ)
+
+// The number of ticks in an hour.
+#define HOUR_TICKS (SECOND_TICKS * 3600)
+
+// The number of ticks in a day.
+#define DAY_TICKS (HOUR_TICKS * 24)
+
+// The time before the tick timer rolls over at which the test starts. (Ticks)
+#define ROLLOVER_TICKS (SECOND_TICKS * 600)
+
+// The simulated execution time of the second task handler. (nS)
+#define SECOND_HANDLER_NS (150000)
+
+// The second task, called once a second on a fixed rate.
+SCHED_TASK_DEF(second_task);
+static uint32_t second_calls = 0;
+static sched_time_t second_expire;
+
+// The hour task, called once an hour on a fixed delay.
+SCHED_TASK_DEF(hour_task);
+static uint32_t hour_calls = 0;
+static sched_time_t hour_expire;
+
+// The day task, a single shot task which stops the test a second after the day.
+SCHED_TASK_DEF(day_task);
+static uint32_t day_calls = 0;
+static sched_time_t day_expire;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+/* Function for checking that a handler was called between its expiration and
+ * the following tick.
+ */
+static void expire_check(const char *p_name, sched_time_t expire_ticks)
+{
+  sched_time_t late_ticks = sched_port_ticks() - expire_ticks;
+
+  if (late_ticks > 1)
+  {
+    log_error("Error: The %s task was called %d ticks from its expiration.\n", p_name,
+              (int32_t)late_ticks);
+    test_pass_set(false);
+  }
+}
+
+// Second Task Handler
+static void second_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  second_calls++;
+  expire_check("second", second_expire);
+  second_expire += SECOND_TICKS;
+
+  sched_sim_advance_ns(SECOND_HANDLER_NS);
+}
+
+// Hour Task Handler
+static void hour_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  hour_calls++;
+  expire_check("hour", hour_expire);
+
+  // A fixed delay task is restarted when its handler is called.
+  hour_expire = sched_port_ticks() + HOUR_TICKS;
+}
+
+// Day Task Handler
+static void day_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  day_calls++;
+  expire_check("day", day_expire);
+
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Simulated Time Test Started ***\n\n");
+
+  // Start the simulated time on a tick shortly before the 32 bit tick timer rolls over.
+  sched_sim_set_ns(sched_sim_ticks_ns((uint64_t)UINT32_MAX + 1 - ROLLOVER_TICKS));
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = sched_task_config(&second_task, second_task_handler, SECOND_TICKS, true);
+  success = success && sched_task_repeat_mode(&second_task, SCHED_REPEAT_FIXED_RATE_CATCHUP);
+  success = success && sched_task_config(&hour_task, hour_task_handler, HOUR_TICKS, true);
+  success = success && sched_task_config(&day_task, day_task_handler, DAY_TICKS + SECOND_TICKS / 2,
+                                         false);
+  assert(success);
+
+  sched_time_t start_ticks = sched_port_ticks();
+  second_expire = start_ticks + SECOND_TICKS;
+  hour_expire = start_ticks + HOUR_TICKS;
+  day_expire = start_ticks + DAY_TICKS + SECOND_TICKS / 2;
+
+  success = sched_task_start(&second_task);
+  success = success && sched_task_start(&hour_task);
+  success = success && sched_task_start(&day_task);
+  assert(success);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  uint32_t handler_calls = second_calls + hour_calls + day_calls;
+  uint32_t sleep_cnt = sched_sim_sleep_cnt();
+
+  log_info("Second Calls: %u, Hour Calls: %u, Day Calls: %u, Sleeps: %u\n", second_calls,
+           hour_calls, day_calls, sleep_cnt);
+
+  if ((second_calls != DAY_TICKS / SECOND_TICKS) || (hour_calls != 24) || (day_calls != 1))
+  {
+    log_error("Error: The tasks were called %u, %u and %u times in a day.\n", second_calls,
+              hour_calls, day_calls);
+    test_pass_set(false);
+  }
+
+  // The hour task expires with the second task so each wake up calls a handler.
+  if ((sleep_cnt < handler_calls - hour_calls) || (sleep_cnt > handler_calls))
+  {
+    log_error("Error: The scheduler slept %u times for %u handler calls.\n", sleep_cnt,
+              handler_calls);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Simulated Time Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Simulated Time Test: FAIL\n");
+    return 1;
+  }
+}
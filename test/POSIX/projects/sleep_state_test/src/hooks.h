@@ -0,0 +1,30 @@
+/**
+ * @file hooks.h
+ * @author Ben Wirz
+ * @brief Scheduler hook functions for the sleep state test.
+ *
+ * The header is included ahead of every source file by the project's
+ * makefile, which maps the scheduler's sleep enter hook to the function.
+ */
+
+#ifndef HOOKS_H__
+#define HOOKS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function called by the SCHED_HOOK_SLEEP_ENTER() hook.
+ *
+ * @param[in] deadline_ms  The time the scheduler will wake at the latest.
+ */
+void sleep_enter_hook(uint64_t deadline_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOOKS_H__
@@ -0,0 +1,314 @@
+/**
+ *  main.c
+ *
+ *  POSIX Sleep State Selection Test
+ *
+ * The program tests the selection of sleep states from a port sleep state
+ * table, built with SCHED_TASK_POWER_EN enabled, on the simulated time port.
+ * The program supplies a table with a light state and a deep state which has
+ * a long break-even time and an exit latency.  A slow repeating task leaves
+ * long idle periods, a fast repeating task is started for a while to shorten
+ * them and a task which only allows the light state is started for a while
+ * after it.  The test verifies that:
+ *
+ *  - The deep state is only selected for the idle periods longer than its
+ *    break-even time and only while every started task allows it.
+ *  - The processor is woken early from the deep state by its exit latency
+ *    and finishes the idle period in the light state.
+ *  - Every handler is called on time.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The simulated sleep modes.
+#define SLEEP_MODE_NONE (0)
+#define SLEEP_MODE_LIGHT (1)
+#define SLEEP_MODE_DEEP (2)
+
+// The deep state's latencies and break-even time. (ticks)
+#define DEEP_ENTRY_TICKS (1)
+#define DEEP_EXIT_TICKS (3)
+#define DEEP_BREAK_EVEN_TICKS (20)
+
+// The light state's break-even time. (ticks)
+#define LIGHT_BREAK_EVEN_TICKS (2)
+
+// The interval of the slow task. (ticks)
+#define SLOW_TICKS (50)
+
+// The interval of the fast task. (ticks)
+#define FAST_TICKS (10)
+
+// The times the fast task runs between. (ticks)
+#define FAST_START_TICKS (300)
+#define FAST_STOP_TICKS (505)
+
+// The delay of the task which only allows the light state. (ticks)
+#define LIGHT_TICKS (100)
+
+// The time at which the test is stopped. (ticks)
+#define STOP_TICKS (805)
+
+// Every task expires on a multiple of the grid. (ticks)
+#define GRID_TICKS (5)
+
+// The expected task calls.
+#define SLOW_CALLS_EXPECTED (STOP_TICKS / SLOW_TICKS)
+#define FAST_CALLS_EXPECTED ((FAST_STOP_TICKS - FAST_START_TICKS) / FAST_TICKS)
+
+// The simulated sleep state table, from the shallowest to the deepest.
+static const sched_port_sleep_state_t sleep_states[] = {
+    {.sleep_mode = SLEEP_MODE_NONE, .entry_ticks = 0, .exit_ticks = 0, .break_even_ticks = 0},
+    {.sleep_mode = SLEEP_MODE_LIGHT,
+     .entry_ticks = 0,
+     .exit_ticks = 0,
+     .break_even_ticks = LIGHT_BREAK_EVEN_TICKS},
+    {.sleep_mode = SLEEP_MODE_DEEP,
+     .entry_ticks = DEEP_ENTRY_TICKS,
+     .exit_ticks = DEEP_EXIT_TICKS,
+     .break_even_ticks = DEEP_BREAK_EVEN_TICKS},
+};
+
+#define SLEEP_STATE_CNT (sizeof(sleep_states) / sizeof(sleep_states[0]))
+
+// The tasks.
+SCHED_TASK_DEF(slow_task);
+SCHED_TASK_DEF(fast_task);
+SCHED_TASK_DEF(light_task);
+SCHED_TASK_DEF(phase_task);
+SCHED_TASK_DEF(stop_task);
+
+// The sleep mode selected for the next sleep.
+static uint8_t sleep_mode = SLEEP_MODE_NONE;
+
+// Did the last sleep use the deep state?
+static bool deep_last = false;
+
+// The number of sleeps in each state.
+static uint32_t sleep_light_cnt = 0;
+static uint32_t sleep_deep_cnt = 0;
+
+// The number of light sleeps which finished an idle period after a deep sleep.
+static uint32_t deep_finish_cnt = 0;
+
+// The number of task calls.
+static uint32_t slow_calls = 0;
+static uint32_t fast_calls = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// The simulated sleep state table.
+uint8_t sched_port_sleep_states(const sched_port_sleep_state_t **pp_states)
+{
+  *pp_states = sleep_states;
+  return SLEEP_STATE_CNT;
+}
+
+// Simulated sleep mode selection.
+void sched_port_sleep_mode(uint8_t mode)
+{
+  sleep_mode = mode;
+}
+
+void sleep_enter_hook(uint64_t deadline_ms)
+{
+  sched_time_t now_ticks = sched_port_ticks();
+  sched_time_t sleep_ticks = (sched_time_t)deadline_ms - now_ticks;
+  log_info("Sleep at %u Ticks: Mode %u for %u Ticks\n", (uint32_t)now_ticks, sleep_mode,
+           (uint32_t)sleep_ticks);
+
+  bool valid = true;
+  switch (sleep_mode)
+  {
+    case SLEEP_MODE_DEEP:
+      // The processor wakes early by the exit latency.
+      valid = ((deadline_ms + DEEP_EXIT_TICKS) % GRID_TICKS == 0) &&
+              (sleep_ticks + DEEP_EXIT_TICKS >= DEEP_BREAK_EVEN_TICKS) &&
+              ((now_ticks < FAST_START_TICKS) || (now_ticks >= FAST_STOP_TICKS + LIGHT_TICKS));
+      sleep_deep_cnt++;
+      break;
+    case SLEEP_MODE_LIGHT:
+      valid = (deadline_ms % GRID_TICKS == 0) && (sleep_ticks >= LIGHT_BREAK_EVEN_TICKS);
+      if (deep_last)
+      {
+        // The idle period is finished in the light state after the early wake.
+        valid = valid && (sleep_ticks == DEEP_EXIT_TICKS);
+        deep_finish_cnt++;
+      }
+      sleep_light_cnt++;
+      break;
+    default:
+      valid = (sleep_ticks < LIGHT_BREAK_EVEN_TICKS);
+      break;
+  }
+
+  if (!valid)
+  {
+    log_error("Error: Sleep mode %u was selected for %u ticks at %u ticks.\n", sleep_mode,
+              (uint32_t)sleep_ticks, (uint32_t)now_ticks);
+    test_pass_set(false);
+  }
+
+  deep_last = (sleep_mode == SLEEP_MODE_DEEP);
+}
+
+// Function for checking that a task is called on time.
+static void on_time_check(uint32_t calls, sched_time_t start_ticks, sched_time_t interval_ticks)
+{
+  if (sched_port_ticks() != start_ticks + calls * interval_ticks)
+  {
+    log_error("Error: A task was called late at %u ticks.\n", (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+}
+
+// Slow Task Handler
+static void slow_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  slow_calls++;
+  on_time_check(slow_calls, 0, SLOW_TICKS);
+}
+
+// Fast Task Handler
+static void fast_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  fast_calls++;
+  on_time_check(fast_calls, FAST_START_TICKS, FAST_TICKS);
+}
+
+// Light Task Handler, the task only limits the sleep while it is started.
+static void light_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  if (sched_port_ticks() != FAST_STOP_TICKS + LIGHT_TICKS)
+  {
+    log_error("Error: The light task was called at %u ticks.\n", (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+}
+
+// Phase Task Handler, starts and stops the fast task then starts the light task.
+static void phase_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  bool success = true;
+  if (sched_port_ticks() == FAST_START_TICKS)
+  {
+    success = success && sched_task_start(&fast_task);
+    success = success && sched_task_update(p_task, FAST_STOP_TICKS - FAST_START_TICKS);
+  }
+  else
+  {
+    success = success && sched_task_stop(&fast_task);
+    success = success && sched_task_start(&light_task);
+  }
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Sleep State Selection Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  bool success = sched_task_config(&slow_task, slow_task_handler, SLOW_TICKS, true);
+  success = success && sched_task_start(&slow_task);
+
+  success = success && sched_task_config(&fast_task, fast_task_handler, FAST_TICKS, true);
+
+  success = success && sched_task_config(&light_task, light_task_handler, LIGHT_TICKS, false);
+  success = success && sched_task_power(&light_task, SCHED_RUN_MODE_LOW, SLEEP_MODE_LIGHT);
+
+  success = success && sched_task_config(&phase_task, phase_task_handler, FAST_START_TICKS, false);
+  success = success && sched_task_start(&phase_task);
+
+  success = success && sched_task_config(&stop_task, stop_task_handler, STOP_TICKS, false);
+  success = success && sched_task_start(&stop_task);
+
+  if (!success)
+  {
+    log_error("Error: The tasks could not be started.\n");
+    test_pass_set(false);
+  }
+  else
+  {
+    // Start the Scheduler (Returns after Tests)
+    sched_start();
+  }
+
+  log_info("Light Sleeps: %u, Deep Sleeps: %u, Finished After Deep: %u\n", sleep_light_cnt,
+           sleep_deep_cnt, deep_finish_cnt);
+
+  if ((slow_calls != SLOW_CALLS_EXPECTED) || (fast_calls != FAST_CALLS_EXPECTED))
+  {
+    log_error("Error: %u slow and %u fast task calls.\n", slow_calls, fast_calls);
+    test_pass_set(false);
+  }
+
+  if ((sleep_deep_cnt == 0) || (deep_finish_cnt != sleep_deep_cnt) ||
+      (sleep_light_cnt <= deep_finish_cnt))
+  {
+    log_error("Error: %u light and %u deep sleeps.\n", sleep_light_cnt, sleep_deep_cnt);
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Sleep State Selection Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Sleep State Selection Test: FAIL\n");
+    return 1;
+  }
+}
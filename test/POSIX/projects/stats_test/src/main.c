@@ -0,0 +1,295 @@
+/**
+ *  main.c
+ *
+ *  POSIX Runtime Statistics Test
+ *
+ * The program tests the scheduler's runtime statistics.
+ *
+ * A repeating task with a short handler runs alongside a repeating task whose
+ * handler executes for longer than its interval.  The overrunning task is
+ * stopped after a fixed number of calls so the scheduler also sleeps.  The
+ * test verifies that:
+ *
+ *  - Statistics can only be read and cleared for configured tasks.
+ *  - Each task's call count matches its handler calls.
+ *  - The handler execution times match the simulated execution times.
+ *  - Every call of the overrunning task is counted as an overrun and no call
+ *    of the short task is.
+ *  - The lateness statistics are consistent and a cleared task restarts its
+ *    statistics.
+ *  - The scheduler's wake up count is non zero and its sleep and awake times
+ *    add up to the time the scheduler was running.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+#if (SCHED_STATS_EN == 0)
+#error "The stats test must be built with runtime statistics enabled"
+#endif
+
+// The short task interval (mS)
+#define SHORT_INTERVAL_MS (10)
+
+// The short task handler execution time (mS)
+#define SHORT_HANDLER_MS (2)
+
+// The overrunning task interval (mS)
+#define OVERRUN_INTERVAL_MS (5)
+
+// The overrunning task handler execution time (mS)
+#define OVERRUN_HANDLER_MS (6)
+
+// The number of overrunning task calls before it is stopped.
+#define OVERRUN_CALLS (20)
+
+// The test duration (mS)
+#define TEST_DURATION_MS (500)
+
+// The allowed error of the measured times, the tick resolution plus host jitter. (mS)
+#define TIME_MARGIN_MS (2)
+
+// The short repeating task.
+SCHED_TASK_DEF(short_task);
+static uint32_t short_calls = 0;
+
+// The overrunning repeating task.
+SCHED_TASK_DEF(overrun_task);
+static uint32_t overrun_calls = 0;
+
+// The test completion task.
+SCHED_TASK_DEF(stop_task);
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for busy waiting to simulate a handler's execution time.
+static void busy_wait_ms(uint32_t wait_ms)
+{
+  struct timespec start, now;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  do
+  {
+    clock_gettime(CLOCK_MONOTONIC, &now);
+  } while ((((now.tv_sec - start.tv_sec) * 1000) + ((now.tv_nsec - start.tv_nsec) / 1000000)) <
+           wait_ms);
+}
+
+// Function for logging a task's statistics snapshot.
+static void stats_log(const char *p_name, const sched_task_stats_t *p_stats)
+{
+  log_info("%s: %u Calls, %u Overruns, Late Min/Avg/Max: %u/%u/%u mS, Exec Avg/Max: %u/%u mS\n",
+           p_name, p_stats->call_cnt, p_stats->overrun_cnt, (uint32_t)p_stats->late_min_ms,
+           (uint32_t)p_stats->late_avg_ms, (uint32_t)p_stats->late_max_ms,
+           (uint32_t)p_stats->exec_avg_ms, (uint32_t)p_stats->exec_max_ms);
+}
+
+// Function for checking the consistency of a task's lateness statistics.
+static void stats_check_late(const char *p_name, const sched_task_stats_t *p_stats)
+{
+  if ((p_stats->late_min_ms > p_stats->late_avg_ms) ||
+      (p_stats->late_avg_ms > p_stats->late_max_ms))
+  {
+    log_error("Error: The %s task's lateness statistics are inconsistent.\n", p_name);
+    test_pass_set(false);
+  }
+}
+
+// Short Task Handler
+static void short_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  short_calls++;
+  busy_wait_ms(SHORT_HANDLER_MS);
+}
+
+// Overrunning Task Handler
+static void overrun_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  overrun_calls++;
+  busy_wait_ms(OVERRUN_HANDLER_MS);
+
+  if (overrun_calls == OVERRUN_CALLS)
+  {
+    sched_task_stop(p_task);
+  }
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_task_stats_t stats;
+
+  // Check the short task's statistics.
+  bool success = sched_task_stats(&short_task, &stats);
+  assert(success);
+  stats_log("Short", &stats);
+  stats_check_late("short", &stats);
+
+  if (stats.call_cnt != short_calls)
+  {
+    log_error("Error: The short task made %u calls, not %u.\n", stats.call_cnt, short_calls);
+    test_pass_set(false);
+  }
+  if ((stats.exec_max_ms < SHORT_HANDLER_MS) || (stats.exec_avg_ms + 1 < SHORT_HANDLER_MS) ||
+      (stats.exec_avg_ms > SHORT_HANDLER_MS + 1))
+  {
+    log_error("Error: The short task's execution time is wrong.\n");
+    test_pass_set(false);
+  }
+  if (stats.overrun_cnt != 0)
+  {
+    log_error("Error: The short task overran %u times.\n", stats.overrun_cnt);
+    test_pass_set(false);
+  }
+
+  // The short task waits for the overrunning task's handler.
+  if (stats.late_max_ms + TIME_MARGIN_MS < OVERRUN_HANDLER_MS)
+  {
+    log_error("Error: The short task's lateness wasn't recorded.\n");
+    test_pass_set(false);
+  }
+
+  // Check the overrunning task's statistics.
+  success = sched_task_stats(&overrun_task, &stats);
+  assert(success);
+  stats_log("Overrun", &stats);
+  stats_check_late("overrun", &stats);
+
+  if ((stats.call_cnt != OVERRUN_CALLS) || (stats.overrun_cnt != OVERRUN_CALLS))
+  {
+    log_error("Error: The overrunning task made %u calls and %u overruns.\n", stats.call_cnt,
+              stats.overrun_cnt);
+    test_pass_set(false);
+  }
+  if (stats.exec_avg_ms + 1 < OVERRUN_HANDLER_MS)
+  {
+    log_error("Error: The overrunning task's execution time is wrong.\n");
+    test_pass_set(false);
+  }
+
+  // A cleared task restarts its statistics.
+  success = sched_task_stats_clear(&overrun_task);
+  success = success && sched_task_stats(&overrun_task, &stats);
+  if (!success || (stats.call_cnt != 0) || (stats.overrun_cnt != 0) || (stats.late_max_ms != 0))
+  {
+    log_error("Error: The overrunning task's statistics weren't cleared.\n");
+    test_pass_set(false);
+  }
+
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Runtime Statistics Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Statistics can only be read and cleared for configured tasks.
+  sched_task_stats_t stats;
+  if (sched_task_stats(NULL, &stats) || sched_task_stats(&short_task, &stats) ||
+      sched_task_stats_clear(NULL) || sched_task_stats_clear(&short_task) ||
+      sched_stats(NULL))
+  {
+    log_error("Error: Statistics were read for an unconfigured or NULL task.\n");
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_config(&short_task, short_task_handler, SHORT_INTERVAL_MS, true);
+  success = success && sched_task_start(&short_task);
+  assert(success);
+
+  if (sched_task_stats(&short_task, NULL) || !sched_task_stats(&short_task, &stats) ||
+      (stats.call_cnt != 0))
+  {
+    log_error("Error: A configured task's statistics weren't cleared.\n");
+    test_pass_set(false);
+  }
+
+  success = sched_task_config(&overrun_task, overrun_task_handler, OVERRUN_INTERVAL_MS, true);
+  success = success && sched_task_start(&overrun_task);
+  assert(success);
+
+  success = sched_task_config(&stop_task, stop_task_handler, TEST_DURATION_MS, false);
+  success = success && sched_task_start(&stop_task);
+  assert(success);
+
+  // Start the Scheduler (Returns after Tests)
+  uint32_t start_ms = sched_port_ms();
+  sched_start();
+  uint32_t run_ms = sched_port_ms() - start_ms;
+
+  // The sleep and awake times add up to the time the scheduler was running.
+  sched_stats_t sched_run_stats;
+  success = sched_stats(&sched_run_stats);
+  assert(success);
+
+  log_info("Scheduler: %u Wake Ups, Sleep: %u mS, Awake: %u mS, Run: %u mS\n",
+           sched_run_stats.wake_cnt, (uint32_t)sched_run_stats.sleep_ms,
+           (uint32_t)sched_run_stats.awake_ms, run_ms);
+
+  uint64_t total_ms = sched_run_stats.sleep_ms + sched_run_stats.awake_ms;
+  if ((total_ms > run_ms) || ((total_ms + TIME_MARGIN_MS) < run_ms))
+  {
+    log_error("Error: The sleep and awake times add up to %u mS, not %u mS.\n",
+              (uint32_t)total_ms, run_ms);
+    test_pass_set(false);
+  }
+
+  // Both tasks' handlers keep the scheduler awake.
+  uint32_t exec_ms = (short_calls * SHORT_HANDLER_MS) + (overrun_calls * OVERRUN_HANDLER_MS);
+  if ((sched_run_stats.wake_cnt == 0) || ((sched_run_stats.awake_ms + TIME_MARGIN_MS) < exec_ms))
+  {
+    log_error("Error: The scheduler's wake ups or awake time weren't recorded.\n");
+    test_pass_set(false);
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Runtime Statistics Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Runtime Statistics Test: FAIL\n");
+    return 1;
+  }
+}
@@ -0,0 +1,320 @@
+/**
+ *  main.c
+ *
+ *  POSIX Static Task Table Test
+ *
+ * The program tests static task tables on the simulated time port.  A table
+ * of tasks is defined with the SCHED_TASK_TABLE_DEF() macro, a group of its
+ * tasks share an interval and expire together and one of its tasks isn't
+ * started with the table.  The table is started, the scheduler is run and
+ * stopped and then the table is started again.  The test verifies that:
+ *
+ *  - A table whose entries aren't listed from the highest priority to the
+ *    lowest, or whose tasks haven't stopped, isn't started.
+ *  - Only the tasks marked to start are started and linked, the others are
+ *    configured and can be started later.
+ *  - The expired tasks of the table are called in priority order and every
+ *    task is called on time.
+ *  - The table can be started again after the scheduler stops.
+ *  - With the heap que engine, a table whose tasks don't all fit in the que
+ *    heap isn't started and none of its tasks are changed.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "scheduler.h"
+#include "sched_port_sim.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+// The interval of the group tasks. (ticks)
+#define GROUP_TICKS (10)
+
+// The delay of the task which isn't started with the table. (ticks)
+#define LATE_TICKS (25)
+
+// The time after the table is started at which the test is stopped. (ticks)
+#define STOP_TICKS (105)
+
+// The number of times the table is started.
+#define RUN_CNT (2)
+
+// The number of group tasks, which expire together.
+#define GROUP_CNT (4)
+
+// The expected calls of each group task for each run.
+#define GROUP_CALLS_EXPECTED (STOP_TICKS / GROUP_TICKS)
+
+// The entry indexes of the table's tasks.
+enum
+{
+  GROUP_TASK_0,
+  GROUP_TASK_1,
+  GROUP_TASK_2,
+  GROUP_TASK_3,
+  LATE_TASK,
+  STOP_TASK
+};
+
+// Handler Prototypes
+static void group_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size);
+static void late_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size);
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size);
+
+// The task table, listed from the highest priority to the lowest.
+SCHED_TASK_TABLE_DEF(app_tasks,
+                     SCHED_TASK_ENTRY(group_task_handler, GROUP_TICKS, true, 3, true),
+                     SCHED_TASK_ENTRY(group_task_handler, GROUP_TICKS, true, 2, true),
+                     SCHED_TASK_ENTRY(group_task_handler, GROUP_TICKS, true, 1, true),
+                     SCHED_TASK_ENTRY(group_task_handler, GROUP_TICKS, true, 0, true),
+                     SCHED_TASK_ENTRY(late_task_handler, LATE_TICKS, false, 0, false),
+                     SCHED_TASK_ENTRY(stop_task_handler, STOP_TICKS, false, 0, true));
+
+// The number of tasks in the table is a constant.
+SCHED_STATIC_ASSERT(SCHED_TASK_TABLE_CNT(app_tasks) == STOP_TASK + 1,
+                    "The task table's count is wrong");
+
+// A table whose entries aren't listed in priority order.
+SCHED_TASK_TABLE_DEF(bad_tasks,
+                     SCHED_TASK_ENTRY(group_task_handler, GROUP_TICKS, true, 0, true),
+                     SCHED_TASK_ENTRY(group_task_handler, GROUP_TICKS, true, 1, true));
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+// The tasks which fill the que heap, leaving too little room for the table.
+static SCHED_TASK_SECTION sched_task_t filler_tasks[SCHED_QUE_HEAP_SIZE - 1];
+#endif
+
+// The number of handler calls of each task.
+static uint32_t task_calls[SCHED_TASK_TABLE_CNT(app_tasks)];
+
+// The total number of group task calls.
+static uint32_t group_calls = 0;
+
+// The time the table was started. (ticks)
+static sched_time_t start_ticks = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for getting the entry index of a table task.
+static uint32_t task_index(const sched_task_t *p_task)
+{
+  uint32_t index = (uint32_t)(p_task - SCHED_TASK_TABLE_TASK(app_tasks, 0));
+  assert(index < SCHED_TASK_TABLE_CNT(app_tasks));
+  return index;
+}
+
+// Group Task Handler, the group tasks are called in priority order.
+static void group_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint32_t index = task_index(p_task);
+  task_calls[index]++;
+
+  // The group tasks are called GROUP_CALLS_EXPECTED times on each run.
+  uint32_t run_calls = ((task_calls[index] - 1) % GROUP_CALLS_EXPECTED) + 1;
+  sched_time_t expected_ticks = start_ticks + (run_calls * GROUP_TICKS);
+  if ((index != group_calls % GROUP_CNT) || (sched_port_ticks() != expected_ticks))
+  {
+    log_error("Error: Group task %u was called out of order at %u ticks.\n", index,
+              (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+  group_calls++;
+}
+
+// Late Task Handler
+static void late_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  task_calls[task_index(p_task)]++;
+
+  if (sched_port_ticks() != start_ticks + LATE_TICKS)
+  {
+    log_error("Error: The late task was called at %u ticks.\n", (uint32_t)sched_port_ticks());
+    test_pass_set(false);
+  }
+}
+
+// Stop Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  task_calls[task_index(p_task)]++;
+  sched_stop();
+}
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+// Filler Task Handler, never called since the scheduler isn't started.
+static void filler_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+}
+
+// Function for checking that a table which doesn't fit in the que heap is left unchanged.
+static void table_heap_full_check(void)
+{
+  sched_init();
+
+  bool success = true;
+  for (uint32_t index = 0; success && (index < SCHED_QUE_HEAP_SIZE - 1); index++)
+  {
+    success = sched_task_config(&filler_tasks[index], filler_task_handler, STOP_TICKS, false) &&
+              sched_task_start(&filler_tasks[index]);
+  }
+  assert(success);
+
+  if (sched_task_table_start(&app_tasks) || (sched_task_cnt() != SCHED_QUE_HEAP_SIZE - 1))
+  {
+    log_error("Error: A table which doesn't fit in the que heap was started.\n");
+    test_pass_set(false);
+  }
+
+  for (uint32_t index = 0; index < SCHED_TASK_TABLE_CNT(app_tasks); index++)
+  {
+    if (sched_task_state(SCHED_TASK_TABLE_TASK(app_tasks, index)) != SCHED_TASK_STOPPED)
+    {
+      log_error("Error: Task %u was changed by a table which wasn't started.\n", index);
+      test_pass_set(false);
+    }
+  }
+}
+#endif
+
+// Function for starting the table and checking the started tasks.
+static bool table_start(void)
+{
+  start_ticks = sched_port_ticks();
+
+  if (!sched_task_table_start(&app_tasks))
+  {
+    log_error("Error: The task table could not be started.\n");
+    return false;
+  }
+
+  // The table can't be started while its tasks are started.
+  if (sched_task_table_start(&app_tasks))
+  {
+    log_error("Error: The started task table was started again.\n");
+    return false;
+  }
+
+  // Every task is configured but only the tasks marked to start are linked.
+  if ((sched_task_state(SCHED_TASK_TABLE_TASK(app_tasks, LATE_TASK)) != SCHED_TASK_STOPPED) ||
+      (sched_task_state(SCHED_TASK_TABLE_TASK(app_tasks, STOP_TASK)) != SCHED_TASK_ACTIVE) ||
+      (sched_task_cnt() != GROUP_CNT + 1))
+  {
+    log_error("Error: %u tasks were started with the table.\n", sched_task_cnt());
+    return false;
+  }
+
+  return true;
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Static Task Table Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // The table isn't started unless it's listed in priority order.
+  if (sched_task_table_start(&bad_tasks) ||
+      (sched_task_state(SCHED_TASK_TABLE_TASK(bad_tasks, 0)) != SCHED_TASK_UNINIT))
+  {
+    log_error("Error: A table which isn't in priority order was started.\n");
+    test_pass_set(false);
+  }
+
+  for (uint32_t run = 0; run < RUN_CNT; run++)
+  {
+    if (run > 0)
+    {
+      // Initialize the stopped scheduler again.
+      sched_init();
+    }
+
+    bool success = table_start();
+
+    // The task which isn't started with the table is only started on the first run.
+    if (success && (run == 0))
+    {
+      success = sched_task_start(SCHED_TASK_TABLE_TASK(app_tasks, LATE_TASK));
+    }
+
+    if (!success)
+    {
+      log_error("Error: The tasks could not be started.\n");
+      test_pass_set(false);
+      break;
+    }
+
+    // Start the Scheduler (Returns after the Stop Task)
+    sched_start();
+
+    log_info("Run %u Stopped at %u Ticks\n", run, (uint32_t)sched_port_ticks());
+  }
+
+#if (SCHED_QUE_ENGINE == SCHED_QUE_HEAP)
+  table_heap_full_check();
+#endif
+
+  for (uint32_t index = 0; index < SCHED_TASK_TABLE_CNT(app_tasks); index++)
+  {
+    uint32_t expected = RUN_CNT;
+    if (index < GROUP_CNT)
+    {
+      expected = RUN_CNT * GROUP_CALLS_EXPECTED;
+    }
+    else if (index == LATE_TASK)
+    {
+      expected = 1;
+    }
+
+    if (task_calls[index] != expected)
+    {
+      log_error("Error: Task %u was called %u times.\n", index, task_calls[index]);
+      test_pass_set(false);
+    }
+  }
+
+  if (test_pass)
+  {
+    log_info("Scheduler Static Task Table Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Static Task Table Test: FAIL\n");
+    return 1;
+  }
+}
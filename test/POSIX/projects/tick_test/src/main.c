@@ -0,0 +1,258 @@
+/**
+ *  main.c
+ *
+ *  POSIX Tick Resolution Test
+ *
+ * The program tests the scheduler with a sub-mS tick time base.
+ *
+ * The test is built with a SCHED_TICK_HZ of 10 kHz which gives 100 uS ticks.
+ * A fixed delay task with an interval of a few ticks and a fixed rate catch up
+ * task with an interval which isn't a whole number of mS are run alongside a
+ * test completion task.  The test verifies that:
+ *
+ *  - The mS to tick conversion helpers scale by SCHED_TICK_HZ.
+ *  - No task handler is called before its scheduled expiration, measured with
+ *    uS resolution.
+ *  - The catch up task is called once per interval on average.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "scheduler.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+#if (SCHED_TICK_HZ != 10000)
+#error "The tick test must be built with a SCHED_TICK_HZ of 10000"
+#endif
+
+// The fine fixed delay task interval (ticks)
+#define FINE_INTERVAL_TICKS (3)
+
+// The fixed rate catch up task interval, 1.5 mS. (ticks)
+#define RATE_INTERVAL_TICKS (15)
+
+/* The maximum number of intervals the catch up task may be behind its
+ * schedule when the test completes.
+ */
+#define RATE_LAG_MAX (10)
+
+/*
+ * Data structure for tracking each of the test tasks.
+ */
+typedef struct
+{
+  uint64_t first_start_us;  // The time the task was started.
+  uint64_t expire_us;       // The task's next scheduled expiration.
+  uint32_t handler_cnt;     // Count of the number of handler calls.
+} test_task_data_t;
+
+// Test Task Indices
+enum
+{
+  TASK_FINE = 0,
+  TASK_RATE,
+  TASK_COUNT
+};
+
+// The test tasks.
+static SCHED_TASK_SECTION sched_task_t test_tasks[TASK_COUNT];
+
+// The test data for each task.
+static test_task_data_t test_data[TASK_COUNT];
+
+// The task intervals (ticks)
+static const uint32_t test_intervals[TASK_COUNT] =
+{
+  [TASK_FINE] = FINE_INTERVAL_TICKS,
+  [TASK_RATE] = RATE_INTERVAL_TICKS,
+};
+
+// The task repeat modes.
+static const sched_repeat_mode_t test_modes[TASK_COUNT] =
+{
+  [TASK_FINE] = SCHED_REPEAT_FIXED_DELAY,
+  [TASK_RATE] = SCHED_REPEAT_FIXED_RATE_CATCHUP,
+};
+
+// The test completion task.
+SCHED_TASK_DEF(stop_task);
+
+// The test completion task's scheduled expiration (uS)
+static uint64_t stop_expire_us = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for getting the monotonic clock time used by the port (uS)
+static uint64_t time_us(void)
+{
+  struct timespec time;
+  int ret = clock_gettime(CLOCK_MONOTONIC, &time);
+  assert(ret == 0);
+  return ((uint64_t)time.tv_sec * 1000000) + (time.tv_nsec / 1000);
+}
+
+/* Function for converting a scheduler tick timer value near the current time
+ * into the monotonic clock time at which the tick starts (uS)
+ */
+static uint64_t tick_us(uint32_t ticks)
+{
+  uint64_t now_ticks = (time_us() * SCHED_TICK_HZ) / 1000000;
+  int32_t offset = (int32_t)(ticks - (uint32_t)now_ticks);
+  return (((int64_t)now_ticks + offset) * 1000000) / SCHED_TICK_HZ;
+}
+
+// Function for storing a task's next scheduled expiration.
+static void test_expire_set(uint32_t index)
+{
+  sched_task_t *p_task = &test_tasks[index];
+  test_data[index].expire_us = tick_us(p_task->start_ms + p_task->interval_ms);
+}
+
+// Test Task Handler
+static void test_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint64_t now_us = time_us();
+  uint32_t index = (uint32_t)(p_task - test_tasks);
+  assert(index < TASK_COUNT);
+  test_task_data_t *p_test_data = &test_data[index];
+
+  if (now_us < p_test_data->expire_us)
+  {
+    log_error("Error: Task %u called %u uS early.\n", index,
+              (uint32_t)(p_test_data->expire_us - now_us));
+    test_pass_set(false);
+  }
+
+  // The task has been re-armed before the handler call.
+  test_expire_set(index);
+  p_test_data->handler_cnt++;
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  uint64_t now_us = time_us();
+
+  if (now_us < stop_expire_us)
+  {
+    log_error("Error: Stop task called %u uS early.\n",
+              (uint32_t)(stop_expire_us - now_us));
+    test_pass_set(false);
+  }
+
+  test_task_data_t *p_rate = &test_data[TASK_RATE];
+  uint32_t expected_cnt = (uint32_t)(((now_us - p_rate->first_start_us) * SCHED_TICK_HZ) /
+                                     (1000000 * RATE_INTERVAL_TICKS));
+
+  log_info("Expected: %u, Catch Up: %u, Fine: %u\n", expected_cnt,
+           p_rate->handler_cnt, test_data[TASK_FINE].handler_cnt);
+
+  if ((p_rate->handler_cnt > expected_cnt) ||
+      ((expected_cnt - p_rate->handler_cnt) > RATE_LAG_MAX))
+  {
+    log_error("Error: Catch up task called %u times, expected %u.\n",
+              p_rate->handler_cnt, expected_cnt);
+    test_pass_set(false);
+  }
+
+  if (test_data[TASK_FINE].handler_cnt == 0)
+  {
+    log_error("Error: Fine task was not called.\n");
+    test_pass_set(false);
+  }
+
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    sched_task_stop(&test_tasks[index]);
+  }
+  sched_stop();
+}
+
+int main(void)
+{
+  log_info("\n*** Scheduler Tick Resolution Test Started ***\n\n");
+
+  // The conversion helpers scale by the tick frequency.
+  if ((sched_ms(0, 0, 0, 1, 0) != SCHED_TICK_HZ) ||
+      (sched_ms(0, 0, 1, 0, 5) != (60 * SCHED_TICK_HZ) + 50) ||
+      (SCHED_MS_TO_TICKS(2055) != 20550) ||
+      (SCHED_TICKS_TO_MS(RATE_INTERVAL_TICKS) != 1))
+  {
+    log_error("Error: Tick conversion failed.\n");
+    test_pass_set(false);
+  }
+
+  // Initialize the Scheduler
+  sched_init();
+
+  // Configure and start the test tasks.
+  for (uint32_t index = 0; index < TASK_COUNT; index++)
+  {
+    bool success = sched_task_config(&test_tasks[index], test_task_handler,
+                                     test_intervals[index], true);
+    success = success && sched_task_repeat_mode(&test_tasks[index], test_modes[index]);
+    success = success && sched_task_start(&test_tasks[index]);
+    if (!success)
+    {
+      log_error("Error: Task %u could not be started.\n", index);
+      test_pass_set(false);
+    }
+    test_data[index].first_start_us = tick_us(test_tasks[index].start_ms);
+    test_expire_set(index);
+  }
+
+  // Configure and start the test completion task.
+  sched_task_config(&stop_task, stop_task_handler, sched_ms(0, 0, 0, 2, 0), false);
+  sched_task_start(&stop_task);
+  stop_expire_us = tick_us(stop_task.start_ms + stop_task.interval_ms);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  if (test_pass)
+  {
+    log_info("Scheduler Tick Resolution Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Tick Resolution Test: FAIL\n");
+    return 1;
+  }
+}
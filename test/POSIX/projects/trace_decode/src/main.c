@@ -0,0 +1,97 @@
+/**
+ *  main.c
+ *
+ *  POSIX Scheduler Trace Decoder
+ *
+ * The program converts a binary dump of scheduler trace events into a Chrome
+ * trace JSON timeline which can be viewed with chrome://tracing or Perfetto.
+ *
+ * A dump is an array of sched_trace_t records, as read with the
+ * sched_trace_read() function, in the byte order of the decoding machine.
+ *
+ *    trace_decode <dump file> [tick Hz] > trace.json
+ *
+ * The tick rate defaults to SCHED_TICK_HZ.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include "scheduler.h"
+#include "trace_decode.h"
+
+int main(int argc, char *argv[])
+{
+  if ((argc < 2) || (argc > 3))
+  {
+    fprintf(stderr, "Usage: %s <dump file> [tick Hz]\n", argv[0]);
+    return 1;
+  }
+
+  uint32_t tick_hz = SCHED_TICK_HZ;
+  if (argc == 3)
+  {
+    tick_hz = (uint32_t)strtoul(argv[2], NULL, 10);
+    if (tick_hz == 0)
+    {
+      fprintf(stderr, "Error: Invalid tick rate %s.\n", argv[2]);
+      return 1;
+    }
+  }
+
+  FILE *p_dump = fopen(argv[1], "rb");
+  if (p_dump == NULL)
+  {
+    fprintf(stderr, "Error: Could not open %s.\n", argv[1]);
+    return 1;
+  }
+
+  // Read the whole dump, growing the event buffer as needed.
+  uint32_t event_cnt = 0;
+  uint32_t event_max = 1024;
+  sched_trace_t *p_events = malloc(event_max * sizeof(sched_trace_t));
+
+  while (p_events != NULL)
+  {
+    if (event_cnt == event_max)
+    {
+      event_max *= 2;
+      sched_trace_t *p_grown = realloc(p_events, event_max * sizeof(sched_trace_t));
+      if (p_grown == NULL)
+      {
+        free(p_events);
+        p_events = NULL;
+        break;
+      }
+      p_events = p_grown;
+    }
+
+    size_t read_cnt =
+        fread(&p_events[event_cnt], sizeof(sched_trace_t), event_max - event_cnt, p_dump);
+    event_cnt += (uint32_t)read_cnt;
+    if (read_cnt == 0)
+    {
+      break;
+    }
+  }
+
+  bool partial = (ftell(p_dump) % sizeof(sched_trace_t)) != 0;
+  fclose(p_dump);
+
+  if (p_events == NULL)
+  {
+    fprintf(stderr, "Error: Out of memory.\n");
+    return 1;
+  }
+  if (partial)
+  {
+    fprintf(stderr, "Warning: Ignoring a partial record at the end of %s.\n", argv[1]);
+  }
+
+  uint32_t json_cnt = trace_decode_json(stdout, p_events, event_cnt, tick_hz);
+  fprintf(stderr, "Decoded %u events into %u timeline events.\n", event_cnt, json_cnt);
+
+  free(p_events);
+  return 0;
+}
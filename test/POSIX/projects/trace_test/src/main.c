@@ -0,0 +1,345 @@
+/**
+ *  main.c
+ *
+ *  POSIX Trace Ring Test
+ *
+ * The program tests the scheduler's event trace ring.
+ *
+ * The ring is first overfilled by restarting a task before the scheduler is
+ * started.  A repeating task, a single shot task and a task which is stopped
+ * while active are then run while a reader task periodically drains the ring
+ * into a dump.  The dump is written to a file and decoded into a Chrome trace
+ * JSON timeline.  The test verifies that:
+ *
+ *  - A full ring keeps the newest events and the sequence numbers show the
+ *    overwritten events.
+ *  - No events are lost while the ring is drained in time.
+ *  - Each handler call is traced as an expiration, a handler enter and a
+ *    handler exit and each sleep enter is followed by a wake.
+ *  - Single shot tasks are traced from their start to their stop and a
+ *    stopped active task is traced as stopped.
+ *  - The decoder converts every event into a timeline event.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <libgen.h>
+#include "scheduler.h"
+#include "trace_decode.h"
+
+// Enable Debugging?
+const bool DEBUG = false;
+
+// Informational Logging - Only print if debug is true.
+#define log_info(fmt, ...)              \
+  do {                                  \
+      if (DEBUG) {                      \
+        printf(fmt, ## __VA_ARGS__);    \
+        fflush(stdout);                 \
+      }                                 \
+  } while (0)
+
+
+// Error Logging - Always Print
+#define log_error(fmt, ...)             \
+  do {                                  \
+    printf(fmt, ## __VA_ARGS__);        \
+    fflush(stdout);                     \
+  } while (0)
+
+#if (SCHED_TRACE_SIZE != 256)
+#error "The trace test must be built with a SCHED_TRACE_SIZE of 256"
+#endif
+
+// The number of restarts used to overfill the ring.
+#define OVERFILL_CNT (SCHED_TRACE_SIZE + 44)
+
+// The repeating task interval (mS)
+#define REPEAT_INTERVAL_MS (3)
+
+// The single shot task delay (mS)
+#define SINGLE_DELAY_MS (7)
+
+// The reader task interval (mS)
+#define READER_INTERVAL_MS (10)
+
+// The test duration (mS)
+#define TEST_DURATION_MS (200)
+
+// The maximum number of events in the dump.
+#define DUMP_SIZE (8192)
+
+// The dump and timeline files, written next to the executable.
+#define DUMP_FILE "trace_dump.bin"
+#define JSON_FILE "trace.json"
+
+// The repeating task.
+SCHED_TASK_DEF(repeat_task);
+
+// The single shot task, restarted by the reader task.
+SCHED_TASK_DEF(single_task);
+
+// The task which is stopped by the reader while active.
+SCHED_TASK_DEF(idle_task);
+
+// The reader task.
+SCHED_TASK_DEF(reader_task);
+
+// The test completion task.
+SCHED_TASK_DEF(stop_task);
+
+// The events read from the ring.
+static sched_trace_t dump[DUMP_SIZE];
+static uint32_t dump_cnt = 0;
+
+// Count of the repeating task handler calls.
+static uint32_t repeat_calls = 0;
+
+// Test Result
+static bool test_pass = true;
+
+/* Function for setting the test pass results.
+ * Test fails are sticky, once set to false it stays false.
+ */
+static void test_pass_set(bool pass)
+{
+  if (test_pass == true)
+  {
+    test_pass = pass;
+  }
+}
+
+// Function for getting a task's trace id.
+static uint32_t task_id(const sched_task_t *p_task)
+{
+  return sched_task_trace_id(p_task);
+}
+
+// Function for draining the trace ring into the dump.
+static void dump_read(void)
+{
+  dump_cnt += sched_trace_read(&dump[dump_cnt], DUMP_SIZE - dump_cnt);
+}
+
+// Repeating Task Handler
+static void repeat_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  repeat_calls++;
+}
+
+// Single Shot Task Handler
+static void single_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+}
+
+// Reader Task Handler
+static void reader_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  // Restart the single shot task and stop the idle task while it's active.
+  sched_task_start(&single_task);
+  sched_task_start(&idle_task);
+  sched_task_stop(&idle_task);
+
+  dump_read();
+}
+
+// Test Completion Task Handler
+static void stop_task_handler(sched_task_t *p_task, void *p_data, uint8_t data_size)
+{
+  sched_stop();
+}
+
+// Function for checking the traced events of the scheduler run.
+static void dump_check(void)
+{
+  uint32_t handler_cnt = 0;
+  uint32_t single_stop_cnt = 0;
+  uint32_t idle_stop_cnt = 0;
+  uint32_t sleep_cnt = 0;
+  bool sleeping = false;
+  uint32_t handler_id = 0;
+
+  for (uint32_t index = 0; index < dump_cnt; index++)
+  {
+    const sched_trace_t *p_event = &dump[index];
+
+    if ((index > 0) && (p_event->seq != (uint16_t)(dump[index - 1].seq + 1)))
+    {
+      log_error("Error: Event %u was lost.\n", (uint16_t)(dump[index - 1].seq + 1));
+      test_pass_set(false);
+    }
+
+    switch (p_event->event)
+    {
+    case SCHED_TRACE_TASK_EXPIRE:
+      // The handler enter must follow the expiration.
+      if ((index + 1 >= dump_cnt) || (dump[index + 1].event != SCHED_TRACE_HANDLER_ENTER) ||
+          (dump[index + 1].task_id != p_event->task_id) ||
+          ((int32_t)(dump[index + 1].time_ms - p_event->time_ms) < 0))
+      {
+        log_error("Error: Event %u expired without a handler call.\n", p_event->seq);
+        test_pass_set(false);
+      }
+      break;
+
+    case SCHED_TRACE_HANDLER_ENTER:
+      if (handler_id != 0)
+      {
+        log_error("Error: Event %u entered a handler inside a handler.\n", p_event->seq);
+        test_pass_set(false);
+      }
+      handler_id = p_event->task_id;
+      break;
+
+    case SCHED_TRACE_HANDLER_EXIT:
+      if (handler_id != p_event->task_id)
+      {
+        log_error("Error: Event %u exited a handler which wasn't entered.\n", p_event->seq);
+        test_pass_set(false);
+      }
+      handler_id = 0;
+      handler_cnt++;
+      break;
+
+    case SCHED_TRACE_TASK_STOP:
+      if (p_event->task_id == task_id(&single_task))
+      {
+        single_stop_cnt++;
+      }
+      else if (p_event->task_id == task_id(&idle_task))
+      {
+        idle_stop_cnt++;
+      }
+      break;
+
+    case SCHED_TRACE_SLEEP_ENTER:
+    case SCHED_TRACE_WAKE:
+      if (sleeping != (p_event->event == SCHED_TRACE_WAKE))
+      {
+        log_error("Error: Event %u doesn't alternate sleeps and wakes.\n", p_event->seq);
+        test_pass_set(false);
+      }
+      sleeping = (p_event->event == SCHED_TRACE_SLEEP_ENTER);
+      sleep_cnt += sleeping ? 1 : 0;
+      break;
+
+    default:
+      break;
+    }
+  }
+
+  log_info("Events: %u, Handler Calls: %u, Sleeps: %u, Single Stops: %u, Idle Stops: %u\n",
+           dump_cnt, handler_cnt, sleep_cnt, single_stop_cnt, idle_stop_cnt);
+
+  if ((handler_cnt < repeat_calls) || (sleep_cnt == 0) || (single_stop_cnt == 0) ||
+      (idle_stop_cnt == 0))
+  {
+    log_error("Error: Events are missing from the trace.\n");
+    test_pass_set(false);
+  }
+}
+
+// Function for writing the dump and its decoded timeline to files in a directory.
+static void dump_decode(const char *p_dir)
+{
+  char dump_path[512];
+  char json_path[512];
+  snprintf(dump_path, sizeof(dump_path), "%s/%s", p_dir, DUMP_FILE);
+  snprintf(json_path, sizeof(json_path), "%s/%s", p_dir, JSON_FILE);
+
+  FILE *p_file = fopen(dump_path, "wb");
+  assert(p_file != NULL);
+  size_t write_cnt = fwrite(dump, sizeof(sched_trace_t), dump_cnt, p_file);
+  fclose(p_file);
+  assert(write_cnt == dump_cnt);
+
+  // Read the dump back as the decoder tool would.
+  static sched_trace_t dump_copy[DUMP_SIZE];
+  p_file = fopen(dump_path, "rb");
+  assert(p_file != NULL);
+  size_t read_cnt = fread(dump_copy, sizeof(sched_trace_t), DUMP_SIZE, p_file);
+  fclose(p_file);
+
+  p_file = fopen(json_path, "w");
+  assert(p_file != NULL);
+  uint32_t json_cnt = trace_decode_json(p_file, dump_copy, (uint32_t)read_cnt, SCHED_TICK_HZ);
+  fclose(p_file);
+
+  log_info("Timeline Events: %u\n", json_cnt);
+
+  if ((read_cnt != dump_cnt) || (json_cnt != dump_cnt))
+  {
+    log_error("Error: %u events were decoded into %u timeline events.\n", dump_cnt, json_cnt);
+    test_pass_set(false);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  log_info("\n*** Scheduler Trace Ring Test Started ***\n\n");
+
+  // Initialize the Scheduler
+  sched_init();
+
+  if (sched_trace_read(NULL, 1) != 0)
+  {
+    log_error("Error: Events were read into a NULL buffer.\n");
+    test_pass_set(false);
+  }
+
+  bool success = sched_task_config(&repeat_task, repeat_task_handler, REPEAT_INTERVAL_MS, true);
+  assert(success);
+
+  // Overfill the ring, only the newest events are kept.
+  for (uint32_t cnt = 0; cnt < OVERFILL_CNT; cnt++)
+  {
+    success = sched_task_start(&repeat_task);
+    assert(success);
+  }
+
+  dump_read();
+  if ((dump_cnt != SCHED_TRACE_SIZE) || (dump[0].seq != (OVERFILL_CNT - SCHED_TRACE_SIZE)) ||
+      (dump[SCHED_TRACE_SIZE - 1].seq != (OVERFILL_CNT - 1)) ||
+      (dump[0].event != SCHED_TRACE_TASK_START) || (dump[0].task_id != task_id(&repeat_task)) ||
+      (sched_trace_read(dump, 1) != 0))
+  {
+    log_error("Error: The full ring didn't keep the newest %u events.\n", SCHED_TRACE_SIZE);
+    test_pass_set(false);
+  }
+
+  // The run starts with an empty dump.
+  dump_cnt = 0;
+
+  success = sched_task_config(&single_task, single_task_handler, SINGLE_DELAY_MS, false);
+  success = success && sched_task_config(&idle_task, single_task_handler, TEST_DURATION_MS, false);
+  success = success && sched_task_config(&reader_task, reader_task_handler, READER_INTERVAL_MS, true);
+  success = success && sched_task_start(&reader_task);
+  success = success && sched_task_config(&stop_task, stop_task_handler, TEST_DURATION_MS, false);
+  success = success && sched_task_start(&stop_task);
+  assert(success);
+
+  // Start the Scheduler (Returns after Tests)
+  sched_start();
+
+  // Read the events from the end of the run.
+  dump_read();
+
+  dump_check();
+  dump_decode(dirname(argv[0]));
+
+  if (test_pass)
+  {
+    log_info("Scheduler Trace Ring Test: Pass\n");
+    return 0;
+  }
+  else
+  {
+    log_error("Scheduler Trace Ring Test: FAIL\n");
+    return 1;
+  }
+}
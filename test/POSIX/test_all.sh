@@ -31,6 +31,204 @@ task_pool_test() {
   fi  
 }
 
+arena_pool_test() {
+  # Task Arena Pool Test
+  if ./projects/arena_test/build/arena_test; then
+    echo "Task Arena Pool Test ($1): Pass"
+  else
+    printf "Task Arena Pool Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+que_test() {
+  # Task Que Test
+  if ./projects/que_test/build/que_test; then
+    echo "Task Que Test ($1): Pass"
+  else
+    printf "Task Que Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+rate_test() {
+  # Task Repeat Mode Test
+  if ./projects/rate_test/build/rate_test; then
+    echo "Task Repeat Mode Test ($1): Pass"
+  else
+    printf "Task Repeat Mode Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+coalesce_test() {
+  # Task Slack Coalescing Test
+  if ./projects/coalesce_test/build/coalesce_test; then
+    echo "Task Slack Coalescing Test ($1): Pass"
+  else
+    printf "Task Slack Coalescing Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+tick_test() {
+  # Tick Resolution Test
+  if ./projects/tick_test/build/tick_test; then
+    echo "Tick Resolution Test ($1): Pass"
+  else
+    printf "Tick Resolution Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+post_test() {
+  # Task Post Que Test
+  if ./projects/post_test/build/post_test; then
+    echo "Task Post Que Test ($1): Pass"
+  else
+    printf "Task Post Que Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+instance_test() {
+  # Scheduler Instance Test
+  if ./projects/instance_test/build/instance_test; then
+    echo "Scheduler Instance Test ($1): Pass"
+  else
+    printf "Scheduler Instance Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+priority_test() {
+  # Scheduler Task Priority Test
+  if ./projects/priority_test/build/priority_test; then
+    echo "Scheduler Task Priority Test ($1): Pass"
+  else
+    printf "Scheduler Task Priority Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+stats_test() {
+  # Scheduler Runtime Statistics Test
+  if ./projects/stats_test/build/stats_test; then
+    echo "Scheduler Runtime Statistics Test ($1): Pass"
+  else
+    printf "Scheduler Runtime Statistics Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+trace_test() {
+  # Scheduler Trace Ring Test
+  if ./projects/trace_test/build/trace_test; then
+    echo "Scheduler Trace Ring Test ($1): Pass"
+  else
+    printf "Scheduler Trace Ring Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+sim_test() {
+  # Scheduler Simulated Time Test
+  if ./projects/sim_test/build/sim_test; then
+    echo "Scheduler Simulated Time Test ($1): Pass"
+  else
+    printf "Scheduler Simulated Time Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+compact_test() {
+  # Scheduler Compact Task Layout Test
+  if ./projects/compact_test/build/compact_test; then
+    echo "Scheduler Compact Task Layout Test ($1): Pass"
+  else
+    printf "Scheduler Compact Task Layout Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+event_test() {
+  # Scheduler Event Triggered Task Test
+  if ./projects/event_test/build/event_test; then
+    echo "Scheduler Event Triggered Task Test ($1): Pass"
+  else
+    printf "Scheduler Event Triggered Task Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+msg_test() {
+  # Scheduler Message Task Test
+  if ./projects/msg_test/build/msg_test; then
+    echo "Scheduler Message Task Test ($1): Pass"
+  else
+    printf "Scheduler Message Task Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+coro_test() {
+  # Scheduler Coroutine Task Test
+  if ./projects/coro_test/build/coro_test; then
+    echo "Scheduler Coroutine Task Test ($1): Pass"
+  else
+    printf "Scheduler Coroutine Task Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+budget_test() {
+  # Scheduler Task Budget Test
+  if ./projects/budget_test/build/budget_test; then
+    echo "Scheduler Task Budget Test ($1): Pass"
+  else
+    printf "Scheduler Task Budget Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+prune_test() {
+  # Scheduler Task List Pruning Test
+  if ./projects/prune_test/build/prune_test; then
+    echo "Scheduler Task List Pruning Test ($1): Pass"
+  else
+    printf "Scheduler Task List Pruning Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+power_test() {
+  # Scheduler Task Power Mode Test
+  if ./projects/power_test/build/power_test; then
+    echo "Scheduler Task Power Mode Test ($1): Pass"
+  else
+    printf "Scheduler Task Power Mode Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+sleep_state_test() {
+  # Scheduler Sleep State Selection Test
+  if ./projects/sleep_state_test/build/sleep_state_test; then
+    echo "Scheduler Sleep State Selection Test ($1): Pass"
+  else
+    printf "Scheduler Sleep State Selection Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+table_test() {
+  # Scheduler Static Task Table Test
+  if ./projects/table_test/build/table_test; then
+    echo "Scheduler Static Task Table Test ($1): Pass"
+  else
+    printf "Scheduler Static Task Table Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+cpp_test() {
+  # Scheduler C++ Wrapper Test
+  if ./projects/cpp_test/build/cpp_test; then
+    echo "Scheduler C++ Wrapper Test ($1): Pass"
+  else
+    printf "Scheduler C++ Wrapper Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
+hosted_test() {
+  # Scheduler Hosted Port Test
+  if ./projects/hosted_test/build/hosted_test; then
+    echo "Scheduler Hosted Port Test ($1): Pass"
+  else
+    printf "Scheduler Hosted Port Test ($1): ${RED}FAIL${NOCOLOR}\n"
+  fi
+}
+
 clear
 
 echo "*** Scheduler Library Test ***"
@@ -42,6 +240,28 @@ echo ""
 access_test 'Default'
 interval_math_test 'Default'
 task_pool_test 'Default'
+arena_pool_test 'Default'
+que_test 'Default'
+rate_test 'Default'
+coalesce_test 'Default'
+tick_test 'Default'
+post_test 'Default'
+instance_test 'Default'
+priority_test 'Default'
+stats_test 'Default'
+trace_test 'Default'
+sim_test 'Default'
+compact_test 'Default'
+event_test 'Default'
+msg_test 'Default'
+coro_test 'Default'
+budget_test 'Default'
+prune_test 'Default'
+power_test 'Default'
+sleep_state_test 'Default'
+table_test 'Default'
+cpp_test 'Default'
+hosted_test 'Default'
 
 # Test the Buffer Clear Enabled Configuration
 make -s clean
@@ -50,6 +270,28 @@ echo ""
 access_test 'Buff Clear Enabled'
 interval_math_test 'Buff Clear Enabled'
 task_pool_test 'Buff Clear Enabled'
+arena_pool_test 'Buff Clear Enabled'
+que_test 'Buff Clear Enabled'
+rate_test 'Buff Clear Enabled'
+coalesce_test 'Buff Clear Enabled'
+tick_test 'Buff Clear Enabled'
+post_test 'Buff Clear Enabled'
+instance_test 'Buff Clear Enabled'
+priority_test 'Buff Clear Enabled'
+stats_test 'Buff Clear Enabled'
+trace_test 'Buff Clear Enabled'
+sim_test 'Buff Clear Enabled'
+compact_test 'Buff Clear Enabled'
+event_test 'Buff Clear Enabled'
+msg_test 'Buff Clear Enabled'
+coro_test 'Buff Clear Enabled'
+budget_test 'Buff Clear Enabled'
+prune_test 'Buff Clear Enabled'
+power_test 'Buff Clear Enabled'
+sleep_state_test 'Buff Clear Enabled'
+table_test 'Buff Clear Enabled'
+cpp_test 'Buff Clear Enabled'
+hosted_test 'Buff Clear Enabled'
 
 # Test the Task Pool Disabled Configuration
 make -s clean
@@ -57,7 +299,27 @@ make -s task_pools_disable
 echo ""
 access_test 'Task Pools Disabled'
 interval_math_test 'Task Pools Disabled'
-# The task pool test would fail, skip test.
+# The task pool tests would fail, skip tests.
+que_test 'Task Pools Disabled'
+rate_test 'Task Pools Disabled'
+coalesce_test 'Task Pools Disabled'
+tick_test 'Task Pools Disabled'
+post_test 'Task Pools Disabled'
+instance_test 'Task Pools Disabled'
+priority_test 'Task Pools Disabled'
+stats_test 'Task Pools Disabled'
+trace_test 'Task Pools Disabled'
+sim_test 'Task Pools Disabled'
+event_test 'Task Pools Disabled'
+msg_test 'Task Pools Disabled'
+coro_test 'Task Pools Disabled'
+budget_test 'Task Pools Disabled'
+prune_test 'Task Pools Disabled'
+power_test 'Task Pools Disabled'
+sleep_state_test 'Task Pools Disabled'
+table_test 'Task Pools Disabled'
+cpp_test 'Task Pools Disabled'
+hosted_test 'Task Pools Disabled'
 
 # Test the Task Cache Disabled Configuration
 make -s clean
@@ -66,6 +328,202 @@ echo ""
 access_test 'Task Cache Disabled'
 interval_math_test 'Task Cache Disabled'
 task_pool_test 'Task Cache'
+arena_pool_test 'Task Cache'
+que_test 'Task Cache Disabled'
+rate_test 'Task Cache Disabled'
+coalesce_test 'Task Cache Disabled'
+tick_test 'Task Cache Disabled'
+post_test 'Task Cache Disabled'
+instance_test 'Task Cache Disabled'
+priority_test 'Task Cache Disabled'
+stats_test 'Task Cache Disabled'
+trace_test 'Task Cache Disabled'
+sim_test 'Task Cache Disabled'
+compact_test 'Task Cache Disabled'
+event_test 'Task Cache Disabled'
+msg_test 'Task Cache Disabled'
+coro_test 'Task Cache Disabled'
+budget_test 'Task Cache Disabled'
+prune_test 'Task Cache Disabled'
+power_test 'Task Cache Disabled'
+sleep_state_test 'Task Cache Disabled'
+table_test 'Task Cache Disabled'
+cpp_test 'Task Cache Disabled'
+hosted_test 'Task Cache Disabled'
+
+# Test the Batch Dispatch Enabled Configuration
+make -s clean
+make -s task_batch_enable
+echo ""
+access_test 'Batch Dispatch Enabled'
+interval_math_test 'Batch Dispatch Enabled'
+task_pool_test 'Batch Dispatch Enabled'
+arena_pool_test 'Batch Dispatch Enabled'
+que_test 'Batch Dispatch Enabled'
+rate_test 'Batch Dispatch Enabled'
+coalesce_test 'Batch Dispatch Enabled'
+tick_test 'Batch Dispatch Enabled'
+post_test 'Batch Dispatch Enabled'
+instance_test 'Batch Dispatch Enabled'
+priority_test 'Batch Dispatch Enabled'
+stats_test 'Batch Dispatch Enabled'
+trace_test 'Batch Dispatch Enabled'
+sim_test 'Batch Dispatch Enabled'
+compact_test 'Batch Dispatch Enabled'
+event_test 'Batch Dispatch Enabled'
+msg_test 'Batch Dispatch Enabled'
+coro_test 'Batch Dispatch Enabled'
+budget_test 'Batch Dispatch Enabled'
+prune_test 'Batch Dispatch Enabled'
+power_test 'Batch Dispatch Enabled'
+sleep_state_test 'Batch Dispatch Enabled'
+table_test 'Batch Dispatch Enabled'
+cpp_test 'Batch Dispatch Enabled'
+hosted_test 'Batch Dispatch Enabled'
+
+# Test the 64 Bit Time Enabled Configuration
+make -s clean
+make -s time_64_enable
+echo ""
+access_test '64 Bit Time Enabled'
+interval_math_test '64 Bit Time Enabled'
+task_pool_test '64 Bit Time Enabled'
+arena_pool_test '64 Bit Time Enabled'
+que_test '64 Bit Time Enabled'
+rate_test '64 Bit Time Enabled'
+coalesce_test '64 Bit Time Enabled'
+tick_test '64 Bit Time Enabled'
+post_test '64 Bit Time Enabled'
+instance_test '64 Bit Time Enabled'
+priority_test '64 Bit Time Enabled'
+stats_test '64 Bit Time Enabled'
+trace_test '64 Bit Time Enabled'
+sim_test '64 Bit Time Enabled'
+compact_test '64 Bit Time Enabled'
+event_test '64 Bit Time Enabled'
+msg_test '64 Bit Time Enabled'
+coro_test '64 Bit Time Enabled'
+budget_test '64 Bit Time Enabled'
+prune_test '64 Bit Time Enabled'
+power_test '64 Bit Time Enabled'
+sleep_state_test '64 Bit Time Enabled'
+table_test '64 Bit Time Enabled'
+cpp_test '64 Bit Time Enabled'
+hosted_test '64 Bit Time Enabled'
+
+# Test the Heap Que Engine Configuration
+make -s clean
+make -s que_heap
+echo ""
+access_test 'Heap Que'
+interval_math_test 'Heap Que'
+task_pool_test 'Heap Que'
+arena_pool_test 'Heap Que'
+que_test 'Heap Que'
+rate_test 'Heap Que'
+coalesce_test 'Heap Que'
+tick_test 'Heap Que'
+post_test 'Heap Que'
+instance_test 'Heap Que'
+priority_test 'Heap Que'
+stats_test 'Heap Que'
+trace_test 'Heap Que'
+sim_test 'Heap Que'
+compact_test 'Heap Que'
+event_test 'Heap Que'
+msg_test 'Heap Que'
+coro_test 'Heap Que'
+budget_test 'Heap Que'
+prune_test 'Heap Que'
+power_test 'Heap Que'
+sleep_state_test 'Heap Que'
+table_test 'Heap Que'
+cpp_test 'Heap Que'
+hosted_test 'Heap Que'
+
+# Test the Timing Wheel Que Engine Configuration
+make -s clean
+make -s que_wheel
+echo ""
+access_test 'Wheel Que'
+interval_math_test 'Wheel Que'
+task_pool_test 'Wheel Que'
+arena_pool_test 'Wheel Que'
+que_test 'Wheel Que'
+rate_test 'Wheel Que'
+coalesce_test 'Wheel Que'
+tick_test 'Wheel Que'
+post_test 'Wheel Que'
+instance_test 'Wheel Que'
+priority_test 'Wheel Que'
+stats_test 'Wheel Que'
+trace_test 'Wheel Que'
+sim_test 'Wheel Que'
+compact_test 'Wheel Que'
+event_test 'Wheel Que'
+msg_test 'Wheel Que'
+coro_test 'Wheel Que'
+budget_test 'Wheel Que'
+prune_test 'Wheel Que'
+power_test 'Wheel Que'
+sleep_state_test 'Wheel Que'
+table_test 'Wheel Que'
+cpp_test 'Wheel Que'
+hosted_test 'Wheel Que'
+
+# Test the 64 Bit Time Heap Que Engine Configuration
+make -s clean
+make -s time_64_que_heap
+echo ""
+que_test '64 Bit Time Heap Que'
+rate_test '64 Bit Time Heap Que'
+coalesce_test '64 Bit Time Heap Que'
+tick_test '64 Bit Time Heap Que'
+sim_test '64 Bit Time Heap Que'
+prune_test '64 Bit Time Heap Que'
+table_test '64 Bit Time Heap Que'
+
+# Test the 64 Bit Time Timing Wheel Que Engine Configuration
+make -s clean
+make -s time_64_que_wheel
+echo ""
+que_test '64 Bit Time Wheel Que'
+rate_test '64 Bit Time Wheel Que'
+coalesce_test '64 Bit Time Wheel Que'
+tick_test '64 Bit Time Wheel Que'
+sim_test '64 Bit Time Wheel Que'
+prune_test '64 Bit Time Wheel Que'
+table_test '64 Bit Time Wheel Que'
+
+# Test the Compact Task Layout Configuration
+make -s clean
+make -s task_compact_enable
+echo ""
+access_test 'Compact Layout'
+interval_math_test 'Compact Layout'
+task_pool_test 'Compact Layout'
+arena_pool_test 'Compact Layout'
+que_test 'Compact Layout'
+rate_test 'Compact Layout'
+coalesce_test 'Compact Layout'
+tick_test 'Compact Layout'
+post_test 'Compact Layout'
+instance_test 'Compact Layout'
+priority_test 'Compact Layout'
+stats_test 'Compact Layout'
+trace_test 'Compact Layout'
+sim_test 'Compact Layout'
+compact_test 'Compact Layout'
+event_test 'Compact Layout'
+msg_test 'Compact Layout'
+coro_test 'Compact Layout'
+budget_test 'Compact Layout'
+prune_test 'Compact Layout'
+power_test 'Compact Layout'
+sleep_state_test 'Compact Layout'
+table_test 'Compact Layout'
+cpp_test 'Compact Layout'
+hosted_test 'Compact Layout'
 
 #TODO Make a shortened interval test and add it back in.
 